@@ -31,8 +31,15 @@
 list (APPEND MAIN_SOURCE_FILES
   opm/core/grid/GridHelpers.cpp
 	opm/core/grid/GridManager.cpp
+	opm/core/grid/GridPartition.cpp
+	opm/core/grid/GridRenumbering.cpp
 	opm/core/grid/GridUtilities.cpp
 	opm/core/grid/grid.c
+	opm/core/grid/grid_binary.c
+	opm/core/grid/grid_compact.c
+	opm/core/grid/grid_text.c
+	opm/core/grid/grid_partition.c
+	opm/core/grid/grid_renumber.c
 	opm/core/grid/cart_grid.c
 	opm/core/grid/cornerpoint_grid.c
 	opm/core/grid/cpgpreprocess/facetopology.c
@@ -41,8 +48,13 @@ list (APPEND MAIN_SOURCE_FILES
 	opm/core/grid/cpgpreprocess/uniquepoints.c
 	opm/core/io/eclipse/EclipseGridInspector.cpp
 	opm/core/io/eclipse/EclipseWriter.cpp
+	opm/core/io/eclipse/StreamingCornerpointChopper.cpp
 	opm/core/io/eclipse/writeECLData.cpp
+	opm/core/io/AsyncOutputWriter.cpp
+	opm/core/io/BinaryOutputWriter.cpp
+	opm/core/io/Checkpoint.cpp
 	opm/core/io/OutputWriter.cpp
+	opm/core/io/SummaryOutputWriter.cpp
 	opm/core/io/vag/vag.cpp
 	opm/core/io/vtk/writeVtkData.cpp
 	opm/core/linalg/LinearSolverFactory.cpp
@@ -133,6 +145,7 @@ list (APPEND MAIN_SOURCE_FILES
 	opm/core/utility/miscUtilities.cpp
 	opm/core/utility/miscUtilitiesBlackoil.cpp
 	opm/core/utility/NullStream.cpp
+	opm/core/utility/scan_double.c
 	opm/core/utility/parameters/Parameter.cpp
 	opm/core/utility/parameters/ParameterGroup.cpp
 	opm/core/utility/parameters/ParameterTools.cpp
@@ -156,12 +169,25 @@ list (APPEND MAIN_SOURCE_FILES
 # find tests -name '*.cpp' -a ! -wholename '*/not-unit/*' -printf '\t%p\n' | sort
 list (APPEND TEST_SOURCE_FILES
   tests/test_writenumwells.cpp
+	tests/test_asyncoutputwriter.cpp
+	tests/test_binaryoutputwriter.cpp
+	tests/test_summaryoutputwriter.cpp
+	tests/test_checkpoint.cpp
 	tests/test_EclipseWriter.cpp
 	tests/test_compressedpropertyaccess.cpp
 	tests/test_spline.cpp
 	tests/test_propertysystem.cpp
 	tests/test_dgbasis.cpp
 	tests/test_cartgrid.cpp
+	tests/test_grid_binary.cpp
+	tests/test_grid_compact.cpp
+	tests/test_grid_text.cpp
+	tests/test_grid_partition.cpp
+	tests/test_grid_renumber.cpp
+	tests/test_writeVtkData.cpp
+	tests/test_vag.cpp
+	tests/test_scan_double.cpp
+	tests/test_streamingcornerpointchopper.cpp
   tests/test_ug.cpp
 	tests/test_cubic.cpp
 	tests/test_event.cpp
@@ -187,6 +213,8 @@ list (APPEND TEST_SOURCE_FILES
 	tests/test_regionmapping.cpp
 	tests/test_units.cpp
 	tests/test_blackoilstate.cpp
+	tests/test_mobilities.cpp
+	tests/test_cpgpreprocess.cpp
 	tests/test_parser.cpp
 	tests/test_wellsmanager.cpp
 	tests/test_wellcontrols.cpp
@@ -219,6 +247,7 @@ list (APPEND TEST_DATA_FILES
 	tests/satfuncEPS_B.DATA
 	tests/satfuncEPS_C.DATA
 	tests/satfuncEPS_D.DATA
+	tests/satfuncEPS_E.DATA
 	tests/testBlackoilState1.DATA
 	tests/testBlackoilState2.DATA
   tests/testBlackoilState3.DATA
@@ -234,11 +263,14 @@ list (APPEND TEST_DATA_FILES
 # originally generated with the command:
 # find tutorials examples -name '*.c*' -printf '\t%p\n' | sort
 list (APPEND EXAMPLE_SOURCE_FILES
+	examples/cart_grid_scaling.cpp
 	examples/compute_eikonal_from_files.cpp
 	examples/compute_initial_state.cpp
 	examples/compute_tof.cpp
 	examples/compute_tof_from_files.cpp
   examples/mirror_grid.cpp
+	examples/props_thread_scaling.cpp
+	examples/renumbering_benchmark.cpp
 	examples/sim_2p_comp_reorder.cpp
 	examples/sim_2p_incomp.cpp
 	examples/wells_example.cpp
@@ -277,10 +309,17 @@ list (APPEND PUBLIC_HEADER_FILES
 	opm/core/grid/FaceQuadrature.hpp
 	opm/core/grid/GridHelpers.hpp
 	opm/core/grid/GridManager.hpp
+	opm/core/grid/GridPartition.hpp
+	opm/core/grid/GridRenumbering.hpp
 	opm/core/grid/GridUtilities.hpp
 	opm/core/grid/MinpvProcessor.hpp
 	opm/core/grid/cart_grid.h
 	opm/core/grid/cornerpoint_grid.h
+	opm/core/grid/grid_binary.h
+	opm/core/grid/grid_compact.h
+	opm/core/grid/grid_text.h
+	opm/core/grid/grid_partition.h
+	opm/core/grid/grid_renumber.h
 	opm/core/grid/cpgpreprocess/facetopology.h
 	opm/core/grid/cpgpreprocess/geometry.h
 	opm/core/grid/cpgpreprocess/preprocess.h
@@ -289,8 +328,13 @@ list (APPEND PUBLIC_HEADER_FILES
 	opm/core/io/eclipse/EclipseGridInspector.hpp
 	opm/core/io/eclipse/EclipseUnits.hpp
 	opm/core/io/eclipse/EclipseWriter.hpp
+	opm/core/io/eclipse/StreamingCornerpointChopper.hpp
 	opm/core/io/eclipse/writeECLData.hpp
+	opm/core/io/AsyncOutputWriter.hpp
+	opm/core/io/BinaryOutputWriter.hpp
+	opm/core/io/Checkpoint.hpp
 	opm/core/io/OutputWriter.hpp
+	opm/core/io/SummaryOutputWriter.hpp
 	opm/core/io/vag/vag.hpp
 	opm/core/io/vtk/writeVtkData.hpp
 	opm/core/linalg/LinearSolverFactory.hpp
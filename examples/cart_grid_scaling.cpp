@@ -0,0 +1,109 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif // HAVE_CONFIG_H
+
+#include <opm/core/grid.h>
+#include <opm/core/grid/cart_grid.h>
+#include <opm/core/utility/ErrorMacros.hpp>
+#include <opm/core/utility/StopWatch.hpp>
+#include <opm/core/utility/parameters/ParameterGroup.hpp>
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+// ----------------- Main program -----------------
+// Measures the thread scaling of structured grid construction
+// (create_grid_hexa3d(), and create_grid_tensor3d() with and without
+// layer depths).
+int
+main(int argc, char** argv)
+try
+{
+    using namespace Opm;
+
+    parameter::ParameterGroup param(argc, argv, false);
+    const int nx = param.getDefault("nx", 200);
+    const int ny = param.getDefault("ny", 200);
+    const int nz = param.getDefault("nz", 100);
+#ifdef _OPENMP
+    const int max_threads = param.getDefault("max_threads", omp_get_max_threads());
+#else
+    const int max_threads = 1;
+#endif
+
+    std::vector<double> x(nx + 1), y(ny + 1), z(nz + 1);
+    std::vector<double> depthz((nx + 1)*(ny + 1));
+    for (int i = 0; i <= nx; ++i) { x[i] = i*(1.0 + 0.001*i); }
+    for (int j = 0; j <= ny; ++j) { y[j] = j*(1.0 + 0.002*j); }
+    for (int k = 0; k <= nz; ++k) { z[k] = 0.5*k; }
+    for (int j = 0; j <= ny; ++j) {
+        for (int i = 0; i <= nx; ++i) {
+            depthz[i + (nx + 1)*j] = 0.01*(i + j);
+        }
+    }
+
+    std::cout << "Grid " << nx << " x " << ny << " x " << nz
+              << " (" << double(nx)*ny*nz << " cells)\n"
+              << "threads        hexa3d     tensor3d      layered" << std::endl;
+    for (int num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+#ifdef _OPENMP
+        omp_set_num_threads(num_threads);
+#endif
+        double t[3];
+        for (int variant = 0; variant < 3; ++variant) {
+            time::StopWatch clock;
+            clock.start();
+            UnstructuredGrid* g = 0;
+            switch (variant) {
+            case 0:
+                g = create_grid_hexa3d(nx, ny, nz, 1.0, 1.0, 0.5);
+                break;
+            case 1:
+                g = create_grid_tensor3d(nx, ny, nz, &x[0], &y[0], &z[0], 0);
+                break;
+            case 2:
+                g = create_grid_tensor3d(nx, ny, nz, &x[0], &y[0], &z[0], &depthz[0]);
+                break;
+            }
+            t[variant] = clock.secsSinceStart();
+            if (!g) {
+                OPM_THROW(std::runtime_error, "Failed to construct grid.");
+            }
+            destroy_grid(g);
+        }
+        std::cout << std::setw(7) << num_threads
+                  << std::setw(14) << t[0]
+                  << std::setw(13) << t[1]
+                  << std::setw(13) << t[2] << std::endl;
+    }
+}
+catch (const std::exception& e) {
+    std::cerr << "Program threw an exception: " << e.what() << "\n";
+    throw;
+}
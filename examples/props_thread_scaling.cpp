@@ -0,0 +1,193 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif // HAVE_CONFIG_H
+
+#include <opm/core/grid.h>
+#include <opm/core/grid/GridManager.hpp>
+#include <opm/core/utility/ErrorMacros.hpp>
+#include <opm/core/utility/StopWatch.hpp>
+#include <opm/core/utility/Units.hpp>
+#include <opm/core/utility/parameters/ParameterGroup.hpp>
+#include <opm/core/props/BlackoilPropertiesFromDeck.hpp>
+
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace
+{
+    struct PropsInput
+    {
+        std::vector<int> cells;
+        std::vector<double> p;
+        std::vector<double> T;
+        std::vector<double> z;
+        std::vector<double> s;
+    };
+
+    struct PropsOutput
+    {
+        std::vector<double> A;
+        std::vector<double> dAdp;
+        std::vector<double> mu;
+        std::vector<double> rho;
+        std::vector<double> kr;
+
+        bool operator==(const PropsOutput& other) const
+        {
+            return A == other.A && dAdp == other.dAdp && mu == other.mu
+                && rho == other.rho && kr == other.kr;
+        }
+    };
+
+    // Evaluate all properties for the data points [begin, end).
+    void evalRange(const Opm::BlackoilPropertiesFromDeck& props,
+                   const PropsInput& in,
+                   const int begin,
+                   const int end,
+                   Opm::BlackoilPropertiesFromDeck::Workspace& ws,
+                   PropsOutput& out)
+    {
+        const int np = props.numPhases();
+        const int n = end - begin;
+        if (n <= 0) {
+            return;
+        }
+        const int* cells = &in.cells[begin];
+        props.matrix(n, &in.p[begin], &in.T[begin], &in.z[np*begin], cells,
+                     &out.A[np*np*begin], &out.dAdp[np*np*begin], ws);
+        props.viscosity(n, &in.p[begin], &in.T[begin], &in.z[np*begin], cells,
+                        &out.mu[np*begin], 0, ws);
+        props.density(n, &out.A[np*np*begin], cells, &out.rho[np*begin]);
+        props.relperm(n, &in.s[np*begin], cells, &out.kr[np*begin], 0);
+    }
+
+    // Evaluate all data points, split in one contiguous chunk per thread,
+    // each with its own workspace.
+    double evalAll(const Opm::BlackoilPropertiesFromDeck& props,
+                   const PropsInput& in,
+                   const int num_threads,
+                   const int repeats,
+                   PropsOutput& out)
+    {
+        const int n = in.cells.size();
+        std::vector<Opm::BlackoilPropertiesFromDeck::Workspace> ws(num_threads);
+        Opm::time::StopWatch clock;
+        clock.start();
+        for (int rep = 0; rep < repeats; ++rep) {
+#pragma omp parallel for num_threads(num_threads) schedule(static, 1)
+            for (int chunk = 0; chunk < num_threads; ++chunk) {
+                const int begin = (long(n)*chunk)/num_threads;
+                const int end = (long(n)*(chunk + 1))/num_threads;
+                evalRange(props, in, begin, end, ws[chunk], out);
+            }
+        }
+        return clock.secsSinceStart()/repeats;
+    }
+
+} // anon namespace
+
+
+
+// ----------------- Main program -----------------
+// Measures the thread scaling of BlackoilPropertiesFromDeck evaluation,
+// each thread evaluating a disjoint range of cells on a shared object.
+int
+main(int argc, char** argv)
+try
+{
+    using namespace Opm;
+
+    // Setup.
+    parameter::ParameterGroup param(argc, argv, false);
+    std::cout << "---------------    Reading parameters     ---------------" << std::endl;
+    const std::string deck_filename = param.get<std::string>("deck_filename");
+    Opm::ParserPtr parser(new Opm::Parser() );
+    Opm::DeckConstPtr deck = parser->parseFile(deck_filename);
+    Opm::EclipseStateConstPtr eclipseState(new Opm::EclipseState(deck));
+    GridManager gm(deck);
+    const UnstructuredGrid& grid = *gm.c_grid();
+    BlackoilPropertiesFromDeck props(deck, eclipseState, grid, param);
+    const int repeats = param.getDefault("repeats", 10);
+#ifdef _OPENMP
+    const int max_threads = param.getDefault("max_threads", omp_get_max_threads());
+#else
+    const int max_threads = 1;
+#endif
+
+    // Input: all cells, with pressures and saturations varying over the grid.
+    const int nc = grid.number_of_cells;
+    const int np = props.numPhases();
+    PropsInput in;
+    in.cells.resize(nc);
+    in.p.resize(nc);
+    in.T.assign(nc, 273.15 + 20.0);
+    in.z.resize(nc*np);
+    in.s.resize(nc*np);
+    for (int c = 0; c < nc; ++c) {
+        const double frac = (c + 0.5)/nc;
+        in.cells[c] = c;
+        in.p[c] = (100.0 + 200.0*frac)*unit::barsa;
+        for (int phase = 0; phase < np; ++phase) {
+            in.s[np*c + phase] = (phase == 0) ? frac : (1.0 - frac)/(np - 1);
+            in.z[np*c + phase] = in.s[np*c + phase];
+        }
+    }
+
+    PropsOutput reference;
+    reference.A.resize(nc*np*np);
+    reference.dAdp.resize(nc*np*np);
+    reference.mu.resize(nc*np);
+    reference.rho.resize(nc*np);
+    reference.kr.resize(nc*np);
+    const double serial_time = evalAll(props, in, 1, repeats, reference);
+
+    std::cout << "threads      seconds      speedup" << std::endl;
+    for (int num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+        PropsOutput out;
+        out.A.assign(nc*np*np, 0.0);
+        out.dAdp.assign(nc*np*np, 0.0);
+        out.mu.assign(nc*np, 0.0);
+        out.rho.assign(nc*np, 0.0);
+        out.kr.assign(nc*np, 0.0);
+        const double t = evalAll(props, in, num_threads, repeats, out);
+        if (!(out == reference)) {
+            OPM_THROW(std::runtime_error, "Results with " << num_threads
+                      << " threads differ from serial evaluation.");
+        }
+        std::cout << std::setw(7) << num_threads
+                  << std::setw(13) << t
+                  << std::setw(13) << serial_time/t << std::endl;
+    }
+}
+catch (const std::exception& e) {
+    std::cerr << "Program threw an exception: " << e.what() << "\n";
+    throw;
+}
@@ -0,0 +1,191 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif // HAVE_CONFIG_H
+
+#include <opm/core/grid.h>
+#include <opm/core/grid/GridManager.hpp>
+#include <opm/core/grid/GridRenumbering.hpp>
+#include <opm/core/linalg/LinearSolverFactory.hpp>
+#include <opm/core/pressure/IncompTpfa.hpp>
+#include <opm/core/props/IncompPropertiesBasic.hpp>
+#include <opm/core/props/IncompPropertiesFromDeck.hpp>
+#include <opm/core/simulator/TwophaseState.hpp>
+#include <opm/core/simulator/WellState.hpp>
+#include <opm/core/transport/reorder/TransportSolverTwophaseReorder.hpp>
+#include <opm/core/utility/ErrorMacros.hpp>
+#include <opm/core/utility/StopWatch.hpp>
+#include <opm/core/utility/Units.hpp>
+#include <opm/core/utility/miscUtilities.hpp>
+#include <opm/core/utility/parameters/ParameterGroup.hpp>
+
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+    struct RunResult
+    {
+        double pressure_time;
+        double transport_time;
+        std::vector<double> saturation;
+    };
+
+    // Run a fixed number of sequential pressure and transport steps,
+    // driven by source terms src (in the grid's cell numbering).
+    RunResult run(const UnstructuredGrid& grid,
+                  const Opm::IncompPropertiesInterface& props,
+                  const std::vector<double>& src,
+                  const Opm::parameter::ParameterGroup& param)
+    {
+        using namespace Opm;
+        const int steps = param.getDefault("steps", 10);
+        const double dt = param.getDefault("dt_days", 10.0)*unit::day;
+
+        LinearSolverFactory linsolver(param);
+        IncompTpfa psolver(grid, props, linsolver, 0, 0, src, 0);
+        TransportSolverTwophaseReorder tsolver(grid, props, 0, 1e-9, 30);
+
+        std::vector<double> porevol;
+        computePorevolume(grid, props.porosity(), porevol);
+
+        TwophaseState state;
+        state.init(grid, 2);
+        for (int c = 0; c < grid.number_of_cells; ++c) {
+            state.saturation()[2*c] = 0.0;
+            state.saturation()[2*c + 1] = 1.0;
+        }
+        WellState well_state;
+        well_state.init(0, state);
+
+        RunResult res;
+        res.pressure_time = 0.0;
+        res.transport_time = 0.0;
+        std::vector<double> transport_src;
+        for (int step = 0; step < steps; ++step) {
+            time::StopWatch clock;
+            clock.start();
+            psolver.solve(dt, state, well_state);
+            res.pressure_time += clock.secsSinceStart();
+
+            clock.start();
+            computeTransportSource(grid, src, state.faceflux(), 1.0, 0,
+                                   well_state.perfRates(), transport_src);
+            tsolver.solve(&porevol[0], &transport_src[0], dt, state);
+            res.transport_time += clock.secsSinceStart();
+        }
+        res.saturation = state.saturation();
+        return res;
+    }
+
+} // anon namespace
+
+
+
+// ----------------- Main program -----------------
+// Compares end-to-end incompressible pressure and reordering transport
+// time on the original grid and on its cell and face renumberings.
+int
+main(int argc, char** argv)
+try
+{
+    using namespace Opm;
+
+    parameter::ParameterGroup param(argc, argv, false);
+    std::cout << "---------------    Reading parameters     ---------------" << std::endl;
+
+    // Grid, from deck or cartesian.
+    Opm::DeckConstPtr deck;
+    EclipseStateConstPtr eclipseState;
+    std::unique_ptr<GridManager> gm;
+    const bool use_deck = param.has("deck_filename");
+    if (use_deck) {
+        ParserPtr parser(new Opm::Parser());
+        deck = parser->parseFile(param.get<std::string>("deck_filename"));
+        eclipseState.reset(new EclipseState(deck));
+        gm.reset(new GridManager(deck));
+    } else {
+        gm.reset(new GridManager(param.getDefault("nx", 100),
+                                 param.getDefault("ny", 100),
+                                 param.getDefault("nz", 10)));
+    }
+    const UnstructuredGrid& grid = *gm->c_grid();
+    const int nc = grid.number_of_cells;
+
+    GridRenumbering rcm(grid, GridRenumbering::ReverseCuthillMcKee);
+    GridRenumbering hilbert(grid, GridRenumbering::Hilbert);
+
+    const char* names[] = { "original", "rcm", "hilbert" };
+    const UnstructuredGrid* grids[] = { &grid, rcm.c_grid(), hilbert.c_grid() };
+    const GridRenumbering* renum[] = { 0, &rcm, &hilbert };
+
+    // Inject in the first cell and produce from the last, in original numbering.
+    std::vector<double> src(nc, 0.0);
+    {
+        std::vector<double> porevol;
+        IncompPropertiesBasic basic(param, grid.dimensions, nc);
+        computePorevolume(grid, basic.porosity(), porevol);
+        const double rate = 0.01*std::accumulate(porevol.begin(), porevol.end(), 0.0)/unit::day;
+        src[0] = rate;
+        src[nc - 1] = -rate;
+    }
+
+    std::vector<double> reference;
+    std::cout << "ordering      pressure    transport        total    max |ds|" << std::endl;
+    for (int i = 0; i < 3; ++i) {
+        const UnstructuredGrid& g = *grids[i];
+        std::unique_ptr<IncompPropertiesInterface> props;
+        if (use_deck) {
+            props.reset(new IncompPropertiesFromDeck(deck, eclipseState, g));
+        } else {
+            props.reset(new IncompPropertiesBasic(param, g.dimensions, g.number_of_cells));
+        }
+        const std::vector<double> g_src = renum[i] ? renum[i]->cellDataToNew(src) : src;
+        RunResult res = run(g, *props, g_src, param);
+        if (renum[i]) {
+            res.saturation = renum[i]->cellDataToOld(res.saturation);
+        } else {
+            reference = res.saturation;
+        }
+        double maxdiff = 0.0;
+        for (std::size_t k = 0; k < reference.size(); ++k) {
+            maxdiff = std::max(maxdiff, std::fabs(res.saturation[k] - reference[k]));
+        }
+        std::cout << std::setw(8) << names[i]
+                  << std::setw(14) << res.pressure_time
+                  << std::setw(13) << res.transport_time
+                  << std::setw(13) << res.pressure_time + res.transport_time
+                  << std::setw(12) << maxdiff << std::endl;
+    }
+}
+catch (const std::exception& e) {
+    std::cerr << "Program threw an exception: " << e.what() << "\n";
+    throw;
+}
@@ -43,6 +43,7 @@
 #include <opm/core/simulator/BlackoilState.hpp>
 #include <opm/core/simulator/WellState.hpp>
 #include <opm/core/simulator/SimulatorCompressibleTwophase.hpp>
+#include <opm/core/io/Checkpoint.hpp>
 
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
@@ -200,6 +201,14 @@ try
 
     std::cout << "\n\n================    Starting main simulation loop     ===============\n";
 
+    // Optionally resume from a checkpoint written with output_checkpoint=true.
+    std::unique_ptr<Checkpoint> checkpoint;
+    if (param.has("restart_checkpoint")) {
+        checkpoint.reset(new Checkpoint(param.get<std::string>("restart_checkpoint")));
+        std::cout << "Resuming from step " << checkpoint->stepNum() << " of checkpoint "
+                  << param.get<std::string>("restart_checkpoint") << std::endl;
+    }
+
     SimulatorReport rep;
     if (!use_deck) {
         // Simple simulation without a deck.
@@ -218,11 +227,15 @@ try
         warnIfUnusedParams(param);
         WellState well_state;
         well_state.init(0, state);
+        if (checkpoint) {
+            checkpoint->restore(state, well_state);
+            simtimer.setCurrentStepNum(checkpoint->stepNum());
+        }
         rep = simulator.run(simtimer, state, well_state);
     } else {
         // With a deck, we may have more epochs etc.
         WellState well_state;
-        int step = 0;
+        int step = checkpoint ? checkpoint->stepNum() : 0;
         SimulatorTimer simtimer;
         // Use timer for last epoch to obtain total time.
         Opm::TimeMapPtr timeMap(new Opm::TimeMap(deck));
@@ -244,6 +257,9 @@ try
             // since number of wells may change etc.
             if (reportStepIdx == 0) {
                 well_state.init(wells.c_wells(), state);
+                if (checkpoint) {
+                    checkpoint->restore(state, well_state);
+                }
             }
 
             // Create and run simulator.
@@ -44,6 +44,7 @@
 #include <opm/core/simulator/TwophaseState.hpp>
 #include <opm/core/simulator/WellState.hpp>
 #include <opm/core/simulator/SimulatorIncompTwophase.hpp>
+#include <opm/core/io/Checkpoint.hpp>
 
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
@@ -214,6 +215,14 @@ try
         param.writeParam(output_dir + "/simulation.param");
     }
 
+    // Optionally resume from a checkpoint written with output_checkpoint=true.
+    std::unique_ptr<Checkpoint> checkpoint;
+    if (param.has("restart_checkpoint")) {
+        checkpoint.reset(new Checkpoint(param.get<std::string>("restart_checkpoint")));
+        std::cout << "Resuming from step " << checkpoint->stepNum() << " of checkpoint "
+                  << param.get<std::string>("restart_checkpoint") << std::endl;
+    }
+
     SimulatorReport rep;
     if (!use_deck) {
         std::cout << "\n\n================    Starting main simulation loop     ===============\n"
@@ -234,6 +243,10 @@ try
         warnIfUnusedParams(param);
         WellState well_state;
         well_state.init(0, state);
+        if (checkpoint) {
+            checkpoint->restore(state, well_state);
+            simtimer.setCurrentStepNum(checkpoint->stepNum());
+        }
         rep = simulator.run(simtimer, state, well_state);
     } else {
         // With a deck, we may have more epochs etc.
@@ -243,7 +256,7 @@ try
                   << "                        (number of report steps: "
                   << timeMap->numTimesteps() << ")\n\n" << std::flush;
         WellState well_state;
-        int step = 0;
+        int step = checkpoint ? checkpoint->stepNum() : 0;
         SimulatorTimer simtimer;
         // Use timer for last epoch to obtain total time.
         simtimer.init(timeMap);
@@ -265,6 +278,9 @@ try
             // since number of wells may change etc.
             if (reportStepIdx == 0) {
                 well_state.init(wells.c_wells(), state);
+                if (checkpoint) {
+                    checkpoint->restore(state, well_state);
+                }
             }
 
             // Create and run simulator.
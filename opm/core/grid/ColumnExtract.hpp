@@ -1,37 +1,11 @@
 #include <opm/core/grid.h>
 #include <vector>
-#include <map>
-#include <algorithm>
+#include <numeric>
 
 namespace Opm {
 
     namespace {
 
-        /// Helper struct for extractColumn
-        /// Compares the underlying k-index
-        struct ExtractColumnCompare
-        {
-            ExtractColumnCompare(const UnstructuredGrid& g)
-            : grid(g)
-            {
-                // empty
-            }
-
-            bool operator()(const int i, const int j)
-            {
-                // Extract k-index
-                int index_i = grid.global_cell ? grid.global_cell[i] : i;
-                int k_i = index_i / grid.cartdims[0] / grid.cartdims[1];
-                int index_j = grid.global_cell ? grid.global_cell[j] : j;
-                int k_j = index_j / grid.cartdims[0] / grid.cartdims[1];
-
-                return k_i < k_j;
-            }
-
-            const UnstructuredGrid& grid;
-        };
-
-
         /// Neighbourhood query.
         /// \return true if two cells are neighbours.
         bool neighbours(const UnstructuredGrid& grid, const int c0, const int c1)
@@ -54,67 +28,95 @@ namespace Opm {
 ///  \param columns will for each (i, j) where (i, j) represents a non-empty column,
 ////        contain the cell indices contained in the column
 ///         centered at (i, j) in the second variable, and i+jN in the first variable.
+///         Columns are numbered in order of their first cell.  A column
+///         consisting of several disconnected parts is split, the
+///         topmost parts being appended after all other columns.
+///         Any previous contents are replaced.
 inline void extractColumn( const UnstructuredGrid& grid, std::vector<std::vector<int> >& columns )
 {
-    const int* dims = grid.cartdims;
-
-    // Keeps track of column_index ---> index of vector
-    std::map<int, int> global_to_local;
-    for (int cell = 0; cell < grid.number_of_cells; ++cell) {
-        // Extract Cartesian coordinates
-        int index = grid.global_cell ? grid.global_cell[cell] : cell; // If null, assume mapping is identity.
-        int i_cart = index % dims[0];
-        int k_cart = index / dims[0] / dims[1];
-        int j_cart = (index - k_cart*dims[0]*dims[1])/ dims[0];
+    const int nc = grid.number_of_cells;
+    const int nxy = grid.cartdims[0] * grid.cartdims[1];
+    const int nz = grid.cartdims[2];
+
+    // Column (i + j*nx) and layer k of each cell.
+    std::vector<int> ij(nc);
+    std::vector<int> k(nc);
+#pragma omp parallel for
+    for (int cell = 0; cell < nc; ++cell) {
+        const int index = grid.global_cell ? grid.global_cell[cell] : cell; // If null, assume mapping is identity.
+        ij[cell] = index % nxy;
+        k[cell] = index / nxy;
+    }
 
-        int local_index;
-        std::map<int, int>::iterator local_index_iterator = global_to_local.find(i_cart+j_cart*dims[0]);
-        if (local_index_iterator != global_to_local.end()) {
-            local_index = local_index_iterator->second;
-        } else {
-            local_index = columns.size();
-            global_to_local[i_cart+j_cart*dims[0]] = local_index;
-            columns.push_back(std::vector<int>());
+    // Number the columns in order of first occurrence,
+    // and count the cells of each column.
+    std::vector<int> col_of_ij(nxy, -1);
+    std::vector<int> col(nc);
+    std::vector<int> colpos(1, 0);
+    for (int cell = 0; cell < nc; ++cell) {
+        int& c = col_of_ij[ij[cell]];
+        if (c < 0) {
+            c = colpos.size() - 1;
+            colpos.push_back(0);
         }
-        columns[local_index].push_back(cell);
+        col[cell] = c;
+        ++colpos[c + 1];
     }
-
-    int num_cols = columns.size();
-    for (int col = 0; col < num_cols; ++col) {
-        std::sort(columns[col].begin(), columns[col].end(), ExtractColumnCompare(grid));
+    const int num_cols = colpos.size() - 1;
+    std::partial_sum(colpos.begin(), colpos.end(), colpos.begin());
+
+    // Bucket the cells by layer, then distribute them to their columns
+    // in that order, so that each column is sorted by k.
+    std::vector<int> layerpos(nz + 1, 0);
+    for (int cell = 0; cell < nc; ++cell) {
+        ++layerpos[k[cell] + 1];
+    }
+    std::partial_sum(layerpos.begin(), layerpos.end(), layerpos.begin());
+    std::vector<int> by_layer(nc);
+    for (int cell = 0; cell < nc; ++cell) {
+        by_layer[layerpos[k[cell]]++] = cell;
+    }
+    std::vector<int> cells(nc);
+    {
+        std::vector<int> next(colpos.begin(), colpos.end() - 1);
+        for (int i = 0; i < nc; ++i) {
+            const int cell = by_layer[i];
+            cells[next[col[cell]]++] = cell;
+        }
     }
 
     // At this point, a column may contain multiple disjoint sets of cells.
-    // We must split these columns into connected parts.
+    // Determine for each consecutive pair of cells in a column whether
+    // they are connected.
+    std::vector<char> connected(nc, 0);
+#pragma omp parallel for
+    for (int i = 0; i < nc - 1; ++i) {
+        const int c0 = cells[i];
+        const int c1 = cells[i + 1];
+        connected[i] = (col[c0] == col[c1]) && neighbours(grid, c0, c1);
+    }
+
+    // Split the columns into connected parts.  All but the last part
+    // of each column become new columns.
+    columns.assign(num_cols, std::vector<int>());
     std::vector< std::vector<int> > new_columns;
-    for (int col = 0; col < num_cols; ++col) {
-        const int colsz = columns[col].size();
-        int first_of_col = 0;
-        for (int k = 1; k < colsz; ++k) {
-            const int c0 = columns[col][k-1];
-            const int c1 = columns[col][k];
-            if (!neighbours(grid, c0, c1)) {
-                // Must split. Move the cells [first_of_col, ... , k-1] to
-                // a new column, known to be connected.
-                new_columns.push_back(std::vector<int>());
-                new_columns.back().assign(columns[col].begin() + first_of_col, columns[col].begin() + k);
-                // The working column now starts with index k.
-                first_of_col = k;
+    for (int c = 0; c < num_cols; ++c) {
+        int first_of_col = colpos[c];
+        for (int i = colpos[c]; i < colpos[c + 1] - 1; ++i) {
+            if (!connected[i]) {
+                new_columns.push_back(std::vector<int>(cells.begin() + first_of_col,
+                                                       cells.begin() + i + 1));
+                first_of_col = i + 1;
             }
         }
-        if (first_of_col != 0) {
-            // The column was split, the working part should be
-            // the entire column. We erase the cells before first_of_col.
-            // (Could be more efficient if we instead chop off end.)
-            columns[col].erase(columns[col].begin(), columns[col].begin() + first_of_col);
-        }
+        columns[c].assign(cells.begin() + first_of_col, cells.begin() + colpos[c + 1]);
     }
 
     // Must tack on the new columns to complete the set.
     const int num_cols_all = num_cols + new_columns.size();
     columns.resize(num_cols_all);
-    for (int col = num_cols; col < num_cols_all; ++col) {
-        columns[col].swap(new_columns[col - num_cols]);
+    for (int c = num_cols; c < num_cols_all; ++c) {
+        columns[c].swap(new_columns[c - num_cols]);
     }
 
 }
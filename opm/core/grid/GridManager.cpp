@@ -23,27 +23,71 @@
 #include <opm/core/grid.h>
 #include <opm/core/grid/cart_grid.h>
 #include <opm/core/grid/cornerpoint_grid.h>
+#include <opm/core/grid/grid_binary.h>
+#include <opm/core/grid/grid_text.h>
+#include <opm/core/grid/grid_compact.h>
 #include <opm/core/grid/MinpvProcessor.hpp>
 #include <opm/core/utility/ErrorMacros.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 
 #include <array>
 #include <algorithm>
+#include <cstdint>
+#include <cstdio>
 #include <numeric>
+#include <sstream>
+
+#include <unistd.h>
+
+namespace
+{
+    // 64-bit FNV-1a hash, used to key cached grids on their input.
+    class InputHash
+    {
+    public:
+        InputHash() : h_(14695981039346656037ULL) {}
+
+        template <typename T>
+        void add(const T* data, const std::size_t n)
+        {
+            const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+            const std::size_t len = n*sizeof(T);
+            for (std::size_t i = 0; i < len; ++i) {
+                h_ = (h_ ^ p[i]) * 1099511628211ULL;
+            }
+        }
+
+        template <typename T>
+        void add(const std::vector<T>& v)
+        {
+            const std::uint64_t n = v.size();
+            add(&n, 1);
+            if (!v.empty()) {
+                add(v.data(), v.size());
+            }
+        }
+
+        std::uint64_t value() const { return h_; }
+
+    private:
+        std::uint64_t h_;
+    };
+} // anonymous namespace
+
 
 namespace Opm
 {
 
     /// Construct a 3d corner-point grid from a deck.
     GridManager::GridManager(Opm::EclipseGridConstPtr eclipseGrid)
-        : ug_(0)
+        : ug_(0), mapped_(false), node_archive_(0), cache_status_(NotCached)
     {
         initFromEclipseGrid(eclipseGrid, std::vector<double>());
     }
 
 
     GridManager::GridManager(Opm::DeckConstPtr deck)
-        : ug_(0)
+        : ug_(0), mapped_(false), node_archive_(0), cache_status_(NotCached)
     {
         auto eclipseGrid = std::make_shared<const Opm::EclipseGrid>(deck);
         initFromEclipseGrid(eclipseGrid, std::vector<double>());
@@ -52,14 +96,24 @@ namespace Opm
 
     GridManager::GridManager(Opm::EclipseGridConstPtr eclipseGrid,
                              const std::vector<double>& poreVolumes)
-        : ug_(0)
+        : ug_(0), mapped_(false), node_archive_(0), cache_status_(NotCached)
     {
         initFromEclipseGrid(eclipseGrid, poreVolumes);
     }
 
 
+    GridManager::GridManager(Opm::EclipseGridConstPtr eclipseGrid,
+                             const std::vector<double>& poreVolumes,
+                             const std::string& cache_dir)
+        : ug_(0), mapped_(false), node_archive_(0), cache_status_(NotCached)
+    {
+        initFromEclipseGrid(eclipseGrid, poreVolumes, cache_dir);
+    }
+
+
     /// Construct a 2d cartesian grid with cells of unit size.
     GridManager::GridManager(int nx, int ny)
+        : mapped_(false), node_archive_(0), cache_status_(NotCached)
     {
         ug_ = create_grid_cart2d(nx, ny, 1.0, 1.0);
         if (!ug_) {
@@ -68,6 +122,7 @@ namespace Opm
     }
 
     GridManager::GridManager(int nx, int ny,double dx, double dy)
+        : mapped_(false), node_archive_(0), cache_status_(NotCached)
     {
         ug_ = create_grid_cart2d(nx, ny, dx, dy);
         if (!ug_) {
@@ -78,6 +133,7 @@ namespace Opm
 
     /// Construct a 3d cartesian grid with cells of unit size.
     GridManager::GridManager(int nx, int ny, int nz)
+        : mapped_(false), node_archive_(0), cache_status_(NotCached)
     {
         ug_ = create_grid_cart3d(nx, ny, nz);
         if (!ug_) {
@@ -91,6 +147,7 @@ namespace Opm
     /// Construct a 3d cartesian grid with cells of size [dx, dy, dz].
     GridManager::GridManager(int nx, int ny, int nz,
                              double dx, double dy, double dz)
+        : mapped_(false), node_archive_(0), cache_status_(NotCached)
     {
         ug_ = create_grid_hexa3d(nx, ny, nz, dx, dy, dz);
         if (!ug_) {
@@ -105,8 +162,9 @@ namespace Opm
     /// The file format used is currently undocumented,
     /// and is therefore only suited for internal use.
     GridManager::GridManager(const std::string& input_filename)
+        : mapped_(false), node_archive_(0), cache_status_(NotCached)
     {
-        ug_ = read_grid(input_filename.c_str());
+        ug_ = read_grid_mapped(input_filename.c_str());
         if (!ug_) {
             OPM_THROW(std::runtime_error, "Failed to read grid from file " << input_filename);
         }
@@ -115,7 +173,12 @@ namespace Opm
     /// Destructor.
     GridManager::~GridManager()
     {
-        destroy_grid(ug_);
+        destroy_grid_node_archive(node_archive_);
+        if (mapped_) {
+            unmap_grid_binary(ug_);
+        } else {
+            destroy_grid(ug_);
+        }
     }
 
 
@@ -132,9 +195,58 @@ namespace Opm
 
 
 
+    /// Outcome of the grid cache lookup.
+    GridManager::CacheStatus GridManager::cacheStatus() const
+    {
+        return cache_status_;
+    }
+
+
+
+
+    /// Name of the grid cache file.
+    const std::string& GridManager::cacheFile() const
+    {
+        return cache_file_;
+    }
+
+
+
+
+    /// Release node data of the managed grid into a compact archive.
+    void GridManager::compactNodes(bool single_precision)
+    {
+        if (mapped_ || node_archive_ != 0) {
+            return;
+        }
+        node_archive_ = archive_grid_nodes(ug_, single_precision ? 1 : 0);
+        if (!node_archive_) {
+            OPM_THROW(std::runtime_error, "Failed to compact grid nodes.");
+        }
+    }
+
+
+
+
+    /// Restore node data released by compactNodes().
+    void GridManager::restoreNodes()
+    {
+        if (node_archive_ == 0) {
+            return;
+        }
+        if (!restore_grid_nodes(ug_, node_archive_)) {
+            OPM_THROW(std::runtime_error, "Failed to restore grid nodes.");
+        }
+        node_archive_ = 0;
+    }
+
+
+
+
     // Construct corner-point grid from EclipseGrid.
     void GridManager::initFromEclipseGrid(Opm::EclipseGridConstPtr eclipseGrid,
-                                          const std::vector<double>& poreVolumes)
+                                          const std::vector<double>& poreVolumes,
+                                          const std::string& cache_dir)
     {
         struct grdecl g;
         std::vector<int> actnum;
@@ -156,17 +268,61 @@ namespace Opm
         g.actnum = actnum.data();
         g.mapaxes = mapaxes.data();
 
-        if (!poreVolumes.empty() && eclipseGrid->isMinpvActive()) {
+        const double z_tolerance = eclipseGrid->isPinchActive() ?
+            eclipseGrid->getPinchThresholdThickness() : 0.0;
+        const bool do_minpv = !poreVolumes.empty() && eclipseGrid->isMinpvActive();
+        const double minpv = do_minpv ? eclipseGrid->getMinpvValue() : 0.0;
+
+        // Look for a cached grid built from identical input.
+        std::uint64_t key = 0;
+        if (!cache_dir.empty()) {
+            InputHash hash;
+            hash.add(g.dims, 3);
+            hash.add(coord);
+            hash.add(zcorn);
+            hash.add(actnum);
+            hash.add(&z_tolerance, 1);
+            hash.add(&minpv, 1);
+            if (do_minpv) {
+                hash.add(poreVolumes);
+            }
+            key = hash.value();
+
+            std::ostringstream fname;
+            fname << cache_dir << "/grid-" << std::hex << key << ".ugrid";
+            cache_file_ = fname.str();
+
+            ug_ = map_grid_binary(cache_file_.c_str(), key);
+            if (ug_) {
+                mapped_ = true;
+                cache_status_ = ReadFromCache;
+                return;
+            }
+        }
+
+        if (do_minpv) {
             MinpvProcessor mp(g.dims[0], g.dims[1], g.dims[2]);
-            mp.process(poreVolumes, eclipseGrid->getMinpvValue(), actnum, zcorn.data());
+            mp.process(poreVolumes, minpv, actnum, zcorn.data());
         }
 
-        const double z_tolerance = eclipseGrid->isPinchActive() ?
-            eclipseGrid->getPinchThresholdThickness() : 0.0;
         ug_ = create_grid_cornerpoint(&g, z_tolerance);
         if (!ug_) {
             OPM_THROW(std::runtime_error, "Failed to construct grid.");
         }
+
+        if (!cache_file_.empty()) {
+            // Write to a private file first, so that concurrent runs
+            // never map a partially written grid.
+            std::ostringstream tmp;
+            tmp << cache_file_ << ".tmp." << ::getpid();
+            if (write_grid_binary(ug_, tmp.str().c_str(), key)
+                && std::rename(tmp.str().c_str(), cache_file_.c_str()) == 0) {
+                cache_status_ = WrittenToCache;
+            } else {
+                std::remove(tmp.str().c_str());
+                cache_status_ = CacheWriteFailed;
+            }
+        }
     }
 
 
@@ -24,9 +24,11 @@
 #include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
 
 #include <string>
+#include <vector>
 
 struct UnstructuredGrid;
 struct grdecl;
+struct grid_node_archive;
 
 namespace Opm
 {
@@ -41,6 +43,14 @@ namespace Opm
     class GridManager
     {
     public:
+        /// Outcome of the grid cache lookup, see cacheStatus().
+        enum CacheStatus {
+            NotCached,        ///< No cache directory was given.
+            ReadFromCache,    ///< Mapped from an existing cache file.
+            WrittenToCache,   ///< Constructed and stored in the cache.
+            CacheWriteFailed  ///< Constructed, but the cache file could not be written.
+        };
+
         /// Construct a 3d corner-point grid or tensor grid from a deck.
         explicit GridManager(Opm::DeckConstPtr deck);
 
@@ -55,6 +65,22 @@ namespace Opm
         GridManager(Opm::EclipseGridConstPtr eclipseGrid,
                     const std::vector<double>& poreVolumes);
 
+        /// Construct a grid from an EclipseState::EclipseGrid instance,
+        /// using a binary cache of processed grids.
+        /// The cache file is named by a hash of the grid input (including
+        /// pore volumes and MINPV/PINCH settings).  If a matching file
+        /// exists in cache_dir, it is memory-mapped and used directly,
+        /// skipping preprocessing and geometry computations.  Otherwise
+        /// the grid is constructed as usual and written to cache_dir.
+        /// Failure to write the cache file is not an error, see
+        /// cacheStatus().
+        /// \input[in] eclipseGrid    encapsulates a corner-point grid given from a deck
+        /// \input[in] poreVolumes    one element per logical cartesian grid element
+        /// \input[in] cache_dir      existing directory holding cached grids
+        GridManager(Opm::EclipseGridConstPtr eclipseGrid,
+                    const std::vector<double>& poreVolumes,
+                    const std::string& cache_dir);
+
         /// Construct a 2d cartesian grid with cells of unit size.
         GridManager(int nx, int ny);
 
@@ -81,6 +107,29 @@ namespace Opm
         /// to make it clear that we are returning a C-compatible struct.
         const UnstructuredGrid* c_grid() const;
 
+        /// Whether the grid came from or went to the cache of the
+        /// caching constructor.
+        CacheStatus cacheStatus() const;
+
+        /// Cache file of the grid, empty unless a cache directory was
+        /// given.
+        const std::string& cacheFile() const;
+
+        /// Release the node coordinates and face-node topology of the
+        /// managed grid, keeping them in a compact archive.
+        /// Only geometry computation and output (e.g. VTK) need these
+        /// arrays, so this reduces the memory footprint of simulations
+        /// on large grids.  Until restoreNodes() is called, the
+        /// node_coordinates, face_nodes and face_nodepos fields of
+        /// c_grid() are null.  Does nothing for grids mapped from a
+        /// cache, whose pages the operating system reclaims on its own.
+        /// \param[in] single_precision  store node coordinates as float
+        void compactNodes(bool single_precision = false);
+
+        /// Restore the arrays released by compactNodes().
+        /// Does nothing if the nodes are not compacted.
+        void restoreNodes();
+
         static void createGrdecl(Opm::DeckConstPtr deck, struct grdecl &grdecl);
 
     private:
@@ -89,11 +138,20 @@ namespace Opm
         GridManager& operator=(const GridManager& other);
 
         // Construct corner-point grid from EclipseGrid.
+        // If cache_dir is non-empty, look up and store the grid there.
         void initFromEclipseGrid(Opm::EclipseGridConstPtr eclipseGrid,
-                                 const std::vector<double>& poreVolumes);
+                                 const std::vector<double>& poreVolumes,
+                                 const std::string& cache_dir = std::string());
 
         // The managed UnstructuredGrid.
         UnstructuredGrid* ug_;
+        // True if ug_ was obtained from map_grid_binary().
+        bool mapped_;
+        // Node data released by compactNodes(), or null.
+        grid_node_archive* node_archive_;
+        // Outcome of the cache lookup, and the cache file used.
+        CacheStatus cache_status_;
+        std::string cache_file_;
     };
 
 } // namespace Opm
@@ -0,0 +1,117 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#include <opm/core/grid/GridPartition.hpp>
+#include <opm/core/grid.h>
+#include <opm/core/grid/grid_partition.h>
+#include <opm/core/utility/ErrorMacros.hpp>
+
+namespace Opm
+{
+
+    GridPartition::GridPartition(const UnstructuredGrid& grid,
+                                 int num_parts,
+                                 bool refine,
+                                 double max_imbalance)
+        : num_parts_(num_parts),
+          cell_part_(grid.number_of_cells),
+          num_cut_faces_(0)
+    {
+        if (num_parts < 1) {
+            OPM_THROW(std::runtime_error, "Number of parts must be positive, got " << num_parts);
+        }
+        if (!grid_partition_rcb(&grid, num_parts, cell_part_.data())) {
+            OPM_THROW(std::runtime_error, "Failed to partition grid.");
+        }
+        if (refine && grid_partition_refine(&grid, num_parts, max_imbalance, cell_part_.data()) < 0) {
+            OPM_THROW(std::runtime_error, "Failed to refine grid partition.");
+        }
+        num_cut_faces_ = grid_partition_cut(&grid, cell_part_.data());
+    }
+
+
+
+
+    SubdomainGrid::SubdomainGrid(const UnstructuredGrid& grid,
+                                 const GridPartition& partition,
+                                 int part,
+                                 int overlap)
+        : ug_(0), num_owned_(0)
+    {
+        if (part < 0 || part >= partition.numParts()) {
+            OPM_THROW(std::runtime_error, "No part " << part << " in partition with "
+                      << partition.numParts() << " parts.");
+        }
+        std::vector<int> cells(grid.number_of_cells);
+        const int nc = grid_partition_overlap(&grid, partition.cellPart().data(),
+                                              part, overlap, cells.data(), &num_owned_);
+        if (nc < 0) {
+            OPM_THROW(std::runtime_error, "Failed to compute overlap of part " << part << ".");
+        }
+        parent_cell_.assign(cells.begin(), cells.begin() + nc);
+
+        std::vector<int> faces(grid.number_of_faces);
+        ug_ = extract_subgrid(&grid, nc, parent_cell_.data(), faces.data());
+        if (!ug_) {
+            OPM_THROW(std::runtime_error, "Failed to construct subgrid of part " << part << ".");
+        }
+        parent_face_.assign(faces.begin(), faces.begin() + ug_->number_of_faces);
+    }
+
+
+    SubdomainGrid::~SubdomainGrid()
+    {
+        destroy_grid(ug_);
+    }
+
+
+    const UnstructuredGrid* SubdomainGrid::c_grid() const
+    {
+        return ug_;
+    }
+
+
+#if HAVE_MPI && HAVE_DUNE_ISTL
+    ParallelISTLInformation SubdomainGrid::parallelInformation(MPI_Comm comm) const
+    {
+        typedef ParallelISTLInformation::ParallelIndexSet IndexSet;
+        typedef ParallelISTLInformation::RemoteIndices RemoteIndices;
+        typedef IndexSet::LocalIndex LocalIndex;
+        typedef Dune::OwnerOverlapCopyAttributeSet AttributeSet;
+
+        std::shared_ptr<IndexSet> index_set(new IndexSet);
+        index_set->beginResize();
+        const int nc = parent_cell_.size();
+        for (int c = 0; c < nc; ++c) {
+            const AttributeSet::AttributeSet attribute =
+                c < num_owned_ ? AttributeSet::owner : AttributeSet::copy;
+            index_set->add(parent_cell_[c], LocalIndex(c, attribute, true));
+        }
+        index_set->endResize();
+
+        std::shared_ptr<RemoteIndices> remote_indices(new RemoteIndices(*index_set, *index_set, comm));
+        remote_indices->rebuild<false>();
+
+        return ParallelISTLInformation(index_set, remote_indices, comm);
+    }
+#endif
+
+} // namespace Opm
@@ -0,0 +1,162 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_GRIDPARTITION_HEADER_INCLUDED
+#define OPM_GRIDPARTITION_HEADER_INCLUDED
+
+#include <opm/core/linalg/ParallelIstlInformation.hpp>
+
+#include <cassert>
+#include <vector>
+
+struct UnstructuredGrid;
+
+namespace Opm
+{
+
+    /// This class computes a partition of the cells of a grid into a
+    /// number of parts, e.g. one per MPI rank.
+    ///
+    /// Cells are split by recursive coordinate bisection of their
+    /// centroids, which gives parts of equal size.  Optionally, the
+    /// partition is then refined by greedily moving boundary cells so as
+    /// to reduce the number of faces between parts (and thereby the
+    /// communication volume), within a given imbalance.
+    class GridPartition
+    {
+    public:
+        /// Partition grid.
+        /// \param[in] grid           Grid to partition.  Not referenced after construction.
+        /// \param[in] num_parts      Number of parts.
+        /// \param[in] refine         Whether to refine the bisection partition.
+        /// \param[in] max_imbalance  Maximum relative deviation of a part's size
+        ///                           from the average allowed by refinement.
+        GridPartition(const UnstructuredGrid& grid,
+                      int num_parts,
+                      bool refine = true,
+                      double max_imbalance = 0.05);
+
+        /// Number of parts.
+        int numParts() const { return num_parts_; }
+
+        /// Part of each cell.
+        const std::vector<int>& cellPart() const { return cell_part_; }
+
+        /// Number of internal faces connecting cells in different parts.
+        int numCutFaces() const { return num_cut_faces_; }
+
+    private:
+        int num_parts_;
+        std::vector<int> cell_part_;
+        int num_cut_faces_;
+    };
+
+
+    /// This class manages the subgrid of one part of a GridPartition,
+    /// extended by one or more layers of overlap cells from
+    /// neighbouring parts.
+    ///
+    /// Subgrid cells [0, numOwnedCells()) are owned by the part, in
+    /// increasing order of their parent grid index, and the remaining
+    /// cells are copies of cells owned by other parts.  Faces to cells
+    /// outside the subgrid become boundary faces.
+    class SubdomainGrid
+    {
+    public:
+        /// Extract subgrid.
+        /// \param[in] grid       Grid that was partitioned.  Must have node data.
+        ///                       Not referenced after construction.
+        /// \param[in] partition  Partition of grid.
+        /// \param[in] part       Part to extract.
+        /// \param[in] overlap    Number of overlap layers.
+        SubdomainGrid(const UnstructuredGrid& grid,
+                      const GridPartition& partition,
+                      int part,
+                      int overlap = 1);
+
+        /// Destructor.
+        ~SubdomainGrid();
+
+        /// Access the subgrid.
+        const UnstructuredGrid* c_grid() const;
+
+        /// Number of owned cells, which come first in the subgrid.
+        int numOwnedCells() const { return num_owned_; }
+
+        /// Parent grid index of each subgrid cell.
+        const std::vector<int>& parentCell() const { return parent_cell_; }
+
+        /// Parent grid index of each subgrid face.
+        const std::vector<int>& parentFace() const { return parent_face_; }
+
+        /// Restrict per-cell data on the parent grid to the subgrid.
+        /// The data may have any fixed number of components per cell.
+        template <typename T>
+        std::vector<T> cellDataFromParent(const std::vector<T>& data,
+                                          const int num_parent_cells) const
+        { return restrictData(parent_cell_, num_parent_cells, data); }
+
+        /// Restrict per-face data on the parent grid to the subgrid.
+        /// Face orientations are unchanged, so fluxes need no sign change.
+        template <typename T>
+        std::vector<T> faceDataFromParent(const std::vector<T>& data,
+                                          const int num_parent_faces) const
+        { return restrictData(parent_face_, num_parent_faces, data); }
+
+#if HAVE_MPI && HAVE_DUNE_ISTL
+        /// Create the parallel information needed by the ISTL solvers
+        /// (see LinearSolverIstl), with owned cells having the owner
+        /// attribute and overlap cells the copy attribute.  Global
+        /// indices are the parent grid cell indices.  Collective: every
+        /// rank must call this for its own subgrid.
+        /// \param[in] comm  Communicator whose ranks correspond to parts.
+        ParallelISTLInformation parallelInformation(MPI_Comm comm) const;
+#endif
+
+    private:
+        // Disable copying and assignment.
+        SubdomainGrid(const SubdomainGrid& other);
+        SubdomainGrid& operator=(const SubdomainGrid& other);
+
+        template <typename T>
+        static std::vector<T> restrictData(const std::vector<int>& parent,
+                                       const int num_parent,
+                                       const std::vector<T>& data)
+        {
+            const int n = parent.size();
+            const int m = num_parent > 0 ? data.size()/num_parent : 0;
+            assert(std::size_t(num_parent*m) == data.size());
+            std::vector<T> result(n*m);
+            for (int i = 0; i < n; ++i) {
+                for (int k = 0; k < m; ++k) {
+                    result[m*i + k] = data[m*parent[i] + k];
+                }
+            }
+            return result;
+        }
+
+        UnstructuredGrid* ug_;
+        int num_owned_;
+        std::vector<int> parent_cell_;
+        std::vector<int> parent_face_;
+    };
+
+} // namespace Opm
+
+#endif // OPM_GRIDPARTITION_HEADER_INCLUDED
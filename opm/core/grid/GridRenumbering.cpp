@@ -0,0 +1,75 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#include <opm/core/grid/GridRenumbering.hpp>
+#include <opm/core/grid.h>
+#include <opm/core/grid/grid_renumber.h>
+#include <opm/core/utility/ErrorMacros.hpp>
+
+namespace Opm
+{
+
+    GridRenumbering::GridRenumbering(const UnstructuredGrid& grid, Ordering ordering)
+        : ug_(0),
+          cell_new2old_(grid.number_of_cells),
+          cell_old2new_(grid.number_of_cells),
+          face_new2old_(grid.number_of_faces),
+          face_old2new_(grid.number_of_faces)
+    {
+        int ok = 0;
+        switch (ordering) {
+        case ReverseCuthillMcKee:
+            ok = grid_cell_order_rcm(&grid, cell_new2old_.data());
+            break;
+        case Hilbert:
+            ok = grid_cell_order_hilbert(&grid, cell_new2old_.data());
+            break;
+        }
+        if (!ok) {
+            OPM_THROW(std::runtime_error, "Failed to compute cell ordering.");
+        }
+
+        ug_ = renumber_grid(&grid, cell_new2old_.data(), face_new2old_.data());
+        if (!ug_) {
+            OPM_THROW(std::runtime_error, "Failed to construct renumbered grid.");
+        }
+
+        for (int c = 0; c < grid.number_of_cells; ++c) {
+            cell_old2new_[cell_new2old_[c]] = c;
+        }
+        for (int f = 0; f < grid.number_of_faces; ++f) {
+            face_old2new_[face_new2old_[f]] = f;
+        }
+    }
+
+
+    GridRenumbering::~GridRenumbering()
+    {
+        destroy_grid(ug_);
+    }
+
+
+    const UnstructuredGrid* GridRenumbering::c_grid() const
+    {
+        return ug_;
+    }
+
+} // namespace Opm
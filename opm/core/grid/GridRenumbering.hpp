@@ -0,0 +1,134 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_GRIDRENUMBERING_HEADER_INCLUDED
+#define OPM_GRIDRENUMBERING_HEADER_INCLUDED
+
+#include <cassert>
+#include <vector>
+
+struct UnstructuredGrid;
+
+namespace Opm
+{
+
+    /// This class manages a copy of an UnstructuredGrid with cells and
+    /// faces renumbered for memory locality, along with the mappings
+    /// between the original and the new numbering.
+    ///
+    /// The renumbered grid's global_cell maps cells to their logical
+    /// cartesian indices, so property objects and wells constructed from
+    /// a deck using the renumbered grid need no translation.  Data
+    /// computed on the original grid (or to be reported in its ordering)
+    /// can be translated with the cellData/faceData methods.
+    class GridRenumbering
+    {
+    public:
+        enum Ordering { ReverseCuthillMcKee, Hilbert };
+
+        /// Renumber grid.
+        /// \param[in] grid      Grid to renumber.  Not referenced after construction.
+        /// \param[in] ordering  Cell ordering to apply.  Faces are numbered
+        ///                      by first occurrence in the new cell order.
+        GridRenumbering(const UnstructuredGrid& grid, Ordering ordering);
+
+        /// Destructor.
+        ~GridRenumbering();
+
+        /// Access the renumbered grid.
+        const UnstructuredGrid* c_grid() const;
+
+        /// Original index of each new cell.
+        const std::vector<int>& cellNewToOld() const { return cell_new2old_; }
+        /// New index of each original cell.
+        const std::vector<int>& cellOldToNew() const { return cell_old2new_; }
+        /// Original index of each new face.
+        const std::vector<int>& faceNewToOld() const { return face_new2old_; }
+        /// New index of each original face.
+        const std::vector<int>& faceOldToNew() const { return face_old2new_; }
+
+        /// Translate per-cell data from original to new ordering.
+        /// The data may have any fixed number of components per cell.
+        template <typename T>
+        std::vector<T> cellDataToNew(const std::vector<T>& data) const
+        { return permuteToNew(cell_new2old_, data); }
+
+        /// Translate per-cell data from new to original ordering.
+        template <typename T>
+        std::vector<T> cellDataToOld(const std::vector<T>& data) const
+        { return permuteToOld(cell_new2old_, data); }
+
+        /// Translate per-face data from original to new ordering.
+        /// Face orientations are unchanged, so fluxes need no sign change.
+        template <typename T>
+        std::vector<T> faceDataToNew(const std::vector<T>& data) const
+        { return permuteToNew(face_new2old_, data); }
+
+        /// Translate per-face data from new to original ordering.
+        template <typename T>
+        std::vector<T> faceDataToOld(const std::vector<T>& data) const
+        { return permuteToOld(face_new2old_, data); }
+
+    private:
+        // Disable copying and assignment.
+        GridRenumbering(const GridRenumbering& other);
+        GridRenumbering& operator=(const GridRenumbering& other);
+
+        template <typename T>
+        static std::vector<T> permuteToNew(const std::vector<int>& new2old,
+                                           const std::vector<T>& data)
+        {
+            const int n = new2old.size();
+            const int m = n > 0 ? data.size()/n : 0;
+            assert(std::size_t(n*m) == data.size());
+            std::vector<T> result(data.size());
+            for (int i = 0; i < n; ++i) {
+                for (int k = 0; k < m; ++k) {
+                    result[m*i + k] = data[m*new2old[i] + k];
+                }
+            }
+            return result;
+        }
+
+        template <typename T>
+        static std::vector<T> permuteToOld(const std::vector<int>& new2old,
+                                           const std::vector<T>& data)
+        {
+            const int n = new2old.size();
+            const int m = n > 0 ? data.size()/n : 0;
+            assert(std::size_t(n*m) == data.size());
+            std::vector<T> result(data.size());
+            for (int i = 0; i < n; ++i) {
+                for (int k = 0; k < m; ++k) {
+                    result[m*new2old[i] + k] = data[m*i + k];
+                }
+            }
+            return result;
+        }
+
+        UnstructuredGrid* ug_;
+        std::vector<int> cell_new2old_;
+        std::vector<int> cell_old2new_;
+        std::vector<int> face_new2old_;
+        std::vector<int> face_old2new_;
+    };
+
+} // namespace Opm
+
+#endif // OPM_GRIDRENUMBERING_HEADER_INCLUDED
@@ -22,7 +22,10 @@
 
 
 #include <opm/core/utility/ErrorMacros.hpp>
+#include <algorithm>
 #include <array>
+#include <utility>
+#include <vector>
 
 
 namespace Opm
@@ -32,6 +35,18 @@ namespace Opm
     class MinpvProcessor
     {
     public:
+        /// \brief Cells and connections affected by processing.
+        struct Result
+        {
+            /// Logical cartesian indices of the cells made zero-thickness,
+            /// in increasing order.
+            std::vector<int> collapsed_cells;
+            /// Pairs (upper, lower) of active logical cartesian cells that
+            /// have become vertical neighbours because all cells between
+            /// them were collapsed, in increasing order.
+            std::vector< std::pair<int, int> > pinch_connections;
+        };
+
         /// \brief Create a processor.
         /// \param[in]   nx   logical cartesian number of cells in I-direction
         /// \param[in]   ny   logical cartesian number of cells in J-direction
@@ -45,14 +60,14 @@ namespace Opm
         /// After processing, all cells that have lower pore volume than minpv
         /// will have the zcorn numbers changed so they are zero-thickness. Any
         /// cell below will be changed to include the deleted volume.
-        void process(const std::vector<double>& pv,
-                     const double minpv,
-                     const std::vector<int>& actnum,
-                     double* zcorn) const;
+        /// Columns of cells are processed in parallel.
+        /// \return the collapsed cells and resulting pinch-out connections
+        Result process(const std::vector<double>& pv,
+                       const double minpv,
+                       const std::vector<int>& actnum,
+                       double* zcorn) const;
     private:
         std::array<int,8> cornerIndices(const int i, const int j, const int k) const;
-        std::array<double, 8> getCellZcorn(const int i, const int j, const int k, const double* z) const;
-        void setCellZcorn(const int i, const int j, const int k, const std::array<double, 8>& cellz, double* z) const;
         std::array<int, 3> dims_;
         std::array<int, 3> delta_;
     };
@@ -71,10 +86,11 @@ namespace Opm
 
 
 
-    inline void MinpvProcessor::process(const std::vector<double>& pv,
-                                        const double minpv,
-                                        const std::vector<int>& actnum,
-                                        double* zcorn) const
+    inline MinpvProcessor::Result
+    MinpvProcessor::process(const std::vector<double>& pv,
+                            const double minpv,
+                            const std::vector<int>& actnum,
+                            double* zcorn) const
     {
         // Algorithm:
         // 1. Process each column of cells (with same i and j
@@ -86,6 +102,8 @@ namespace Opm
         //    the upper four (so it becomes degenerate). Also move
         //    the higher four zcorn associated with the cell below
         //    to these values (so it gains the deleted volume).
+        // Every cell has its own zcorn values, so the columns are
+        // independent and may be processed in parallel.
 
         // Check for sane input sizes.
         const size_t log_size = dims_[0] * dims_[1] * dims_[2];
@@ -96,31 +114,62 @@ namespace Opm
             OPM_THROW(std::runtime_error, "Wrong size of ACTNUM input, must have one element per logical cartesian cell.");
         }
 
+        const int ncol = dims_[0] * dims_[1];
+        Result result;
+
         // Main loop.
-        for (int kk = 0; kk < dims_[2]; ++kk) {
-            for (int jj = 0; jj < dims_[1]; ++jj) {
-                for (int ii = 0; ii < dims_[0]; ++ii) {
-                    const int c = ii + dims_[0] * (jj + dims_[1] * kk);
+#pragma omp parallel
+        {
+            Result local;
+#pragma omp for schedule(static)
+            for (int col = 0; col < ncol; ++col) {
+                const int ii = col % dims_[0];
+                const int jj = col / dims_[0];
+                int above = -1; // Last active, uncollapsed cell in column.
+                bool pinched = false;
+                for (int kk = 0; kk < dims_[2]; ++kk) {
+                    const int c = col + ncol * kk;
                     if (pv[c] < minpv && actnum[c]) {
                         // Move deeper (higher k) coordinates to lower k coordinates.
-                        std::array<double, 8> cz = getCellZcorn(ii, jj, kk, zcorn);
+                        const std::array<int, 8> ixs = cornerIndices(ii, jj, kk);
                         for (int count = 0; count < 4; ++count) {
-                            cz[count + 4] = cz[count];
+                            zcorn[ixs[count + 4]] = zcorn[ixs[count]];
                         }
-                        setCellZcorn(ii, jj, kk, cz, zcorn);
                         // Check if there is a cell below.
                         if (kk < dims_[2] - 1) {
                             // Set lower k coordinates of cell below to upper cells's coordinates.
-                            std::array<double, 8> cz_below = getCellZcorn(ii, jj, kk + 1, zcorn);
                             for (int count = 0; count < 4; ++count) {
-                                cz_below[count] = cz[count];
+                                zcorn[ixs[count] + 2*delta_[2]] = zcorn[ixs[count]];
                             }
-                            setCellZcorn(ii, jj, kk + 1, cz_below, zcorn);
                         }
+                        local.collapsed_cells.push_back(c);
+                        pinched = true;
+                    } else if (actnum[c]) {
+                        if (pinched && above >= 0) {
+                            local.pinch_connections.push_back(std::make_pair(above, c));
+                        }
+                        above = c;
+                        pinched = false;
+                    } else {
+                        above = -1;
+                        pinched = false;
                     }
                 }
             }
+#pragma omp critical
+            {
+                result.collapsed_cells.insert(result.collapsed_cells.end(),
+                                              local.collapsed_cells.begin(),
+                                              local.collapsed_cells.end());
+                result.pinch_connections.insert(result.pinch_connections.end(),
+                                                local.pinch_connections.begin(),
+                                                local.pinch_connections.end());
+            }
         }
+
+        std::sort(result.collapsed_cells.begin(), result.collapsed_cells.end());
+        std::sort(result.pinch_connections.begin(), result.pinch_connections.end());
+        return result;
     }
 
 
@@ -138,32 +187,6 @@ namespace Opm
 
 
 
-    // Returns the eight z-values associated with a given cell.
-    // The ordering is such that i runs fastest. That is, with
-    // L = low and H = high:
-    // {LLL, HLL, LHL, HHL, LLH, HLH, LHH, HHH }.
-    inline std::array<double, 8> MinpvProcessor::getCellZcorn(const int i, const int j, const int k, const double* z) const
-    {
-        const std::array<int, 8> ixs = cornerIndices(i, j, k);
-        std::array<double, 8> cellz;
-        for (int count = 0; count < 8; ++count) {
-            cellz[count] = z[ixs[count]];
-        }
-        return cellz;
-    }
-
-
-
-    inline void MinpvProcessor::setCellZcorn(const int i, const int j, const int k, const std::array<double, 8>& cellz, double* z) const
-    {
-        const std::array<int, 8> ixs = cornerIndices(i, j, k);
-        for (int count = 0; count < 8; ++count) {
-            z[ixs[count]] = cellz[count];
-        }
-    }
-
-
-
 } // namespace Opm
 
 #endif // OPM_MINPVPROCESSOR_HEADER_INCLUDED
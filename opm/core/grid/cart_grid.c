@@ -164,6 +164,62 @@ create_grid_tensor3d(int           nx    ,
     return G;
 }
 
+/* --------------------------------------------------------------------- */
+
+int
+grid_has_cartesian_topology(const struct UnstructuredGrid *G)
+{
+    int nx, ny, nz, nc;
+    int c, i, j, k, t, p, f, c1, c2, other, nbr, seen;
+    int ok;
+
+    nx = G->cartdims[0];
+    ny = G->cartdims[1];
+    nz = G->cartdims[2];
+    nc = G->number_of_cells;
+
+    ok = (G->dimensions == 3) && (G->cell_facetag != NULL) &&
+         (nx > 0) && (ny > 0) && (nz > 0) &&
+         ((size_t) nx * ny * nz == (size_t) nc);
+
+    for (c = 0; ok && (c < nc); c++) {
+        ok = ((G->global_cell == NULL) || (G->global_cell[c] == c)) &&
+             (G->cell_facepos[c + 1] - G->cell_facepos[c] == 6);
+
+        i = c % nx;
+        j = (c / nx) % ny;
+        k = c / (nx * ny);
+
+        seen = 0;
+        for (p = G->cell_facepos[c]; ok && (p < G->cell_facepos[c + 1]); p++) {
+            t = G->cell_facetag[p];
+            f = G->cell_faces[p];
+
+            ok = (t >= 0) && (t < 6) && !(seen & (1 << t));
+            if (! ok) { break; }
+            seen |= 1 << t;
+
+            c1 = G->face_cells[2*f + 0];
+            c2 = G->face_cells[2*f + 1];
+            ok = (c1 == c) || (c2 == c);
+            other = (c1 == c) ? c2 : c1;
+
+            switch (t) {
+            case 0:  nbr = (i > 0     ) ? c - 1       : -1; break;
+            case 1:  nbr = (i < nx - 1) ? c + 1       : -1; break;
+            case 2:  nbr = (j > 0     ) ? c - nx      : -1; break;
+            case 3:  nbr = (j < ny - 1) ? c + nx      : -1; break;
+            case 4:  nbr = (k > 0     ) ? c - nx * ny : -1; break;
+            default: nbr = (k < nz - 1) ? c + nx * ny : -1; break;
+            }
+
+            ok = ok && (other == nbr);
+        }
+    }
+
+    return ok;
+}
+
 /* --------------------------------------------------------------------- */
 /* Static functions follow:                                              */
 /* --------------------------------------------------------------------- */
@@ -230,10 +286,12 @@ fill_cart_topology_3d(struct UnstructuredGrid *G)
 {
     int nx, ny, nz;
     int Nx, Ny;
+    int i, j, k, m, row;
+    int ncells, nfaces;
     int nxf, nyf;
-    int i,j,k;
 
-    int *cfaces, *cfacepos, *fnodes, *fnodepos, *fcells;
+    int *cfaces, *fnodes, *fcells;
+    size_t c, f;
 
     nx = G->cartdims[0];
     ny = G->cartdims[1];
@@ -245,109 +303,105 @@ fill_cart_topology_3d(struct UnstructuredGrid *G)
     nxf = Nx*ny*nz;
     nyf = nx*Ny*nz;
 
-    cfaces     = G->cell_faces;
-    cfacepos   = G->cell_facepos;
-    cfacepos[0] = 0;
-    for (k=0; k<nz; ++k)  {
-        for (j=0; j<ny; ++j) {
-            for (i=0; i<nx; ++i) {
-                *cfaces++ = i+  Nx*(j+  ny* k   );
-                *cfaces++ = i+1+Nx*(j+  ny* k   );
-                *cfaces++ = i+  nx*(j+  Ny* k   )  +nxf;
-                *cfaces++ = i+  nx*(j+1+Ny* k   )  +nxf;
-                *cfaces++ = i+  nx*(j+  ny* k   )  +nxf+nyf;
-                *cfaces++ = i+  nx*(j+  ny*(k+1))  +nxf+nyf;
-
-                cfacepos[1] = cfacepos[0]+6;
-                ++cfacepos;
+    ncells = G->number_of_cells;
+    nfaces = G->number_of_faces;
+
+    /* All entities are numbered analytically, so each row of cells or
+     * faces (fixed j and k) is filled independently. */
+
+    /* Cell faces ordered -x, +x, -y, +y, -z, +z */
+#pragma omp parallel for private(i, j, k, m, c, cfaces)
+    for (row = 0; row < ny*nz; ++row) {
+        j = row % ny;
+        k = row / ny;
+
+        for (i = 0; i < nx; ++i) {
+            c      = i + (size_t) nx*row;
+            cfaces = G->cell_faces + 6*c;
+
+            cfaces[0] = i+  Nx*(j+  ny* k   );
+            cfaces[1] = i+1+Nx*(j+  ny* k   );
+            cfaces[2] = i+  nx*(j+  Ny* k   )  +nxf;
+            cfaces[3] = i+  nx*(j+1+Ny* k   )  +nxf;
+            cfaces[4] = i+  nx*(j+  ny* k   )  +nxf+nyf;
+            cfaces[5] = i+  nx*(j+  ny*(k+1))  +nxf+nyf;
+
+            for (m = 0; m < 6; ++m) {
+                G->cell_facetag[6*c + m] = m;
             }
         }
     }
 
-    for (k = 0; k < nx * ny * nz; ++k) {
-        for (i = 0; i < 6; ++i) {
-            G->cell_facetag[k*6 + i] = i;
-        }
+#pragma omp parallel for
+    for (row = 0; row <= ncells; ++row) {
+        G->cell_facepos[row] = 6 * row;
     }
 
-    fnodes      = G->face_nodes;
-    fnodepos    = G->face_nodepos;
-    fcells      = G->face_cells;
-    fnodepos[0] = 0;
+#pragma omp parallel for
+    for (row = 0; row <= nfaces; ++row) {
+        G->face_nodepos[row] = 4 * row;
+    }
 
     /* Faces with x-normal */
-    for (k=0; k<nz; ++k) {
-        for (j=0; j<ny; ++j) {
-            for (i=0; i<nx+1; ++i) {
-                *fnodes++ = i+Nx*(j   + Ny * k   );
-                *fnodes++ = i+Nx*(j+1 + Ny * k   );
-                *fnodes++ = i+Nx*(j+1 + Ny *(k+1));
-                *fnodes++ = i+Nx*(j   + Ny *(k+1));
-                fnodepos[1] = fnodepos[0] + 4;
-                ++fnodepos;
-                if (i==0) {
-                    *fcells++ = -1;
-                    *fcells++ =  i+nx*(j+ny*k);
-                }
-                else if (i == nx) {
-                    *fcells++ =  i-1+nx*(j+ny*k);
-                    *fcells++ = -1;
-                }
-                else {
-                    *fcells++ =  i-1 + nx*(j+ny*k);
-                    *fcells++ =  i   + nx*(j+ny*k);
-                }
-            }
+#pragma omp parallel for private(i, j, k, f, fnodes, fcells)
+    for (row = 0; row < ny*nz; ++row) {
+        j = row % ny;
+        k = row / ny;
+
+        for (i = 0; i < nx+1; ++i) {
+            f      = i + (size_t) Nx*row;
+            fnodes = G->face_nodes + 4*f;
+            fcells = G->face_cells + 2*f;
+
+            fnodes[0] = i+Nx*(j   + Ny * k   );
+            fnodes[1] = i+Nx*(j+1 + Ny * k   );
+            fnodes[2] = i+Nx*(j+1 + Ny *(k+1));
+            fnodes[3] = i+Nx*(j   + Ny *(k+1));
+
+            fcells[0] = (i == 0 ) ? -1 : i-1 + nx*(j+ny*k);
+            fcells[1] = (i == nx) ? -1 : i   + nx*(j+ny*k);
         }
     }
+
     /* Faces with y-normal */
-    for (k=0; k<nz; ++k) {
-        for (j=0; j<ny+1; ++j) {
-            for (i=0; i<nx; ++i) {
-                *fnodes++ = i+    Nx*(j + Ny * k   );
-                *fnodes++ = i   + Nx*(j + Ny *(k+1));
-                *fnodes++ = i+1 + Nx*(j + Ny *(k+1));
-                *fnodes++ = i+1 + Nx*(j + Ny * k   );
-                fnodepos[1] = fnodepos[0] + 4;
-                ++fnodepos;
-                if (j==0) {
-                    *fcells++ = -1;
-                    *fcells++ =  i+nx*(j+ny*k);
-                }
-                else if (j == ny) {
-                    *fcells++ =  i+nx*(j-1+ny*k);
-                    *fcells++ = -1;
-                }
-                else {
-                    *fcells++ =  i+nx*(j-1+ny*k);
-                    *fcells++ =  i+nx*(j+ny*k);
-                }
-            }
+#pragma omp parallel for private(i, j, k, f, fnodes, fcells)
+    for (row = 0; row < Ny*nz; ++row) {
+        j = row % Ny;
+        k = row / Ny;
+
+        for (i = 0; i < nx; ++i) {
+            f      = nxf + i + (size_t) nx*row;
+            fnodes = G->face_nodes + 4*f;
+            fcells = G->face_cells + 2*f;
+
+            fnodes[0] = i+    Nx*(j + Ny * k   );
+            fnodes[1] = i   + Nx*(j + Ny *(k+1));
+            fnodes[2] = i+1 + Nx*(j + Ny *(k+1));
+            fnodes[3] = i+1 + Nx*(j + Ny * k   );
+
+            fcells[0] = (j == 0 ) ? -1 : i+nx*(j-1+ny*k);
+            fcells[1] = (j == ny) ? -1 : i+nx*(j  +ny*k);
         }
     }
+
     /* Faces with z-normal */
-    for (k=0; k<nz+1; ++k) {
-        for (j=0; j<ny; ++j) {
-            for (i=0; i<nx; ++i) {
-                *fnodes++ = i+    Nx*(j   + Ny * k);
-                *fnodes++ = i+1 + Nx*(j   + Ny * k);
-                *fnodes++ = i+1 + Nx*(j+1 + Ny * k);
-                *fnodes++ = i+    Nx*(j+1 + Ny * k);
-                fnodepos[1] = fnodepos[0] + 4;
-                ++fnodepos;
-                if (k==0) {
-                    *fcells++ = -1;
-                    *fcells++ =  i+nx*(j+ny*k);
-                }
-                else if (k == nz) {
-                    *fcells++ =  i+nx*(j+ny*(k-1));
-                    *fcells++ = -1;
-                }
-                else {
-                    *fcells++ =  i+nx*(j+ny*(k-1));
-                    *fcells++ =  i+nx*(j+ny*k);
-                }
-            }
+#pragma omp parallel for private(i, j, k, f, fnodes, fcells)
+    for (row = 0; row < ny*(nz+1); ++row) {
+        j = row % ny;
+        k = row / ny;
+
+        for (i = 0; i < nx; ++i) {
+            f      = nxf + nyf + i + (size_t) nx*row;
+            fnodes = G->face_nodes + 4*f;
+            fcells = G->face_cells + 2*f;
+
+            fnodes[0] = i+    Nx*(j   + Ny * k);
+            fnodes[1] = i+1 + Nx*(j   + Ny * k);
+            fnodes[2] = i+1 + Nx*(j+1 + Ny * k);
+            fnodes[3] = i+    Nx*(j+1 + Ny * k);
+
+            fcells[0] = (k == 0 ) ? -1 : i+nx*(j+ny*(k-1));
+            fcells[1] = (k == nz) ? -1 : i+nx*(j+ny* k   );
         }
     }
 }
@@ -361,106 +415,136 @@ fill_cart_geometry_3d(struct UnstructuredGrid *G,
                       const double            *z)
 {
     int nx, ny, nz;
-    int i,j,k;
+    int Nx, Ny;
+    int i, j, k, row;
+    int nxf, nyf;
 
     double dx, dy, dz;
 
-    double *coord, *ccentroids, *cvolumes;
-    double *fnormals, *fcentroids, *fareas;
+    double *coord, *ccentroids, *fnormals, *fcentroids;
+    size_t c, f, n;
 
     nx  = G->cartdims[0];
     ny  = G->cartdims[1];
     nz  = G->cartdims[2];
 
-    ccentroids = G->cell_centroids;
-    cvolumes   = G->cell_volumes;
-    for (k=0; k<nz; ++k)  {
-        for (j=0; j<ny; ++j) {
-            for (i=0; i<nx; ++i) {
-                *ccentroids++ = (x[i] + x[i + 1]) / 2.0;
-                *ccentroids++ = (y[j] + y[j + 1]) / 2.0;
-                *ccentroids++ = (z[k] + z[k + 1]) / 2.0;
-
-                dx = x[i + 1] - x[i];
-                dy = y[j + 1] - y[j];
-                dz = z[k + 1] - z[k];
-
-                *cvolumes++ = dx * dy * dz;
-            }
+    Nx  = nx + 1;
+    Ny  = ny + 1;
+
+    nxf = Nx*ny*nz;
+    nyf = nx*Ny*nz;
+
+#pragma omp parallel for private(i, j, k, c, dx, dy, dz, ccentroids)
+    for (row = 0; row < ny*nz; ++row) {
+        j = row % ny;
+        k = row / ny;
+
+        dy = y[j + 1] - y[j];
+        dz = z[k + 1] - z[k];
+
+        for (i = 0; i < nx; ++i) {
+            c          = i + (size_t) nx*row;
+            ccentroids = G->cell_centroids + 3*c;
+            dx         = x[i + 1] - x[i];
+
+            ccentroids[0] = (x[i] + x[i + 1]) / 2.0;
+            ccentroids[1] = (y[j] + y[j + 1]) / 2.0;
+            ccentroids[2] = (z[k] + z[k + 1]) / 2.0;
+
+            G->cell_volumes[c] = dx * dy * dz;
         }
     }
 
+    /* Faces with x-normal */
+#pragma omp parallel for private(i, j, k, f, dy, dz, fnormals, fcentroids)
+    for (row = 0; row < ny*nz; ++row) {
+        j = row % ny;
+        k = row / ny;
 
-    fnormals   = G->face_normals;
-    fcentroids = G->face_centroids;
-    fareas     = G->face_areas;
+        dy = y[j + 1] - y[j];
+        dz = z[k + 1] - z[k];
 
-    /* Faces with x-normal */
-    for (k=0; k<nz; ++k) {
-        for (j=0; j<ny; ++j) {
-            for (i=0; i<nx+1; ++i) {
-                dy = y[j + 1] - y[j];
-                dz = z[k + 1] - z[k];
+        for (i = 0; i < nx+1; ++i) {
+            f          = i + (size_t) Nx*row;
+            fnormals   = G->face_normals   + 3*f;
+            fcentroids = G->face_centroids + 3*f;
 
-                *fnormals++ = dy * dz;
-                *fnormals++ = 0;
-                *fnormals++ = 0;
+            fnormals[0] = dy * dz;
+            fnormals[1] = 0;
+            fnormals[2] = 0;
 
-                *fcentroids++ = x[i];
-                *fcentroids++ = (y[j] + y[j + 1]) / 2.0;
-                *fcentroids++ = (z[k] + z[k + 1]) / 2.0;
+            fcentroids[0] = x[i];
+            fcentroids[1] = (y[j] + y[j + 1]) / 2.0;
+            fcentroids[2] = (z[k] + z[k + 1]) / 2.0;
 
-                *fareas++ = dy * dz;
-            }
+            G->face_areas[f] = dy * dz;
         }
     }
+
     /* Faces with y-normal */
-    for (k=0; k<nz; ++k) {
-        for (j=0; j<ny+1; ++j) {
-            for (i=0; i<nx; ++i) {
-                dx = x[i + 1] - x[i];
-                dz = z[k + 1] - z[k];
+#pragma omp parallel for private(i, j, k, f, dx, dz, fnormals, fcentroids)
+    for (row = 0; row < Ny*nz; ++row) {
+        j = row % Ny;
+        k = row / Ny;
 
-                *fnormals++ = 0;
-                *fnormals++ = dx * dz;
-                *fnormals++ = 0;
+        dz = z[k + 1] - z[k];
 
-                *fcentroids++ = (x[i] + x[i + 1]) / 2.0;
-                *fcentroids++ = y[j];
-                *fcentroids++ = (z[k] + z[k + 1]) / 2.0;
+        for (i = 0; i < nx; ++i) {
+            f          = nxf + i + (size_t) nx*row;
+            fnormals   = G->face_normals   + 3*f;
+            fcentroids = G->face_centroids + 3*f;
+            dx         = x[i + 1] - x[i];
 
-                *fareas++ = dx * dz;
-            }
+            fnormals[0] = 0;
+            fnormals[1] = dx * dz;
+            fnormals[2] = 0;
+
+            fcentroids[0] = (x[i] + x[i + 1]) / 2.0;
+            fcentroids[1] = y[j];
+            fcentroids[2] = (z[k] + z[k + 1]) / 2.0;
+
+            G->face_areas[f] = dx * dz;
         }
     }
+
     /* Faces with z-normal */
-    for (k=0; k<nz+1; ++k) {
-        for (j=0; j<ny; ++j) {
-            for (i=0; i<nx; ++i) {
-                dx = x[i + 1] - x[i];
-                dy = y[j + 1] - y[j];
+#pragma omp parallel for private(i, j, k, f, dx, dy, fnormals, fcentroids)
+    for (row = 0; row < ny*(nz+1); ++row) {
+        j = row % ny;
+        k = row / ny;
 
-                *fnormals++ = 0;
-                *fnormals++ = 0;
-                *fnormals++ = dx * dy;
+        dy = y[j + 1] - y[j];
 
-                *fcentroids++ = (x[i] + x[i + 1]) / 2.0;
-                *fcentroids++ = (y[j] + y[j + 1]) / 2.0;
-                *fcentroids++ = z[k];
+        for (i = 0; i < nx; ++i) {
+            f          = nxf + nyf + i + (size_t) nx*row;
+            fnormals   = G->face_normals   + 3*f;
+            fcentroids = G->face_centroids + 3*f;
+            dx         = x[i + 1] - x[i];
 
-                *fareas++ = dx * dy;
-            }
+            fnormals[0] = 0;
+            fnormals[1] = 0;
+            fnormals[2] = dx * dy;
+
+            fcentroids[0] = (x[i] + x[i + 1]) / 2.0;
+            fcentroids[1] = (y[j] + y[j + 1]) / 2.0;
+            fcentroids[2] = z[k];
+
+            G->face_areas[f] = dx * dy;
         }
     }
 
-    coord = G->node_coordinates;
-    for (k=0; k<nz+1; ++k) {
-        for (j=0; j<ny+1; ++j) {
-            for (i=0; i<nx+1; ++i) {
-                *coord++ = x[i];
-                *coord++ = y[j];
-                *coord++ = z[k];
-            }
+#pragma omp parallel for private(i, j, k, n, coord)
+    for (row = 0; row < Ny*(nz+1); ++row) {
+        j = row % Ny;
+        k = row / Ny;
+
+        for (i = 0; i < Nx; ++i) {
+            n     = i + (size_t) Nx*row;
+            coord = G->node_coordinates + 3*n;
+
+            coord[0] = x[i];
+            coord[1] = y[j];
+            coord[2] = z[k];
         }
     }
 }
@@ -474,7 +558,7 @@ fill_layered_geometry_3d(struct UnstructuredGrid *G,
                          const double            *z,
                          const double            *depthz)
 {
-    int i , j , k ;
+    int i , j , k , row;
     int nx, ny, nz;
 
     const double *depth;
@@ -482,17 +566,18 @@ fill_layered_geometry_3d(struct UnstructuredGrid *G,
 
     nx = G->cartdims[0];  ny = G->cartdims[1];  nz = G->cartdims[2];
 
-    coord = G->node_coordinates;
-    for (k = 0; k < nz + 1; k++) {
+#pragma omp parallel for private(i, j, k, depth, coord)
+    for (row = 0; row < (ny + 1)*(nz + 1); row++) {
+        j = row % (ny + 1);
+        k = row / (ny + 1);
 
-        depth = depthz;
+        depth = depthz + (size_t) (nx + 1)*j;
+        coord = G->node_coordinates + 3 * (size_t) (nx + 1)*row;
 
-        for (j = 0; j < ny + 1; j++) {
-            for (i = 0; i < nx + 1; i++) {
-                *coord++ = x[i];
-                *coord++ = y[j];
-                *coord++ = z[k] + *depth++;
-            }
+        for (i = 0; i < nx + 1; i++) {
+            *coord++ = x[i];
+            *coord++ = y[j];
+            *coord++ = z[k] + *depth++;
         }
     }
 
@@ -166,6 +166,30 @@ create_grid_tensor3d(int           nx    ,
                      const double *y     ,
                      const double *z     ,
                      const double *depthz);
+
+
+/**
+ * Determine whether a three-dimensional grid has the topology of a complete,
+ * logically Cartesian box of size <CODE>G->cartdims</CODE>.
+ *
+ * This requires that every logical cell is active and numbered in natural
+ * (lexicographic) order, and that each cell has exactly six faces, tagged
+ * 0 through 5, connecting it to its logical neighbour in the corresponding
+ * direction (or to the outside at the box boundary).  Grids produced by
+ * create_grid_cart3d(), create_grid_hexa3d() and create_grid_tensor3d()
+ * have this property, as do corner-point grids without inactive cells,
+ * faults or pinch-outs.  Face numbering and geometry are not restricted.
+ *
+ * Kernels may use this to replace topology look-ups by fixed seven-point
+ * stencils computed from the cell's (i,j,k) index.
+ *
+ * @param[in] G Grid.
+ *
+ * @return Non-zero if @c G has Cartesian topology, zero otherwise.
+ */
+int
+grid_has_cartesian_topology(const struct UnstructuredGrid *G);
+
 #ifdef __cplusplus
 }
 #endif
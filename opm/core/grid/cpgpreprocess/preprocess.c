@@ -51,19 +51,32 @@
 static void
 compute_cell_index(const int dims[3], int i, int j, int *neighbors, int len);
 
-static int
-checkmemory(int nz, struct processed_grid *out, int **intersections);
-
-static void
-process_vertical_faces(int direction,
-                       int **intersections,
-                       int *plist, int *work,
-                       struct processed_grid *out);
+/* Output generated by one row of pillars (fixed 'j') in one of the
+ * face processing sweeps.  In the first (counting) pass these are the
+ * sizes, in the second (filling) pass the positions at which the row
+ * writes its output. */
+struct row_count {
+    int faces;          /* Faces */
+    int face_nodes;     /* Entries of ->face_nodes */
+    int intersections;  /* Nodes at fault intersections */
+    int cells;          /* Non-collapsed cells */
+};
+
+/* Private work space of one thread during vertical face processing.
+ * The face and intersection arrays are grown as needed for each pair
+ * of pillars. */
+struct face_scratch {
+    int *work;
+    int *face_ptr;
+    int *intersections;
+    int  max_faces;          /* Capacity of the face arrays */
+    int  max_intersections;  /* Capacity of ->intersections */
+    struct processed_grid g;
+};
 
 static void
-process_horizontal_faces(int **intersections,
-                         int *plist,
-                         struct processed_grid *out);
+process_faces(int *plist, int **intersections,
+              struct processed_grid *out);
 
 static int
 linearindex(const int dims[3], int i, int j, int k)
@@ -135,159 +148,282 @@ compute_cell_index(const int dims[3], int i, int j,
 
 
 /*-----------------------------------------------------------------
-  Ensure there's sufficient memory */
+  Ensure that the private work space holds at least 'nfaces' faces of
+  at most eight nodes each and 'nitsct' intersections.  Returns zero
+  if the space could not be allocated, in which case the existing
+  space is retained.  */
 static int
-checkmemory(int nz, struct processed_grid *out, int **intersections)
+reserve_face_scratch(int nfaces, int nitsct, struct face_scratch *s)
 {
-    int r, m, n, ok;
+    void *p;
 
-    /* Ensure there is enough space to manage the (pathological) case
-     * of every single cell on one side of a fault connecting to all
-     * cells on the other side of the fault (i.e., an all-to-all cell
-     * connectivity pairing). */
-    r = (2*nz + 2) * (2*nz + 2);
-    m = out->m;
-    n = out->n;
+    if (nfaces > s->max_faces) {
+        p = realloc(s->g.face_nodes, 8 * ((size_t) nfaces) * sizeof *s->g.face_nodes);
+        if (p == NULL) { return 0; }
+        s->g.face_nodes = p;
 
-    if (out->number_of_faces +  r > m) {
-        m += MAX(m / 2,  2 * r);
-    }
-    if (out->face_ptr[out->number_of_faces] + 6*r > n) {
-        n += MAX(n / 2, 12 * r);
+        p = realloc(s->g.face_ptr, (nfaces + ((size_t) 1)) * sizeof *s->g.face_ptr);
+        if (p == NULL) { return 0; }
+        s->g.face_ptr = p;
+
+        p = realloc(s->g.face_neighbors, 2 * ((size_t) nfaces) * sizeof *s->g.face_neighbors);
+        if (p == NULL) { return 0; }
+        s->g.face_neighbors = p;
+
+        p = realloc(s->face_ptr, (nfaces + ((size_t) 1)) * sizeof *s->face_ptr);
+        if (p == NULL) { return 0; }
+        s->face_ptr = p;
+
+        s->max_faces = nfaces;
     }
 
-    ok = m == out->m;
-    if (! ok) {
-        void *p1, *p2, *p3, *p4;
+    if (nitsct > s->max_intersections) {
+        p = realloc(s->intersections, 4 * ((size_t) nitsct) * sizeof *s->intersections);
+        if (p == NULL) { return 0; }
+        s->intersections = p;
 
-        p1 = realloc(*intersections     , 4*m   * sizeof **intersections);
-        p2 = realloc(out->face_neighbors, 2*m   * sizeof *out->face_neighbors);
-        p3 = realloc(out->face_ptr      , (m+1) * sizeof *out->face_ptr);
-        p4 = realloc(out->face_tag      , 1*m   * sizeof *out->face_tag);
+        s->max_intersections = nitsct;
+    }
 
-        if (p1 != NULL) { *intersections      = p1; }
-        if (p2 != NULL) { out->face_neighbors = p2; }
-        if (p3 != NULL) { out->face_ptr       = p3; }
-        if (p4 != NULL) { out->face_tag       = p4; }
+    return 1;
+}
 
-        ok = (p1 != NULL) && (p2 != NULL) && (p3 != NULL) && (p4 != NULL);
 
-        if (ok) { out->m = m; }
+/*-----------------------------------------------------------------
+  Allocate private work space for processing pairs of pillars.
+  Initially sized for pillar pairs without crossing lines, which
+  produce at most one face per interval on either pillar.  */
+static int
+alloc_face_scratch(const struct processed_grid *out,
+                   struct face_scratch *s)
+{
+    size_t i, n;
+
+    n = 2*out->dimensions[2] + 2;
+
+    s->g                  = *out;
+    s->g.face_nodes       = NULL;
+    s->g.face_ptr         = NULL;
+    s->g.face_neighbors   = NULL;
+    s->face_ptr           = NULL;
+    s->intersections      = NULL;
+    s->max_faces          = 0;
+    s->max_intersections  = 0;
+    s->work               = malloc(2 * n * sizeof *s->work);
+
+    if (s->work != NULL) {
+        for (i = 0; i < 2 * n; ++i) { s->work[i] = -1; }
     }
 
-    if (ok && (n != out->n)) {
-        void *p1;
+    return (s->work != NULL) && reserve_face_scratch(2 * (n - 1), 1, s);
+}
 
-        p1 = realloc(out->face_nodes, n * sizeof *out->face_nodes);
 
-        ok = p1 != NULL;
+/*-----------------------------------------------------------------
+  Release work space allocated in alloc_face_scratch(). */
+static void
+free_face_scratch(struct face_scratch *s)
+{
+    free(s->g.face_nodes);
+    free(s->g.face_ptr);
+    free(s->g.face_neighbors);
+    free(s->work);
+    free(s->face_ptr);
+    free(s->intersections);
+}
 
-        if (ok) {
-            out->face_nodes = p1;
-            out->n          = n;
-        }
+
+/*-----------------------------------------------------------------
+  Number of pairs of lines, one between the points a1[k] and a2[k]
+  and one between b1[l] and b2[l], that cross between the pillars.
+  The point numbers increase with depth along each pillar, so for
+  each 'k' the crossing 'l' form a range whose ends move monotonically
+  with 'k'.  */
+static int
+count_crossings(int n, const int *a1, const int *a2,
+                const int *b1, const int *b2)
+{
+    int k, lo, hi, count;
+
+    count = 0;
+    lo    = hi = 0;
+    for (k = 0; k < n; ++k) {
+        /* b1[l] > a1[k] and b2[l] < a2[k] for l in [lo, hi) */
+        while ((lo < n) && (b1[lo] <= a1[k])) { ++lo; }
+        while ((hi < n) && (b2[hi] <  a2[k])) { ++hi; }
+        count += MAX(hi - lo, 0);
     }
 
-    return ok;
+    return count;
+}
+
+
+/*-----------------------------------------------------------------
+  Ensure that the private work space can hold the output of
+  findconnections() for a pair of pillars with 'n' points each.  The
+  lines of either side divide the face between the pillars into
+  n - 1 intervals.  The overlay of both sides has at most one region,
+  and so one face, per interval and per crossing, and one intersection
+  node per crossing.  */
+static int
+reserve_pillar_pair(int n, int *cornerpts[4], struct face_scratch *s)
+{
+    int ncross;
+
+    ncross = count_crossings(n, cornerpts[0], cornerpts[1],
+                             cornerpts[2], cornerpts[3])
+        +    count_crossings(n, cornerpts[2], cornerpts[3],
+                             cornerpts[0], cornerpts[1]);
+
+    return reserve_face_scratch(2*(n - 1) + ncross, MAX(ncross, 1), s);
 }
 
+
+/*-----------------------------------------------------------------
+  Vectors of point numbers of the pillar pair (i,j) in the given
+  direction, ordered as expected by findconnections(). */
+static void
+vertical_face_corners(int direction, int i, int j, int d[3],
+                      int *plist, int *cornerpts[4])
+{
+    int *tmp;
+
+    igetvectors(d, 2*i + direction, 2*j + (1 - direction),
+                plist, cornerpts);
+
+    if (direction == 1) {
+        /* 1   3       0   1    */
+        /*       --->           */
+        /* 0   2       2   3    */
+        /* rotate clockwise     */
+        tmp          = cornerpts[1];
+        cornerpts[1] = cornerpts[0];
+        cornerpts[0] = cornerpts[2];
+        cornerpts[2] = cornerpts[3];
+        cornerpts[3] = tmp;
+    }
+}
+
+
 /*-----------------------------------------------------------------
-  For each vertical face (i.e. i or j constant),
+  For each vertical face (i.e. i or j constant) in row 'j' of pillar
+  pairs,
   -find point numbers for the corners and
   -cell neighbors.
   -new points on faults defined by two intgersecting lines.
 
   direction == 0 : constant-i faces.
   direction == 1 : constant-j faces.
+
+  If 'pos' is NULL, only count the faces, face nodes and
+  intersections of the row into *cnt, using the scratch grid
+  only.  Otherwise, write the row's output into 'out' and
+  'intersections' at the positions given by *pos.
+
+  Returns zero if the work space could not be allocated.
 */
-static void
-process_vertical_faces(int direction,
-                       int **intersections,
-                       int *plist, int *work,
-                       struct processed_grid *out)
+static int
+process_vertical_row(int direction, int j,
+                     int *plist,
+                     const struct row_count *pos,
+                     struct row_count *cnt,
+                     struct face_scratch *s,
+                     int *intersections,
+                     struct processed_grid *out)
 {
-    int i,j;
+    int i, f, k;
     int *cornerpts[4];
     int d[3];
-    int f;
     enum face_tag tag[] = { LEFT, BACK };
-    int *tmp;
     int nx = out->dimensions[0];
-    int ny = out->dimensions[1];
     int nz = out->dimensions[2];
-    int startface;
-    int num_intersections;
-    int *ptr;
-    int len;
+    int face, node, itsct;
+    struct processed_grid  fill;
+    struct processed_grid *g = &s->g;
 
     assert ((direction == 0) || (direction == 1));
 
     d[0] = 2 * (nx + 0);
-    d[1] = 2 * (ny + 0);
+    d[1] = 2 * (out->dimensions[1] + 0);
     d[2] = 2 * (nz + 1);
 
-    for (j = 0; j < ny + direction; ++j) {
+    if (pos == NULL) {
         for (i = 0; i < nx + (1 - direction); ++i) {
-
-            if (! checkmemory(nz, out, intersections)) {
-                fprintf(stderr,
-                        "Could not allocate enough space in "
-                        "process_vertical_faces()\n");
-                exit(1);
+            vertical_face_corners(direction, i, j, d, plist, cornerpts);
+            if (! reserve_pillar_pair(2*nz + 2, cornerpts, s)) {
+                return 0;
             }
 
-            /* Vectors of point numbers */
-            igetvectors(d, 2*i + direction, 2*j + (1 - direction),
-                        plist, cornerpts);
-
-            if (direction == 1) {
-                /* 1   3       0   1    */
-                /*       --->           */
-                /* 0   2       2   3    */
-                /* rotate clockwise     */
-                tmp          = cornerpts[1];
-                cornerpts[1] = cornerpts[0];
-                cornerpts[0] = cornerpts[2];
-                cornerpts[2] = cornerpts[3];
-                cornerpts[3] = tmp;
-            }
+            g->number_of_faces = 0;
+            g->face_ptr[0]     = 0;
+            g->number_of_nodes = g->number_of_nodes_on_pillars;
 
-            /* int startface = ftab->position; */
-            startface = out->number_of_faces;
-            /* int num_intersections = *npoints - npillarpoints; */
-            num_intersections = out->number_of_nodes -
-                out->number_of_nodes_on_pillars;
-
-            /* Establish new connections (faces) along pillar pair. */
-            findconnections(2*nz + 2, cornerpts,
-                            *intersections + 4*num_intersections,
-                            work, out);
-
-            /* Start of ->face_neighbors[] for this set of connections. */
-            ptr = out->face_neighbors + 2*startface;
-
-            /* Total number of cells (both sides) connected by this
-             * set of connections (faces). */
-            len = 2*out->number_of_faces - 2*startface;
-
-            /* Derive inter-cell connectivity (i.e. ->face_neighbors)
-             * of global (uncompressed) cells for this set of
-             * connections (faces). */
-            compute_cell_index(out->dimensions, i-1+direction, j-direction, ptr    , len);
-            compute_cell_index(out->dimensions, i            , j          , ptr + 1, len);
-
-            /* Tag the new faces */
-            f = startface;
-            for (; f < out->number_of_faces; ++f) {
-                out->face_tag[f] = tag[direction];
-            }
+            findconnections(2*nz + 2, cornerpts, s->intersections,
+                            s->work, g);
+
+            cnt->faces         += g->number_of_faces;
+            cnt->face_nodes    += g->face_ptr[g->number_of_faces];
+            cnt->intersections += g->number_of_nodes -
+                                  g->number_of_nodes_on_pillars;
+        }
+        return 1;
+    }
+
+    face  = pos->faces;
+    node  = pos->face_nodes;
+    itsct = pos->intersections;
+
+    /* Write straight into the output arrays, except for ->face_ptr
+     * whose first entry for this set of connections belongs to the
+     * preceding set. */
+    fill            = *out;
+    g               = &fill;
+    g->face_nodes   = out->face_nodes;
+    for (i = 0; i < nx + (1 - direction); ++i) {
+        vertical_face_corners(direction, i, j, d, plist, cornerpts);
+        if (! reserve_pillar_pair(2*nz + 2, cornerpts, s)) {
+            return 0;
         }
+
+        g->face_ptr        = s->face_ptr;
+        g->face_ptr[0]     = node;
+        g->face_neighbors  = out->face_neighbors + 2*face;
+        g->number_of_faces = 0;
+        g->number_of_nodes = out->number_of_nodes_on_pillars + itsct;
+
+        /* Establish new connections (faces) along pillar pair. */
+        findconnections(2*nz + 2, cornerpts,
+                        intersections + 4*itsct,
+                        s->work, g);
+
+        for (k = 1; k <= g->number_of_faces; ++k) {
+            out->face_ptr[face + k] = g->face_ptr[k];
+        }
+
+        /* Derive inter-cell connectivity (i.e. ->face_neighbors)
+         * of global (uncompressed) cells for this set of
+         * connections (faces). */
+        compute_cell_index(out->dimensions, i-1+direction, j-direction,
+                           g->face_neighbors    , 2*g->number_of_faces);
+        compute_cell_index(out->dimensions, i            , j          ,
+                           g->face_neighbors + 1, 2*g->number_of_faces);
+
+        /* Tag the new faces */
+        for (f = 0; f < g->number_of_faces; ++f) {
+            out->face_tag[face + f] = tag[direction];
+        }
+
+        node   = g->face_ptr[g->number_of_faces];
+        face  += g->number_of_faces;
+        itsct  = g->number_of_nodes - out->number_of_nodes_on_pillars;
     }
+
+    return 1;
 }
 
 
 /*-----------------------------------------------------------------
-  For each horizontal face (i.e. k constant),
+  For each horizontal face (i.e. k constant) in row 'j' of pillars,
   -find point numbers for the corners and
   -cell neighbors.
 
@@ -296,21 +432,25 @@ process_vertical_faces(int direction,
   cells that are have collapsed coordinates. (This includes cells with
   ACTNUM==0)
 
+  If 'pos' is NULL, only count the faces and cells of the row into
+  *cnt.  Otherwise, write the row's output at the positions given by
+  *pos.
 */
 static void
-process_horizontal_faces(int **intersections,
-                         int *plist,
-                         struct processed_grid *out)
+process_horizontal_row(int j, int *plist,
+                       const struct row_count *pos,
+                       struct row_count *cnt,
+                       struct processed_grid *out)
 {
-    int i,j,k;
+    int i,k;
 
     int nx = out->dimensions[0];
     int ny = out->dimensions[1];
     int nz = out->dimensions[2];
 
     int *cell  = out->local_cell_index;
-    int cellno = 0;
-    int *f, *n, *c[4];
+    int cellno, face, nfaces, ncells;
+    int *f = NULL, *n = NULL, *c[4];
     int prevcell, thiscell;
     int idx;
 
@@ -320,82 +460,237 @@ process_horizontal_faces(int **intersections,
     d[1] = 2*ny;
     d[2] = 2+2*nz;
 
+    nfaces = ncells = 0;
+    cellno = face = 0;
+    if (pos != NULL) {
+        cellno = pos->cells;
+        face   = pos->faces;
+        f = out->face_nodes     + pos->face_nodes;
+        n = out->face_neighbors + 2*face;
+    }
 
-    for(j=0; j<ny; ++j) {
-        for (i=0; i<nx; ++i) {
-
-
-            if (! checkmemory(nz, out, intersections)) {
-                fprintf(stderr,
-                        "Could not allocate enough space in "
-                        "process_horizontal_faces()\n");
-                exit(1);
-            }
-
-
-            f = out->face_nodes     + out->face_ptr[out->number_of_faces];
-            n = out->face_neighbors + 2*out->number_of_faces;
-
+    for (i=0; i<nx; ++i) {
 
-            /* Vectors of point numbers */
-            igetvectors(d, 2*i+1, 2*j+1, plist, c);
+        /* Vectors of point numbers */
+        igetvectors(d, 2*i+1, 2*j+1, plist, c);
 
-            prevcell = -1;
+        prevcell = -1;
 
 
-            for (k = 1; k<nz*2+1; ++k){
+        for (k = 1; k<nz*2+1; ++k){
 
-                /* Skip if space between face k and face k+1 is collapsed. */
-                /* Note that inactive cells (with ACTNUM==0) have all been  */
-                /* collapsed in finduniquepoints.                           */
-                if (c[0][k] == c[0][k+1] && c[1][k] == c[1][k+1] &&
-                    c[2][k] == c[2][k+1] && c[3][k] == c[3][k+1]){
+            /* Skip if space between face k and face k+1 is collapsed. */
+            /* Note that inactive cells (with ACTNUM==0) have all been  */
+            /* collapsed in finduniquepoints.                           */
+            if (c[0][k] == c[0][k+1] && c[1][k] == c[1][k+1] &&
+                c[2][k] == c[2][k+1] && c[3][k] == c[3][k+1]){
 
-                    /* If the pinch is a cell: */
-                    if (k%2){
-                        idx = linearindex(out->dimensions, i,j,(k-1)/2);
-                        cell[idx] = -1;
-                    }
+                /* If the pinch is a cell: */
+                if ((k%2) && (pos != NULL)){
+                    idx = linearindex(out->dimensions, i,j,(k-1)/2);
+                    cell[idx] = -1;
                 }
-                else{
+            }
+            else{
+
+                if (k%2){
+                    thiscell = linearindex(out->dimensions, i,j,(k-1)/2);
 
-                    if (k%2){
+                    if (pos != NULL) {
                         /* Add face */
                         *f++ = c[0][k];
                         *f++ = c[2][k];
                         *f++ = c[3][k];
                         *f++ = c[1][k];
 
-                        out->face_tag[  out->number_of_faces] = TOP;
-                        out->face_ptr[++out->number_of_faces] = f - out->face_nodes;
+                        out->face_tag[face] = TOP;
+                        out->face_ptr[++face] = f - out->face_nodes;
 
-                        thiscell = linearindex(out->dimensions, i,j,(k-1)/2);
                         *n++ = prevcell;
-                        *n++ = prevcell = thiscell;
+                        *n++ = thiscell;
 
                         cell[thiscell] = cellno++;
-
                     }
-                    else{
-                        if (prevcell != -1){
+                    prevcell = thiscell;
+                    nfaces++;
+                    ncells++;
+                }
+                else{
+                    if (prevcell != -1){
+                        if (pos != NULL) {
                             /* Add face */
                             *f++ = c[0][k];
                             *f++ = c[2][k];
                             *f++ = c[3][k];
                             *f++ = c[1][k];
 
-                            out->face_tag[  out->number_of_faces] = TOP;
-                            out->face_ptr[++out->number_of_faces] = f - out->face_nodes;
+                            out->face_tag[face] = TOP;
+                            out->face_ptr[++face] = f - out->face_nodes;
 
                             *n++ = prevcell;
-                            *n++ = prevcell = -1;
+                            *n++ = -1;
                         }
+                        prevcell = -1;
+                        nfaces++;
                     }
                 }
             }
         }
     }
-    out->number_of_cells = cellno;
+
+    if (cnt != NULL) {
+        cnt->faces      += nfaces;
+        cnt->face_nodes += 4 * nfaces;
+        cnt->cells      += ncells;
+    }
+}
+
+
+/*-----------------------------------------------------------------
+  Process one row of the face sweeps.  Rows [0, ny) are the constant-i
+  faces, rows [ny, 2*ny + 1) the constant-j faces and rows
+  [2*ny + 1, 3*ny + 1) the horizontal faces, in the order in which
+  the faces are numbered.  Returns zero if the work space could not
+  be allocated. */
+static int
+process_row(int row, int *plist,
+            const struct row_count *pos,
+            struct row_count *cnt,
+            struct face_scratch *s,
+            int *intersections,
+            struct processed_grid *out)
+{
+    int ny = out->dimensions[1];
+
+    if (row < ny) {
+        return process_vertical_row(0, row, plist, pos, cnt, s,
+                                    intersections, out);
+    }
+    else if (row < 2*ny + 1) {
+        return process_vertical_row(1, row - ny, plist, pos, cnt, s,
+                                    intersections, out);
+    }
+    else {
+        process_horizontal_row(row - (2*ny + 1), plist, pos, cnt, out);
+        return 1;
+    }
+}
+
+
+/*-----------------------------------------------------------------
+  Find face topology and face-to-cell connections of all faces.
+
+  Rows of pillars are processed independently (and concurrently if
+  OpenMP is enabled) in two passes.  The first pass counts the
+  faces, face nodes, intersections and cells of each row.  Prefix
+  sums of the counts then give the position of each row's output,
+  and the second pass fills exactly sized output arrays.  Faces and
+  intersection nodes are numbered as if the rows had been processed
+  in sequence.  */
+static void
+process_faces(int *plist, int **intersections,
+              struct processed_grid *out)
+{
+    int row, ok;
+    int nrows = 3*out->dimensions[1] + 1;
+    struct row_count *rows, total, tmp;
+
+    rows = calloc(nrows + 1, sizeof *rows);
+    if (rows == NULL) {
+        fprintf(stderr, "Could not allocate enough space in "
+                "process_faces()\n");
+        exit(1);
+    }
+
+    /* Pass 1: Count output of each row. */
+    ok = 1;
+#pragma omp parallel
+    {
+        struct face_scratch s;
+        int r, have_scratch;
+
+        /* All threads must take part in the work-sharing loop. */
+        have_scratch = alloc_face_scratch(out, &s);
+
+#pragma omp for schedule(dynamic)
+        for (r = 0; r < nrows; ++r) {
+            if (! (have_scratch &&
+                   process_row(r, plist, NULL, &rows[r], &s, NULL, out))) {
+#pragma omp atomic write
+                ok = 0;
+            }
+        }
+        free_face_scratch(&s);
+    }
+    if (! ok) {
+        fprintf(stderr, "Could not allocate enough space in "
+                "process_faces()\n");
+        exit(1);
+    }
+
+    /* Exclusive prefix sum, rows[nrows] holds the totals. */
+    total.faces = total.face_nodes = total.intersections = total.cells = 0;
+    for (row = 0; row <= nrows; ++row) {
+        tmp        = rows[row];
+        rows[row]  = total;
+
+        total.faces         += tmp.faces;
+        total.face_nodes    += tmp.face_nodes;
+        total.intersections += tmp.intersections;
+        total.cells         += tmp.cells;
+    }
+    total = rows[nrows];
+
+    out->m = total.faces;
+    out->n = total.face_nodes;
+
+    out->face_nodes     = malloc(MAX(out->n, 1)     * sizeof *out->face_nodes);
+    out->face_ptr       = malloc((out->m + 1)       * sizeof *out->face_ptr);
+    out->face_neighbors = malloc(MAX(2*out->m, 1)   * sizeof *out->face_neighbors);
+    out->face_tag       = malloc(MAX(out->m, 1)     * sizeof *out->face_tag);
+    *intersections      = malloc(MAX(4*total.intersections, 1)
+                                 * sizeof **intersections);
+
+    if ((out->face_nodes == NULL) || (out->face_ptr == NULL) ||
+        (out->face_neighbors == NULL) || (out->face_tag == NULL) ||
+        (*intersections == NULL)) {
+        fprintf(stderr, "Could not allocate enough space in "
+                "process_faces()\n");
+        exit(1);
+    }
+    out->face_ptr[0] = 0;
+
+    /* Pass 2: Fill output. */
+#pragma omp parallel
+    {
+        struct face_scratch s;
+        int r, have_scratch;
+
+        /* All threads must take part in the work-sharing loop. */
+        have_scratch = alloc_face_scratch(out, &s);
+
+#pragma omp for schedule(dynamic)
+        for (r = 0; r < nrows; ++r) {
+            if (! (have_scratch &&
+                   process_row(r, plist, &rows[r], NULL, &s,
+                               *intersections, out))) {
+#pragma omp atomic write
+                ok = 0;
+            }
+        }
+        free_face_scratch(&s);
+    }
+    if (! ok) {
+        fprintf(stderr, "Could not allocate enough space in "
+                "process_faces()\n");
+        exit(1);
+    }
+
+    out->number_of_faces  = total.faces;
+    out->number_of_nodes += total.intersections;
+    out->number_of_cells  = total.cells;
+
+    free(rows);
 }
 
 
@@ -773,14 +1068,12 @@ void process_grdecl(const struct grdecl   *in,
 
     double *zcorn;
 
-    const size_t BIGNUM = 64;
     const int    nx = in->dims[0];
     const int    ny = in->dims[1];
     const int    nz = in->dims[2];
     const size_t nc = ((size_t) nx) * ((size_t) ny) * ((size_t) nz);
 
     /* internal work arrays */
-    int    *work;
     int    *plist;
     int    *intersections;
 
@@ -789,18 +1082,17 @@ void process_grdecl(const struct grdecl   *in,
 
     /* -----------------------------------------------------------------*/
     /* Initialize output structure:
-       1) allocate space for grid topology (which may need to be
-          increased)
+       1) grid topology is allocated in process_faces() once its size
+          is known
        2) set Cartesian imensions
     */
-    out->m                = (int) (BIGNUM / 3);
-    out->n                = (int) BIGNUM;
+    out->m                = 0;
+    out->n                = 0;
 
-    out->face_neighbors   = malloc( BIGNUM      * sizeof *out->face_neighbors);
-    out->face_nodes       = malloc( out->n      * sizeof *out->face_nodes);
-    out->face_ptr         = malloc((out->m + 1) * sizeof *out->face_ptr);
-    out->face_tag         = malloc( out->m      * sizeof *out->face_tag);
-    out->face_ptr[0]      = 0;
+    out->face_neighbors   = NULL;
+    out->face_nodes       = NULL;
+    out->face_ptr         = NULL;
+    out->face_tag         = NULL;
 
     out->dimensions[0]    = in->dims[0];
     out->dimensions[1]    = in->dims[1];
@@ -861,21 +1153,11 @@ void process_grdecl(const struct grdecl   *in,
     /* -----------------------------------------------------------------*/
     /* Find face topology and face-to-cell connections */
 
-    /* internal */
-    work = malloc(2 * ((size_t) (2*nz + 2)) * sizeof *work);
-    for(i = 0; i < ((size_t)4) * (nz + 1); ++i) { work[i] = -1; }
-
-    /* internal array to store intersections */
-    intersections = malloc(BIGNUM* sizeof(*intersections));
-
-
-
-    process_vertical_faces   (0, &intersections, plist, work, out);
-    process_vertical_faces   (1, &intersections, plist, work, out);
-    process_horizontal_faces (   &intersections, plist,       out);
+    /* intersections: point numbers of the lines defining each node
+     * at a fault intersection */
+    process_faces(plist, &intersections, out);
 
     free (plist);
-    free (work);
 
     /* -----------------------------------------------------------------*/
     /* (re)allocate space for and compute coordinates of nodes that
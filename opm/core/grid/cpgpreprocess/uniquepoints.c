@@ -37,6 +37,7 @@
 #include <float.h>
 #include <limits.h>
 #include <math.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -48,23 +49,99 @@
 #define MIN(i,j) (((i) < (j)) ? (i) : (j))
 #define MAX(i,j) (((i) > (j)) ? (i) : (j))
 
+/* Lists no longer than this are sorted by insertion */
+#define SMALL_SORT 64
+
+#define SIGN_BIT ((uint64_t) 1 << 63)
+
 /*-----------------------------------------------------------------
-  Compare function passed to qsortx  */
-static int compare(const void *a, const void *b)
+  Map double to unsigned integer with the same ordering.  */
+static uint64_t double_key(double x)
 {
-    const double a0 = *(const double*) a;
-    const double b0 = *(const double*) b;
+    uint64_t u;
+
+    memcpy(&u, &x, sizeof u);
+
+    return (u & SIGN_BIT) ? ~u : (u | SIGN_BIT);
+}
+
+/*-----------------------------------------------------------------
+  Inverse of double_key().  */
+static double key_double(uint64_t u)
+{
+    double x;
+
+    u = (u & SIGN_BIT) ? (u & ~SIGN_BIT) : ~u;
+    memcpy(&x, &u, sizeof x);
 
-    /*                { -1, a < b
-     * compare(a,b) = {  0, a = b
-     *                {  1, a > b */
-    return (a0 > b0) - (a0 < b0);
+    return x;
+}
+
+/*-----------------------------------------------------------------
+  Sort <n> doubles in increasing order.  Short lists are sorted by
+  insertion, longer ones by least significant digit radix sort on the
+  IEEE bit pattern, skipping bytes that are equal in all values.  The
+  sort is stable, except that -0.0 precedes 0.0.  <work> must have room
+  for 2*n values.  */
+static void sort_doubles(double *list, int n, uint64_t *work)
+{
+    int       i, b, pos, t;
+    int       count[8][256];
+    uint64_t  key;
+    uint64_t *src, *dst, *tmp;
+    double    val;
+
+    if (n <= SMALL_SORT) {
+        for (i=1; i<n; ++i){
+            val = list[i];
+            for (pos=i; (pos > 0) && (val < list[pos-1]); --pos){
+                list[pos] = list[pos-1];
+            }
+            list[pos] = val;
+        }
+        return;
+    }
+
+    src = work;
+    dst = work + n;
+
+    memset(count, 0, sizeof count);
+    for (i=0; i<n; ++i){
+        key    = double_key(list[i]);
+        src[i] = key;
+        for (b=0; b<8; ++b){
+            count[b][(key >> (8*b)) & 0xff] += 1;
+        }
+    }
+
+    for (b=0; b<8; ++b){
+        if (count[b][(src[0] >> (8*b)) & 0xff] == n) {
+            continue;           /* All values share this byte */
+        }
+
+        for (i=0, pos=0; i<256; ++i){
+            t           = count[b][i];
+            count[b][i] = pos;
+            pos        += t;
+        }
+
+        for (i=0; i<n; ++i){
+            dst[count[b][(src[i] >> (8*b)) & 0xff]++] = src[i];
+        }
+
+        tmp = src;  src = dst;  dst = tmp;
+    }
+
+    for (i=0; i<n; ++i){
+        list[i] = key_double(src[i]);
+    }
 }
 
 /*-----------------------------------------------------------------
   Creat sorted list of z-values in zcorn with actnum==1x */
 static int createSortedList(double *list, int n, int m,
-                            const double *z[], const int *a[])
+                            const double *z[], const int *a[],
+                            uint64_t *work)
 {
     int i,j;
     double *ptr = list;
@@ -75,7 +152,7 @@ static int createSortedList(double *list, int n, int m,
         }
     }
 
-    qsort(list, ptr-list, sizeof(double), compare);
+    sort_doubles(list, ptr-list, work);
     return ptr-list;
 }
 
@@ -288,6 +365,9 @@ int finduniquepoints(const struct grdecl *g,
     double *zlist = malloc(npillarpoints*sizeof *zlist);
     int     *zptr = malloc((npillars+1)*sizeof *zptr);
 
+    /* Sorting workspace, room for twice the largest pillar list */
+    uint64_t *work = malloc(2*8*g->dims[2]*sizeof *work);
+
 
 
 
@@ -306,6 +386,14 @@ int finduniquepoints(const struct grdecl *g,
 
     const double *coord = g->coord;
 
+    if ((zlist == NULL) || (zptr == NULL) || (work == NULL)) {
+        fprintf(stderr, "Failed to allocate memory in finduniquepoints");
+        free(work);
+        free(zptr);
+        free(zlist);
+        return 0;
+    }
+
     d1[0] = 2*g->dims[0];
     d1[1] = 2*g->dims[1];
     d1[2] = 2*g->dims[2];
@@ -324,7 +412,7 @@ int finduniquepoints(const struct grdecl *g,
             igetvectors(g->dims,   i,   j, g->actnum, a);
             dgetvectors(d1,      2*i, 2*j, g->zcorn,  z);
 
-            len = createSortedList(     zout, d1[2], 4, z, a);
+            len = createSortedList(     zout, d1[2], 4, z, a, work);
             len = uniquify        (len, zout, tolerance);
 
             /* Assign unique points */
@@ -372,6 +460,7 @@ int finduniquepoints(const struct grdecl *g,
         }
     }
 
+    free(work);
     free(zptr);
     free(zlist);
 
@@ -0,0 +1,379 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+#include <opm/core/grid.h>
+#include <opm/core/grid/grid_binary.h>
+
+#include <assert.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+#define GRID_BINARY_MAGIC     "OPMUGRID"
+#define GRID_BINARY_VERSION   1
+#define GRID_BINARY_BYTEORDER 0x01020304u
+#define GRID_BINARY_ALIGN     64
+
+enum grid_binary_array {
+    GB_NODE_COORDINATES = 0,
+    GB_FACE_NODES,
+    GB_FACE_NODEPOS,
+    GB_FACE_CELLS,
+    GB_CELL_FACES,
+    GB_CELL_FACEPOS,
+    GB_FACE_CENTROIDS,
+    GB_FACE_AREAS,
+    GB_FACE_NORMALS,
+    GB_CELL_CENTROIDS,
+    GB_CELL_VOLUMES,
+    GB_GLOBAL_CELL,
+    GB_CELL_FACETAG,
+    GB_NARRAYS
+};
+
+struct grid_binary_header {
+    char     magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t int_size;
+    uint32_t double_size;
+    uint64_t key;
+
+    int32_t  dimensions;
+    int32_t  number_of_cells;
+    int32_t  number_of_faces;
+    int32_t  number_of_nodes;
+    int32_t  cartdims[3];
+    int32_t  padding;
+    uint64_t number_of_facenodes;
+    uint64_t number_of_cellfaces;
+
+    /* Byte offset from start of file and size in bytes of each array.
+     * Optional arrays that are not present have offset zero. */
+    uint64_t offset[GB_NARRAYS];
+    uint64_t size  [GB_NARRAYS];
+};
+
+/* Grid whose arrays live in a file mapping.  The grid must be the
+ * first member, so that unmap_grid_binary() can recover the mapping
+ * from the grid pointer. */
+struct mapped_grid {
+    struct UnstructuredGrid g;
+    void                   *base;
+    size_t                  len;
+};
+
+
+/* ---------------------------------------------------------------------- */
+static void
+array_table(const struct UnstructuredGrid *G,
+            const void *array[GB_NARRAYS],
+            uint64_t    size [GB_NARRAYS])
+/* ---------------------------------------------------------------------- */
+{
+    size_t nd, nc, nf, nn, nfn, ncf;
+
+    nd  = G->dimensions;
+    nc  = G->number_of_cells;
+    nf  = G->number_of_faces;
+    nn  = G->number_of_nodes;
+    nfn = G->face_nodepos[nf];
+    ncf = G->cell_facepos[nc];
+
+    array[GB_NODE_COORDINATES] = G->node_coordinates;
+    size [GB_NODE_COORDINATES] = nd * nn  * sizeof *G->node_coordinates;
+    array[GB_FACE_NODES      ] = G->face_nodes;
+    size [GB_FACE_NODES      ] = nfn      * sizeof *G->face_nodes;
+    array[GB_FACE_NODEPOS    ] = G->face_nodepos;
+    size [GB_FACE_NODEPOS    ] = (nf + 1) * sizeof *G->face_nodepos;
+    array[GB_FACE_CELLS      ] = G->face_cells;
+    size [GB_FACE_CELLS      ] = 2 * nf   * sizeof *G->face_cells;
+    array[GB_CELL_FACES      ] = G->cell_faces;
+    size [GB_CELL_FACES      ] = ncf      * sizeof *G->cell_faces;
+    array[GB_CELL_FACEPOS    ] = G->cell_facepos;
+    size [GB_CELL_FACEPOS    ] = (nc + 1) * sizeof *G->cell_facepos;
+    array[GB_FACE_CENTROIDS  ] = G->face_centroids;
+    size [GB_FACE_CENTROIDS  ] = nd * nf  * sizeof *G->face_centroids;
+    array[GB_FACE_AREAS      ] = G->face_areas;
+    size [GB_FACE_AREAS      ] = nf       * sizeof *G->face_areas;
+    array[GB_FACE_NORMALS    ] = G->face_normals;
+    size [GB_FACE_NORMALS    ] = nd * nf  * sizeof *G->face_normals;
+    array[GB_CELL_CENTROIDS  ] = G->cell_centroids;
+    size [GB_CELL_CENTROIDS  ] = nd * nc  * sizeof *G->cell_centroids;
+    array[GB_CELL_VOLUMES    ] = G->cell_volumes;
+    size [GB_CELL_VOLUMES    ] = nc       * sizeof *G->cell_volumes;
+    array[GB_GLOBAL_CELL     ] = G->global_cell;
+    size [GB_GLOBAL_CELL     ] = nc       * sizeof *G->global_cell;
+    array[GB_CELL_FACETAG    ] = G->cell_facetag;
+    size [GB_CELL_FACETAG    ] = ncf      * sizeof *G->cell_facetag;
+}
+
+
+/* ---------------------------------------------------------------------- */
+static uint64_t
+align_offset(uint64_t off)
+/* ---------------------------------------------------------------------- */
+{
+    return GRID_BINARY_ALIGN * ((off + GRID_BINARY_ALIGN - 1) / GRID_BINARY_ALIGN);
+}
+
+
+/* ---------------------------------------------------------------------- */
+int
+write_grid_binary(const struct UnstructuredGrid *G,
+                  const char                    *fname,
+                  uint64_t                       key)
+/* ---------------------------------------------------------------------- */
+{
+    int                        i, ok;
+    uint64_t                   pos;
+    const void                *array[GB_NARRAYS];
+    struct grid_binary_header  h;
+    static const char          zeros[GRID_BINARY_ALIGN] = { 0 };
+    FILE                      *fp;
+
+    memset(&h, 0, sizeof h);
+    memcpy(h.magic, GRID_BINARY_MAGIC, sizeof h.magic);
+    h.version     = GRID_BINARY_VERSION;
+    h.byte_order  = GRID_BINARY_BYTEORDER;
+    h.int_size    = sizeof(int);
+    h.double_size = sizeof(double);
+    h.key         = key;
+
+    h.dimensions          = G->dimensions;
+    h.number_of_cells     = G->number_of_cells;
+    h.number_of_faces     = G->number_of_faces;
+    h.number_of_nodes     = G->number_of_nodes;
+    h.cartdims[0]         = G->cartdims[0];
+    h.cartdims[1]         = G->cartdims[1];
+    h.cartdims[2]         = G->cartdims[2];
+    h.number_of_facenodes = G->face_nodepos[G->number_of_faces];
+    h.number_of_cellfaces = G->cell_facepos[G->number_of_cells];
+
+    array_table(G, array, h.size);
+
+    pos = align_offset(sizeof h);
+    for (i = 0; i < GB_NARRAYS; i++) {
+        if (array[i] == NULL) {
+            h.offset[i] = 0;
+            h.size  [i] = 0;
+        }
+        else {
+            h.offset[i] = pos;
+            pos         = align_offset(pos + h.size[i]);
+        }
+    }
+
+    fp = fopen(fname, "wb");
+    if (fp == NULL) {
+        return 0;
+    }
+
+    ok  = fwrite(&h, sizeof h, 1, fp) == 1;
+    pos = sizeof h;
+    for (i = 0; ok && (i < GB_NARRAYS); i++) {
+        if (array[i] != NULL) {
+            assert (h.offset[i] - pos < GRID_BINARY_ALIGN);
+
+            ok = fwrite(zeros, 1, h.offset[i] - pos, fp) == h.offset[i] - pos;
+
+            ok = ok && (fwrite(array[i], 1, h.size[i], fp) == h.size[i]);
+            pos = h.offset[i] + h.size[i];
+        }
+    }
+
+    ok = (fclose(fp) == 0) && ok;
+
+    return ok;
+}
+
+
+/* ---------------------------------------------------------------------- */
+static int
+valid_header(const struct grid_binary_header *h, size_t len, uint64_t key)
+/* ---------------------------------------------------------------------- */
+{
+    int      i, ok;
+    uint64_t nd, nc, nf, nn, nfn, ncf;
+    uint64_t size[GB_NARRAYS];
+
+    ok = (len >= sizeof *h)                                          &&
+         (memcmp(h->magic, GRID_BINARY_MAGIC, sizeof h->magic) == 0) &&
+         (h->version     == GRID_BINARY_VERSION)                     &&
+         (h->byte_order  == GRID_BINARY_BYTEORDER)                   &&
+         (h->int_size    == sizeof(int))                             &&
+         (h->double_size == sizeof(double))                          &&
+         (h->key         == key)                                     &&
+         (h->dimensions      >= 0) && (h->number_of_cells >= 0)     &&
+         (h->number_of_faces >= 0) && (h->number_of_nodes >= 0);
+
+    if (! ok) {
+        return 0;
+    }
+
+    nd  = h->dimensions;
+    nc  = h->number_of_cells;
+    nf  = h->number_of_faces;
+    nn  = h->number_of_nodes;
+    nfn = h->number_of_facenodes;
+    ncf = h->number_of_cellfaces;
+
+    size[GB_NODE_COORDINATES] = nd * nn  * sizeof(double);
+    size[GB_FACE_NODES      ] = nfn      * sizeof(int);
+    size[GB_FACE_NODEPOS    ] = (nf + 1) * sizeof(int);
+    size[GB_FACE_CELLS      ] = 2 * nf   * sizeof(int);
+    size[GB_CELL_FACES      ] = ncf      * sizeof(int);
+    size[GB_CELL_FACEPOS    ] = (nc + 1) * sizeof(int);
+    size[GB_FACE_CENTROIDS  ] = nd * nf  * sizeof(double);
+    size[GB_FACE_AREAS      ] = nf       * sizeof(double);
+    size[GB_FACE_NORMALS    ] = nd * nf  * sizeof(double);
+    size[GB_CELL_CENTROIDS  ] = nd * nc  * sizeof(double);
+    size[GB_CELL_VOLUMES    ] = nc       * sizeof(double);
+    size[GB_GLOBAL_CELL     ] = nc       * sizeof(int);
+    size[GB_CELL_FACETAG    ] = ncf      * sizeof(int);
+
+    for (i = 0; ok && (i < GB_NARRAYS); i++) {
+        if (h->offset[i] == 0) {
+            /* Only global_cell and cell_facetag are optional. */
+            ok = (i == GB_GLOBAL_CELL) || (i == GB_CELL_FACETAG);
+        }
+        else {
+            ok = (h->size[i] == size[i])                    &&
+                 (h->offset[i] % GRID_BINARY_ALIGN == 0)    &&
+                 (h->offset[i] >= sizeof *h)                &&
+                 (h->offset[i] <= len)                      &&
+                 (h->size[i]   <= len - h->offset[i]);
+        }
+    }
+
+    return ok;
+}
+
+
+/* ---------------------------------------------------------------------- */
+static void *
+array_at(void *base, const struct grid_binary_header *h, int i)
+/* ---------------------------------------------------------------------- */
+{
+    return (h->offset[i] == 0) ? NULL : (char *) base + h->offset[i];
+}
+
+
+/* ---------------------------------------------------------------------- */
+struct UnstructuredGrid *
+map_grid_binary(const char *fname, uint64_t key)
+/* ---------------------------------------------------------------------- */
+{
+    int                        fd;
+    size_t                     len;
+    void                      *base;
+    struct stat                st;
+    struct mapped_grid        *mg;
+    struct UnstructuredGrid   *G;
+    const struct grid_binary_header *h;
+
+    fd = open(fname, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    if ((fstat(fd, &st) != 0) || (st.st_size < (off_t) sizeof *h)) {
+        close(fd);
+        return NULL;
+    }
+    len = st.st_size;
+
+    /* Private, writable mapping: Grid consumers may modify the arrays
+     * in place without affecting the file. */
+    base = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (base == MAP_FAILED) {
+        return NULL;
+    }
+
+    h = base;
+    if (! valid_header(h, len, key)) {
+        munmap(base, len);
+        return NULL;
+    }
+
+    mg = malloc(1 * sizeof *mg);
+    if (mg == NULL) {
+        munmap(base, len);
+        return NULL;
+    }
+
+    memset(mg, 0, sizeof *mg);
+    mg->base = base;
+    mg->len  = len;
+
+    G = &mg->g;
+    G->dimensions       = h->dimensions;
+    G->number_of_cells  = h->number_of_cells;
+    G->number_of_faces  = h->number_of_faces;
+    G->number_of_nodes  = h->number_of_nodes;
+    G->cartdims[0]      = h->cartdims[0];
+    G->cartdims[1]      = h->cartdims[1];
+    G->cartdims[2]      = h->cartdims[2];
+
+    G->node_coordinates = array_at(base, h, GB_NODE_COORDINATES);
+    G->face_nodes       = array_at(base, h, GB_FACE_NODES      );
+    G->face_nodepos     = array_at(base, h, GB_FACE_NODEPOS    );
+    G->face_cells       = array_at(base, h, GB_FACE_CELLS      );
+    G->cell_faces       = array_at(base, h, GB_CELL_FACES      );
+    G->cell_facepos     = array_at(base, h, GB_CELL_FACEPOS    );
+    G->face_centroids   = array_at(base, h, GB_FACE_CENTROIDS  );
+    G->face_areas       = array_at(base, h, GB_FACE_AREAS      );
+    G->face_normals     = array_at(base, h, GB_FACE_NORMALS    );
+    G->cell_centroids   = array_at(base, h, GB_CELL_CENTROIDS  );
+    G->cell_volumes     = array_at(base, h, GB_CELL_VOLUMES    );
+    G->global_cell      = array_at(base, h, GB_GLOBAL_CELL     );
+    G->cell_facetag     = array_at(base, h, GB_CELL_FACETAG    );
+
+    if ((G->face_nodepos[G->number_of_faces] != (int) h->number_of_facenodes) ||
+        (G->cell_facepos[G->number_of_cells] != (int) h->number_of_cellfaces)) {
+        unmap_grid_binary(G);
+        G = NULL;
+    }
+
+    return G;
+}
+
+
+/* ---------------------------------------------------------------------- */
+void
+unmap_grid_binary(struct UnstructuredGrid *G)
+/* ---------------------------------------------------------------------- */
+{
+    struct mapped_grid *mg;
+
+    if (G != NULL) {
+        mg = (struct mapped_grid *) G;
+
+        munmap(mg->base, mg->len);
+        free(mg);
+    }
+}
@@ -0,0 +1,92 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_GRID_BINARY_H_HEADER
+#define OPM_GRID_BINARY_H_HEADER
+
+/**
+ * \file
+ * Versioned binary on-disk representation of an UnstructuredGrid.
+ *
+ * The file consists of a fixed-size header followed by the grid's
+ * arrays, each starting at a 64-byte aligned offset.  The arrays are
+ * stored in native byte order with the exact layout they have in
+ * memory, so a file can be memory-mapped and its arrays used directly
+ * as the arrays of a grid without any parsing or copying.
+ *
+ * Each file carries a caller-defined 64-bit key, typically a hash of
+ * the input from which the grid was built.  A file is only loaded if
+ * its key, format version and native data layout all match.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct UnstructuredGrid;
+
+/**
+ * Write grid to binary file.
+ *
+ * @param[in] G     Grid.
+ * @param[in] fname File name.  Any existing file is overwritten.
+ * @param[in] key   Key to store with the grid.
+ *
+ * @return Non-zero if the grid was successfully written, zero otherwise.
+ */
+int
+write_grid_binary(const struct UnstructuredGrid *G,
+                  const char                    *fname,
+                  uint64_t                       key);
+
+
+/**
+ * Map grid from binary file previously created by write_grid_binary().
+ *
+ * The arrays of the returned grid point directly into a private
+ * (copy-on-write) mapping of the file.  Modifying them is allowed, but
+ * never alters the file.
+ *
+ * @param[in] fname File name.
+ * @param[in] key   Expected key.
+ *
+ * @return Fully formed grid structure.  Must be destroyed using function
+ * unmap_grid_binary(), not destroy_grid().  @c NULL if the file does not
+ * exist, is not a valid grid file of the current format version or was
+ * stored with a different key.
+ */
+struct UnstructuredGrid *
+map_grid_binary(const char *fname, uint64_t key);
+
+
+/**
+ * Release grid obtained from map_grid_binary().
+ *
+ * @param[in,out] G Grid.  May be @c NULL.
+ */
+void
+unmap_grid_binary(struct UnstructuredGrid *G);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OPM_GRID_BINARY_H_HEADER */
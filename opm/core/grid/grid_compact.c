@@ -0,0 +1,268 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+#include <opm/core/grid.h>
+#include <opm/core/grid/grid_compact.h>
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+struct grid_node_archive {
+    int            dimensions;
+    int            number_of_faces;
+    int            number_of_nodes;
+    int            face_nodes_size;  /* Total length of face-node lists */
+
+    size_t         nbytes;           /* Length of encoded topology */
+    unsigned char *topology;         /* Encoded face-node lists */
+
+    int            single_precision;
+    void          *coords;           /* float or double */
+};
+
+
+/* ---------------------------------------------------------------------- */
+/* Append variable-length (base 128) encoding of v.  Returns number of    */
+/* bytes, writing only if p is non-NULL.                                  */
+/* ---------------------------------------------------------------------- */
+static size_t
+put_varint(uint32_t v, unsigned char *p)
+/* ---------------------------------------------------------------------- */
+{
+    size_t n = 0;
+
+    while (v >= 0x80) {
+        if (p != NULL) { p[n] = (unsigned char) (v | 0x80); }
+        v >>= 7;
+        n  += 1;
+    }
+    if (p != NULL) { p[n] = (unsigned char) v; }
+
+    return n + 1;
+}
+
+
+/* ---------------------------------------------------------------------- */
+static uint32_t
+get_varint(const unsigned char **p)
+/* ---------------------------------------------------------------------- */
+{
+    uint32_t v     = 0;
+    int      shift = 0;
+
+    while (**p & 0x80) {
+        v     |= (uint32_t) (**p & 0x7f) << shift;
+        shift += 7;
+        *p    += 1;
+    }
+    v  |= (uint32_t) **p << shift;
+    *p += 1;
+
+    return v;
+}
+
+
+/* Map signed difference to unsigned, small magnitudes to small values. */
+static uint32_t zigzag  (int32_t  d) { return ((uint32_t) d << 1) ^ (uint32_t) (d >> 31); }
+static int32_t  unzigzag(uint32_t u) { return (int32_t) (u >> 1) ^ -(int32_t) (u & 1); }
+
+
+/* ---------------------------------------------------------------------- */
+/* Encode face-node lists of G.  Returns number of bytes, writing only if */
+/* p is non-NULL.  The first node of each face is encoded relative to    */
+/* the first node of the previous face.                                   */
+/* ---------------------------------------------------------------------- */
+static size_t
+encode_topology(const struct UnstructuredGrid *G, unsigned char *p)
+/* ---------------------------------------------------------------------- */
+{
+    int    f, i, prev, first;
+    size_t n;
+
+    n     = 0;
+    first = 0;
+
+    for (f = 0; f < G->number_of_faces; f++) {
+        n += put_varint(G->face_nodepos[f + 1] - G->face_nodepos[f],
+                        p ? p + n : NULL);
+
+        prev = first;
+        for (i = G->face_nodepos[f]; i < G->face_nodepos[f + 1]; i++) {
+            n   += put_varint(zigzag(G->face_nodes[i] - prev), p ? p + n : NULL);
+            prev = G->face_nodes[i];
+
+            if (i == G->face_nodepos[f]) {
+                first = prev;
+            }
+        }
+    }
+
+    return n;
+}
+
+
+/* ---------------------------------------------------------------------- */
+void
+destroy_grid_node_archive(struct grid_node_archive *A)
+/* ---------------------------------------------------------------------- */
+{
+    if (A != NULL) {
+        free(A->coords);
+        free(A->topology);
+    }
+
+    free(A);
+}
+
+
+/* ---------------------------------------------------------------------- */
+struct grid_node_archive *
+archive_grid_nodes(struct UnstructuredGrid *G, int single_precision)
+/* ---------------------------------------------------------------------- */
+{
+    size_t                    i, ncoord;
+    float                    *fc;
+    struct grid_node_archive *A;
+
+    A = malloc(1 * sizeof *A);
+    if (A == NULL) {
+        return NULL;
+    }
+
+    A->dimensions       = G->dimensions;
+    A->number_of_faces  = G->number_of_faces;
+    A->number_of_nodes  = G->number_of_nodes;
+    A->face_nodes_size  = G->face_nodepos[G->number_of_faces];
+    A->single_precision = single_precision != 0;
+
+    ncoord = (size_t) G->dimensions * G->number_of_nodes;
+
+    A->nbytes   = encode_topology(G, NULL);
+    A->topology = malloc(A->nbytes + 1);
+    A->coords   = A->single_precision
+        ? malloc((ncoord + 1) * sizeof(float))
+        : malloc((ncoord + 1) * sizeof(double));
+
+    if ((A->topology == NULL) || (A->coords == NULL)) {
+        destroy_grid_node_archive(A);
+        return NULL;
+    }
+
+    encode_topology(G, A->topology);
+
+    if (A->single_precision) {
+        fc = A->coords;
+        for (i = 0; i < ncoord; i++) {
+            fc[i] = (float) G->node_coordinates[i];
+        }
+    }
+    else {
+        memcpy(A->coords, G->node_coordinates,
+               ncoord * sizeof *G->node_coordinates);
+    }
+
+    free(G->node_coordinates);  G->node_coordinates = NULL;
+    free(G->face_nodes);        G->face_nodes       = NULL;
+    free(G->face_nodepos);      G->face_nodepos     = NULL;
+
+    return A;
+}
+
+
+/* ---------------------------------------------------------------------- */
+int
+restore_grid_nodes(struct UnstructuredGrid *G, struct grid_node_archive *A)
+/* ---------------------------------------------------------------------- */
+{
+    int                  f, i, n, prev, first;
+    size_t               k, ncoord;
+    double              *coords;
+    int                 *fnodes, *fnodepos;
+    const float         *fc;
+    const unsigned char *p;
+
+    assert (G->number_of_faces == A->number_of_faces);
+    assert (G->number_of_nodes == A->number_of_nodes);
+
+    ncoord   = (size_t) A->dimensions * A->number_of_nodes;
+    coords   = malloc((ncoord + 1)              * sizeof *coords);
+    fnodes   = malloc((A->face_nodes_size + 1)  * sizeof *fnodes);
+    fnodepos = malloc((A->number_of_faces + 1)  * sizeof *fnodepos);
+
+    if ((coords == NULL) || (fnodes == NULL) || (fnodepos == NULL)) {
+        free(fnodepos);  free(fnodes);  free(coords);
+        return 0;
+    }
+
+    p           = A->topology;
+    first       = 0;
+    fnodepos[0] = 0;
+    for (f = 0; f < A->number_of_faces; f++) {
+        n = (int) get_varint(&p);
+        fnodepos[f + 1] = fnodepos[f] + n;
+
+        prev = first;
+        for (i = fnodepos[f]; i < fnodepos[f + 1]; i++) {
+            fnodes[i] = prev + unzigzag(get_varint(&p));
+            prev      = fnodes[i];
+        }
+
+        if (n > 0) {
+            first = fnodes[fnodepos[f]];
+        }
+    }
+    assert ((size_t) (p - A->topology) == A->nbytes);
+    assert (fnodepos[A->number_of_faces] == A->face_nodes_size);
+
+    if (A->single_precision) {
+        fc = A->coords;
+        for (k = 0; k < ncoord; k++) {
+            coords[k] = fc[k];
+        }
+    }
+    else {
+        memcpy(coords, A->coords, ncoord * sizeof *coords);
+    }
+
+    G->node_coordinates = coords;
+    G->face_nodes       = fnodes;
+    G->face_nodepos     = fnodepos;
+
+    destroy_grid_node_archive(A);
+
+    return 1;
+}
+
+
+/* ---------------------------------------------------------------------- */
+size_t
+grid_node_archive_size(const struct grid_node_archive *A)
+/* ---------------------------------------------------------------------- */
+{
+    size_t ncoord;
+
+    ncoord = (size_t) A->dimensions * A->number_of_nodes;
+
+    return sizeof *A + A->nbytes +
+        ncoord * (A->single_precision ? sizeof(float) : sizeof(double));
+}
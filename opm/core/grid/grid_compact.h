@@ -0,0 +1,105 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_GRID_COMPACT_H_HEADER
+#define OPM_GRID_COMPACT_H_HEADER
+
+/**
+ * \file
+ * Compact storage of the node data of an UnstructuredGrid.
+ *
+ * Node coordinates and face-to-node topology are needed to compute
+ * geometry and to write output, but by no flow or transport kernel.
+ * The functions below move them into a compact archive while they are
+ * not needed, and restore them on demand.
+ *
+ * In the archive, each face's node list is stored as its length
+ * followed by the differences between consecutive node indices, all as
+ * variable-length integers.  Node indices of neighbouring faces are
+ * usually close, so most entries need a single byte.  Coordinates are
+ * kept in double precision, or optionally rounded to single precision.
+ */
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct UnstructuredGrid;
+struct grid_node_archive;
+
+/**
+ * Move node data of grid into a compact archive.
+ *
+ * On success, <code>G->node_coordinates</code>, <code>G->face_nodes</code>
+ * and <code>G->face_nodepos</code> are released and set to @c NULL.  All
+ * other grid fields, including <code>G->number_of_nodes</code>, are
+ * unchanged.
+ *
+ * @param[in,out] G                Grid.  Its node arrays must have been
+ *                                 allocated by malloc().
+ * @param[in]     single_precision If non-zero, store node coordinates in
+ *                                 single precision.  Restored coordinates
+ *                                 are then rounded.
+ *
+ * @return Archive.  @c NULL in case of allocation failure, in which case
+ * @c G is unchanged.
+ */
+struct grid_node_archive *
+archive_grid_nodes(struct UnstructuredGrid *G, int single_precision);
+
+
+/**
+ * Restore node data of grid from archive created by archive_grid_nodes().
+ *
+ * @param[in,out] G Grid from which the archive was created.
+ * @param[in]     A Archive.  Destroyed on success.
+ *
+ * @return Non-zero on success.  Zero in case of allocation failure, in
+ * which case both @c G and @c A are unchanged.
+ */
+int
+restore_grid_nodes(struct UnstructuredGrid *G, struct grid_node_archive *A);
+
+
+/**
+ * Number of bytes used by archive.
+ *
+ * @param[in] A Archive.
+ *
+ * @return Total size of the archive's data.
+ */
+size_t
+grid_node_archive_size(const struct grid_node_archive *A);
+
+
+/**
+ * Dispose of archive without restoring it.
+ *
+ * @param[in,out] A Archive.  May be @c NULL.
+ */
+void
+destroy_grid_node_archive(struct grid_node_archive *A);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OPM_GRID_COMPACT_H_HEADER */
@@ -0,0 +1,473 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+#include <opm/core/grid.h>
+#include <opm/core/grid/grid_partition.h>
+
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Maximum number of sweeps over all cells in grid_partition_refine() */
+#define MAX_REFINE_PASSES 10
+
+
+/* ---------------------------------------------------------------------- */
+/* Cell on other side of face f, as seen from cell c.  Negative if f is   */
+/* a boundary face.                                                       */
+/* ---------------------------------------------------------------------- */
+static int
+other_cell(const struct UnstructuredGrid *G, int f, int c)
+/* ---------------------------------------------------------------------- */
+{
+    return (G->face_cells[2*f + 0] == c)
+        ? G->face_cells[2*f + 1] : G->face_cells[2*f + 0];
+}
+
+
+/* ---------------------------------------------------------------------- */
+/* Strict ordering of cells along coordinate direction d, ties broken by  */
+/* cell index.                                                            */
+/* ---------------------------------------------------------------------- */
+static int
+less_along(const double *x, int nd, int d, int a, int b)
+/* ---------------------------------------------------------------------- */
+{
+    const double xa = x[nd*a + d];
+    const double xb = x[nd*b + d];
+
+    return (xa < xb) || ((xa == xb) && (a < b));
+}
+
+
+/* ---------------------------------------------------------------------- */
+/* Rearrange idx[0..n-1] such that its k first elements are the k         */
+/* smallest along direction d (quickselect).                              */
+/* ---------------------------------------------------------------------- */
+static void
+select_along(const double *x, int nd, int d, int *idx, int n, int k)
+/* ---------------------------------------------------------------------- */
+{
+    int lo, hi, i, j, pivot, tmp;
+
+    lo = 0;
+    hi = n - 1;
+
+    while (lo < hi) {
+        pivot = idx[lo + (hi - lo)/2];
+
+        i = lo;
+        j = hi;
+        while (i <= j) {
+            while (less_along(x, nd, d, idx[i], pivot)) { i++; }
+            while (less_along(x, nd, d, pivot, idx[j])) { j--; }
+
+            if (i <= j) {
+                tmp = idx[i];  idx[i] = idx[j];  idx[j] = tmp;
+                i++;  j--;
+            }
+        }
+
+        if      (k <= j) { hi = j; }
+        else if (k >= i) { lo = i; }
+        else             { break;  }
+    }
+}
+
+
+/* ---------------------------------------------------------------------- */
+/* Assign cells idx[0..n-1] to parts first..first+nparts-1.               */
+/* ---------------------------------------------------------------------- */
+static void
+rcb(const double *x, int nd, int *idx, int n,
+    int nparts, int first, int *part)
+/* ---------------------------------------------------------------------- */
+{
+    int    i, d, dmax, np1, n1;
+    double lo[3], hi[3], v;
+
+    assert (nd <= 3);
+
+    if ((nparts == 1) || (n == 0)) {
+        for (i = 0; i < n; i++) { part[idx[i]] = first; }
+        return;
+    }
+
+    for (d = 0; d < nd; d++) {
+        lo[d] = hi[d] = x[nd*idx[0] + d];
+    }
+    for (i = 1; i < n; i++) {
+        for (d = 0; d < nd; d++) {
+            v = x[nd*idx[i] + d];
+            if (v < lo[d]) { lo[d] = v; }
+            if (v > hi[d]) { hi[d] = v; }
+        }
+    }
+
+    dmax = 0;
+    for (d = 1; d < nd; d++) {
+        if (hi[d] - lo[d] > hi[dmax] - lo[dmax]) { dmax = d; }
+    }
+
+    np1 = nparts / 2;
+    n1  = (int) (((double) n * np1) / nparts);
+
+    if ((n1 > 0) && (n1 < n)) {
+        select_along(x, nd, dmax, idx, n, n1);
+    }
+
+    rcb(x, nd, idx     , n1    , np1         , first      , part);
+    rcb(x, nd, idx + n1, n - n1, nparts - np1, first + np1, part);
+}
+
+
+/* ---------------------------------------------------------------------- */
+int
+grid_partition_rcb(const struct UnstructuredGrid *G, int nparts, int *part)
+/* ---------------------------------------------------------------------- */
+{
+    int c, nc, *idx;
+
+    assert (nparts > 0);
+
+    nc  = G->number_of_cells;
+    idx = malloc((nc + 1) * sizeof *idx);
+
+    if (idx == NULL) {
+        return 0;
+    }
+
+    for (c = 0; c < nc; c++) { idx[c] = c; }
+
+    rcb(G->cell_centroids, G->dimensions, idx, nc, nparts, 0, part);
+
+    free(idx);
+
+    return 1;
+}
+
+
+/* ---------------------------------------------------------------------- */
+int
+grid_partition_refine(const struct UnstructuredGrid *G, int nparts,
+                      double max_imbalance, int *part)
+/* ---------------------------------------------------------------------- */
+{
+    int    c, i, k, f, o, p, q, nc, maxdeg, nnbr, nown, best, gain, bestgain;
+    int    pass, nmoves, moved, minsize, maxsize;
+    int   *size, *nbr_part, *nbr_count;
+    double avg;
+
+    nc = G->number_of_cells;
+
+    maxdeg = 0;
+    for (c = 0; c < nc; c++) {
+        k = G->cell_facepos[c + 1] - G->cell_facepos[c];
+        if (k > maxdeg) { maxdeg = k; }
+    }
+
+    size      = calloc(nparts, sizeof *size);
+    nbr_part  = malloc((maxdeg + 1) * sizeof *nbr_part);
+    nbr_count = malloc((maxdeg + 1) * sizeof *nbr_count);
+
+    if ((size == NULL) || (nbr_part == NULL) || (nbr_count == NULL)) {
+        free(nbr_count);  free(nbr_part);  free(size);
+        return -1;
+    }
+
+    for (c = 0; c < nc; c++) { size[part[c]] += 1; }
+
+    avg     = ((double) nc) / nparts;
+    maxsize = (int) floor(avg * (1.0 + max_imbalance));
+    minsize = (int) ceil (avg * (1.0 - max_imbalance));
+    if (maxsize < (int) ceil (avg)) { maxsize = (int) ceil (avg); }
+    if (minsize > (int) floor(avg)) { minsize = (int) floor(avg); }
+
+    moved = 0;
+    for (pass = 0; pass < MAX_REFINE_PASSES; pass++) {
+        nmoves = 0;
+
+        for (c = 0; c < nc; c++) {
+            p    = part[c];
+            nown = 0;
+            nnbr = 0;
+
+            /* Count internal faces to own and neighbouring parts. */
+            for (i = G->cell_facepos[c]; i < G->cell_facepos[c + 1]; i++) {
+                f = G->cell_faces[i];
+                o = other_cell(G, f, c);
+
+                if ((o < 0) || (o == c)) { continue; }
+
+                q = part[o];
+                if (q == p) { nown += 1; continue; }
+
+                for (k = 0; (k < nnbr) && (nbr_part[k] != q); k++) { ; }
+                if (k == nnbr) {
+                    nbr_part [nnbr] = q;
+                    nbr_count[nnbr] = 0;
+                    nnbr += 1;
+                }
+                nbr_count[k] += 1;
+            }
+
+            if ((nnbr == 0) || (size[p] <= minsize)) { continue; }
+
+            best     = -1;
+            bestgain = 0;
+            for (k = 0; k < nnbr; k++) {
+                gain = nbr_count[k] - nown;
+                if ((gain > bestgain) && (size[nbr_part[k]] < maxsize)) {
+                    best     = nbr_part[k];
+                    bestgain = gain;
+                }
+            }
+
+            if (best >= 0) {
+                part[c]     = best;
+                size[p]    -= 1;
+                size[best] += 1;
+                nmoves     += 1;
+            }
+        }
+
+        moved += nmoves;
+        if (nmoves == 0) { break; }
+    }
+
+    free(nbr_count);  free(nbr_part);  free(size);
+
+    return moved;
+}
+
+
+/* ---------------------------------------------------------------------- */
+int
+grid_partition_cut(const struct UnstructuredGrid *G, const int *part)
+/* ---------------------------------------------------------------------- */
+{
+    int f, c1, c2, cut;
+
+    cut = 0;
+    for (f = 0; f < G->number_of_faces; f++) {
+        c1 = G->face_cells[2*f + 0];
+        c2 = G->face_cells[2*f + 1];
+
+        if ((c1 >= 0) && (c2 >= 0) && (part[c1] != part[c2])) {
+            cut += 1;
+        }
+    }
+
+    return cut;
+}
+
+
+/* ---------------------------------------------------------------------- */
+int
+grid_partition_overlap(const struct UnstructuredGrid *G, const int *part,
+                       int p, int nlayers, int *cells, int *nowned)
+/* ---------------------------------------------------------------------- */
+{
+    int   c, o, i, j, n, nc, layer, begin, end;
+    char *mark;
+
+    nc   = G->number_of_cells;
+    mark = calloc(nc + 1, sizeof *mark);
+
+    if (mark == NULL) {
+        return -1;
+    }
+
+    n = 0;
+    for (c = 0; c < nc; c++) {
+        if (part[c] == p) {
+            mark[c]    = 1;
+            cells[n++] = c;
+        }
+    }
+    *nowned = n;
+
+    /* Breadth-first search, layer by layer, using cells[] as queue. */
+    begin = 0;
+    for (layer = 0; layer < nlayers; layer++) {
+        end = n;
+        for (i = begin; i < end; i++) {
+            c = cells[i];
+            for (j = G->cell_facepos[c]; j < G->cell_facepos[c + 1]; j++) {
+                o = other_cell(G, G->cell_faces[j], c);
+
+                if ((o >= 0) && !mark[o]) {
+                    mark[o]    = 2;
+                    cells[n++] = o;
+                }
+            }
+        }
+        begin = end;
+    }
+
+    /* Overlap cells in increasing order. */
+    n = *nowned;
+    for (c = 0; c < nc; c++) {
+        if (mark[c] == 2) { cells[n++] = c; }
+    }
+
+    free(mark);
+
+    return n;
+}
+
+
+/* ---------------------------------------------------------------------- */
+struct UnstructuredGrid *
+extract_subgrid(const struct UnstructuredGrid *G, int nc,
+                const int *cells, int *face_map)
+/* ---------------------------------------------------------------------- */
+{
+    int  nd, c, oc, i, j, f, of, n, nsf, nsn, nfn, ncf;
+    int *cell_new, *face_new, *node_new, *fmap, *nmap;
+    struct UnstructuredGrid *R;
+
+    assert (G->face_nodepos != NULL);
+
+    nd = G->dimensions;
+
+    cell_new = malloc((G->number_of_cells + 1) * sizeof *cell_new);
+    face_new = malloc((G->number_of_faces + 1) * sizeof *face_new);
+    node_new = malloc((G->number_of_nodes + 1) * sizeof *node_new);
+    fmap     = malloc((G->number_of_faces + 1) * sizeof *fmap);
+    nmap     = malloc((G->number_of_nodes + 1) * sizeof *nmap);
+
+    if ((cell_new == NULL) || (face_new == NULL) || (node_new == NULL) ||
+        (fmap     == NULL) || (nmap     == NULL)) {
+        free(nmap);  free(fmap);  free(node_new);  free(face_new);  free(cell_new);
+        return NULL;
+    }
+
+    for (c = 0; c < G->number_of_cells; c++) { cell_new[c] = -1; }
+    for (f = 0; f < G->number_of_faces; f++) { face_new[f] = -1; }
+    for (n = 0; n < G->number_of_nodes; n++) { node_new[n] = -1; }
+
+    for (c = 0; c < nc; c++) { cell_new[cells[c]] = c; }
+
+    /* Number faces and nodes by first occurrence. */
+    nsf = ncf = 0;
+    for (c = 0; c < nc; c++) {
+        oc = cells[c];
+        for (i = G->cell_facepos[oc]; i < G->cell_facepos[oc + 1]; i++, ncf++) {
+            of = G->cell_faces[i];
+            if (face_new[of] < 0) {
+                face_new[of] = nsf;
+                fmap[nsf++]  = of;
+            }
+        }
+    }
+
+    nsn = nfn = 0;
+    for (f = 0; f < nsf; f++) {
+        of = fmap[f];
+        for (i = G->face_nodepos[of]; i < G->face_nodepos[of + 1]; i++, nfn++) {
+            n = G->face_nodes[i];
+            if (node_new[n] < 0) {
+                node_new[n] = nsn;
+                nmap[nsn++] = n;
+            }
+        }
+    }
+
+    R = allocate_grid(nd, nc, nsf, nfn, ncf, nsn);
+    if (R != NULL) {
+        R->global_cell = malloc((nc + 1) * sizeof *R->global_cell);
+    }
+
+    if ((R == NULL) || (R->global_cell == NULL)) {
+        destroy_grid(R);
+        free(nmap);  free(fmap);  free(node_new);  free(face_new);  free(cell_new);
+        return NULL;
+    }
+
+    R->cartdims[0] = G->cartdims[0];
+    R->cartdims[1] = G->cartdims[1];
+    R->cartdims[2] = G->cartdims[2];
+
+    /* Nodes. */
+    for (n = 0; n < nsn; n++) {
+        memcpy(R->node_coordinates + nd*n, G->node_coordinates + nd*nmap[n],
+               nd * sizeof *R->node_coordinates);
+    }
+
+    /* Cells. */
+    R->cell_facepos[0] = 0;
+    for (c = 0; c < nc; c++) {
+        oc = cells[c];
+
+        j = R->cell_facepos[c];
+        for (i = G->cell_facepos[oc]; i < G->cell_facepos[oc + 1]; i++, j++) {
+            R->cell_faces[j] = face_new[G->cell_faces[i]];
+
+            if (G->cell_facetag != NULL) {
+                R->cell_facetag[j] = G->cell_facetag[i];
+            }
+        }
+        R->cell_facepos[c + 1] = j;
+
+        memcpy(R->cell_centroids + nd*c, G->cell_centroids + nd*oc,
+               nd * sizeof *R->cell_centroids);
+        R->cell_volumes[c] = G->cell_volumes[oc];
+
+        R->global_cell[c] = (G->global_cell != NULL) ? G->global_cell[oc] : oc;
+    }
+
+    if (G->cell_facetag == NULL) {
+        free(R->cell_facetag);
+        R->cell_facetag = NULL;
+    }
+
+    /* Faces.  Neighbours outside the subset become boundary. */
+    R->face_nodepos[0] = 0;
+    for (f = 0; f < nsf; f++) {
+        of = fmap[f];
+
+        j = R->face_nodepos[f];
+        for (i = G->face_nodepos[of]; i < G->face_nodepos[of + 1]; i++, j++) {
+            R->face_nodes[j] = node_new[G->face_nodes[i]];
+        }
+        R->face_nodepos[f + 1] = j;
+
+        for (i = 0; i < 2; i++) {
+            c = G->face_cells[2*of + i];
+            R->face_cells[2*f + i] = (c >= 0) ? cell_new[c] : -1;
+        }
+
+        memcpy(R->face_centroids + nd*f, G->face_centroids + nd*of,
+               nd * sizeof *R->face_centroids);
+        memcpy(R->face_normals   + nd*f, G->face_normals   + nd*of,
+               nd * sizeof *R->face_normals);
+        R->face_areas[f] = G->face_areas[of];
+    }
+
+    if (face_map != NULL) {
+        memcpy(face_map, fmap, nsf * sizeof *face_map);
+    }
+
+    free(nmap);  free(fmap);  free(node_new);  free(face_new);  free(cell_new);
+
+    return R;
+}
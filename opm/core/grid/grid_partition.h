@@ -0,0 +1,134 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_GRID_PARTITION_H_HEADER
+#define OPM_GRID_PARTITION_H_HEADER
+
+/**
+ * \file
+ * Partitioning of UnstructuredGrid cells into subdomains, and extraction
+ * of subdomain grids.
+ *
+ * Partitions are represented as arrays mapping each cell to its part,
+ * <code>part[c]</code> being in the range <code>0..nparts-1</code>.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct UnstructuredGrid;
+
+/**
+ * Partition cells by recursive coordinate bisection of the cell
+ * centroids.  Each bisection splits the cells along the coordinate
+ * direction of largest extent, in proportion to the number of parts on
+ * each side, so part sizes differ by at most one cell per bisection
+ * level.
+ *
+ * @param[in]  G      Grid.
+ * @param[in]  nparts Number of parts, at least one.
+ * @param[out] part   Partition, array of size
+ *                    <code>G->number_of_cells</code>.
+ *
+ * @return Non-zero on success, zero in case of allocation failure.
+ */
+int
+grid_partition_rcb(const struct UnstructuredGrid *G, int nparts, int *part);
+
+
+/**
+ * Improve partition by greedily moving cells on part boundaries to the
+ * neighbouring part to which they have most internal faces, as long as
+ * this reduces the number of faces between parts and keeps every part
+ * within the given imbalance.
+ *
+ * @param[in]     G             Grid.
+ * @param[in]     nparts        Number of parts.
+ * @param[in]     max_imbalance Maximum relative deviation of a part's
+ *                              size from the average, e.g. 0.05.
+ * @param[in,out] part          Partition.
+ *
+ * @return Number of cells moved, or -1 in case of allocation failure.
+ */
+int
+grid_partition_refine(const struct UnstructuredGrid *G, int nparts,
+                      double max_imbalance, int *part);
+
+
+/**
+ * Count faces connecting cells in different parts.
+ *
+ * @param[in] G    Grid.
+ * @param[in] part Partition.
+ *
+ * @return Number of internal faces between parts.
+ */
+int
+grid_partition_cut(const struct UnstructuredGrid *G, const int *part);
+
+
+/**
+ * Collect the cells of one part together with the cells reached from
+ * it through at most @c nlayers internal faces.
+ *
+ * @param[in]  G       Grid.
+ * @param[in]  part    Partition.
+ * @param[in]  p       Part.
+ * @param[in]  nlayers Number of overlap layers.
+ * @param[out] cells   Cells of part @c p in increasing order, followed by
+ *                     the overlap cells in increasing order.  Array of
+ *                     size <code>G->number_of_cells</code>.
+ * @param[out] nowned  Number of cells in part @c p.
+ *
+ * @return Total number of cells, or -1 in case of allocation failure.
+ */
+int
+grid_partition_overlap(const struct UnstructuredGrid *G, const int *part,
+                       int p, int nlayers, int *cells, int *nowned);
+
+
+/**
+ * Create a grid consisting of a subset of the cells of a grid.
+ *
+ * The subgrid contains all faces and nodes of the selected cells, in
+ * order of first occurrence.  Faces connecting to cells outside the
+ * subset become boundary faces with the same orientation.  The
+ * subgrid's @c global_cell maps each cell to its logical Cartesian
+ * index.
+ *
+ * @param[in]  G        Grid.
+ * @param[in]  nc       Number of cells in subset.
+ * @param[in]  cells    Cells in subset, becoming cells
+ *                      <code>0..nc-1</code> of the subgrid.
+ * @param[out] face_map Face of @c G of each subgrid face.  Array of size
+ *                      <code>G->number_of_faces</code>, or @c NULL.
+ *
+ * @return Fully formed grid structure that must be destroyed using
+ * destroy_grid().  @c NULL in case of allocation failure.
+ */
+struct UnstructuredGrid *
+extract_subgrid(const struct UnstructuredGrid *G, int nc,
+                const int *cells, int *face_map);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OPM_GRID_PARTITION_H_HEADER */
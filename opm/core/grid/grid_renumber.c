@@ -0,0 +1,527 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+#include <opm/core/grid.h>
+#include <opm/core/grid/grid_renumber.h>
+
+#include <assert.h>
+#include <float.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* ---------------------------------------------------------------------- */
+/* Cell-to-cell adjacency through internal faces, in compressed format.   */
+/* ---------------------------------------------------------------------- */
+struct cell_adjacency {
+    int *pos;
+    int *nbr;
+};
+
+
+/* ---------------------------------------------------------------------- */
+static int
+build_adjacency(const struct UnstructuredGrid *G, struct cell_adjacency *A)
+/* ---------------------------------------------------------------------- */
+{
+    int f, c1, c2, c, nc, nf;
+
+    nc = G->number_of_cells;
+    nf = G->number_of_faces;
+
+    A->pos = calloc(nc + 2, sizeof *A->pos);
+    A->nbr = NULL;
+
+    if (A->pos == NULL) {
+        return 0;
+    }
+
+    for (f = 0; f < nf; f++) {
+        c1 = G->face_cells[2*f + 0];
+        c2 = G->face_cells[2*f + 1];
+
+        if ((c1 >= 0) && (c2 >= 0) && (c1 != c2)) {
+            A->pos[c1 + 2] += 1;
+            A->pos[c2 + 2] += 1;
+        }
+    }
+
+    for (c = 1; c <= nc; c++) {
+        A->pos[c + 1] += A->pos[c];
+    }
+
+    A->nbr = malloc((A->pos[nc + 1] + 1) * sizeof *A->nbr);
+    if (A->nbr == NULL) {
+        free(A->pos);
+        A->pos = NULL;
+        return 0;
+    }
+
+    for (f = 0; f < nf; f++) {
+        c1 = G->face_cells[2*f + 0];
+        c2 = G->face_cells[2*f + 1];
+
+        if ((c1 >= 0) && (c2 >= 0) && (c1 != c2)) {
+            A->nbr[A->pos[c1 + 1]++] = c2;
+            A->nbr[A->pos[c2 + 1]++] = c1;
+        }
+    }
+
+    return 1;
+}
+
+
+/* ---------------------------------------------------------------------- */
+static void
+free_adjacency(struct cell_adjacency *A)
+/* ---------------------------------------------------------------------- */
+{
+    free(A->nbr);
+    free(A->pos);
+}
+
+
+/* ---------------------------------------------------------------------- */
+/* Breadth-first search from 'start' over cells not yet numbered.  Stores */
+/* visited cells in queue[0..n) and returns n.  On return, *last is the   */
+/* start of the final level in queue and *depth the number of levels.     */
+/* Resets 'level' to -1 for all visited cells before returning.           */
+/* ---------------------------------------------------------------------- */
+static int
+bfs_levels(const struct cell_adjacency *A,
+           int start, int *level, int *queue,
+           int *last, int *depth)
+/* ---------------------------------------------------------------------- */
+{
+    int head, tail, c, i, n;
+
+    head = 0; tail = 0;
+    queue[tail++] = start;
+    level[start]  = 0;
+    *last         = 0;
+
+    while (head < tail) {
+        c = queue[head];
+
+        if (level[c] != level[queue[*last]]) {
+            *last = head;
+        }
+        head++;
+
+        for (i = A->pos[c]; i < A->pos[c + 1]; i++) {
+            n = A->nbr[i];
+
+            if (level[n] == -1) {
+                level[n]      = level[c] + 1;
+                queue[tail++] = n;
+            }
+        }
+    }
+
+    *depth = level[queue[tail - 1]] + 1;
+
+    for (i = 0; i < tail; i++) {
+        level[queue[i]] = -1;
+    }
+
+    return tail;
+}
+
+
+/* ---------------------------------------------------------------------- */
+static int
+degree(const struct cell_adjacency *A, int c)
+/* ---------------------------------------------------------------------- */
+{
+    return A->pos[c + 1] - A->pos[c];
+}
+
+
+/* ---------------------------------------------------------------------- */
+/* George-Liu pseudo-peripheral node finder within start's component.     */
+/* ---------------------------------------------------------------------- */
+static int
+pseudo_peripheral(const struct cell_adjacency *A, int start,
+                  int *level, int *queue)
+/* ---------------------------------------------------------------------- */
+{
+    int n, last, depth, prev_depth, i, cand;
+
+    n = bfs_levels(A, start, level, queue, &last, &depth);
+
+    do {
+        prev_depth = depth;
+
+        cand = queue[last];
+        for (i = last + 1; i < n; i++) {
+            if (degree(A, queue[i]) < degree(A, cand)) {
+                cand = queue[i];
+            }
+        }
+
+        n = bfs_levels(A, cand, level, queue, &last, &depth);
+
+        if (depth > prev_depth) {
+            start = cand;
+        }
+    } while (depth > prev_depth);
+
+    return start;
+}
+
+
+/* ---------------------------------------------------------------------- */
+int
+grid_cell_order_rcm(const struct UnstructuredGrid *G, int *order)
+/* ---------------------------------------------------------------------- */
+{
+    int                    nc, c, i, j, k, n, t, head, tail, begin, start, next;
+    int                   *level, *queue;
+    struct cell_adjacency  A;
+
+    nc = G->number_of_cells;
+
+    if (! build_adjacency(G, &A)) {
+        return 0;
+    }
+
+    level = malloc((nc + 1) * sizeof *level);
+    queue = malloc((nc + 1) * sizeof *queue);
+
+    if ((level == NULL) || (queue == NULL)) {
+        free(queue);  free(level);
+        free_adjacency(&A);
+        return 0;
+    }
+
+    for (c = 0; c < nc; c++) { level[c] = -1; }
+
+    /* 'order' doubles as the Cuthill-McKee queue, and level[c] == 0
+     * marks cells that are already numbered.  This also confines the
+     * pseudo-peripheral search to the current component. */
+    tail = 0;
+    next = 0;
+    while (tail < nc) {
+        /* Start new component from the first unnumbered cell. */
+        while (level[next] != -1) { next++; }
+
+        start = pseudo_peripheral(&A, next, level, queue);
+
+        head          = tail;
+        order[tail++] = start;
+        level[start]  = 0;
+
+        while (head < tail) {
+            c     = order[head++];
+            begin = tail;
+
+            for (i = A.pos[c]; i < A.pos[c + 1]; i++) {
+                n = A.nbr[i];
+
+                if (level[n] == -1) {
+                    level[n]      = 0;
+                    order[tail++] = n;
+                }
+            }
+
+            /* Insertion sort on degree: neighbour lists are short. */
+            for (j = begin + 1; j < tail; j++) {
+                t = order[j];
+                for (k = j; (k > begin) && (degree(&A, order[k - 1]) > degree(&A, t)); k--) {
+                    order[k] = order[k - 1];
+                }
+                order[k] = t;
+            }
+        }
+    }
+
+    /* Reverse. */
+    for (i = 0, j = nc - 1; i < j; i++, j--) {
+        t = order[i];  order[i] = order[j];  order[j] = t;
+    }
+
+    free(queue);  free(level);
+    free_adjacency(&A);
+
+    return 1;
+}
+
+
+/* ---------------------------------------------------------------------- */
+/* Hilbert index of point with 'nd' coordinates of 'b' bits each.  See   */
+/* J. Skilling, "Programming the Hilbert curve", AIP Conf. Proc. 707      */
+/* (2004).  Coordinates are overwritten.                                  */
+/* ---------------------------------------------------------------------- */
+static uint64_t
+hilbert_index(uint32_t *x, int nd, int b)
+/* ---------------------------------------------------------------------- */
+{
+    int      i, j;
+    uint32_t M, P, Q, t;
+    uint64_t h;
+
+    M = (uint32_t) 1 << (b - 1);
+
+    /* Inverse undo excess work. */
+    for (Q = M; Q > 1; Q >>= 1) {
+        P = Q - 1;
+        for (i = 0; i < nd; i++) {
+            if (x[i] & Q) {
+                x[0] ^= P;
+            }
+            else {
+                t = (x[0] ^ x[i]) & P;
+                x[0] ^= t;
+                x[i] ^= t;
+            }
+        }
+    }
+
+    /* Gray encode. */
+    for (i = 1; i < nd; i++) {
+        x[i] ^= x[i - 1];
+    }
+
+    t = 0;
+    for (Q = M; Q > 1; Q >>= 1) {
+        if (x[nd - 1] & Q) {
+            t ^= Q - 1;
+        }
+    }
+
+    for (i = 0; i < nd; i++) {
+        x[i] ^= t;
+    }
+
+    /* Interleave transposed bits, most significant first. */
+    h = 0;
+    for (j = b - 1; j >= 0; j--) {
+        for (i = 0; i < nd; i++) {
+            h = (h << 1) | ((x[i] >> j) & 1u);
+        }
+    }
+
+    return h;
+}
+
+
+struct keyed_cell {
+    uint64_t key;
+    int      cell;
+};
+
+
+/* ---------------------------------------------------------------------- */
+static int
+compare_keyed_cell(const void *a, const void *b)
+/* ---------------------------------------------------------------------- */
+{
+    const struct keyed_cell *p = a, *q = b;
+
+    if (p->key != q->key) { return (p->key < q->key) ? -1 : 1; }
+
+    return (p->cell > q->cell) - (p->cell < q->cell);
+}
+
+
+/* ---------------------------------------------------------------------- */
+int
+grid_cell_order_hilbert(const struct UnstructuredGrid *G, int *order)
+/* ---------------------------------------------------------------------- */
+{
+    int                nc, nd, c, d, b;
+    double             lo[3], hi[3], extent, scale, v;
+    uint32_t           x[3], maxint;
+    struct keyed_cell *kc;
+
+    nc = G->number_of_cells;
+    nd = G->dimensions;
+
+    if ((nd != 2) && (nd != 3)) {
+        return 0;
+    }
+
+    kc = malloc((nc + 1) * sizeof *kc);
+    if (kc == NULL) {
+        return 0;
+    }
+
+    /* Bits per coordinate, such that the index fits in 64 bits. */
+    b      = (nd == 2) ? 31 : 21;
+    maxint = ((uint32_t) 1 << b) - 1;
+
+    for (d = 0; d < nd; d++) { lo[d] = DBL_MAX;  hi[d] = -DBL_MAX; }
+
+    for (c = 0; c < nc; c++) {
+        for (d = 0; d < nd; d++) {
+            v = G->cell_centroids[nd*c + d];
+            if (v < lo[d]) { lo[d] = v; }
+            if (v > hi[d]) { hi[d] = v; }
+        }
+    }
+
+    extent = 0.0;
+    for (d = 0; d < nd; d++) {
+        if (hi[d] - lo[d] > extent) { extent = hi[d] - lo[d]; }
+    }
+    scale = (extent > 0.0) ? maxint / extent : 0.0;
+
+    for (c = 0; c < nc; c++) {
+        for (d = 0; d < nd; d++) {
+            v    = (G->cell_centroids[nd*c + d] - lo[d]) * scale;
+            x[d] = (v >= maxint) ? maxint : (uint32_t) v;
+        }
+
+        kc[c].key  = hilbert_index(x, nd, b);
+        kc[c].cell = c;
+    }
+
+    qsort(kc, nc, sizeof *kc, compare_keyed_cell);
+
+    for (c = 0; c < nc; c++) {
+        order[c] = kc[c].cell;
+    }
+
+    free(kc);
+
+    return 1;
+}
+
+
+/* ---------------------------------------------------------------------- */
+struct UnstructuredGrid *
+renumber_grid(const struct UnstructuredGrid *G,
+              const int                     *cell_order,
+              int                           *face_order)
+/* ---------------------------------------------------------------------- */
+{
+    int                      nc, nf, nd, c, oc, f, of, i, j, k, nnf, *cell_new, *face_new;
+    struct UnstructuredGrid *R;
+
+    nc = G->number_of_cells;
+    nf = G->number_of_faces;
+    nd = G->dimensions;
+
+    cell_new = malloc((nc + 1) * sizeof *cell_new);
+    face_new = malloc((nf + 1) * sizeof *face_new);
+    R        = allocate_grid(nd, nc, nf,
+                             G->face_nodepos[nf], G->cell_facepos[nc],
+                             G->number_of_nodes);
+
+    if (R != NULL) {
+        R->global_cell = malloc((nc + 1) * sizeof *R->global_cell);
+    }
+
+    if ((cell_new == NULL) || (face_new == NULL) ||
+        (R == NULL) || (R->global_cell == NULL)) {
+        destroy_grid(R);
+        free(face_new);  free(cell_new);
+        return NULL;
+    }
+
+    R->cartdims[0] = G->cartdims[0];
+    R->cartdims[1] = G->cartdims[1];
+    R->cartdims[2] = G->cartdims[2];
+
+    for (c = 0; c < nc; c++) { cell_new[cell_order[c]] = c; }
+
+    /* Number faces by first occurrence in new cell order. */
+    for (f = 0; f < nf; f++) { face_new[f] = -1; }
+
+    k = 0;
+    for (c = 0; c < nc; c++) {
+        oc = cell_order[c];
+        for (i = G->cell_facepos[oc]; i < G->cell_facepos[oc + 1]; i++) {
+            of = G->cell_faces[i];
+            if (face_new[of] < 0) {
+                face_new[of]    = k;
+                face_order[k++] = of;
+            }
+        }
+    }
+
+    /* Faces not referenced by any cell keep their relative order. */
+    for (f = 0; f < nf; f++) {
+        if (face_new[f] < 0) {
+            face_new[f]     = k;
+            face_order[k++] = f;
+        }
+    }
+    assert (k == nf);
+
+    /* Nodes are unchanged. */
+    memcpy(R->node_coordinates, G->node_coordinates,
+           nd * G->number_of_nodes * sizeof *R->node_coordinates);
+
+    /* Cells. */
+    R->cell_facepos[0] = 0;
+    for (c = 0; c < nc; c++) {
+        oc = cell_order[c];
+
+        j = R->cell_facepos[c];
+        for (i = G->cell_facepos[oc]; i < G->cell_facepos[oc + 1]; i++, j++) {
+            R->cell_faces[j] = face_new[G->cell_faces[i]];
+
+            if (G->cell_facetag != NULL) {
+                R->cell_facetag[j] = G->cell_facetag[i];
+            }
+        }
+        R->cell_facepos[c + 1] = j;
+
+        memcpy(R->cell_centroids + nd*c, G->cell_centroids + nd*oc,
+               nd * sizeof *R->cell_centroids);
+        R->cell_volumes[c] = G->cell_volumes[oc];
+
+        R->global_cell[c] = (G->global_cell != NULL) ? G->global_cell[oc] : oc;
+    }
+
+    if (G->cell_facetag == NULL) {
+        free(R->cell_facetag);
+        R->cell_facetag = NULL;
+    }
+
+    /* Faces. */
+    R->face_nodepos[0] = 0;
+    for (f = 0; f < nf; f++) {
+        of = face_order[f];
+
+        nnf = G->face_nodepos[of + 1] - G->face_nodepos[of];
+        memcpy(R->face_nodes + R->face_nodepos[f],
+               G->face_nodes + G->face_nodepos[of],
+               nnf * sizeof *R->face_nodes);
+        R->face_nodepos[f + 1] = R->face_nodepos[f] + nnf;
+
+        for (i = 0; i < 2; i++) {
+            c = G->face_cells[2*of + i];
+            R->face_cells[2*f + i] = (c >= 0) ? cell_new[c] : c;
+        }
+
+        memcpy(R->face_centroids + nd*f, G->face_centroids + nd*of,
+               nd * sizeof *R->face_centroids);
+        memcpy(R->face_normals   + nd*f, G->face_normals   + nd*of,
+               nd * sizeof *R->face_normals);
+        R->face_areas[f] = G->face_areas[of];
+    }
+
+    free(face_new);  free(cell_new);
+
+    return R;
+}
@@ -0,0 +1,98 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_GRID_RENUMBER_H_HEADER
+#define OPM_GRID_RENUMBER_H_HEADER
+
+/**
+ * \file
+ * Cell and face renumbering of UnstructuredGrid for improved memory
+ * locality.
+ *
+ * Orderings are represented as arrays mapping new indices to old, i.e.,
+ * <code>order[i]</code> is the original index of the entity that is
+ * numbered @c i after renumbering.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct UnstructuredGrid;
+
+/**
+ * Compute reverse Cuthill-McKee ordering of the cells of a grid, based
+ * on the connectivity through internal faces.  Each connected component
+ * is started from a pseudo-peripheral cell.
+ *
+ * @param[in]  G     Grid.
+ * @param[out] order Cell ordering, array of size
+ *                   <code>G->number_of_cells</code>.
+ *
+ * @return Non-zero on success, zero in case of allocation failure.
+ */
+int
+grid_cell_order_rcm(const struct UnstructuredGrid *G, int *order);
+
+
+/**
+ * Compute ordering of the cells of a grid along a Hilbert space-filling
+ * curve through the cell centroids.  The bounding box of the centroids
+ * is uniformly scaled, preserving its aspect ratio.
+ *
+ * @param[in]  G     Grid.  Must have two or three dimensions.
+ * @param[out] order Cell ordering, array of size
+ *                   <code>G->number_of_cells</code>.
+ *
+ * @return Non-zero on success, zero in case of allocation failure or
+ * unsupported dimension.
+ */
+int
+grid_cell_order_hilbert(const struct UnstructuredGrid *G, int *order);
+
+
+/**
+ * Create a renumbered copy of a grid.
+ *
+ * Faces are numbered in order of first occurrence when traversing the
+ * cells in their new order.  All cell and face arrays are permuted
+ * consistently; face orientations, the node numbering and the
+ * cell-to-face ordering within each cell are unchanged.  The resulting
+ * grid's @c global_cell maps each new cell to its logical Cartesian
+ * index, so input data indexed through @c global_cell applies directly.
+ *
+ * @param[in]  G          Grid.
+ * @param[in]  cell_order Cell ordering, a permutation of
+ *                        <code>0..G->number_of_cells-1</code>.
+ * @param[out] face_order Resulting face ordering, array of size
+ *                        <code>G->number_of_faces</code>.
+ *
+ * @return Fully formed grid structure that must be destroyed using
+ * destroy_grid().  @c NULL in case of allocation failure.
+ */
+struct UnstructuredGrid *
+renumber_grid(const struct UnstructuredGrid *G,
+              const int                     *cell_order,
+              int                           *face_order);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OPM_GRID_RENUMBER_H_HEADER */
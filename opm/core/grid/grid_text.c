@@ -0,0 +1,572 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+#include <opm/core/grid.h>
+#include <opm/core/grid/grid_text.h>
+#include <opm/core/utility/scan_double.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+#define GRID_NMETA      6
+#define GRID_NDIMS      0
+#define GRID_NCELLS     1
+#define GRID_NFACES     2
+#define GRID_NNODES     3
+#define GRID_NFACENODES 4
+#define GRID_NCELLFACES 5
+
+/* Approximate size of the parts of the file that are processed
+ * independently.  Small enough that locating a number by its index
+ * within a chunk is cheap. */
+#define GRID_TEXT_CHUNK_SIZE (1 << 16)
+
+/* Sections of the file, in order of appearance. */
+enum grid_text_section {
+    GT_NODE_COORDINATES = 0,
+    GT_FACE_NODEPOS,
+    GT_FACE_NODES,
+    GT_FACE_CELLS,
+    GT_FACE_AREAS,
+    GT_FACE_CENTROIDS,
+    GT_FACE_NORMALS,
+    GT_CELL_FACEPOS,
+    GT_CELL_FACES,
+    GT_GLOBAL_CELL,
+    GT_CELL_VOLUMES,
+    GT_CELL_CENTROIDS,
+    GT_NSECTIONS
+};
+
+/* Consecutive run of numbers stored in one or, for the interleaved
+ * cell faces and tags, two arrays.  Integer sections without a
+ * destination are parsed and discarded. */
+struct section {
+    size_t  begin;              /* Index of first number in file */
+    size_t  count;              /* Number of numbers in section  */
+    size_t  stride;             /* Number of interleaved arrays  */
+    int    *ival[2];
+    double *dval;
+};
+
+/* Part of the file that starts and ends at white space. */
+struct chunk {
+    const char *begin;
+    const char *end;
+    size_t      first;          /* Index of first number in chunk */
+    size_t      count;          /* Number of numbers in chunk     */
+};
+
+
+/* ---------------------------------------------------------------------- */
+static int
+is_space(char c)
+/* ---------------------------------------------------------------------- */
+{
+    /* ' ' or one of '\t', '\n', '\v', '\f' and '\r'. */
+    return (c == ' ') | ((unsigned char) (c - '\t') < 5);
+}
+
+
+/* ---------------------------------------------------------------------- */
+static int
+is_digit(char c)
+/* ---------------------------------------------------------------------- */
+{
+    return (c >= '0') && (c <= '9');
+}
+
+
+/* ---------------------------------------------------------------------- */
+static const char *
+skip_space(const char *p, const char *end)
+/* ---------------------------------------------------------------------- */
+{
+    while ((p != end) && is_space(*p)) { ++p; }
+
+    return p;
+}
+
+
+/* ---------------------------------------------------------------------- */
+static const char *
+skip_token(const char *p, const char *end)
+/* ---------------------------------------------------------------------- */
+{
+    while ((p != end) && ! is_space(*p)) { ++p; }
+
+    return p;
+}
+
+
+/* ---------------------------------------------------------------------- */
+static size_t
+count_tokens(const char *p, const char *end)
+/* ---------------------------------------------------------------------- */
+{
+    size_t n;
+    int    prev_space, space;
+
+    /* Branch free to let the compiler vectorise the loop. */
+    n          = 0;
+    prev_space = 1;
+    for (; p != end; ++p) {
+        space       = is_space(*p);
+        n          += prev_space & ! space;
+        prev_space  = space;
+    }
+
+    return n;
+}
+
+
+/* ---------------------------------------------------------------------- */
+/* Convert optionally signed decimal integer of magnitude at most 'max'
+ * that extends to the next white space.  Returns position after the
+ * number, or NULL if the token is anything else. */
+static const char *
+scan_integer(const char *p, const char *end,
+             unsigned long max, int allow_minus,
+             unsigned long *v, int *neg)
+/* ---------------------------------------------------------------------- */
+{
+    const char    *digits;
+    unsigned long  value;
+
+    *neg = (p != end) && (*p == '-');
+    if ((p != end) && ((*p == '-') || (*p == '+'))) { ++p; }
+
+    if (*neg && ! allow_minus) { return NULL; }
+
+    digits = p;
+    value  = 0;
+    for (; (p != end) && is_digit(*p); ++p) {
+        if (value > (max - (unsigned long) (*p - '0')) / 10) {
+            return NULL;
+        }
+        value = 10*value + (unsigned long) (*p - '0');
+    }
+
+    if ((p == digits) || ((p != end) && ! is_space(*p))) {
+        return NULL;
+    }
+
+    *v = value;
+
+    return p;
+}
+
+
+/* ---------------------------------------------------------------------- */
+static const char *
+scan_int(const char *p, const char *end, int *v)
+/* ---------------------------------------------------------------------- */
+{
+    unsigned long value;
+    int           neg;
+
+    p = scan_integer(p, end, (unsigned long) INT_MAX + 1, 1, &value, &neg);
+
+    if ((p != NULL) && ! neg && (value > (unsigned long) INT_MAX)) {
+        p = NULL;
+    }
+
+    if (p != NULL) {
+        *v = neg ? (int) (-(long) value) : (int) value;
+    }
+
+    return p;
+}
+
+
+/* ---------------------------------------------------------------------- */
+/* Read the dimensions, grid predicates and Cartesian dimensions at the
+ * start of the file.  Returns number of header tokens, or zero if the
+ * header is not in the expected form. */
+static size_t
+scan_header(const char *p, const char *end,
+            size_t dimens[GRID_NMETA],
+            int *has_tag, int *has_indexmap, int cartdims[3])
+/* ---------------------------------------------------------------------- */
+{
+    size_t        i, n;
+    unsigned long value;
+    int           neg;
+
+    n = 0;
+    for (i = 0; (p != NULL) && (i < GRID_NMETA); i++, n++) {
+        p = scan_integer(skip_space(p, end), end, ULONG_MAX, 0, &value, &neg);
+        dimens[i] = value;
+    }
+
+    if (p != NULL) { p = scan_int(skip_space(p, end), end, has_tag     ); n++; }
+    if (p != NULL) { p = scan_int(skip_space(p, end), end, has_indexmap); n++; }
+
+    if ((p != NULL) && (dimens[GRID_NDIMS] > 3)) {
+        p = NULL;
+    }
+
+    for (i = 0; (p != NULL) && (i < dimens[GRID_NDIMS]); i++, n++) {
+        p = scan_int(skip_space(p, end), end, &cartdims[i]);
+    }
+    for (; i < 3; i++) { cartdims[i] = 1; }
+
+    return (p != NULL) ? n : 0;
+}
+
+
+/* ---------------------------------------------------------------------- */
+/* Integer value of token 'idx'.  Returns zero if there is no such token
+ * or it is not an integer. */
+static int
+token_value(const struct chunk *c, size_t nchunk, size_t idx, int *v)
+/* ---------------------------------------------------------------------- */
+{
+    const char *p;
+    size_t      i, t;
+
+    for (i = 0; i < nchunk; i++) {
+        if ((c[i].first <= idx) && (idx < c[i].first + c[i].count)) {
+            p = skip_space(c[i].begin, c[i].end);
+            for (t = c[i].first; t < idx; t++) {
+                p = skip_space(skip_token(p, c[i].end), c[i].end);
+            }
+
+            return scan_int(p, c[i].end, v) != NULL;
+        }
+    }
+
+    return 0;
+}
+
+
+/* ---------------------------------------------------------------------- */
+/* Convert the numbers of a chunk that fall within the sections.
+ * Returns zero if any of them is not in a form accepted by the
+ * scanner. */
+static int
+scan_chunk(const struct chunk *c, const struct section *s, size_t nsec)
+/* ---------------------------------------------------------------------- */
+{
+    const char *p;
+    size_t      k, t, off;
+    int        *dst, v;
+
+    k = 0;
+    t = c->first;
+    while ((k < nsec) && (s[k].begin + s[k].count <= t)) { k++; }
+
+    p = skip_space(c->begin, c->end);
+    for (; (p != c->end) && (k < nsec); t++) {
+        if (t < s[k].begin) {
+            p = skip_token(p, c->end);
+        }
+        else {
+            off = t - s[k].begin;
+
+            if (s[k].dval != NULL) {
+                p = scan_double(p, c->end, &s[k].dval[off]);
+            }
+            else {
+                p   = scan_int(p, c->end, &v);
+                dst = s[k].ival[off % s[k].stride];
+
+                if ((p != NULL) && (dst != NULL)) {
+                    dst[off / s[k].stride] = v;
+                }
+            }
+
+            if (p == NULL) { return 0; }
+
+            while ((k < nsec) && (s[k].begin + s[k].count <= t + 1)) { k++; }
+        }
+
+        p = skip_space(p, c->end);
+    }
+
+    return 1;
+}
+
+
+/* ---------------------------------------------------------------------- */
+static void
+set_section(struct section *s, size_t begin, size_t count,
+            int *ival, double *dval)
+/* ---------------------------------------------------------------------- */
+{
+    s->begin   = begin;
+    s->count   = count;
+    s->stride  = 1;
+    s->ival[0] = ival;
+    s->ival[1] = NULL;
+    s->dval    = dval;
+}
+
+
+/* ---------------------------------------------------------------------- */
+/* Split the mapped file into chunks and count their numbers.  Returns
+ * the total number of numbers in the file. */
+static size_t
+split_chunks(const char *base, size_t len, struct chunk *c, size_t nchunk)
+/* ---------------------------------------------------------------------- */
+{
+    const char *end;
+    size_t      i, total;
+    int         j, n;
+
+    end = base + len;
+
+    c[0].begin = base;
+    for (i = 1; i < nchunk; i++) {
+        c[i].begin = base + (i * len) / nchunk;
+        if (c[i].begin < c[i - 1].begin) { c[i].begin = c[i - 1].begin; }
+
+        while ((c[i].begin != end) && ! is_space(*c[i].begin)) {
+            ++c[i].begin;
+        }
+        c[i - 1].end = c[i].begin;
+    }
+    c[nchunk - 1].end = end;
+
+    n = (int) nchunk;
+#pragma omp parallel for schedule(static)
+    for (j = 0; j < n; j++) {
+        c[j].count = count_tokens(c[j].begin, c[j].end);
+    }
+
+    total = 0;
+    for (i = 0; i < nchunk; i++) {
+        c[i].first  = total;
+        total      += c[i].count;
+    }
+
+    return total;
+}
+
+
+/* ---------------------------------------------------------------------- */
+static struct UnstructuredGrid *
+allocate_grid_from_header(const size_t dimens[GRID_NMETA],
+                          int has_tag, int has_indexmap,
+                          const int cartdims[3])
+/* ---------------------------------------------------------------------- */
+{
+    struct UnstructuredGrid *G;
+
+    G = allocate_grid(dimens[GRID_NDIMS]     ,
+                      dimens[GRID_NCELLS]    ,
+                      dimens[GRID_NFACES]    ,
+                      dimens[GRID_NFACENODES],
+                      dimens[GRID_NCELLFACES],
+                      dimens[GRID_NNODES]    );
+
+    if (G != NULL) {
+        if (! has_tag) {
+            free(G->cell_facetag);
+            G->cell_facetag = NULL;
+        }
+
+        if (has_indexmap) {
+            /* Global cells are discarded if this fails, as in
+             * read_grid(). */
+            G->global_cell =
+                malloc(dimens[GRID_NCELLS] * sizeof *G->global_cell);
+        }
+
+        G->number_of_cells = (int) dimens[GRID_NCELLS];
+        G->number_of_faces = (int) dimens[GRID_NFACES];
+        G->number_of_nodes = (int) dimens[GRID_NNODES];
+        G->dimensions      = (int) dimens[GRID_NDIMS];
+
+        memcpy(G->cartdims, cartdims, 3 * sizeof *cartdims);
+    }
+
+    return G;
+}
+
+
+/* ---------------------------------------------------------------------- */
+/* Parse mapped file.  Sets '*fallback' if the file should be handed to
+ * read_grid() instead, i.e. if it contains syntax that the scanner does
+ * not accept or ends prematurely. */
+static struct UnstructuredGrid *
+scan_grid(const char *base, size_t len, int *fallback)
+/* ---------------------------------------------------------------------- */
+{
+    struct UnstructuredGrid *G;
+    struct chunk            *c;
+    struct section           s[GT_NSECTIONS];
+
+    size_t dimens[GRID_NMETA], nchunk, ntok, t0, t, nd, nc, nf, nn;
+    int    has_tag, has_indexmap, cartdims[3], nfn, ncf, ok, i, n;
+
+    *fallback = 1;
+
+    t0 = scan_header(base, base + len, dimens, &has_tag, &has_indexmap, cartdims);
+    if (t0 == 0) {
+        return NULL;
+    }
+
+    nchunk = 1 + (len / GRID_TEXT_CHUNK_SIZE);
+
+    c = malloc(nchunk * sizeof *c);
+    if (c == NULL) {
+        *fallback = 0;
+        return NULL;
+    }
+
+    ntok = split_chunks(base, len, c, nchunk);
+
+    nd = dimens[GRID_NDIMS];
+    nc = dimens[GRID_NCELLS];
+    nf = dimens[GRID_NFACES];
+    nn = dimens[GRID_NNODES];
+
+    /* The number of face-nodes and cell-faces are the last entries of
+     * the respective indirection arrays. */
+    t   = t0 + nd*nn;
+    ok  = token_value(c, nchunk, t + nf, &nfn) && (nfn >= 0);
+
+    t  += (nf + 1) + nfn + 2*nf + nf + 2*nd*nf;
+    ok  = ok && token_value(c, nchunk, t + nc, &ncf) && (ncf >= 0);
+
+    /* read_grid() would write past the end of the arrays. */
+    if (ok && (((size_t) nfn > dimens[GRID_NFACENODES]) ||
+               ((size_t) ncf > dimens[GRID_NCELLFACES]))) {
+        fprintf(stderr, "Number of face-nodes or cell-faces "
+                "exceeds grid dimensions\n");
+
+        *fallback = 0;
+        ok        = 0;
+    }
+
+    G = NULL;
+    if (ok) {
+        G = allocate_grid_from_header(dimens, has_tag, has_indexmap, cartdims);
+
+        if (G == NULL) {
+            *fallback = 0;
+            ok        = 0;
+        }
+    }
+
+    if (ok) {
+        set_section(&s[GT_NODE_COORDINATES], t0, nd*nn, NULL, G->node_coordinates);
+        set_section(&s[GT_FACE_NODEPOS    ], 0 , nf + 1, G->face_nodepos, NULL);
+        set_section(&s[GT_FACE_NODES      ], 0 , nfn   , G->face_nodes  , NULL);
+        set_section(&s[GT_FACE_CELLS      ], 0 , 2*nf  , G->face_cells  , NULL);
+        set_section(&s[GT_FACE_AREAS      ], 0 , nf    , NULL, G->face_areas);
+        set_section(&s[GT_FACE_CENTROIDS  ], 0 , nd*nf , NULL, G->face_centroids);
+        set_section(&s[GT_FACE_NORMALS    ], 0 , nd*nf , NULL, G->face_normals);
+        set_section(&s[GT_CELL_FACEPOS    ], 0 , nc + 1, G->cell_facepos, NULL);
+        set_section(&s[GT_CELL_FACES      ], 0 , ncf   , G->cell_faces  , NULL);
+        set_section(&s[GT_GLOBAL_CELL     ], 0 , has_indexmap ? nc : 0,
+                    G->global_cell, NULL);
+        set_section(&s[GT_CELL_VOLUMES    ], 0 , nc    , NULL, G->cell_volumes);
+        set_section(&s[GT_CELL_CENTROIDS  ], 0 , nd*nc , NULL, G->cell_centroids);
+
+        if (has_tag) {
+            s[GT_CELL_FACES].count   = 2 * (size_t) ncf;
+            s[GT_CELL_FACES].stride  = 2;
+            s[GT_CELL_FACES].ival[1] = G->cell_facetag;
+        }
+
+        for (i = 1; i < GT_NSECTIONS; i++) {
+            s[i].begin = s[i - 1].begin + s[i - 1].count;
+        }
+
+        ok = s[GT_NSECTIONS - 1].begin + s[GT_NSECTIONS - 1].count <= ntok;
+
+        if (ok) {
+            n = (int) nchunk;
+#pragma omp parallel for schedule(static) reduction(&&:ok)
+            for (i = 0; i < n; i++) {
+                ok = scan_chunk(&c[i], s, GT_NSECTIONS) && ok;
+            }
+        }
+
+        if (! ok) {
+            destroy_grid(G);
+            G = NULL;
+        }
+    }
+
+    free(c);
+
+    return G;
+}
+
+
+/* ---------------------------------------------------------------------- */
+struct UnstructuredGrid *
+read_grid_mapped(const char *fname)
+/* ---------------------------------------------------------------------- */
+{
+    struct UnstructuredGrid *G;
+    struct stat              st;
+    void                    *base;
+    size_t                   len;
+    int                      fd, save_errno, fallback;
+
+    save_errno = errno;
+
+    fd = open(fname, O_RDONLY);
+    if (fd < 0) {
+        errno = save_errno;
+        return NULL;
+    }
+
+    base = MAP_FAILED;
+    len  = 0;
+    if ((fstat(fd, &st) == 0) && S_ISREG(st.st_mode) && (st.st_size > 0)) {
+        len  = st.st_size;
+        base = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+
+    if (base != MAP_FAILED) {
+#ifdef MADV_SEQUENTIAL
+        madvise(base, len, MADV_SEQUENTIAL);
+#endif
+        G = scan_grid(base, len, &fallback);
+
+        munmap(base, len);
+    }
+    else {
+        G        = NULL;
+        fallback = 1;
+    }
+
+    errno = save_errno;
+
+    if ((G == NULL) && fallback) {
+        G = read_grid(fname);
+    }
+
+    return G;
+}
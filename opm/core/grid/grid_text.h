@@ -0,0 +1,59 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_GRID_TEXT_H_HEADER
+#define OPM_GRID_TEXT_H_HEADER
+
+/**
+ * \file
+ * Fast reader for the character grid representation of read_grid().
+ *
+ * The file is mapped into memory and its numbers converted by a
+ * dedicated scanner directly into the grid arrays.  When built with
+ * OpenMP, large files are split into chunks that are counted and
+ * converted in parallel.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct UnstructuredGrid;
+
+/**
+ * Import a grid from a character representation stored in file.
+ *
+ * Equivalent to read_grid(), but considerably faster on large files.
+ * Files containing number syntax that the scanner does not handle
+ * itself, such as numbers not separated by white space, are passed on
+ * to read_grid().
+ *
+ * @param[in] fname File name.
+ * @return Fully formed UnstructuredGrid with all fields allocated and
+ * filled, to be released using destroy_grid().  @c NULL if the file can
+ * not be read or is not a valid grid file.
+ */
+struct UnstructuredGrid *
+read_grid_mapped(const char *fname);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OPM_GRID_TEXT_H_HEADER */
@@ -0,0 +1,225 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#include <opm/core/io/AsyncOutputWriter.hpp>
+#include <opm/core/simulator/SimulatorState.hpp>
+#include <opm/core/simulator/WellState.hpp>
+#include <opm/core/utility/ErrorMacros.hpp>
+
+#include <iostream>
+#include <typeinfo>
+
+using namespace Opm;
+
+namespace {
+
+/// Copy of the values of a timer at a given time step
+class TimerSnapshot : public SimulatorTimerInterface {
+public:
+    void assign (const SimulatorTimerInterface& timer) {
+        stepNum_ = timer.currentStepNum ();
+        reportStepNum_ = timer.reportStepNum ();
+        done_ = timer.done ();
+        // these are only defined while running, respectively after the first step
+        stepLength_ = done_ ? 0.0 : timer.currentStepLength ();
+        stepLengthTaken_ = (stepNum_ > 0) ? timer.stepLengthTaken () : 0.0;
+        reportStepLengthTaken_ = (reportStepNum_ > 0) ? timer.reportStepLengthTaken () : 0.0;
+        elapsed_ = timer.simulationTimeElapsed ();
+        start_ = timer.startDateTime ();
+        current_ = timer.currentDateTime ();
+        posixTime_ = timer.currentPosixTime ();
+    }
+
+    virtual int currentStepNum () const { return stepNum_; }
+    virtual int reportStepNum () const { return reportStepNum_; }
+    virtual double currentStepLength () const { return stepLength_; }
+    virtual double stepLengthTaken () const { return stepLengthTaken_; }
+    virtual double reportStepLengthTaken () const { return reportStepLengthTaken_; }
+    virtual double simulationTimeElapsed () const { return elapsed_; }
+    virtual bool done () const { return done_; }
+    virtual boost::posix_time::ptime startDateTime () const { return start_; }
+    virtual boost::posix_time::ptime currentDateTime () const { return current_; }
+    virtual time_t currentPosixTime () const { return posixTime_; }
+
+    virtual void advance () {
+        OPM_THROW (std::logic_error, "Cannot advance a timer snapshot");
+    }
+
+private:
+    int stepNum_;
+    int reportStepNum_;
+    bool done_;
+    double stepLength_;
+    double stepLengthTaken_;
+    double reportStepLengthTaken_;
+    double elapsed_;
+    boost::posix_time::ptime start_;
+    boost::posix_time::ptime current_;
+    time_t posixTime_;
+};
+
+} // anonymous namespace
+
+struct AsyncOutputWriter::Snapshot {
+    TimerSnapshot timer;
+    std::unique_ptr <SimulatorState> reservoirState;
+    WellState wellState;
+};
+
+AsyncOutputWriter::AsyncOutputWriter (std::unique_ptr <OutputWriter> writer,
+                                      int max_pending)
+    : writer_ (std::move (writer))
+    , max_pending_ (max_pending > 1 ? max_pending : 1)
+    , busy_ (false)
+    , stop_ (false) {
+
+    thread_ = std::thread (&AsyncOutputWriter::run, this);
+}
+
+AsyncOutputWriter::~AsyncOutputWriter () {
+    {
+        std::lock_guard <std::mutex> lock (mutex_);
+        stop_ = true;
+    }
+    cond_.notify_all ();
+    thread_.join ();
+
+    // cannot throw from a destructor; at least let the user know
+    if (error_) {
+        try {
+            std::rethrow_exception (error_);
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Asynchronous output failed: " << e.what () << std::endl;
+        }
+        catch (...) {
+            std::cerr << "Asynchronous output failed" << std::endl;
+        }
+    }
+}
+
+void
+AsyncOutputWriter::rethrowError () {
+    if (error_) {
+        std::exception_ptr error = error_;
+        error_ = std::exception_ptr ();
+        std::rethrow_exception (error);
+    }
+}
+
+void
+AsyncOutputWriter::flush () {
+    std::unique_lock <std::mutex> lock (mutex_);
+    cond_.wait (lock, [this] () { return pending_.empty () && !busy_; });
+    rethrowError ();
+}
+
+void
+AsyncOutputWriter::writeInit (const SimulatorTimerInterface& timer) {
+    flush ();
+    writer_->writeInit (timer);
+}
+
+void
+AsyncOutputWriter::writeTimeStep (const SimulatorTimerInterface& timer,
+                                  const SimulatorState& reservoirState,
+                                  const WellState& wellState) {
+    // back-pressure: wait for a free slot before copying anything
+    std::unique_ptr <Snapshot> snapshot;
+    {
+        std::unique_lock <std::mutex> lock (mutex_);
+        cond_.wait (lock, [this] () {
+                return pending_.size () + (busy_ ? 1 : 0) < max_pending_;
+            });
+        rethrowError ();
+        if (!free_.empty ()) {
+            snapshot = std::move (free_.back ());
+            free_.pop_back ();
+        }
+    }
+    if (!snapshot) {
+        snapshot.reset (new Snapshot);
+    }
+
+    SimulatorState* state = snapshot->reservoirState.get ();
+    if (state && typeid (*state) == typeid (reservoirState)) {
+        state->assign (reservoirState);
+    }
+    else {
+        snapshot->reservoirState.reset (reservoirState.clone ());
+        if (typeid (*snapshot->reservoirState) != typeid (reservoirState)) {
+            // a copy would lose information; fall back to writing directly
+            snapshot->reservoirState.reset ();
+            {
+                std::lock_guard <std::mutex> lock (mutex_);
+                free_.push_back (std::move (snapshot));
+            }
+            flush ();
+            writer_->writeTimeStep (timer, reservoirState, wellState);
+            return;
+        }
+    }
+    snapshot->timer.assign (timer);
+    snapshot->wellState = wellState;
+
+    {
+        std::lock_guard <std::mutex> lock (mutex_);
+        pending_.push_back (std::move (snapshot));
+    }
+    cond_.notify_all ();
+}
+
+void
+AsyncOutputWriter::run () {
+    for (;;) {
+        std::unique_ptr <Snapshot> snapshot;
+        {
+            std::unique_lock <std::mutex> lock (mutex_);
+            cond_.wait (lock, [this] () { return stop_ || !pending_.empty (); });
+            if (pending_.empty ()) {
+                return;
+            }
+            snapshot = std::move (pending_.front ());
+            pending_.pop_front ();
+            busy_ = true;
+        }
+
+        std::exception_ptr error;
+        try {
+            writer_->writeTimeStep (snapshot->timer,
+                                    *snapshot->reservoirState,
+                                    snapshot->wellState);
+        }
+        catch (...) {
+            error = std::current_exception ();
+        }
+
+        {
+            std::lock_guard <std::mutex> lock (mutex_);
+            if (error && !error_) {
+                error_ = error;
+            }
+            busy_ = false;
+            free_.push_back (std::move (snapshot));
+        }
+        cond_.notify_all ();
+    }
+}
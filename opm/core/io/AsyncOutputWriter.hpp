@@ -0,0 +1,105 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_ASYNC_OUTPUT_WRITER_HPP
+#define OPM_ASYNC_OUTPUT_WRITER_HPP
+
+#include <opm/core/io/OutputWriter.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>  // unique_ptr
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Opm {
+
+/*!
+ * Output writer that hands time steps to another writer in a background
+ * thread, so that the simulation can continue while they are written.
+ *
+ * writeTimeStep() copies the timer, reservoir state and well state into
+ * a snapshot and returns.  Snapshot buffers are reused between time
+ * steps.  At most a fixed number of snapshots are held; when writing
+ * falls behind, writeTimeStep() waits until a snapshot is done.
+ *
+ * An exception thrown by the wrapped writer is rethrown by the next call
+ * to writeTimeStep(), writeInit() or flush().  The destructor writes all
+ * pending snapshots before returning.
+ *
+ * The reservoir state is copied using SimulatorState::assign() into the
+ * state of a reused snapshot of the same type, else SimulatorState::clone().
+ * States of derived classes that do not override clone() are written
+ * synchronously.
+ */
+class AsyncOutputWriter : public OutputWriter {
+public:
+    /*!
+     * \param[in] writer       Writer to call in the background.
+     * \param[in] max_pending  Maximum number of snapshots being held,
+     *                         including the one being written.
+     */
+    AsyncOutputWriter (std::unique_ptr <OutputWriter> writer,
+                       int max_pending = 2);
+
+    /// Write all pending snapshots, then stop the background thread.
+    virtual ~AsyncOutputWriter ();
+
+    /// Write pending snapshots, then the static data (synchronously).
+    virtual void writeInit (const SimulatorTimerInterface& timer);
+
+    /// Queue a snapshot of the state for writing.
+    virtual void writeTimeStep (const SimulatorTimerInterface& timer,
+                                const SimulatorState& reservoirState,
+                                const WellState& wellState);
+
+    /// Wait until all pending snapshots have been written.
+    void flush ();
+
+private:
+    struct Snapshot;
+
+    /// Body of the background thread
+    void run ();
+
+    /// Rethrow error from the background thread, with mutex_ locked
+    void rethrowError ();
+
+    std::unique_ptr <OutputWriter> writer_;
+    const std::size_t max_pending_;
+
+    /// Snapshots ready for reuse
+    std::vector <std::unique_ptr <Snapshot> > free_;
+    /// Snapshots waiting to be written, oldest first
+    std::deque <std::unique_ptr <Snapshot> > pending_;
+    /// Whether the background thread is writing a snapshot
+    bool busy_;
+    bool stop_;
+    std::exception_ptr error_;
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::thread thread_;
+};
+
+} // namespace Opm
+
+#endif /* OPM_ASYNC_OUTPUT_WRITER_HPP */
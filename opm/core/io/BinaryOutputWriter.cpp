@@ -0,0 +1,396 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#include <opm/core/io/BinaryOutputWriter.hpp>
+#include <opm/core/io/StateFields.hpp>
+#include <opm/core/simulator/SimulatorState.hpp>
+#include <opm/core/simulator/WellState.hpp>
+#include <opm/core/utility/ErrorMacros.hpp>
+#include <opm/core/utility/parameters/ParameterGroup.hpp>
+
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <utility>
+
+using namespace Opm;
+
+namespace {
+
+const char            fieldFileMagic[8] = { 'O', 'P', 'M', 'F', 'I', 'E', 'L', 'D' };
+const boost::uint32_t fieldFileVersion   = 1;
+const boost::uint32_t fieldFileByteOrder = 0x01020304u;
+
+/// How the data of a field is stored in a step file
+enum FieldEncoding {
+    /// All values, as raw doubles
+    FULL      = 0,
+    /// No data; the field is identical to the one of the previous step
+    UNCHANGED = 1,
+    /// Bitwise difference to the field of the previous step, see encodeDelta()
+    DELTA     = 2
+};
+
+struct FileHeader {
+    char            magic[8];
+    boost::uint32_t version;
+    boost::uint32_t byte_order;
+    boost::int32_t  step;
+    boost::int32_t  num_fields;
+    double          simulation_time;
+};
+
+struct FieldEntry {
+    char            name[24];
+    boost::uint32_t encoding;
+    boost::uint32_t padding;
+    boost::uint64_t count;
+    boost::uint64_t checksum;
+    boost::uint64_t offset;
+    boost::uint64_t size;
+};
+
+const char* const allFields[] = {
+    "pressure", "temperature", "facepressure", "faceflux", "saturation",
+    "surfacevol", "gasoilratio", "rv",
+    "well_bhp", "well_temperature", "well_rates", "perf_rates", "perf_press"
+};
+
+using Details::FieldList;
+using Details::fieldList;
+
+inline boost::uint64_t bits (const double value) {
+    boost::uint64_t b;
+    std::memcpy (&b, &value, sizeof b);
+    return b;
+}
+
+/// FNV-1a hash of the bit patterns of the values, including their number
+boost::uint64_t checksum (const std::vector <double>& values) {
+    boost::uint64_t h = 14695981039346656037ull;
+    h = (h ^ values.size ()) * 1099511628211ull;
+    for (std::size_t i = 0; i < values.size (); ++i) {
+        h = (h ^ bits (values[i])) * 1099511628211ull;
+    }
+    return h;
+}
+
+/// Encode the bitwise difference (xor) between two equally sized
+/// arrays.  For each value, a four-bit count of the significant bytes
+/// of the difference is stored, two counts per byte, followed by those
+/// bytes of all values, least significant first.  Values that change
+/// little only differ in the low order bytes of the mantissa, so this
+/// is compact for slowly varying fields.
+void encodeDelta (const std::vector <double>& current,
+                  const std::vector <double>& previous,
+                  std::vector <unsigned char>& out) {
+    const std::size_t n = current.size ();
+    out.assign ((n + 1) / 2, 0);
+    for (std::size_t i = 0; i < n; ++i) {
+        boost::uint64_t x = bits (current[i]) ^ bits (previous[i]);
+        unsigned k = 0;
+        for (boost::uint64_t y = x; y != 0; y >>= 8) {
+            ++k;
+        }
+        out[i / 2] |= static_cast <unsigned char> (k << (4 * (i % 2)));
+        for (unsigned b = 0; b < k; ++b, x >>= 8) {
+            out.push_back (static_cast <unsigned char> (x & 0xff));
+        }
+    }
+}
+
+/// Inverse of encodeDelta(), in place on the previous values
+bool decodeDelta (const unsigned char* in, std::size_t size,
+                  std::vector <double>& values) {
+    const std::size_t n = values.size ();
+    std::size_t pos = (n + 1) / 2;
+    if (pos > size) {
+        return false;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        const unsigned k = (in[i / 2] >> (4 * (i % 2))) & 0xf;
+        if (k > 8 || pos + k > size) {
+            return false;
+        }
+        boost::uint64_t x = 0;
+        for (unsigned b = 0; b < k; ++b) {
+            x |= boost::uint64_t (in[pos++]) << (8 * b);
+        }
+        x ^= bits (values[i]);
+        std::memcpy (&values[i], &x, sizeof x);
+    }
+    return pos == size;
+}
+
+} // anonymous namespace
+
+
+
+BinaryOutputWriter::BinaryOutputWriter (const parameter::ParameterGroup& params,
+                                        std::shared_ptr <const EclipseState> /* eclipseState */,
+                                        const PhaseUsage& /* phaseUsage */,
+                                        int /* numCells */,
+                                        const int* /* compressedToCartesianCellIdx */) {
+    // name the files after the deck, if there is one
+    std::string baseName ("output");
+    if (params.has ("deck_filename")) {
+        baseName = boost::filesystem::path (params.get <std::string> ("deck_filename")).stem ().string ();
+    }
+
+    std::vector <std::string> fields;
+    const std::string selection = params.getDefault <std::string> ("output_fields", "");
+    if (!selection.empty ()) {
+        boost::split (fields, selection, boost::is_any_of (","), boost::token_compress_on);
+        for (auto& name : fields) {
+            boost::trim (name);
+        }
+        fields.erase (std::remove (fields.begin (), fields.end (), std::string ()), fields.end ());
+    }
+
+    init (params.getDefault <std::string> ("output_dir", "."),
+          baseName,
+          fields,
+          params.getDefault <bool> ("output_delta", false),
+          params.getDefault <int> ("output_keyframe_interval", 10));
+}
+
+BinaryOutputWriter::BinaryOutputWriter (const std::string& outputDir,
+                                        const std::string& baseName,
+                                        const std::vector <std::string>& fields,
+                                        bool delta,
+                                        int keyframeInterval) {
+    init (outputDir, baseName, fields, delta, keyframeInterval);
+}
+
+BinaryOutputWriter::~BinaryOutputWriter () {
+}
+
+void
+BinaryOutputWriter::init (const std::string& outputDir,
+                          const std::string& baseName,
+                          const std::vector <std::string>& fields,
+                          bool delta,
+                          int keyframeInterval) {
+    outputDir_ = outputDir;
+    baseName_ = baseName;
+    fields_ = fields;
+    delta_ = delta;
+    keyframeInterval_ = keyframeInterval;
+    writeStepIdx_ = 0;
+
+    if (keyframeInterval_ < 1) {
+        OPM_THROW (std::runtime_error, "Keyframe interval must be positive, got "
+                   << keyframeInterval_);
+    }
+    for (const auto& name : fields_) {
+        if (std::find (std::begin (allFields), std::end (allFields), name) == std::end (allFields)) {
+            OPM_THROW (std::runtime_error, "Unknown output field '" << name << "'");
+        }
+    }
+    if (!boost::filesystem::exists (outputDir_)) {
+        boost::filesystem::create_directories (outputDir_);
+    }
+}
+
+bool
+BinaryOutputWriter::selected (const std::string& name) const {
+    return fields_.empty ()
+        || std::find (fields_.begin (), fields_.end (), name) != fields_.end ();
+}
+
+void
+BinaryOutputWriter::writeInit (const SimulatorTimerInterface& /* timer */) {
+    writeStepIdx_ = 0;
+    history_.clear ();
+}
+
+void
+BinaryOutputWriter::writeTimeStep (const SimulatorTimerInterface& timer,
+                                   const SimulatorState& reservoirState,
+                                   const WellState& wellState) {
+    const bool keyframe = (writeStepIdx_ % keyframeInterval_ == 0);
+
+    FieldList fields = fieldList <FieldList> (reservoirState, wellState);
+    fields.erase (std::remove_if (fields.begin (), fields.end (),
+                                  [this] (const FieldList::value_type& f) {
+                                      return !selected (f.first);
+                                  }),
+                  fields.end ());
+
+    std::vector <FieldEntry> table (fields.size ());
+    std::vector <std::vector <unsigned char> > encoded (fields.size ());
+    boost::uint64_t pos = sizeof (FileHeader) + table.size () * sizeof (FieldEntry);
+    for (std::size_t i = 0; i < fields.size (); ++i) {
+        const std::vector <double>& values = *fields[i].second;
+        FieldEntry& entry = table[i];
+        std::memset (&entry, 0, sizeof entry);
+        std::strncpy (entry.name, fields[i].first.c_str (), sizeof entry.name - 1);
+        entry.count = values.size ();
+        entry.checksum = checksum (values);
+        entry.encoding = FULL;
+        entry.size = values.size () * sizeof (double);
+
+        auto hist = history_.find (fields[i].first);
+        if (!keyframe && hist != history_.end ()) {
+            if (hist->second.checksum == entry.checksum) {
+                entry.encoding = UNCHANGED;
+                entry.size = 0;
+            }
+            else if (delta_ && hist->second.previous.size () == values.size ()) {
+                encodeDelta (values, hist->second.previous, encoded[i]);
+                if (encoded[i].size () < entry.size) {
+                    entry.encoding = DELTA;
+                    entry.size = encoded[i].size ();
+                }
+            }
+        }
+        entry.offset = pos;
+        pos += entry.size;
+
+        FieldHistory& h = history_[fields[i].first];
+        h.checksum = entry.checksum;
+        if (delta_ && entry.encoding != UNCHANGED) {
+            h.previous = values;
+        }
+    }
+
+    FileHeader header;
+    std::memset (&header, 0, sizeof header);
+    std::memcpy (header.magic, fieldFileMagic, sizeof header.magic);
+    header.version = fieldFileVersion;
+    header.byte_order = fieldFileByteOrder;
+    header.step = writeStepIdx_;
+    header.num_fields = table.size ();
+    header.simulation_time = timer.simulationTimeElapsed ();
+
+    const std::string fname = fileName (outputDir_, baseName_, writeStepIdx_);
+    std::ofstream os (fname.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!os) {
+        OPM_THROW (std::runtime_error, "Failed to open " << fname);
+    }
+    os.write (reinterpret_cast <const char*> (&header), sizeof header);
+    os.write (reinterpret_cast <const char*> (table.data ()), table.size () * sizeof (FieldEntry));
+    for (std::size_t i = 0; i < fields.size (); ++i) {
+        if (table[i].encoding == FULL) {
+            os.write (reinterpret_cast <const char*> (fields[i].second->data ()), table[i].size);
+        }
+        else if (table[i].encoding == DELTA) {
+            os.write (reinterpret_cast <const char*> (encoded[i].data ()), table[i].size);
+        }
+    }
+    if (!os) {
+        OPM_THROW (std::runtime_error, "Failed to write " << fname);
+    }
+
+    ++writeStepIdx_;
+}
+
+std::string
+BinaryOutputWriter::fileName (const std::string& outputDir,
+                              const std::string& baseName,
+                              int step) {
+    std::ostringstream fname;
+    fname << outputDir << "/" << baseName << "-"
+          << std::setw (4) << std::setfill ('0') << step << ".opmfield";
+    return fname.str ();
+}
+
+std::vector <double>
+BinaryOutputWriter::readField (const std::string& outputDir,
+                               const std::string& baseName,
+                               int step,
+                               const std::string& name) {
+    const std::string fname = fileName (outputDir, baseName, step);
+    std::ifstream is (fname.c_str (), std::ios::in | std::ios::binary);
+    if (!is) {
+        OPM_THROW (std::runtime_error, "Failed to open " << fname);
+    }
+    const std::vector <char> contents ((std::istreambuf_iterator <char> (is)),
+                                       std::istreambuf_iterator <char> ());
+
+    FileHeader header;
+    bool valid = contents.size () >= sizeof header;
+    if (valid) {
+        std::memcpy (&header, contents.data (), sizeof header);
+        valid = std::memcmp (header.magic, fieldFileMagic, sizeof header.magic) == 0
+            && header.version == fieldFileVersion
+            && header.byte_order == fieldFileByteOrder
+            && header.num_fields >= 0
+            && sizeof header + header.num_fields * sizeof (FieldEntry) <= contents.size ();
+    }
+    if (!valid) {
+        OPM_THROW (std::runtime_error, fname << " is not a field output file of the current version");
+    }
+
+    for (int i = 0; i < header.num_fields; ++i) {
+        FieldEntry entry;
+        std::memcpy (&entry, contents.data () + sizeof header + i * sizeof entry, sizeof entry);
+        entry.name[sizeof entry.name - 1] = '\0';
+        if (name != entry.name) {
+            continue;
+        }
+        if (entry.offset > contents.size () || entry.size > contents.size () - entry.offset) {
+            OPM_THROW (std::runtime_error, "Field " << name << " of " << fname << " is truncated");
+        }
+        const char* data = contents.data () + entry.offset;
+
+        std::vector <double> values;
+        switch (entry.encoding) {
+        case FULL:
+            if (entry.size != entry.count * sizeof (double)) {
+                OPM_THROW (std::runtime_error, "Field " << name << " of " << fname << " is corrupt");
+            }
+            values.resize (entry.count);
+            std::memcpy (values.data (), data, entry.size);
+            break;
+        case UNCHANGED:
+        case DELTA:
+            if (step == 0) {
+                OPM_THROW (std::runtime_error, "Field " << name << " of " << fname
+                           << " refers to a previous step");
+            }
+            values = readField (outputDir, baseName, step - 1, name);
+            if (values.size () != entry.count
+                || (entry.encoding == DELTA
+                    && !decodeDelta (reinterpret_cast <const unsigned char*> (data),
+                                     entry.size, values))) {
+                OPM_THROW (std::runtime_error, "Field " << name << " of " << fname << " is corrupt");
+            }
+            break;
+        default:
+            OPM_THROW (std::runtime_error, "Field " << name << " of " << fname
+                       << " has unknown encoding " << entry.encoding);
+        }
+        if (checksum (values) != entry.checksum) {
+            OPM_THROW (std::runtime_error, "Checksum mismatch for field " << name << " of " << fname);
+        }
+        return values;
+    }
+    OPM_THROW (std::runtime_error, fname << " has no field " << name);
+}
@@ -0,0 +1,135 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_BINARY_OUTPUT_WRITER_HPP
+#define OPM_BINARY_OUTPUT_WRITER_HPP
+
+#include <opm/core/io/OutputWriter.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Opm {
+
+class EclipseState;
+struct PhaseUsage;
+namespace parameter { class ParameterGroup; }
+
+/*!
+ * Output writer storing selected fields of the reservoir and well state
+ * in one compact binary file per written time step.
+ *
+ * A checksum of every field is kept between time steps, and fields that
+ * have not changed since the previous step are recorded as such instead
+ * of being written again.  Optionally, changed fields are stored as the
+ * bitwise difference to the previous step, where only the bytes that
+ * differ are kept.  Every keyframe_interval steps all fields are written
+ * in full, which bounds the number of files needed to read a field.
+ *
+ * Use readField() to read back a field as it was at a given step.
+ *
+ * Configuration parameters, when created from a parameter group:
+ *  - output_binary:          Enable this writer in OutputWriter::create().
+ *  - output_dir:             Output directory (default ".").
+ *  - output_fields:          Comma-separated list of fields to write,
+ *                            default all of those listed below.
+ *  - output_delta:           Enable difference encoding (default false).
+ *  - output_keyframe_interval: Steps between full writes (default 10).
+ *
+ * Field names: pressure, temperature, facepressure, faceflux,
+ * saturation, surfacevol, gasoilratio and rv (blackoil states only),
+ * well_bhp, well_temperature, well_rates, perf_rates and perf_press.
+ */
+class BinaryOutputWriter : public OutputWriter {
+public:
+    /// Create from configuration, with the signature required by
+    /// OutputWriter::create().
+    BinaryOutputWriter (const parameter::ParameterGroup& params,
+                        std::shared_ptr <const EclipseState> eclipseState,
+                        const PhaseUsage& phaseUsage,
+                        int numCells,
+                        const int* compressedToCartesianCellIdx);
+
+    /*!
+     * \param[in] outputDir         Directory to write to.  Created if needed.
+     * \param[in] baseName          Prefix of the file names.
+     * \param[in] fields            Fields to write; all if empty.
+     * \param[in] delta             Whether to enable difference encoding.
+     * \param[in] keyframeInterval  Number of steps between full writes.
+     */
+    BinaryOutputWriter (const std::string& outputDir,
+                        const std::string& baseName,
+                        const std::vector <std::string>& fields,
+                        bool delta,
+                        int keyframeInterval);
+
+    virtual ~BinaryOutputWriter ();
+
+    /// Nothing to write; the fields are all written per time step.
+    virtual void writeInit (const SimulatorTimerInterface& timer);
+
+    virtual void writeTimeStep (const SimulatorTimerInterface& timer,
+                                const SimulatorState& reservoirState,
+                                const WellState& wellState);
+
+    /// Name of the file written for a given step.
+    static std::string fileName (const std::string& outputDir,
+                                 const std::string& baseName,
+                                 int step);
+
+    /*!
+     * Read a field as it was written at a given step, resolving
+     * unchanged and difference encoded entries through earlier steps.
+     * Throws if the files can not be read or do not contain the field.
+     */
+    static std::vector <double> readField (const std::string& outputDir,
+                                           const std::string& baseName,
+                                           int step,
+                                           const std::string& name);
+
+private:
+    struct FieldHistory {
+        boost::uint64_t checksum;
+        std::vector <double> previous;
+    };
+
+    void init (const std::string& outputDir,
+               const std::string& baseName,
+               const std::vector <std::string>& fields,
+               bool delta,
+               int keyframeInterval);
+
+    bool selected (const std::string& name) const;
+
+    std::string outputDir_;
+    std::string baseName_;
+    std::vector <std::string> fields_;
+    bool delta_;
+    int keyframeInterval_;
+    int writeStepIdx_;
+    std::map <std::string, FieldHistory> history_;
+};
+
+} // namespace Opm
+
+#endif /* OPM_BINARY_OUTPUT_WRITER_HPP */
@@ -0,0 +1,261 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#include <opm/core/io/Checkpoint.hpp>
+#include <opm/core/io/StateFields.hpp>
+#include <opm/core/simulator/BlackoilState.hpp>
+#include <opm/core/simulator/SimulatorState.hpp>
+#include <opm/core/simulator/SimulatorTimerInterface.hpp>
+#include <opm/core/simulator/WellState.hpp>
+#include <opm/core/utility/ErrorMacros.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Opm
+{
+    namespace
+    {
+        const char          checkpointMagic[8] = { 'O', 'P', 'M', 'C', 'H', 'K', 'P', 'T' };
+        const boost::uint32_t checkpointVersion   = 1;
+        const boost::uint32_t checkpointByteOrder = 0x01020304u;
+        const boost::uint64_t checkpointAlign     = 64;
+
+        struct CheckpointHeader
+        {
+            char            magic[8];
+            boost::uint32_t version;
+            boost::uint32_t byte_order;
+            boost::uint32_t double_size;
+            boost::int32_t  num_phases;
+            boost::int32_t  step_num;
+            boost::int32_t  num_fields;
+            double          simulation_time;
+        };
+
+        struct CheckpointField
+        {
+            char            name[24];
+            boost::uint64_t offset;
+            boost::uint64_t count;
+        };
+
+        using Details::FieldList;
+        using Details::MutableFieldList;
+        using Details::fieldList;
+
+        boost::uint64_t alignOffset(const boost::uint64_t off)
+        {
+            return checkpointAlign * ((off + checkpointAlign - 1) / checkpointAlign);
+        }
+    } // anonymous namespace
+
+
+
+    void writeCheckpoint(const std::string& filename,
+                         const SimulatorTimerInterface& timer,
+                         const SimulatorState& state,
+                         const WellState& wellState)
+    {
+        const FieldList fields = fieldList<FieldList>(state, wellState);
+
+        CheckpointHeader header;
+        std::memset(&header, 0, sizeof header);
+        std::memcpy(header.magic, checkpointMagic, sizeof header.magic);
+        header.version = checkpointVersion;
+        header.byte_order = checkpointByteOrder;
+        header.double_size = sizeof(double);
+        header.num_phases = state.numPhases();
+        header.step_num = timer.currentStepNum();
+        header.num_fields = fields.size();
+        header.simulation_time = timer.simulationTimeElapsed();
+
+        std::vector<CheckpointField> table(fields.size());
+        boost::uint64_t pos = alignOffset(sizeof header + table.size()*sizeof(CheckpointField));
+        for (std::size_t i = 0; i < fields.size(); ++i) {
+            std::memset(&table[i], 0, sizeof table[i]);
+            assert(fields[i].first.size() < sizeof table[i].name);
+            std::strcpy(table[i].name, fields[i].first.c_str());
+            table[i].offset = pos;
+            table[i].count = fields[i].second->size();
+            pos = alignOffset(pos + table[i].count*sizeof(double));
+        }
+
+        std::ofstream os(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!os) {
+            OPM_THROW(std::runtime_error, "Failed to open checkpoint file " << filename);
+        }
+        static const char zeros[checkpointAlign] = { 0 };
+        os.write(reinterpret_cast<const char*>(&header), sizeof header);
+        os.write(reinterpret_cast<const char*>(table.data()), table.size()*sizeof(CheckpointField));
+        pos = sizeof header + table.size()*sizeof(CheckpointField);
+        for (std::size_t i = 0; i < fields.size(); ++i) {
+            os.write(zeros, table[i].offset - pos);
+            os.write(reinterpret_cast<const char*>(fields[i].second->data()),
+                     table[i].count*sizeof(double));
+            pos = table[i].offset + table[i].count*sizeof(double);
+        }
+        if (!os) {
+            OPM_THROW(std::runtime_error, "Failed to write checkpoint file " << filename);
+        }
+    }
+
+
+
+    Checkpoint::Checkpoint(const std::string& filename)
+        : filename_(filename), base_(0), len_(0)
+    {
+        const int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            OPM_THROW(std::runtime_error, "Failed to open checkpoint file " << filename);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || std::size_t(st.st_size) < sizeof(CheckpointHeader)) {
+            ::close(fd);
+            OPM_THROW(std::runtime_error, "Checkpoint file " << filename << " is truncated");
+        }
+        len_ = st.st_size;
+        base_ = ::mmap(0, len_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (base_ == MAP_FAILED) {
+            base_ = 0;
+            OPM_THROW(std::runtime_error, "Failed to map checkpoint file " << filename);
+        }
+
+        const CheckpointHeader& header = *static_cast<const CheckpointHeader*>(base_);
+        bool valid = std::memcmp(header.magic, checkpointMagic, sizeof header.magic) == 0
+            && header.version == checkpointVersion
+            && header.byte_order == checkpointByteOrder
+            && header.double_size == sizeof(double)
+            && header.num_fields >= 0
+            && sizeof header + header.num_fields*sizeof(CheckpointField) <= len_;
+        if (valid) {
+            const CheckpointField* table = reinterpret_cast<const CheckpointField*>(&header + 1);
+            for (int i = 0; valid && i < header.num_fields; ++i) {
+                valid = table[i].offset % checkpointAlign == 0
+                    && table[i].offset <= len_
+                    && table[i].count <= (len_ - table[i].offset)/sizeof(double)
+                    && std::find(table[i].name, table[i].name + sizeof table[i].name, '\0')
+                       != table[i].name + sizeof table[i].name;
+            }
+        }
+        if (!valid) {
+            ::munmap(base_, len_);
+            base_ = 0;
+            OPM_THROW(std::runtime_error, "File " << filename
+                      << " is not a checkpoint of the current format version");
+        }
+    }
+
+
+
+    Checkpoint::~Checkpoint()
+    {
+        if (base_) {
+            ::munmap(base_, len_);
+        }
+    }
+
+
+
+    int Checkpoint::stepNum() const
+    {
+        return static_cast<const CheckpointHeader*>(base_)->step_num;
+    }
+
+
+
+    double Checkpoint::simulationTime() const
+    {
+        return static_cast<const CheckpointHeader*>(base_)->simulation_time;
+    }
+
+
+
+    int Checkpoint::numPhases() const
+    {
+        return static_cast<const CheckpointHeader*>(base_)->num_phases;
+    }
+
+
+
+    const double* Checkpoint::field(const std::string& name, std::size_t& size) const
+    {
+        const CheckpointHeader* header = static_cast<const CheckpointHeader*>(base_);
+        const CheckpointField* table = reinterpret_cast<const CheckpointField*>(header + 1);
+        for (int i = 0; i < header->num_fields; ++i) {
+            if (name == table[i].name) {
+                size = table[i].count;
+                return reinterpret_cast<const double*>(static_cast<const char*>(base_)
+                                                       + table[i].offset);
+            }
+        }
+        size = 0;
+        return 0;
+    }
+
+
+
+    void Checkpoint::restore(SimulatorState& state, WellState& wellState) const
+    {
+        if (state.numPhases() != numPhases()) {
+            OPM_THROW(std::runtime_error, "Checkpoint " << filename_ << " has " << numPhases()
+                      << " phases, state has " << state.numPhases());
+        }
+        const bool blackoil = dynamic_cast<const BlackoilState*>(&state) != 0;
+        std::size_t size;
+        if (field("surfacevol", size) && !blackoil) {
+            OPM_THROW(std::runtime_error, "Checkpoint " << filename_
+                      << " holds a blackoil state, which can only be restored to a BlackoilState");
+        }
+
+        const MutableFieldList fields = fieldList<MutableFieldList>(state, wellState);
+        for (MutableFieldList::const_iterator it = fields.begin(); it != fields.end(); ++it) {
+            const double* data = field(it->first, size);
+            if (!data) {
+                OPM_THROW(std::runtime_error, "Checkpoint " << filename_
+                          << " has no field " << it->first);
+            }
+            std::vector<double>& target = *it->second;
+            const bool well_field = it->first.compare(0, 5, "well_") == 0
+                || it->first.compare(0, 5, "perf_") == 0;
+            if (well_field) {
+                target.resize(size);
+            } else if (target.size() != size) {
+                OPM_THROW(std::runtime_error, "Field " << it->first << " of checkpoint " << filename_
+                          << " has " << size << " elements, state has " << target.size());
+            }
+            std::copy(data, data + size, target.begin());
+        }
+    }
+
+} // namespace Opm
@@ -0,0 +1,96 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_CHECKPOINT_HEADER_INCLUDED
+#define OPM_CHECKPOINT_HEADER_INCLUDED
+
+#include <boost/noncopyable.hpp>
+
+#include <cstddef>
+#include <string>
+
+namespace Opm
+{
+    class SimulatorState;
+    class SimulatorTimerInterface;
+    class WellState;
+
+    /// Write simulator and well state to a checkpoint file, from which
+    /// a simulation may later be resumed.
+    ///
+    /// The file consists of a versioned header, a table of named fields
+    /// and the raw field arrays, each starting at a 64-byte aligned
+    /// offset and stored in native byte order.  All fields of the state
+    /// are written, including those of BlackoilState if that is the
+    /// dynamic type of the state.
+    ///
+    /// \param[in] filename  File name.  Any existing file is overwritten.
+    /// \param[in] timer     Timer; its current step number and elapsed
+    ///                      time are stored with the state.
+    /// \param[in] state     Reservoir state.
+    /// \param[in] wellState Well state.
+    void writeCheckpoint(const std::string& filename,
+                         const SimulatorTimerInterface& timer,
+                         const SimulatorState& state,
+                         const WellState& wellState);
+
+
+    /// Read-only view of a checkpoint file written by writeCheckpoint().
+    /// The file is memory-mapped, so opening it is cheap regardless of
+    /// its size; data are only read from disk when restored.
+    class Checkpoint : private boost::noncopyable
+    {
+    public:
+        /// Open and validate checkpoint file.  Throws if the file can
+        /// not be opened, or is not a checkpoint of the current format
+        /// version and native data layout.
+        explicit Checkpoint(const std::string& filename);
+        ~Checkpoint();
+
+        /// Step number of the timer when the checkpoint was written.
+        int stepNum() const;
+
+        /// Elapsed simulation time when the checkpoint was written.
+        double simulationTime() const;
+
+        /// Number of phases of the stored state.
+        int numPhases() const;
+
+        /// Access a stored field.
+        /// \param[in]  name Field name, e.g. "pressure" or "well_bhp".
+        /// \param[out] size Number of elements of the field.
+        /// \return Pointer to the field data, or null if there is no
+        ///         field of that name.
+        const double* field(const std::string& name, std::size_t& size) const;
+
+        /// Restore simulator and well state.  The state must already be
+        /// initialised for the grid and number of phases of the stored
+        /// state, which are checked against the stored field sizes.  The
+        /// well state is resized to match the stored one.
+        void restore(SimulatorState& state, WellState& wellState) const;
+
+    private:
+        std::string filename_;
+        void* base_;
+        std::size_t len_;
+    };
+
+} // namespace Opm
+
+#endif // OPM_CHECKPOINT_HEADER_INCLUDED
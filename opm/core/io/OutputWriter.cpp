@@ -1,6 +1,8 @@
 #include "OutputWriter.hpp"
 
 #include <opm/core/grid.h>
+#include <opm/core/io/BinaryOutputWriter.hpp>
+#include <opm/core/io/SummaryOutputWriter.hpp>
 #include <opm/core/io/eclipse/EclipseWriter.hpp>
 #include <opm/core/utility/parameters/Parameter.hpp>
 #include <opm/core/utility/parameters/ParameterGroup.hpp>
@@ -70,6 +72,8 @@ typedef map <const char*, unique_ptr <OutputWriter> (*)(
         std::shared_ptr <const UnstructuredGrid>)> map_t;
 map_t FORMATS = {
     { "output_ecl", &create <EclipseWriter> },
+    { "output_binary", &create <BinaryOutputWriter> },
+    { "output_summary", &create <SummaryOutputWriter> },
 };
 
 } // anonymous namespace
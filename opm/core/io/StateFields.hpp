@@ -0,0 +1,71 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef OPM_STATEFIELDS_HEADER_INCLUDED
+#define OPM_STATEFIELDS_HEADER_INCLUDED
+
+#include <opm/core/simulator/BlackoilState.hpp>
+#include <opm/core/simulator/SimulatorState.hpp>
+#include <opm/core/simulator/WellState.hpp>
+
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Internal to the writers of opm/core/io; not installed.
+
+namespace Opm
+{
+    namespace Details
+    {
+        typedef std::vector< std::pair<std::string, const std::vector<double>*> > FieldList;
+        typedef std::vector< std::pair<std::string, std::vector<double>*> > MutableFieldList;
+
+        /// All fields of a reservoir and well state, named as in the
+        /// files of Checkpoint and BinaryOutputWriter.  Fields is
+        /// FieldList for const states, MutableFieldList otherwise.
+        template <class Fields, class State, class Wells>
+        Fields fieldList(State& state, Wells& wellState)
+        {
+            typedef typename std::conditional<std::is_const<State>::value,
+                                              const BlackoilState, BlackoilState>::type Blackoil;
+            Fields fields;
+            fields.push_back(std::make_pair("pressure", &state.pressure()));
+            fields.push_back(std::make_pair("temperature", &state.temperature()));
+            fields.push_back(std::make_pair("facepressure", &state.facepressure()));
+            fields.push_back(std::make_pair("faceflux", &state.faceflux()));
+            fields.push_back(std::make_pair("saturation", &state.saturation()));
+            if (Blackoil* bstate = dynamic_cast<Blackoil*>(&state)) {
+                fields.push_back(std::make_pair("surfacevol", &bstate->surfacevol()));
+                fields.push_back(std::make_pair("gasoilratio", &bstate->gasoilratio()));
+                fields.push_back(std::make_pair("rv", &bstate->rv()));
+            }
+            fields.push_back(std::make_pair("well_bhp", &wellState.bhp()));
+            fields.push_back(std::make_pair("well_temperature", &wellState.temperature()));
+            fields.push_back(std::make_pair("well_rates", &wellState.wellRates()));
+            fields.push_back(std::make_pair("perf_rates", &wellState.perfRates()));
+            fields.push_back(std::make_pair("perf_press", &wellState.perfPress()));
+            return fields;
+        }
+    } // namespace Details
+} // namespace Opm
+
+#endif // OPM_STATEFIELDS_HEADER_INCLUDED
@@ -0,0 +1,456 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#include <opm/core/io/SummaryOutputWriter.hpp>
+#include <opm/core/simulator/WellState.hpp>
+#include <opm/core/utility/ErrorMacros.hpp>
+#include <opm/core/utility/parameters/ParameterGroup.hpp>
+
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Well.hpp>
+
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <sstream>
+
+using namespace Opm;
+
+namespace {
+
+const char            summaryFileMagic[8] = { 'O', 'P', 'M', 'S', 'U', 'M', 'R', 'Y' };
+const boost::uint32_t summaryFileVersion   = 1;
+const boost::uint32_t summaryFileByteOrder = 0x01020304u;
+
+struct FileHeader {
+    char            magic[8];
+    boost::uint32_t version;
+    boost::uint32_t byte_order;
+    boost::uint64_t num_rows;
+    boost::uint64_t num_columns;
+};
+
+/// Vectors, without the leading W or F, in the order of phase (as in
+/// BlackoilPhases::PhaseIndex), production before injection and rate
+/// before total.  The bottom hole pressure only exists for wells.
+const int numRateVectors = 12;
+const int numVectors = numRateVectors + 1;
+const int bhpVector = numRateVectors;
+
+std::string vectorName (char prefix, int vector) {
+    if (vector == bhpVector) {
+        return std::string (1, prefix) + "BHP";
+    }
+    std::string name (1, prefix);
+    name += "WOG"[vector / 4];
+    name += "PI"[(vector / 2) % 2];
+    name += "RT"[vector % 2];
+    return name;
+}
+
+inline void add (std::vector <double>& values, double amount) {
+    values.back () += amount;
+}
+
+} // anonymous namespace
+
+
+
+SummaryOutputWriter::SummaryOutputWriter (const parameter::ParameterGroup& params,
+                                          std::shared_ptr <const EclipseState> eclipseState,
+                                          const PhaseUsage& phaseUsage,
+                                          int /* numCells */,
+                                          const int* /* compressedToCartesianCellIdx */) {
+    // name the file after the deck, if there is one
+    std::string baseName ("output");
+    if (params.has ("deck_filename")) {
+        baseName = boost::filesystem::path (params.get <std::string> ("deck_filename")).stem ().string ();
+    }
+
+    std::vector <std::string> vectors;
+    const std::string selection = params.getDefault <std::string> ("output_summary_vectors", "");
+    if (!selection.empty ()) {
+        boost::split (vectors, selection, boost::is_any_of (","), boost::token_compress_on);
+        for (auto& name : vectors) {
+            boost::trim (name);
+        }
+        vectors.erase (std::remove (vectors.begin (), vectors.end (), std::string ()), vectors.end ());
+    }
+
+    const std::string format = params.getDefault <std::string> ("output_summary_format", "csv");
+    if (format != "csv" && format != "binary") {
+        OPM_THROW (std::runtime_error, "Unknown summary output format '" << format
+                   << "', expected csv or binary");
+    }
+
+    eclipseState_ = eclipseState;
+    init (params.getDefault <std::string> ("output_dir", "."),
+          baseName,
+          phaseUsage,
+          vectors,
+          format == "csv" ? CSV : BINARY,
+          std::vector <std::string> ());
+}
+
+SummaryOutputWriter::SummaryOutputWriter (const std::string& outputDir,
+                                          const std::string& baseName,
+                                          const PhaseUsage& phaseUsage,
+                                          const std::vector <std::string>& vectors,
+                                          Format format,
+                                          const std::vector <std::string>& wellNames) {
+    init (outputDir, baseName, phaseUsage, vectors, format, wellNames);
+}
+
+SummaryOutputWriter::~SummaryOutputWriter () {
+    // cannot throw from a destructor; at least let the user know
+    if (!written_) {
+        try {
+            writeFile ();
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Summary output failed: " << e.what () << std::endl;
+        }
+        catch (...) {
+            std::cerr << "Summary output failed" << std::endl;
+        }
+    }
+}
+
+void
+SummaryOutputWriter::init (const std::string& outputDir,
+                           const std::string& baseName,
+                           const PhaseUsage& phaseUsage,
+                           const std::vector <std::string>& vectors,
+                           Format format,
+                           const std::vector <std::string>& wellNames) {
+    outputDir_ = outputDir;
+    baseName_ = baseName;
+    phaseUsage_ = phaseUsage;
+    format_ = format;
+    wellNames_ = wellNames;
+    namesReportStep_ = -1;
+
+    wellSelected_.assign (numVectors, vectors.empty ());
+    fieldSelected_.assign (numRateVectors, vectors.empty ());
+    for (const auto& name : vectors) {
+        bool found = false;
+        for (int v = 0; v < numVectors; ++v) {
+            if (name == vectorName ('W', v)) {
+                wellSelected_[v] = found = true;
+            }
+            if (v != bhpVector && name == vectorName ('F', v)) {
+                fieldSelected_[v] = found = true;
+            }
+        }
+        if (!found) {
+            OPM_THROW (std::runtime_error, "Unknown summary vector '" << name << "'");
+        }
+    }
+
+    if (!boost::filesystem::exists (outputDir_)) {
+        boost::filesystem::create_directories (outputDir_);
+    }
+
+    reset ();
+}
+
+void
+SummaryOutputWriter::reset () {
+    columns_.clear ();
+    columnIdx_.clear ();
+    wellColumns_.clear ();
+    written_ = true;
+
+    column ("TIME", false);
+
+    fieldColumns_.assign (numRateVectors, -1);
+    for (int v = 0; v < numRateVectors; ++v) {
+        if (fieldSelected_[v] && phaseUsage_.phase_used[v / 4]) {
+            fieldColumns_[v] = column (vectorName ('F', v), v % 2 == 1);
+        }
+    }
+}
+
+int
+SummaryOutputWriter::column (const std::string& name, bool cumulative) {
+    auto it = columnIdx_.find (name);
+    if (it != columnIdx_.end ()) {
+        return it->second;
+    }
+
+    // vectors of wells that appear later are zero until then
+    Column col;
+    col.name = name;
+    col.cumulative = cumulative;
+    if (!columns_.empty ()) {
+        col.values.assign (columns_.front ().values.size (), 0.0);
+    }
+    columns_.push_back (col);
+    columnIdx_[name] = columns_.size () - 1;
+    return columns_.size () - 1;
+}
+
+const std::vector <int>&
+SummaryOutputWriter::wellColumns (const std::string& wellName) {
+    auto it = wellColumns_.find (wellName);
+    if (it == wellColumns_.end ()) {
+        std::vector <int> cols (numVectors, -1);
+        for (int v = 0; v < numVectors; ++v) {
+            if (wellSelected_[v] && (v == bhpVector || phaseUsage_.phase_used[v / 4])) {
+                cols[v] = column (vectorName ('W', v) + ":" + wellName,
+                                  v != bhpVector && v % 2 == 1);
+            }
+        }
+        it = wellColumns_.insert (std::make_pair (wellName, cols)).first;
+    }
+    return it->second;
+}
+
+const std::vector <std::string>&
+SummaryOutputWriter::wellNames (int reportStep, int numWells) {
+    // the well state holds the wells of the schedule that are not shut,
+    // in the order of the schedule
+    if (eclipseState_ && reportStep != namesReportStep_) {
+        const auto& wells = eclipseState_->getSchedule ()->getWells (reportStep);
+        wellNames_.clear ();
+        for (const auto& well : wells) {
+            if (well->getStatus (reportStep) != WellCommon::SHUT) {
+                wellNames_.push_back (well->name ());
+            }
+        }
+        namesReportStep_ = reportStep;
+    }
+
+    if (int (wellNames_.size ()) < numWells) {
+        if (eclipseState_) {
+            OPM_THROW (std::runtime_error, "Well state has " << numWells
+                       << " wells, but the schedule only " << wellNames_.size ()
+                       << " open wells at report step " << reportStep);
+        }
+        for (int w = wellNames_.size (); w < numWells; ++w) {
+            std::ostringstream name;
+            name << 'W' << (w + 1);
+            wellNames_.push_back (name.str ());
+        }
+    }
+    return wellNames_;
+}
+
+void
+SummaryOutputWriter::writeInit (const SimulatorTimerInterface& /* timer */) {
+    reset ();
+}
+
+void
+SummaryOutputWriter::writeTimeStep (const SimulatorTimerInterface& timer,
+                                    const SimulatorState& /* reservoirState */,
+                                    const WellState& wellState) {
+    // the first step is the initial state; nothing produced yet
+    const bool initial = columns_.front ().values.empty ();
+    const double dt = initial ? 0.0 : timer.stepLengthTaken ();
+
+    // start a new row, carrying the totals forward
+    for (auto& col : columns_) {
+        const double start = (col.cumulative && !col.values.empty ()) ? col.values.back () : 0.0;
+        col.values.push_back (start);
+    }
+    columns_.front ().values.back () = timer.simulationTimeElapsed ();
+
+    const int numPhases = phaseUsage_.num_phases;
+    const int numWells = wellState.bhp ().size ();
+    const std::vector <std::string>& names = wellNames (timer.reportStepNum (), numWells);
+    const std::vector <double>& rates = wellState.wellRates ();
+    const bool haveRates = int (rates.size ()) >= numWells * numPhases;
+
+    for (int w = 0; w < numWells; ++w) {
+        const std::vector <int>& cols = wellColumns (names[w]);
+        if (cols[bhpVector] >= 0) {
+            columns_[cols[bhpVector]].values.back () = wellState.bhp ()[w];
+        }
+        if (!haveRates) {
+            continue;
+        }
+        for (int phase = 0; phase < BlackoilPhases::MaxNumPhases; ++phase) {
+            if (!phaseUsage_.phase_used[phase]) {
+                continue;
+            }
+            // producers have negative rates
+            const double q = rates[w * numPhases + phaseUsage_.phase_pos[phase]];
+            const double amount[2] = { std::max (-q, 0.0), std::max (q, 0.0) };
+            for (int v = 4 * phase; v < 4 * phase + 4; ++v) {
+                // rate, or its integral over the step for totals
+                const double value = amount[(v / 2) % 2] * ((v % 2 == 1) ? dt : 1.0);
+                if (cols[v] >= 0) {
+                    add (columns_[cols[v]].values, value);
+                }
+                if (fieldColumns_[v] >= 0) {
+                    add (columns_[fieldColumns_[v]].values, value);
+                }
+            }
+        }
+    }
+
+    written_ = false;
+}
+
+void
+SummaryOutputWriter::writeFile () {
+    const std::string fname = fileName (outputDir_, baseName_, format_);
+    const std::size_t numRows = columns_.front ().values.size ();
+
+    if (format_ == CSV) {
+        std::ofstream os (fname.c_str (), std::ios::out | std::ios::trunc);
+        if (!os) {
+            OPM_THROW (std::runtime_error, "Failed to open " << fname);
+        }
+        os.precision (std::numeric_limits <double>::digits10 + 2);
+        for (std::size_t c = 0; c < columns_.size (); ++c) {
+            os << (c > 0 ? "," : "") << columns_[c].name;
+        }
+        os << '\n';
+        for (std::size_t r = 0; r < numRows; ++r) {
+            for (std::size_t c = 0; c < columns_.size (); ++c) {
+                os << (c > 0 ? "," : "") << columns_[c].values[r];
+            }
+            os << '\n';
+        }
+        if (!os) {
+            OPM_THROW (std::runtime_error, "Failed to write " << fname);
+        }
+    }
+    else {
+        std::ofstream os (fname.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!os) {
+            OPM_THROW (std::runtime_error, "Failed to open " << fname);
+        }
+        FileHeader header;
+        std::memset (&header, 0, sizeof header);
+        std::memcpy (header.magic, summaryFileMagic, sizeof header.magic);
+        header.version = summaryFileVersion;
+        header.byte_order = summaryFileByteOrder;
+        header.num_rows = numRows;
+        header.num_columns = columns_.size ();
+        os.write (reinterpret_cast <const char*> (&header), sizeof header);
+        for (const auto& col : columns_) {
+            const boost::uint32_t len = col.name.size ();
+            os.write (reinterpret_cast <const char*> (&len), sizeof len);
+            os.write (col.name.data (), len);
+        }
+        // one contiguous array per vector
+        for (const auto& col : columns_) {
+            os.write (reinterpret_cast <const char*> (col.values.data ()),
+                      numRows * sizeof (double));
+        }
+        if (!os) {
+            OPM_THROW (std::runtime_error, "Failed to write " << fname);
+        }
+    }
+
+    written_ = true;
+}
+
+std::vector <std::string>
+SummaryOutputWriter::vectorNames () const {
+    std::vector <std::string> names;
+    for (const auto& col : columns_) {
+        names.push_back (col.name);
+    }
+    return names;
+}
+
+const std::vector <double>&
+SummaryOutputWriter::vector (const std::string& name) const {
+    auto it = columnIdx_.find (name);
+    if (it == columnIdx_.end ()) {
+        OPM_THROW (std::runtime_error, "No summary vector " << name);
+    }
+    return columns_[it->second].values;
+}
+
+std::string
+SummaryOutputWriter::fileName (const std::string& outputDir,
+                               const std::string& baseName,
+                               Format format) {
+    return outputDir + "/" + baseName + (format == CSV ? ".csv" : ".opmsummary");
+}
+
+std::map <std::string, std::vector <double> >
+SummaryOutputWriter::readBinary (const std::string& fname) {
+    std::ifstream is (fname.c_str (), std::ios::in | std::ios::binary);
+    if (!is) {
+        OPM_THROW (std::runtime_error, "Failed to open " << fname);
+    }
+    const std::vector <char> contents ((std::istreambuf_iterator <char> (is)),
+                                       std::istreambuf_iterator <char> ());
+
+    FileHeader header;
+    bool valid = contents.size () >= sizeof header;
+    if (valid) {
+        std::memcpy (&header, contents.data (), sizeof header);
+        valid = std::memcmp (header.magic, summaryFileMagic, sizeof header.magic) == 0
+            && header.version == summaryFileVersion
+            && header.byte_order == summaryFileByteOrder;
+    }
+    if (!valid) {
+        OPM_THROW (std::runtime_error, fname << " is not a summary file of the current version");
+    }
+
+    std::size_t pos = sizeof header;
+    std::vector <std::string> names;
+    for (boost::uint64_t c = 0; c < header.num_columns; ++c) {
+        boost::uint32_t len;
+        if (pos + sizeof len > contents.size ()) {
+            OPM_THROW (std::runtime_error, fname << " is truncated");
+        }
+        std::memcpy (&len, contents.data () + pos, sizeof len);
+        pos += sizeof len;
+        if (len > contents.size () - pos) {
+            OPM_THROW (std::runtime_error, fname << " is truncated");
+        }
+        names.push_back (std::string (contents.data () + pos, len));
+        pos += len;
+    }
+
+    const std::size_t size = header.num_rows * sizeof (double);
+    if (header.num_rows > contents.size () / sizeof (double)
+        || (contents.size () - pos) != names.size () * size) {
+        OPM_THROW (std::runtime_error, fname << " is truncated or corrupt");
+    }
+
+    std::map <std::string, std::vector <double> > vectors;
+    for (const auto& name : names) {
+        std::vector <double>& values = vectors[name];
+        values.resize (header.num_rows);
+        std::memcpy (values.data (), contents.data () + pos, size);
+        pos += size;
+    }
+    return vectors;
+}
@@ -0,0 +1,166 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_SUMMARY_OUTPUT_WRITER_HPP
+#define OPM_SUMMARY_OUTPUT_WRITER_HPP
+
+#include <opm/core/io/OutputWriter.hpp>
+#include <opm/core/props/BlackoilPhases.hpp>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Opm {
+
+class EclipseState;
+namespace parameter { class ParameterGroup; }
+
+/*!
+ * Output writer that only records well and field production data, for
+ * use where the reservoir state is not needed, e.g. in optimization
+ * loops.
+ *
+ * Each call to writeTimeStep() appends one value to every summary
+ * vector, which are held in memory as columns.  The vectors are written
+ * to a single file by writeFile(), or by the destructor if that has not
+ * been done.  No grid, restart or reservoir state data is written.
+ *
+ * Vectors are named as in Eclipse summary files, e.g. FOPR for the field
+ * oil production rate and WBHP:PROD for the bottom hole pressure of the
+ * well PROD.  Available are the well (W) and field (F) vectors
+ * {W,F}{O,W,G}{P,I}{R,T} and WBHP, for the phases in use.  Whether a
+ * well produces or injects a phase is determined by the sign of its
+ * rate.  The TIME vector is the elapsed simulation time.  All values are
+ * in SI units.  As for EclipseWriter, the first time step written is
+ * taken to be the initial state, which does not add to the totals.
+ *
+ * Configuration parameters, when created from a parameter group:
+ *  - output_summary:         Enable this writer in OutputWriter::create().
+ *  - output_dir:             Output directory (default ".").
+ *  - output_summary_vectors: Comma-separated list of vectors to record,
+ *                            e.g. "FOPR,FOPT,WBHP", default all.
+ *  - output_summary_format:  "csv" (default) or "binary".
+ *
+ * Well names are taken from the schedule of the deck, if there is one,
+ * and are W1, W2, ... by the index in the well state otherwise.
+ */
+class SummaryOutputWriter : public OutputWriter {
+public:
+    enum Format { CSV, BINARY };
+
+    /// Create from configuration, with the signature required by
+    /// OutputWriter::create().
+    SummaryOutputWriter (const parameter::ParameterGroup& params,
+                         std::shared_ptr <const EclipseState> eclipseState,
+                         const PhaseUsage& phaseUsage,
+                         int numCells,
+                         const int* compressedToCartesianCellIdx);
+
+    /*!
+     * \param[in] outputDir   Directory to write to.  Created if needed.
+     * \param[in] baseName    Name of the file, without extension.
+     * \param[in] phaseUsage  Phases of the well rates.
+     * \param[in] vectors     Vectors to record, e.g. "FOPR"; all if empty.
+     * \param[in] format      Format of the file.
+     * \param[in] wellNames   Name of each well in the well state; W1,
+     *                        W2, ... if empty.
+     */
+    SummaryOutputWriter (const std::string& outputDir,
+                         const std::string& baseName,
+                         const PhaseUsage& phaseUsage,
+                         const std::vector <std::string>& vectors,
+                         Format format,
+                         const std::vector <std::string>& wellNames = std::vector <std::string> ());
+
+    /// Write the file, unless that has been done since the last time step.
+    virtual ~SummaryOutputWriter ();
+
+    /// Start a new series of vectors.
+    virtual void writeInit (const SimulatorTimerInterface& timer);
+
+    /// Record the well data of the time step; the reservoir state is not used.
+    virtual void writeTimeStep (const SimulatorTimerInterface& timer,
+                                const SimulatorState& reservoirState,
+                                const WellState& wellState);
+
+    /// Write all vectors recorded so far.
+    void writeFile ();
+
+    /// Names of the vectors recorded so far, starting with TIME.
+    std::vector <std::string> vectorNames () const;
+
+    /// Values of a vector.  Throws if there is no such vector.
+    const std::vector <double>& vector (const std::string& name) const;
+
+    /// Name of the file written.
+    static std::string fileName (const std::string& outputDir,
+                                 const std::string& baseName,
+                                 Format format);
+
+    /// Read the vectors from a file in binary format.
+    static std::map <std::string, std::vector <double> >
+    readBinary (const std::string& fname);
+
+private:
+    struct Column {
+        std::string name;
+        bool cumulative;
+        std::vector <double> values;
+    };
+
+    void init (const std::string& outputDir,
+               const std::string& baseName,
+               const PhaseUsage& phaseUsage,
+               const std::vector <std::string>& vectors,
+               Format format,
+               const std::vector <std::string>& wellNames);
+
+    /// Drop all vectors, leaving TIME and the field vectors empty
+    void reset ();
+
+    int column (const std::string& name, bool cumulative);
+    const std::vector <int>& wellColumns (const std::string& wellName);
+    const std::vector <std::string>& wellNames (int reportStep, int numWells);
+
+    std::string outputDir_;
+    std::string baseName_;
+    PhaseUsage phaseUsage_;
+    Format format_;
+    std::vector <bool> wellSelected_;
+    std::vector <bool> fieldSelected_;
+    std::shared_ptr <const EclipseState> eclipseState_;
+
+    /// Well names given to the constructor, or of the schedule at the
+    /// report step namesReportStep_
+    std::vector <std::string> wellNames_;
+    int namesReportStep_;
+
+    std::vector <Column> columns_;
+    std::map <std::string, int> columnIdx_;
+    /// column of each vector of a well, or -1 if not recorded
+    std::map <std::string, std::vector <int> > wellColumns_;
+    std::vector <int> fieldColumns_;
+    bool written_;
+};
+
+} // namespace Opm
+
+#endif /* OPM_SUMMARY_OUTPUT_WRITER_HPP */
@@ -116,6 +116,31 @@ void extractFromStripedData(std::vector<double> &data,
     data.resize(tmpIdx);
 }
 
+// gather one component of striped cell data into the Cartesian order of
+// eclipse and convert it from SI units, all in a single pass. The gather
+// plan maps each eclipse cell to the simulator's cell index; the target
+// buffer is resized as needed and can be reused between calls.
+void gatherToEclipseOrder(const std::vector<double> &data,
+                          int offset,
+                          int stride,
+                          double toSiConversionFactor,
+                          const std::vector<int> &gatherPlan,
+                          std::vector<float> &target)
+{
+    const int numCells = gatherPlan.size();
+    assert(data.size() >= size_t(numCells)*stride);
+    target.resize(numCells);
+
+    const double* src = data.data() + offset;
+    const int* plan = gatherPlan.data();
+    float* dst = target.data();
+#pragma omp parallel for schedule(static) if (numCells > 10000)
+    for (int i = 0; i < numCells; ++i) {
+        dst[i] = static_cast<float>(unit::convert::to(src[plan[i]*stride],
+                                                      toSiConversionFactor));
+    }
+}
+
 /// Convert OPM phase usage to ERT bitmask
 int ertPhaseMask(const PhaseUsage uses)
 {
@@ -143,7 +168,13 @@ public:
         : ertHandle_(0)
     { set(name, data); }
 
-    /// Initialization from double-precision array.
+    /// Initialization from single-precision array.
+    Keyword(const std::string& name,
+            const std::vector<float>& data)
+        : ertHandle_(0)
+    { set(name, data); }
+
+    /// Initialization from integer array.
     Keyword(const std::string& name,
             const std::vector<int>& data)
         : ertHandle_(0)
@@ -268,8 +299,8 @@ public:
      * completion in the eclipse restart file ICON data array.These numbers are
      * written to the INTEHEAD header.
 
-     * The elements are added in the method addRestartFileIwelData(...) and and
-     * addRestartFileIconData(...), respectively.  We write as many elements
+     * The elements are added in the methods WellLayout::addIwelData(...) and
+     * WellLayout::addIconData(...), respectively.  We write as many elements
      * that we need to be able to view the restart file in Resinsight.  The
      * restart file will not be possible to restart from with Eclipse, we write
      * to little information to be able to do this.
@@ -303,49 +334,6 @@ public:
     { ecl_rst_file_add_kw(restartFileHandle_, kw.ertHandle()); }
 
 
-    void addRestartFileIwelData(std::vector<int>& iwel_data, size_t currentStep , WellConstPtr well, size_t offset) const {
-        CompletionSetConstPtr completions = well->getCompletions( currentStep );
-
-        iwel_data[ offset + IWEL_HEADI_ITEM ] = well->getHeadI() + 1;
-        iwel_data[ offset + IWEL_HEADJ_ITEM ] = well->getHeadJ() + 1;
-        iwel_data[ offset + IWEL_CONNECTIONS_ITEM ] = completions->size();
-        iwel_data[ offset + IWEL_GROUP_ITEM ] = 1;
-
-        {
-            WellType welltype = well->isProducer(currentStep) ? PRODUCER : INJECTOR;
-            int ert_welltype = EclipseWriter::eclipseWellTypeMask(welltype, well->getInjectionProperties(currentStep).injectorType);
-            iwel_data[ offset + IWEL_TYPE_ITEM ] = ert_welltype;
-        }
-
-        iwel_data[ offset + IWEL_STATUS_ITEM ] = EclipseWriter::eclipseWellStatusMask(well->getStatus(currentStep));
-    }
-
-
-
-
-    void addRestartFileIconData(std::vector<int>& icon_data, CompletionSetConstPtr completions , size_t wellICONOffset) const {
-        for (size_t i = 0; i < completions->size(); ++i) {
-            CompletionConstPtr completion = completions->get(i);
-            size_t iconOffset = wellICONOffset + i * Opm::EclipseWriterDetails::Restart::NICONZ;
-            icon_data[ iconOffset + ICON_IC_ITEM] = 1;
-
-            icon_data[ iconOffset + ICON_I_ITEM] = completion->getI() + 1;
-            icon_data[ iconOffset + ICON_J_ITEM] = completion->getJ() + 1;
-            icon_data[ iconOffset + ICON_K_ITEM] = completion->getK() + 1;
-
-            {
-                WellCompletion::StateEnum completion_state = completion->getState();
-                if (completion_state == WellCompletion::StateEnum::OPEN) {
-                    icon_data[ iconOffset + ICON_STATUS_ITEM ] = 1;
-                } else {
-                    icon_data[ iconOffset + ICON_STATUS_ITEM ] = 0;
-                }
-            }
-            icon_data[ iconOffset + ICON_DIRECTION_ITEM] = (int)completion->getDirection();
-        }
-    }
-
-
     ~Restart()
     {
         free(restartFileName_);
@@ -371,6 +359,134 @@ private:
     ecl_rst_file_type *restartFileHandle_;
 };
 
+/**
+ * The well and connection arrays of the restart file (IWEL, ZWEL and
+ * ICON) for a report step. They only depend on which wells exist, on
+ * their completions, status and type, so they are kept between report
+ * steps and only rebuilt when one of these changes in the schedule.
+ */
+class WellLayout : private boost::noncopyable
+{
+public:
+    WellLayout()
+        : ncwmax_(0)
+    {}
+
+    /// Bring the arrays up to date with the schedule at a report step.
+    /// Returns true if they had to be rebuilt.
+    bool update(Opm::ScheduleConstPtr schedule, size_t reportStep)
+    {
+        const std::vector<WellConstPtr> wells = schedule->getWells(reportStep);
+
+        std::vector<WellSignature> signature(wells.size());
+        for (size_t iwell = 0; iwell < wells.size(); ++iwell) {
+            WellSignature& sig = signature[iwell];
+            sig.well = wells[iwell];
+            sig.completions = wells[iwell]->getCompletions(reportStep);
+            sig.status = wells[iwell]->getStatus(reportStep);
+            sig.producer = wells[iwell]->isProducer(reportStep);
+            sig.injectorType = wells[iwell]->getInjectionProperties(reportStep).injectorType;
+        }
+        if (!iwel_.empty() && signature == signature_) {
+            return false;
+        }
+        signature_.swap(signature);
+
+        const size_t numWells = wells.size();
+        ncwmax_ = schedule->getMaxNumCompletionsForWells(reportStep);
+        zwel_.assign(numWells * Restart::NZWELZ, "");
+        iwel_.assign(numWells * Restart::NIWELZ, 0);
+        icon_.assign(numWells * ncwmax_ * Restart::NICONZ, 0);
+
+        for (size_t iwell = 0; iwell < numWells; ++iwell) {
+            addIwelData(signature_[iwell], Restart::NIWELZ * iwell);
+            addIconData(signature_[iwell].completions, ncwmax_ * Restart::NICONZ * iwell);
+            zwel_[ iwell * Restart::NZWELZ ] = wells[iwell]->name().c_str();
+        }
+        return true;
+    }
+
+    size_t numWells() const
+    { return signature_.size(); }
+
+    size_t ncwmax() const
+    { return ncwmax_; }
+
+    const std::vector<int>& iwelData() const
+    { return iwel_; }
+
+    const std::vector<const char*>& zwelData() const
+    { return zwel_; }
+
+    const std::vector<int>& iconData() const
+    { return icon_; }
+
+private:
+    // everything the arrays of a well are computed from
+    struct WellSignature
+    {
+        WellConstPtr well;
+        CompletionSetConstPtr completions;
+        WellCommon::StatusEnum status;
+        bool producer;
+        WellInjector::TypeEnum injectorType;
+
+        bool operator==(const WellSignature& other) const
+        {
+            return well == other.well
+                && completions == other.completions
+                && status == other.status
+                && producer == other.producer
+                && injectorType == other.injectorType;
+        }
+    };
+
+    void addIwelData(const WellSignature& sig, size_t offset)
+    {
+        iwel_[ offset + IWEL_HEADI_ITEM ] = sig.well->getHeadI() + 1;
+        iwel_[ offset + IWEL_HEADJ_ITEM ] = sig.well->getHeadJ() + 1;
+        iwel_[ offset + IWEL_CONNECTIONS_ITEM ] = sig.completions->size();
+        iwel_[ offset + IWEL_GROUP_ITEM ] = 1;
+
+        {
+            WellType welltype = sig.producer ? PRODUCER : INJECTOR;
+            int ert_welltype = EclipseWriter::eclipseWellTypeMask(welltype, sig.injectorType);
+            iwel_[ offset + IWEL_TYPE_ITEM ] = ert_welltype;
+        }
+
+        iwel_[ offset + IWEL_STATUS_ITEM ] = EclipseWriter::eclipseWellStatusMask(sig.status);
+    }
+
+    void addIconData(CompletionSetConstPtr completions, size_t wellICONOffset)
+    {
+        for (size_t i = 0; i < completions->size(); ++i) {
+            CompletionConstPtr completion = completions->get(i);
+            size_t iconOffset = wellICONOffset + i * Restart::NICONZ;
+            icon_[ iconOffset + ICON_IC_ITEM] = 1;
+
+            icon_[ iconOffset + ICON_I_ITEM] = completion->getI() + 1;
+            icon_[ iconOffset + ICON_J_ITEM] = completion->getJ() + 1;
+            icon_[ iconOffset + ICON_K_ITEM] = completion->getK() + 1;
+
+            {
+                WellCompletion::StateEnum completion_state = completion->getState();
+                if (completion_state == WellCompletion::StateEnum::OPEN) {
+                    icon_[ iconOffset + ICON_STATUS_ITEM ] = 1;
+                } else {
+                    icon_[ iconOffset + ICON_STATUS_ITEM ] = 0;
+                }
+            }
+            icon_[ iconOffset + ICON_DIRECTION_ITEM] = (int)completion->getDirection();
+        }
+    }
+
+    std::vector<WellSignature> signature_;
+    size_t ncwmax_;
+    std::vector<int> iwel_;
+    std::vector<const char*> zwel_;
+    std::vector<int> icon_;
+};
+
 /**
  * The Solution class wraps the actions that must be done to the restart file while
  * writing solution variables; it is not a handle on its own.
@@ -423,6 +539,7 @@ public:
                                           nx,
                                           ny,
                                           nz);
+        layoutReportStepIdx_ = -1;
     }
 
     ~Summary()
@@ -450,11 +567,40 @@ public:
     ecl_sum_type *ertHandle() const
     { return ertHandle_; }
 
+    /// Whether a well (by its index in the deck) is open in the current
+    /// time step, and its rate of a phase (by position) and bottom hole
+    /// pressure. Valid during writeTimeStep().
+    bool wellActive(int deckWellIdx) const
+    { return wellStateIdx_[deckWellIdx] >= 0; }
+
+    double wellRate(int deckWellIdx, int phasePos) const
+    { return wellRates_[deckWellIdx*phaseUses_.num_phases + phasePos]; }
+
+    double wellBhp(int deckWellIdx) const
+    { return wellBhp_[deckWellIdx]; }
+
 private:
+    void updateWellStateIndices_(int reportStepIdx);
+    void gatherWellValues_(const WellState& wellState);
+
     ecl_sum_type *ertHandle_;
 
     Opm::EclipseStateConstPtr eclipseState_;
+    PhaseUsage phaseUses_;
     SummaryReportVarCollection summaryReportVars_;
+
+    /// index of each well of the deck in the wells of the schedule
+    std::map<const Well*, int> deckWellIdx_;
+
+    /// index of each well of the deck in the well state, or -1 if the
+    /// well is not open, for the report step layoutReportStepIdx_
+    std::vector<int> wellStateIdx_;
+    int layoutReportStepIdx_;
+
+    /// rates and bottom hole pressures of all wells of the deck, in
+    /// the order of the deck
+    std::vector<double> wellRates_;
+    std::vector<double> wellBhp_;
 };
 
 class SummaryTimeStep : private boost::noncopyable
@@ -572,6 +718,7 @@ protected:
     WellReport(const Summary& summary,    /* section to add to  */
                Opm::EclipseStateConstPtr eclipseState,
                Opm::WellConstPtr& well,
+               int deckWellIdx,                  /* index in the deck  */
                PhaseUsage uses,                  /* phases present     */
                BlackoilPhases::PhaseIndex phase, /* oil, water or gas  */
                WellType type,                    /* prod. or inj.      */
@@ -580,6 +727,7 @@ protected:
         // save these for when we update the value in a timestep
         : eclipseState_(eclipseState)
         , well_(well)
+        , deckWellIdx_(deckWellIdx)
         , phaseUses_(uses)
         , phaseIdx_(phase)
     {
@@ -596,73 +744,33 @@ protected:
                                      /*num=*/ 0,
                                      unit.c_str(),
                                      /*defaultValue=*/ 0.);
+        paramsIdx_ = smspec_node_get_params_index(ertHandle_);
     }
 
 public:
     /// Retrieve the value which the monitor is supposed to write to the summary file
-    /// according to the state of the well.
+    /// according to the per-well values gathered by the summary for this time step.
     virtual double retrieveValue(const int writeStepIdx,
                                  const SimulatorTimerInterface& timer,
-                                 const WellState& wellState,
-                                 const std::map<std::string, int>& nameToIdxMap) = 0;
+                                 const Summary& summary) = 0;
 
     smspec_node_type *ertHandle() const
     { return ertHandle_; }
 
-protected:
-    void updateTimeStepWellIndex_(const std::map<std::string, int>& nameToIdxMap)
-    {
-        const std::string& wellName = well_->name();
-
-        const auto wellIdxIt = nameToIdxMap.find(wellName);
-        if (wellIdxIt == nameToIdxMap.end()) {
-            timeStepWellIdx_ = -1;
-            flatIdx_ = -1;
-            return;
-        }
-
-        timeStepWellIdx_ = wellIdxIt->second;
-        flatIdx_ = timeStepWellIdx_*phaseUses_.num_phases + phaseUses_.phase_pos[phaseIdx_];
-    }
+    /// Index of the variable in the parameters of a summary time step.
+    int paramsIndex() const
+    { return paramsIdx_; }
 
+protected:
     // return m^3/s of injected or produced fluid
-    double rate(const WellState& wellState)
+    double rate(const Summary& summary) const
     {
-        double value = 0;
-        if (wellState.wellRates().size() > 0) {
-            assert(int(wellState.wellRates().size()) > flatIdx_);
-            value = sign_ * wellState.wellRates()[flatIdx_];
-        }
-        return value;
+        return sign_ * summary.wellRate(deckWellIdx_, phaseUses_.phase_pos[phaseIdx_]);
     }
 
-    double bhp(const WellState& wellState)
+    double bhp(const Summary& summary) const
     {
-        if (wellState.bhp().size() > 0) {
-            // Note that 'flatIdx_' is used here even though it is meant
-            // to give a (well,phase) pair.
-            const int numPhases = wellState.wellRates().size() / wellState.bhp().size();
-
-            return wellState.bhp()[flatIdx_/numPhases];
-        }
-        return 0.0;
-    }
-
-    /// Get the index associated a well name
-    int wellIndex_(Opm::EclipseStateConstPtr eclipseState)
-    {
-        const Opm::ScheduleConstPtr schedule = eclipseState->getSchedule();
-
-        const std::string& wellName = well_->name();
-        const auto& wells = schedule->getWells();
-        for (size_t wellIdx = 0; wellIdx < wells.size(); ++wellIdx) {
-            if (wells[wellIdx]->name() == wellName) {
-                return wellIdx;
-            }
-        }
-
-        OPM_THROW(std::runtime_error,
-                  "Well '" << wellName << "' is not present in deck");
+        return summary.wellBhp(deckWellIdx_);
     }
 
     /// Compose the name of the summary variable, e.g. "WOPR" for
@@ -697,18 +805,17 @@ protected:
     }
 
     smspec_node_type *ertHandle_;
+    int paramsIdx_;
 
     Opm::EclipseStateConstPtr eclipseState_;
     Opm::WellConstPtr well_;
 
+    /// index of the well in the wells of the deck
+    int deckWellIdx_;
+
     PhaseUsage phaseUses_;
     BlackoilPhases::PhaseIndex phaseIdx_;
 
-    int timeStepWellIdx_;
-
-    /// index into a (flattened) wellsOfTimeStep*phases matrix
-    int flatIdx_;
-
     /// natural sign of the rate
     double sign_;
 };
@@ -720,12 +827,14 @@ public:
     WellRate(const Summary& summary,
              Opm::EclipseStateConstPtr eclipseState,
              Opm::WellConstPtr well,
+             int deckWellIdx,
              PhaseUsage uses,
              BlackoilPhases::PhaseIndex phase,
              WellType type)
         : WellReport(summary,
                      eclipseState,
                      well,
+                     deckWellIdx,
                      uses,
                      phase,
                      type,
@@ -734,25 +843,17 @@ public:
     { }
 
     virtual double retrieveValue(const int /* writeStepIdx */,
-                                 const SimulatorTimerInterface& timer,
-                                 const WellState& wellState,
-                                 const std::map<std::string, int>& wellNameToIdxMap)
+                                 const SimulatorTimerInterface& /* timer */,
+                                 const Summary& summary)
     {
-        // find the index for the quantity in the wellState
-        this->updateTimeStepWellIndex_(wellNameToIdxMap);
-        if (this->flatIdx_ < 0) {
-            // well not active in current time step
-            return 0.0;
-        }
-
-        if (well_->getStatus(timer.reportStepNum()) == WellCommon::SHUT) {
-            // well is shut in the current time step
+        if (!summary.wellActive(deckWellIdx_)) {
+            // well not active or shut in current time step
             return 0.0;
         }
 
         // TODO: Why only positive rates?
         using namespace Opm::unit;
-        return convert::to(std::max(0., rate(wellState)),
+        return convert::to(std::max(0., rate(summary)),
                            cubic(meter)/day);
     }
 };
@@ -764,12 +865,14 @@ public:
     WellTotal(const Summary& summary,
               Opm::EclipseStateConstPtr eclipseState,
               Opm::WellConstPtr well,
+              int deckWellIdx,
               PhaseUsage uses,
               BlackoilPhases::PhaseIndex phase,
               WellType type)
         : WellReport(summary,
                      eclipseState,
                      well,
+                     deckWellIdx,
                      uses,
                      phase,
                      type,
@@ -781,8 +884,7 @@ public:
 
     virtual double retrieveValue(const int writeStepIdx,
                                  const SimulatorTimerInterface& timer,
-                                 const WellState& wellState,
-                                 const std::map<std::string, int>& wellNameToIdxMap)
+                                 const Summary& summary)
     {
         if (writeStepIdx == 0) {
             // We are at the initial state.
@@ -790,22 +892,15 @@ public:
             return 0.0;
         }
 
-        if (well_->getStatus(timer.reportStepNum()) == WellCommon::SHUT) {
-            // well is shut in the current time step
-            return 0.0;
-        }
-
-        // find the index for the quantity in the wellState
-        this->updateTimeStepWellIndex_(wellNameToIdxMap);
-        if (this->flatIdx_ < 0) {
-            // well not active in current time step
+        if (!summary.wellActive(deckWellIdx_)) {
+            // well not active or shut in current time step
             return 0.0;
         }
 
         // due to using an Euler method as time integration scheme, the well rate is the
         // average for the time step. For more complicated time stepping schemes, the
         // integral of the rate is not simply multiplying two numbers...
-        const double intg = timer.stepLengthTaken() * rate(wellState);
+        const double intg = timer.stepLengthTaken() * rate(summary);
 
         // add this timesteps production to the total
         total_ += intg;
@@ -825,12 +920,14 @@ public:
     WellBhp(const Summary& summary,
             Opm::EclipseStateConstPtr eclipseState,
             Opm::WellConstPtr well,
+            int deckWellIdx,
             PhaseUsage uses,
             BlackoilPhases::PhaseIndex phase,
             WellType type)
         : WellReport(summary,
                      eclipseState,
                      well,
+                     deckWellIdx,
                      uses,
                      phase,
                      type,
@@ -839,50 +936,82 @@ public:
     { }
 
     virtual double retrieveValue(const int /* writeStepIdx */,
-                                 const SimulatorTimerInterface& timer,
-                                 const WellState& wellState,
-                                 const std::map<std::string, int>& wellNameToIdxMap)
+                                 const SimulatorTimerInterface& /* timer */,
+                                 const Summary& summary)
     {
-        // find the index for the quantity in the wellState
-        this->updateTimeStepWellIndex_(wellNameToIdxMap);
-        if (this->flatIdx_ < 0) {
-            // well not active in current time step
-            return 0.0;
-        }
-        if (well_->getStatus(timer.reportStepNum()) == WellCommon::SHUT) {
-            // well is shut in the current time step
+        if (!summary.wellActive(deckWellIdx_)) {
+            // well not active or shut in current time step
             return 0.0;
         }
 
-        return bhp(wellState);
+        return bhp(summary);
     }
 };
 
-// no inline implementation of this since it depends on the
-// WellReport type being completed first
-void Summary::writeTimeStep(int writeStepIdx,
-                            const SimulatorTimerInterface& timer,
-                            const WellState& wellState)
+// find the position of each open well of a report step in the well
+// state. Open wells are numbered in the order of the schedule.
+void Summary::updateWellStateIndices_(int reportStepIdx)
 {
-    // create a name -> well index map
+    if (reportStepIdx == layoutReportStepIdx_) {
+        return;
+    }
+
     const Opm::ScheduleConstPtr schedule = eclipseState_->getSchedule();
-    const auto& timeStepWells = schedule->getWells(timer.reportStepNum());
-    std::map<std::string, int> wellNameToIdxMap;
+    const auto& timeStepWells = schedule->getWells(reportStepIdx);
+    std::fill(wellStateIdx_.begin(), wellStateIdx_.end(), -1);
     int openWellIdx = 0;
     for (size_t tsWellIdx = 0; tsWellIdx < timeStepWells.size(); ++tsWellIdx) {
-        if (timeStepWells[tsWellIdx]->getStatus(timer.reportStepNum()) != WellCommon::SHUT ) {
-            wellNameToIdxMap[timeStepWells[tsWellIdx]->name()] = openWellIdx;
+        if (timeStepWells[tsWellIdx]->getStatus(reportStepIdx) != WellCommon::SHUT ) {
+            const auto deckIdxIt = deckWellIdx_.find(timeStepWells[tsWellIdx].get());
+            if (deckIdxIt != deckWellIdx_.end()) {
+                wellStateIdx_[deckIdxIt->second] = openWellIdx;
+            }
             openWellIdx++;
         }
     }
+    layoutReportStepIdx_ = reportStepIdx;
+}
+
+// copy the rates and bottom hole pressures of all wells into the order
+// of the deck in one pass, with zeros for the wells which are not open
+void Summary::gatherWellValues_(const WellState& wellState)
+{
+    const int numPhases = phaseUses_.num_phases;
+    const int numWells = wellStateIdx_.size();
+    const bool haveRates = !wellState.wellRates().empty();
+    const bool haveBhp = !wellState.bhp().empty();
+
+    for (int deckWellIdx = 0; deckWellIdx < numWells; ++deckWellIdx) {
+        const int idx = wellStateIdx_[deckWellIdx];
+        double* rates = &wellRates_[deckWellIdx*numPhases];
+        if (idx >= 0 && haveRates) {
+            assert(int(wellState.wellRates().size()) >= (idx + 1)*numPhases);
+            std::copy(&wellState.wellRates()[idx*numPhases],
+                      &wellState.wellRates()[idx*numPhases] + numPhases,
+                      rates);
+        } else {
+            std::fill(rates, rates + numPhases, 0.0);
+        }
+        wellBhp_[deckWellIdx] = (idx >= 0 && haveBhp) ? wellState.bhp()[idx] : 0.0;
+    }
+}
+
+// no inline implementation of this since it depends on the
+// WellReport type being completed first
+void Summary::writeTimeStep(int writeStepIdx,
+                            const SimulatorTimerInterface& timer,
+                            const WellState& wellState)
+{
+    updateWellStateIndices_(timer.reportStepNum());
+    gatherWellValues_(wellState);
 
     // internal view; do not move this code out of Summary!
     SummaryTimeStep tstep(*this, writeStepIdx, timer);
     // write all the variables
     for (auto varIt = summaryReportVars_.begin(); varIt != summaryReportVars_.end(); ++varIt) {
         ecl_sum_tstep_iset(tstep.ertHandle(),
-                           smspec_node_get_params_index((*varIt)->ertHandle()),
-                           (*varIt)->retrieveValue(writeStepIdx, timer, wellState, wellNameToIdxMap));
+                           (*varIt)->paramsIndex(),
+                           (*varIt)->retrieveValue(writeStepIdx, timer, *this));
     }
 
     // write the summary file to disk
@@ -893,12 +1022,23 @@ void Summary::addAllWells(Opm::EclipseStateConstPtr eclipseState,
                           const PhaseUsage& uses)
 {
     eclipseState_ = eclipseState;
+    phaseUses_ = uses;
     // TODO: Only create report variables that are requested with keywords
     // (e.g. "WOPR") in the input files, and only for those wells that are
     // mentioned in those keywords
     Opm::ScheduleConstPtr schedule = eclipseState->getSchedule();
     const auto& wells = schedule->getWells();
     const int numWells = schedule->numWells();
+
+    deckWellIdx_.clear();
+    for (int wellIdx = 0; wellIdx != numWells; ++wellIdx) {
+        deckWellIdx_[wells[wellIdx].get()] = wellIdx;
+    }
+    wellStateIdx_.assign(numWells, -1);
+    layoutReportStepIdx_ = -1;
+    wellRates_.assign(numWells*uses.num_phases, 0.0);
+    wellBhp_.assign(numWells, 0.0);
+
     for (int phaseIdx = 0; phaseIdx != BlackoilPhases::MaxNumPhases; ++phaseIdx) {
         const BlackoilPhases::PhaseIndex ertPhaseIdx =
             static_cast <BlackoilPhases::PhaseIndex>(phaseIdx);
@@ -915,6 +1055,7 @@ void Summary::addAllWells(Opm::EclipseStateConstPtr eclipseState,
                             new WellRate(*this,
                                          eclipseState,
                                          wells[wellIdx],
+                                         wellIdx,
                                          uses,
                                          ertPhaseIdx,
                                          wellType)));
@@ -923,6 +1064,7 @@ void Summary::addAllWells(Opm::EclipseStateConstPtr eclipseState,
                             new WellTotal(*this,
                                           eclipseState,
                                           wells[wellIdx],
+                                          wellIdx,
                                           uses,
                                           ertPhaseIdx,
                                           wellType)));
@@ -945,6 +1087,7 @@ void Summary::addAllWells(Opm::EclipseStateConstPtr eclipseState,
                     new WellBhp(*this,
                                 eclipseState,
                                 wells[wellIdx],
+                                wellIdx,
                                 uses,
                                 ertPhaseIdx,
                                 WELL_TYPES[0])));
@@ -1040,6 +1183,8 @@ void EclipseWriter::writeInit(const SimulatorTimerInterface &timer)
                                                      eclGrid->getNY(),
                                                      eclGrid->getNZ()));
     summary_->addAllWells(eclipseState_, phaseUsage_);
+
+    wellLayout_.reset(new EclipseWriterDetails::WellLayout());
 }
 
 // implementation of the writeTimeStep method
@@ -1058,29 +1203,12 @@ void EclipseWriter::writeTimeStep(const SimulatorTimerInterface& timer,
         return;
     }
 
-    const size_t ncwmax                 = eclipseState_->getSchedule()->getMaxNumCompletionsForWells(timer.reportStepNum());
-    const size_t numWells               = eclipseState_->getSchedule()->numWells(timer.reportStepNum());
-    std::vector<WellConstPtr> wells_ptr = eclipseState_->getSchedule()->getWells(timer.reportStepNum());
-
-    std::vector<const char*> zwell_data( numWells * Opm::EclipseWriterDetails::Restart::NZWELZ , "");
-    std::vector<int>         iwell_data( numWells * Opm::EclipseWriterDetails::Restart::NIWELZ , 0 );
-    std::vector<int>         icon_data( numWells * ncwmax * Opm::EclipseWriterDetails::Restart::NICONZ , 0 );
+    wellLayout_->update(eclipseState_->getSchedule(), timer.reportStepNum());
+    const size_t ncwmax   = wellLayout_->ncwmax();
+    const size_t numWells = wellLayout_->numWells();
 
     EclipseWriterDetails::Restart restartHandle(outputDir_, baseName_, writeStepIdx_);
 
-    for (size_t iwell = 0; iwell < wells_ptr.size(); ++iwell) {
-        WellConstPtr well = wells_ptr[iwell];
-        {
-            size_t wellIwelOffset = Opm::EclipseWriterDetails::Restart::NIWELZ * iwell;
-            restartHandle.addRestartFileIwelData(iwell_data, timer.reportStepNum(), well , wellIwelOffset);
-        }
-        {
-            size_t wellIconOffset = ncwmax * Opm::EclipseWriterDetails::Restart::NICONZ * iwell;
-            restartHandle.addRestartFileIconData(icon_data,  well->getCompletions( timer.reportStepNum() ), wellIconOffset);
-        }
-        zwell_data[ iwell * Opm::EclipseWriterDetails::Restart::NZWELZ ] = well->name().c_str();
-    }
-
     {
         ecl_rsthead_type rsthead_data = { 0 };
         rsthead_data.sim_time   = timer.currentPosixTime();
@@ -1102,24 +1230,25 @@ void EclipseWriter::writeTimeStep(const SimulatorTimerInterface& timer,
     }
 
 
-    restartHandle.add_kw(EclipseWriterDetails::Keyword<int>(IWEL_KW, iwell_data));
-    restartHandle.add_kw(EclipseWriterDetails::Keyword<const char *>(ZWEL_KW, zwell_data));
-    restartHandle.add_kw(EclipseWriterDetails::Keyword<int>(ICON_KW, icon_data));
+    restartHandle.add_kw(EclipseWriterDetails::Keyword<int>(IWEL_KW, wellLayout_->iwelData()));
+    restartHandle.add_kw(EclipseWriterDetails::Keyword<const char *>(ZWEL_KW, wellLayout_->zwelData()));
+    restartHandle.add_kw(EclipseWriterDetails::Keyword<int>(ICON_KW, wellLayout_->iconData()));
 
     EclipseWriterDetails::Solution sol(restartHandle);
 
-    // write out the pressure of the reference phase (whatever phase that is...). this is
-    // not the most performant solution thinkable, but this is also not in the most
-    // performance critical code path!
+    // write out the pressure of the reference phase (whatever phase that is...).
     //
-    // Also, we want to use the same units as the deck for pressure output, i.e. we have
-    // to mutliate our nice SI pressures by the inverse of the conversion factor of deck
-    // to SI pressure units...
-    std::vector<double> tmp = reservoirState.pressure();
-    EclipseWriterDetails::convertFromSiTo(tmp, deckToSiPressure_);
-    EclipseWriterDetails::restrictAndReorderToActiveCells(tmp, gridToEclipseIdx_.size(), gridToEclipseIdx_.data());
-
-    sol.add(EclipseWriterDetails::Keyword<float>("PRESSURE", tmp));
+    // We want to use the same units as the deck for pressure output, i.e. we have to
+    // divide our nice SI pressures by the conversion factor of deck to SI pressure
+    // units. The gather plan (gridToEclipseIdx_) does the reordering to the active
+    // cells of eclipse, the stride extraction and the unit conversion in one pass
+    // into a buffer which is reused for all keywords and report steps.
+    EclipseWriterDetails::gatherToEclipseOrder(reservoirState.pressure(),
+                                               /*offset=*/0, /*stride=*/1,
+                                               deckToSiPressure_,
+                                               gridToEclipseIdx_,
+                                               outputBuffer_);
+    sol.add(EclipseWriterDetails::Keyword<float>("PRESSURE", outputBuffer_));
 
     for (int phase = 0; phase != BlackoilPhases::MaxNumPhases; ++phase) {
         // Eclipse never writes the oil saturation, so all post-processors
@@ -1128,12 +1257,13 @@ void EclipseWriter::writeTimeStep(const SimulatorTimerInterface& timer,
             continue;
         }
         if (phaseUsage_.phase_used[phase]) {
-            tmp = reservoirState.saturation();
-            EclipseWriterDetails::extractFromStripedData(tmp,
-                                                         /*offset=*/phaseUsage_.phase_pos[phase],
-                                                         /*stride=*/phaseUsage_.num_phases);
-            EclipseWriterDetails::restrictAndReorderToActiveCells(tmp, gridToEclipseIdx_.size(), gridToEclipseIdx_.data());
-            sol.add(EclipseWriterDetails::Keyword<float>(EclipseWriterDetails::saturationKeywordNames[phase], tmp));
+            EclipseWriterDetails::gatherToEclipseOrder(reservoirState.saturation(),
+                                                       /*offset=*/phaseUsage_.phase_pos[phase],
+                                                       /*stride=*/phaseUsage_.num_phases,
+                                                       /*toSiConversionFactor=*/1.0,
+                                                       gridToEclipseIdx_,
+                                                       outputBuffer_);
+            sol.add(EclipseWriterDetails::Keyword<float>(EclipseWriterDetails::saturationKeywordNames[phase], outputBuffer_));
         }
     }
 
@@ -41,6 +41,7 @@ namespace Opm {
 // forward declarations
 namespace EclipseWriterDetails {
 class Summary;
+class WellLayout;
 }
 
 class SimulatorState;
@@ -110,6 +111,7 @@ private:
     std::array<int, 3> cartesianSize_;
     const int* compressedToCartesianCellIdx_;
     std::vector< int > gridToEclipseIdx_;
+    std::vector< float > outputBuffer_;
     double deckToSiPressure_;
     bool enableOutput_;
     int outputInterval_;
@@ -118,6 +120,7 @@ private:
     std::string baseName_;
     PhaseUsage phaseUsage_; // active phases in the input deck
     std::shared_ptr<EclipseWriterDetails::Summary> summary_;
+    std::shared_ptr<EclipseWriterDetails::WellLayout> wellLayout_;
 
     void init(const parameter::ParameterGroup& params);
 };
@@ -0,0 +1,703 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#include <opm/core/io/eclipse/StreamingCornerpointChopper.hpp>
+#include <opm/core/utility/ErrorMacros.hpp>
+
+#include <boost/cstdint.hpp>
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace Opm
+{
+
+    namespace
+    {
+        // Cell properties extracted from the input, in output order.
+        struct CellProperty {
+            const char* keyword;
+            bool integer;
+            int per_line;
+        };
+        const CellProperty cellProperties[] = {
+            { "ACTNUM", true,  20 },
+            { "PORO",   false,  4 },
+            { "NTG",    false,  4 },
+            { "SWCR",   false,  4 },
+            { "SOWCR",  false,  4 },
+            { "PERMX",  false,  4 },
+            { "PERMY",  false,  4 },
+            { "PERMZ",  false,  4 },
+            { "SATNUM", true,  20 }
+        };
+        const int numCellProperties = sizeof cellProperties / sizeof cellProperties[0];
+
+        // Keywords whose records name a property, e.g. "PORO 0.2 /",
+        // ending with an empty record.
+        const char* const operationKeywords[] = {
+            "ADD", "ADDREG", "COPY", "COPYREG", "EQUALREG", "EQUALS",
+            "MAXVALUE", "MINVALUE", "MULTIPLY", "MULTIREG", "OPERATE", "OPERATER"
+        };
+
+        bool isOperationKeyword(const std::string& keyword)
+        {
+            return std::find(std::begin(operationKeywords), std::end(operationKeywords), keyword)
+                != std::end(operationKeywords);
+        }
+
+        bool isSpace(const char c)
+        {
+            return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+        }
+
+        bool isAlpha(const char c)
+        {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+        }
+
+        // Whitespace separated tokens of a GRDECL file, with comments
+        // removed, read through a fixed size buffer.  A token stays valid
+        // until the next call to next().
+        class GrdeclTokenizer
+        {
+        public:
+            explicit GrdeclTokenizer(const std::string& file)
+                : file_(std::fopen(file.c_str(), "rb")),
+                  buf_(1 << 20), pos_(0), end_(0), eof_(false)
+            {
+                if (file_ == 0) {
+                    OPM_THROW(std::runtime_error, "Could not open GRDECL file " << file);
+                }
+            }
+
+            ~GrdeclTokenizer()
+            {
+                std::fclose(file_);
+            }
+
+            bool next(const char*& begin, const char*& end)
+            {
+                for (;;) {
+                    for (;;) {
+                        if (pos_ == end_ && !fill()) {
+                            return false;
+                        }
+                        if (!isSpace(buf_[pos_])) {
+                            break;
+                        }
+                        ++pos_;
+                    }
+
+                    // Find the end of the token, reading more input as needed.
+                    // Quoted strings may contain blanks.
+                    std::size_t e = pos_;
+                    bool quoted = false;
+                    for (;;) {
+                        while (e < end_ && (quoted || !isSpace(buf_[e]))) {
+                            if (buf_[e] == '\'') {
+                                quoted = !quoted;
+                            }
+                            ++e;
+                        }
+                        if (e < end_ || eof_) {
+                            break;
+                        }
+                        const std::size_t offset = e - pos_;
+                        const bool more = fill();
+                        e = pos_ + offset;
+                        if (!more) {
+                            break;
+                        }
+                    }
+
+                    if (e - pos_ >= 2 && buf_[pos_] == '-' && buf_[pos_ + 1] == '-') {
+                        // Comment; skip the rest of the line.
+                        pos_ = e;
+                        for (;;) {
+                            if (pos_ == end_ && !fill()) {
+                                return false;
+                            }
+                            if (buf_[pos_] == '\n') {
+                                break;
+                            }
+                            ++pos_;
+                        }
+                        continue;
+                    }
+
+                    begin = &buf_[pos_];
+                    end = begin + (e - pos_);
+                    pos_ = e;
+                    return true;
+                }
+            }
+
+        private:
+            GrdeclTokenizer(const GrdeclTokenizer&);
+            GrdeclTokenizer& operator=(const GrdeclTokenizer&);
+
+            // Move the unread part of the buffer to the front and read
+            // more.  Returns false if nothing more could be read.
+            bool fill()
+            {
+                if (eof_) {
+                    return false;
+                }
+                std::memmove(&buf_[0], &buf_[pos_], end_ - pos_);
+                end_ -= pos_;
+                pos_ = 0;
+                if (end_ == buf_.size()) {
+                    // A token longer than the buffer.
+                    buf_.resize(2*buf_.size());
+                }
+                const std::size_t n = std::fread(&buf_[end_], 1, buf_.size() - end_, file_);
+                end_ += n;
+                if (n == 0) {
+                    eof_ = true;
+                }
+                return n != 0;
+            }
+
+            std::FILE* file_;
+            std::vector<char> buf_;
+            std::size_t pos_;
+            std::size_t end_;
+            bool eof_;
+        };
+
+        // Convert a single value, copied to be null terminated.
+        template <typename T>
+        T convert(const char* begin, const char* end, const std::string& keyword);
+
+        template <>
+        double convert<double>(const char* begin, const char* end, const std::string& keyword)
+        {
+            char buf[64];
+            const std::size_t len = end - begin;
+            char* stop = buf;
+            double value = 0.0;
+            if (len > 0 && len < sizeof buf) {
+                std::copy(begin, end, buf);
+                buf[len] = '\0';
+                value = std::strtod(buf, &stop);
+            }
+            if (len == 0 || stop != buf + len) {
+                OPM_THROW(std::runtime_error, "Invalid value '" << std::string(begin, end)
+                          << "' in keyword " << keyword);
+            }
+            return value;
+        }
+
+        template <>
+        int convert<int>(const char* begin, const char* end, const std::string& keyword)
+        {
+            char buf[16];
+            const std::size_t len = end - begin;
+            char* stop = buf;
+            long value = 0;
+            if (len > 0 && len < sizeof buf) {
+                std::copy(begin, end, buf);
+                buf[len] = '\0';
+                value = std::strtol(buf, &stop, 10);
+            }
+            if (len == 0 || stop != buf + len || value != long(int(value))) {
+                OPM_THROW(std::runtime_error, "Invalid integer '" << std::string(begin, end)
+                          << "' in keyword " << keyword);
+            }
+            return int(value);
+        }
+
+        template <typename T>
+        void writeTextField(std::ostream& os, const std::vector<T>& field,
+                            const std::string& keyword, const std::size_t nl)
+        {
+            if (field.empty()) {
+                return;
+            }
+            os << keyword << '\n';
+            const std::size_t n = field.size();
+            for (std::size_t i = 0; i < n; ++i) {
+                os << field[i] << (((i + 1) % nl == 0) ? '\n' : ' ');
+            }
+            if (n % nl != 0) {
+                os << '\n';
+            }
+            os << "/\n\n";
+        }
+
+        const char* binaryType(const std::vector<int>&) { return "INTE"; }
+        const char* binaryType(const std::vector<double>&) { return "DOUB"; }
+
+        void writeBigEndian(std::ostream& os, const boost::uint32_t x)
+        {
+            const unsigned char b[4] = { static_cast<unsigned char>(x >> 24),
+                                         static_cast<unsigned char>(x >> 16),
+                                         static_cast<unsigned char>(x >> 8),
+                                         static_cast<unsigned char>(x) };
+            os.write(reinterpret_cast<const char*>(b), 4);
+        }
+
+        void writeBigEndian(std::ostream& os, const boost::uint64_t x)
+        {
+            writeBigEndian(os, boost::uint32_t(x >> 32));
+            writeBigEndian(os, boost::uint32_t(x));
+        }
+
+        void writeBigEndian(std::ostream& os, const int x)
+        {
+            writeBigEndian(os, boost::uint32_t(x));
+        }
+
+        void writeBigEndian(std::ostream& os, const double x)
+        {
+            boost::uint64_t bits;
+            std::memcpy(&bits, &x, sizeof bits);
+            writeBigEndian(os, bits);
+        }
+
+        // One keyword as Fortran unformatted records: a header with the
+        // name, the number of elements and the type, followed by the
+        // data in blocks of at most 1000 elements.
+        template <typename T>
+        void writeBinaryField(std::ostream& os, const std::vector<T>& field,
+                              const std::string& keyword)
+        {
+            if (field.empty() && keyword != "SPECGRID") {
+                return;
+            }
+            char name[8];
+            std::fill(name, name + 8, ' ');
+            std::copy(keyword.begin(), keyword.begin() + std::min(keyword.size(), std::size_t(8)), name);
+            const char* type = binaryType(field);
+
+            writeBigEndian(os, boost::uint32_t(16));
+            os.write(name, 8);
+            writeBigEndian(os, int(field.size()));
+            os.write(type, 4);
+            writeBigEndian(os, boost::uint32_t(16));
+
+            const std::size_t block = 1000;
+            for (std::size_t b = 0; b < field.size(); b += block) {
+                const std::size_t n = std::min(block, field.size() - b);
+                writeBigEndian(os, boost::uint32_t(n*sizeof(T)));
+                for (std::size_t i = b; i < b + n; ++i) {
+                    writeBigEndian(os, field[i]);
+                }
+                writeBigEndian(os, boost::uint32_t(n*sizeof(T)));
+            }
+        }
+    } // anonymous namespace
+
+
+
+    // The values of a keyword, seen as slabs of rows, and the block of
+    // columns, rows and slabs that is kept.
+    struct StreamingCornerPointChopper::Section
+    {
+        Section()
+            : dout(0), iout(0), index(0), col(0), row(0), slab(0), seen(false)
+        {}
+
+        Section(int row_length, int rows_per_slab, int num_slabs,
+                int c0, int c1, int r0, int r1, int s0, int s1)
+            : row_length(row_length), rows_per_slab(rows_per_slab),
+              total(boost::int64_t(row_length)*rows_per_slab*num_slabs),
+              col0(c0), col1(c1), row0(r0), row1(r1), slab0(s0), slab1(s1),
+              dout(0), iout(0), index(0), col(0), row(0), slab(0), seen(false)
+        {}
+
+        std::size_t keptSize() const
+        {
+            return std::size_t(col1 - col0)*(row1 - row0)*(slab1 - slab0);
+        }
+
+        // Store count copies of the value in [begin, end), as far as
+        // they fall inside the kept block.
+        template <typename T>
+        void add(boost::int64_t count, const char* begin, const char* end,
+                 std::vector<T>& out, const std::string& keyword)
+        {
+            if (index + count > total) {
+                OPM_THROW(std::runtime_error, "Too many values in keyword " << keyword
+                          << ", expected " << total);
+            }
+            bool converted = false;
+            T value = T();
+            while (count > 0) {
+                const int m = int(std::min(count, boost::int64_t(row_length - col)));
+                if (row >= row0 && row < row1 && slab >= slab0 && slab < slab1) {
+                    const int a = std::max(col, col0);
+                    const int b = std::min(col + m, col1);
+                    if (a < b) {
+                        if (!converted) {
+                            value = convert<T>(begin, end, keyword);
+                            converted = true;
+                        }
+                        const std::size_t dest =
+                            (std::size_t(slab - slab0)*(row1 - row0) + (row - row0))*(col1 - col0);
+                        std::fill(out.begin() + dest + (a - col0),
+                                  out.begin() + dest + (b - col0), value);
+                    }
+                }
+                col += m;
+                if (col == row_length) {
+                    col = 0;
+                    if (++row == rows_per_slab) {
+                        row = 0;
+                        ++slab;
+                    }
+                }
+                count -= m;
+                index += m;
+            }
+        }
+
+        int row_length;
+        int rows_per_slab;
+        boost::int64_t total;
+        int col0, col1, row0, row1, slab0, slab1;
+
+        std::vector<double>* dout;
+        std::vector<int>* iout;
+
+        boost::int64_t index;
+        int col, row, slab;
+        bool seen;
+    };
+
+
+
+    StreamingCornerPointChopper::StreamingCornerPointChopper(const std::string& file)
+        : file_(file)
+    {
+        std::fill(dims_, dims_ + 3, 0);
+        std::fill(new_dims_, new_dims_ + 3, 0);
+        if (!scan(file_, 0)) {
+            OPM_THROW(std::runtime_error, "No SPECGRID or DIMENS keyword found in " << file);
+        }
+    }
+
+
+
+    const int* StreamingCornerPointChopper::dimensions() const
+    {
+        return dims_;
+    }
+
+
+
+    const int* StreamingCornerPointChopper::newDimensions() const
+    {
+        return new_dims_;
+    }
+
+
+
+    void StreamingCornerPointChopper::chop(int imin, int imax, int jmin, int jmax, int kmin, int kmax)
+    {
+        if (imin < 0 || imin >= imax || imax > dims_[0]
+            || jmin < 0 || jmin >= jmax || jmax > dims_[1]
+            || kmin < 0 || kmin >= kmax || kmax > dims_[2]) {
+            OPM_THROW(std::runtime_error, "Invalid box i: [" << imin << ", " << imax
+                      << "), j: [" << jmin << ", " << jmax << "), k: [" << kmin << ", " << kmax
+                      << ") for grid of dimensions (" << dims_[0] << ", " << dims_[1]
+                      << ", " << dims_[2] << ")");
+        }
+        const int nx = dims_[0], ny = dims_[1], nz = dims_[2];
+
+        std::map<std::string, Section> sections;
+        sections["COORD"] = Section(6*(nx + 1), ny + 1, 1,
+                                    6*imin, 6*(imax + 1), jmin, jmax + 1, 0, 1);
+        sections["ZCORN"] = Section(2*nx, 2*ny, 2*nz,
+                                    2*imin, 2*imax, 2*jmin, 2*jmax, 2*kmin, 2*kmax);
+        sections["COORD"].dout = &new_COORD_;
+        sections["ZCORN"].dout = &new_ZCORN_;
+
+        // Output vectors are only sized when a keyword is found.
+        std::map<std::string, std::vector<double> > double_fields;
+        std::map<std::string, std::vector<int> > int_fields;
+        for (int p = 0; p < numCellProperties; ++p) {
+            Section& s = sections[cellProperties[p].keyword];
+            s = Section(nx, ny, nz, imin, imax, jmin, jmax, kmin, kmax);
+            if (cellProperties[p].integer) {
+                s.iout = &int_fields[cellProperties[p].keyword];
+            } else {
+                s.dout = &double_fields[cellProperties[p].keyword];
+            }
+        }
+
+        new_COORD_.clear();
+        new_ZCORN_.clear();
+        scan(file_, &sections);
+
+        if (!sections["COORD"].seen || !sections["ZCORN"].seen) {
+            OPM_THROW(std::runtime_error, "GRDECL file " << file_ << " lacks COORD or ZCORN");
+        }
+
+        new_dims_[0] = imax - imin;
+        new_dims_[1] = jmax - jmin;
+        new_dims_[2] = kmax - kmin;
+        double_fields_.clear();
+        int_fields_.clear();
+        for (int p = 0; p < numCellProperties; ++p) {
+            const std::string keyword = cellProperties[p].keyword;
+            if (!sections[keyword].seen) {
+                continue;
+            }
+            if (cellProperties[p].integer) {
+                int_fields_[keyword].swap(int_fields[keyword]);
+            } else {
+                double_fields_[keyword].swap(double_fields[keyword]);
+            }
+        }
+    }
+
+
+
+    bool StreamingCornerPointChopper::scan(const std::string& file,
+                                           std::map<std::string, Section>* sections)
+    {
+        GrdeclTokenizer tokens(file);
+        const char* b;
+        const char* e;
+
+        Section* current = 0;
+        std::string keyword;
+        while (tokens.next(b, e)) {
+            if (current != 0) {
+                const bool last = *(e - 1) == '/';
+                if (last) {
+                    --e;
+                }
+                if (b != e) {
+                    // Either "value" or "count*value".
+                    boost::int64_t count = 1;
+                    const char* star = std::find(b, e, '*');
+                    if (star != e) {
+                        count = convert<int>(b, star, keyword);
+                        b = star + 1;
+                        if (count <= 0 || b == e) {
+                            OPM_THROW(std::runtime_error, "Unsupported repeat or default value in keyword "
+                                      << keyword);
+                        }
+                    }
+                    if (current->iout != 0) {
+                        current->add(count, b, e, *current->iout, keyword);
+                    } else {
+                        current->add(count, b, e, *current->dout, keyword);
+                    }
+                }
+                if (last) {
+                    if (current->index != current->total) {
+                        OPM_THROW(std::runtime_error, "Keyword " << keyword << " has "
+                                  << current->index << " values, expected " << current->total);
+                    }
+                    current->seen = true;
+                    current = 0;
+                }
+                continue;
+            }
+
+            if (!isAlpha(*b)) {
+                // Data of a keyword we do not handle.
+                continue;
+            }
+            keyword.assign(b, e);
+            if (keyword == "SPECGRID" || keyword == "DIMENS") {
+                bool last = false;
+                for (int d = 0; d < 3; ++d) {
+                    if (last || !tokens.next(b, e)) {
+                        OPM_THROW(std::runtime_error, "Incomplete " << keyword << " in " << file);
+                    }
+                    last = *(e - 1) == '/';
+                    dims_[d] = convert<int>(b, last ? e - 1 : e, keyword);
+                }
+                if (sections == 0) {
+                    return true;
+                }
+                // Skip the remaining items, which may contain words.
+                while (!last && tokens.next(b, e)) {
+                    last = *(e - 1) == '/';
+                }
+            } else if (isOperationKeyword(keyword)) {
+                // Skip the records, so that the property names in them
+                // are not taken for keywords.
+                bool empty = true;
+                while (tokens.next(b, e)) {
+                    const bool last = *(e - 1) == '/';
+                    if (last && empty && e - b == 1) {
+                        break;
+                    }
+                    empty = last;
+                }
+            } else if (keyword == "INCLUDE") {
+                if (!tokens.next(b, e)) {
+                    OPM_THROW(std::runtime_error, "Incomplete INCLUDE in " << file);
+                }
+                std::string name(b, e);
+                name.erase(std::remove(name.begin(), name.end(), '\''), name.end());
+                if (!name.empty() && *name.rbegin() == '/') {
+                    name.erase(name.size() - 1);
+                } else {
+                    while (tokens.next(b, e) && *(e - 1) != '/') {
+                    }
+                }
+                boost::filesystem::path path(name);
+                if (path.is_relative()) {
+                    path = boost::filesystem::path(file).parent_path() / path;
+                }
+                if (scan(path.string(), sections) && sections == 0) {
+                    return true;
+                }
+            } else if (sections != 0) {
+                std::map<std::string, Section>::iterator it = sections->find(keyword);
+                if (it != sections->end()) {
+                    current = &it->second;
+                    current->index = 0;
+                    current->col = current->row = current->slab = 0;
+                    if (current->iout != 0) {
+                        current->iout->assign(current->keptSize(), 0);
+                    } else {
+                        current->dout->assign(current->keptSize(), 0.0);
+                    }
+                }
+            }
+        }
+        if (current != 0) {
+            OPM_THROW(std::runtime_error, "Keyword " << keyword << " in " << file
+                      << " is not terminated by '/'");
+        }
+        return dims_[0] > 0;
+    }
+
+
+
+    const std::vector<double>& StreamingCornerPointChopper::coord() const
+    {
+        return new_COORD_;
+    }
+
+
+
+    const std::vector<double>& StreamingCornerPointChopper::zcorn() const
+    {
+        return new_ZCORN_;
+    }
+
+
+
+    bool StreamingCornerPointChopper::hasField(const std::string& keyword) const
+    {
+        return double_fields_.count(keyword) != 0 || int_fields_.count(keyword) != 0;
+    }
+
+
+
+    const std::vector<double>& StreamingCornerPointChopper::doubleField(const std::string& keyword) const
+    {
+        std::map<std::string, std::vector<double> >::const_iterator it = double_fields_.find(keyword);
+        if (it == double_fields_.end()) {
+            OPM_THROW(std::runtime_error, "No floating point field " << keyword << " extracted");
+        }
+        return it->second;
+    }
+
+
+
+    const std::vector<int>& StreamingCornerPointChopper::intField(const std::string& keyword) const
+    {
+        std::map<std::string, std::vector<int> >::const_iterator it = int_fields_.find(keyword);
+        if (it == int_fields_.end()) {
+            OPM_THROW(std::runtime_error, "No integer field " << keyword << " extracted");
+        }
+        return it->second;
+    }
+
+
+
+    void StreamingCornerPointChopper::writeGrdecl(const std::string& filename) const
+    {
+        std::ofstream out(filename.c_str());
+        if (!out) {
+            OPM_THROW(std::runtime_error, "Could not open output file " << filename);
+        }
+        out << "SPECGRID\n" << new_dims_[0] << ' ' << new_dims_[1] << ' ' << new_dims_[2]
+            << " 1 F\n/\n\n";
+
+        out.precision(15);
+        out.setf(std::ios::scientific);
+
+        writeTextField(out, new_COORD_, "COORD", 3);
+        writeTextField(out, new_ZCORN_, "ZCORN", 4);
+        for (int p = 0; p < numCellProperties; ++p) {
+            const std::string keyword = cellProperties[p].keyword;
+            if (!hasField(keyword)) {
+                continue;
+            }
+            if (cellProperties[p].integer) {
+                writeTextField(out, intField(keyword), keyword, cellProperties[p].per_line);
+            } else {
+                writeTextField(out, doubleField(keyword), keyword, cellProperties[p].per_line);
+            }
+        }
+        if (!out) {
+            OPM_THROW(std::runtime_error, "Failed writing " << filename);
+        }
+    }
+
+
+
+    void StreamingCornerPointChopper::writeBinaryGrdecl(const std::string& filename) const
+    {
+        std::ofstream out(filename.c_str(), std::ios::binary);
+        if (!out) {
+            OPM_THROW(std::runtime_error, "Could not open output file " << filename);
+        }
+        std::vector<int> specgrid(new_dims_, new_dims_ + 3);
+        specgrid.push_back(1);
+        specgrid.push_back(0);
+        writeBinaryField(out, specgrid, "SPECGRID");
+        writeBinaryField(out, new_COORD_, "COORD");
+        writeBinaryField(out, new_ZCORN_, "ZCORN");
+        for (int p = 0; p < numCellProperties; ++p) {
+            const std::string keyword = cellProperties[p].keyword;
+            if (!hasField(keyword)) {
+                continue;
+            }
+            if (cellProperties[p].integer) {
+                writeBinaryField(out, intField(keyword), keyword);
+            } else {
+                writeBinaryField(out, doubleField(keyword), keyword);
+            }
+        }
+        if (!out) {
+            OPM_THROW(std::runtime_error, "Failed writing " << filename);
+        }
+    }
+
+} // namespace Opm
@@ -0,0 +1,101 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_STREAMINGCORNERPOINTCHOPPER_HEADER_INCLUDED
+#define OPM_STREAMINGCORNERPOINTCHOPPER_HEADER_INCLUDED
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Opm
+{
+
+    /// Extract a logically Cartesian sub-box of a corner-point grid
+    /// stored in a GRDECL file, without holding the full model in memory.
+    ///
+    /// Unlike CornerPointChopper, which parses the complete deck first,
+    /// this class reads the GRDECL text in fixed size chunks and keeps
+    /// only the values of COORD, ZCORN and the cell properties ACTNUM,
+    /// PORO, NTG, SWCR, SOWCR, PERMX, PERMY, PERMZ and SATNUM that fall
+    /// inside the requested (i, j, k) box.  Peak memory use is therefore
+    /// proportional to the size of the box.
+    ///
+    /// INCLUDE statements are followed.  Keywords other than the ones
+    /// above are ignored; in particular, array operations such as EQUALS
+    /// or MULTIPLY are not applied.
+    class StreamingCornerPointChopper
+    {
+    public:
+        /// Read the grid dimensions (SPECGRID or DIMENS) from a GRDECL file.
+        /// Only the part of the file up to that keyword is read.
+        explicit StreamingCornerPointChopper(const std::string& file);
+
+        /// Dimensions of the input grid.
+        const int* dimensions() const;
+
+        /// Dimensions of the extracted box, valid after chop().
+        const int* newDimensions() const;
+
+        /// Scan the input once and keep the data of the cells
+        /// [imin, imax) x [jmin, jmax) x [kmin, kmax) (zero-based).
+        /// Throws std::runtime_error for an invalid box or inconsistent
+        /// input data.
+        void chop(int imin, int imax, int jmin, int jmax, int kmin, int kmax);
+
+        /// COORD and ZCORN of the extracted box.
+        const std::vector<double>& coord() const;
+        const std::vector<double>& zcorn() const;
+
+        /// Whether a cell property was present in the input.
+        bool hasField(const std::string& keyword) const;
+
+        /// Extracted cell properties.  Throw if the field is not present
+        /// or is of the other type (ACTNUM and SATNUM are integer fields).
+        const std::vector<double>& doubleField(const std::string& keyword) const;
+        const std::vector<int>& intField(const std::string& keyword) const;
+
+        /// Write the extracted box as a GRDECL text file, in the same
+        /// layout as CornerPointChopper::writeGrdecl().
+        void writeGrdecl(const std::string& filename) const;
+
+        /// Write the extracted box as an unformatted (binary) GRDECL file,
+        /// i.e. big-endian Fortran records of SPECGRID, COORD, ZCORN and
+        /// the properties, as read by Eclipse and ERT.
+        void writeBinaryGrdecl(const std::string& filename) const;
+
+    private:
+        struct Section;
+
+        // Read a file and the files it includes.  Without sections, stop
+        // as soon as the dimensions are known; returns whether they are.
+        bool scan(const std::string& file, std::map<std::string, Section>* sections);
+
+        std::string file_;
+        int dims_[3];
+        int new_dims_[3];
+        std::vector<double> new_COORD_;
+        std::vector<double> new_ZCORN_;
+        std::map<std::string, std::vector<double> > double_fields_;
+        std::map<std::string, std::vector<int> > int_fields_;
+    };
+
+} // namespace Opm
+
+#endif // OPM_STREAMINGCORNERPOINTCHOPPER_HEADER_INCLUDED
@@ -36,15 +36,24 @@
 #include "config.h"
 #include <opm/core/io/vag/vag.hpp>
 #include <opm/core/grid/cornerpoint_grid.h>
+#include <opm/core/utility/ErrorMacros.hpp>
+#include <opm/core/utility/scan_double.h>
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <string>
 #include <stdlib.h>
 #include <cmath>
+#include <cstdlib>
 #include <cassert>
 #include <set>
 #include <vector>
 #include <map>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 namespace Opm
 {
     void readPosStruct(std::istream& is,int n,PosStruct& pos_struct){
@@ -404,5 +413,275 @@ namespace Opm
 
     }
 
+    namespace {
+        // Read-only mapping of a whole file.
+        class MappedFile {
+        public:
+            explicit MappedFile(const std::string& filename)
+                : base_(0), len_(0)
+            {
+                const int fd = ::open(filename.c_str(), O_RDONLY);
+                if (fd < 0) {
+                    OPM_THROW(std::runtime_error, "Failed to open vag file " << filename);
+                }
+                struct stat st;
+                if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+                    ::close(fd);
+                    OPM_THROW(std::runtime_error, "Vag file " << filename << " is empty");
+                }
+                len_ = st.st_size;
+                base_ = ::mmap(0, len_, PROT_READ, MAP_PRIVATE, fd, 0);
+                ::close(fd);
+                if (base_ == MAP_FAILED) {
+                    base_ = 0;
+                    OPM_THROW(std::runtime_error, "Failed to map vag file " << filename);
+                }
+                ::madvise(base_, len_, MADV_SEQUENTIAL);
+            }
+            ~MappedFile() { ::munmap(base_, len_); }
+
+            const char* begin() const { return static_cast<const char*>(base_); }
+            const char* end() const { return begin() + len_; }
+
+        private:
+            MappedFile(const MappedFile&);
+            MappedFile& operator=(const MappedFile&);
+
+            void* base_;
+            std::size_t len_;
+        };
+
+        // Whitespace separated tokens of a character buffer, with numbers
+        // converted in place.  The buffer need not be null terminated.
+        class VagScanner {
+        public:
+            VagScanner(const char* begin, const char* end)
+                : p_(begin), end_(end)
+            {}
+
+            bool atEnd()
+            {
+                skipSpace();
+                return p_ == end_;
+            }
+
+            // Next token, which is empty at the end of the buffer.
+            std::string word()
+            {
+                skipSpace();
+                const char* b = p_;
+                while (p_ != end_ && !isSpace(*p_)) {
+                    ++p_;
+                }
+                return std::string(b, p_);
+            }
+
+            void skipLine()
+            {
+                while (p_ != end_ && *p_ != '\n') {
+                    ++p_;
+                }
+            }
+
+            // Skip ahead to the next token that is not a number.
+            void skipNumbers()
+            {
+                while (!atEnd() && !isAlpha(*p_)) {
+                    while (p_ != end_ && !isSpace(*p_)) {
+                        ++p_;
+                    }
+                }
+            }
+
+            int integer()
+            {
+                skipSpace();
+                const char* q = p_;
+                const bool neg = q != end_ && *q == '-';
+                if (q != end_ && (*q == '-' || *q == '+')) {
+                    ++q;
+                }
+                const char* digits = q;
+                long long value = 0;
+                while (q != end_ && isDigit(*q) && value <= 0x7fffffffLL) {
+                    value = 10*value + (*q - '0');
+                    ++q;
+                }
+                if (q == digits || value > 0x7fffffffLL || (q != end_ && !isSpace(*q))) {
+                    fail("an integer");
+                }
+                p_ = q;
+                return int(neg ? -value : value);
+            }
+
+            double real()
+            {
+                skipSpace();
+                double value;
+                const char* q = scan_double(p_, end_, &value);
+                if (q == 0) {
+                    fail("a number");
+                }
+                p_ = q;
+                return value;
+            }
+
+        private:
+            static bool isSpace(char c)
+            {
+                return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+            }
+            static bool isDigit(char c) { return c >= '0' && c <= '9'; }
+            static bool isAlpha(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'); }
+
+            void skipSpace()
+            {
+                while (p_ != end_ && isSpace(*p_)) {
+                    ++p_;
+                }
+            }
+
+            void fail(const char* expected) const
+            {
+                const char* e = p_;
+                while (e != end_ && !isSpace(*e) && e - p_ < 32) {
+                    ++e;
+                }
+                OPM_THROW(std::runtime_error, "Vag reader expected " << expected
+                          << ", found '" << std::string(p_, e) << "'");
+            }
+
+            const char* p_;
+            const char* end_;
+        };
+
+        // Read n lines of the form "count v_1 ... v_count" into a
+        // zero-based compressed mapping.
+        void scanPosStruct(VagScanner& scanner, int n,
+                           std::vector<int>& pos, std::vector<int>& value)
+        {
+            pos.resize(n + 1);
+            pos[0] = 0;
+            for (int i = 0; i < n; ++i) {
+                const int count = scanner.integer();
+                if (count < 0) {
+                    OPM_THROW(std::runtime_error, "Negative entry count in vag mapping");
+                }
+                pos[i + 1] = pos[i] + count;
+                for (int j = 0; j < count; ++j) {
+                    value.push_back(scanner.integer() - 1);
+                }
+            }
+        }
+
+        void checkRange(const std::vector<int>& v, int lo, int hi, const char* what)
+        {
+            for (std::vector<int>::const_iterator it = v.begin(); it != v.end(); ++it) {
+                if (*it < lo || *it >= hi) {
+                    OPM_THROW(std::runtime_error, "Vag file has " << what << " index "
+                              << *it + 1 << " out of range");
+                }
+            }
+        }
+    } // anonymous namespace
+
+    UnstructuredGrid* readVagUnstructuredGrid(const std::string& filename)
+    {
+        MappedFile file(filename);
+        VagScanner scanner(file.begin(), file.end());
+
+        int header_vertices = -1;
+        int header_volumes = -1;
+        int header_faces = -1;
+        std::vector<double> coords;
+        std::vector<int> cell_facepos, cell_faces;
+        std::vector<int> face_nodepos, face_nodes;
+        std::vector<int> face_cells;
+        bool have_cell_faces = false, have_face_nodes = false, have_face_cells = false;
+
+        while (!scanner.atEnd()) {
+            const std::string keyword = scanner.word();
+            if (keyword == "Number") {
+                if (scanner.word() != "of") {
+                    OPM_THROW(std::runtime_error, "Wrong vag format: Not of after Number");
+                }
+                const std::string entity = scanner.word();
+                scanner.skipLine();
+                const int number = scanner.integer();
+                if (entity == "vertices") {
+                    header_vertices = number;
+                } else if (entity == "volumes" || entity == "control") {
+                    header_volumes = number;
+                } else if (entity == "faces") {
+                    header_faces = number;
+                }
+            } else if (keyword == "Vertices") {
+                const int n = scanner.integer();
+                coords.resize(3*std::size_t(std::max(n, 0)));
+                for (std::size_t i = 0; i < coords.size(); ++i) {
+                    coords[i] = scanner.real();
+                }
+            } else if (keyword == "Volumes->Faces" || keyword == "Volumes->faces") {
+                const int n = scanner.integer();
+                cell_faces.reserve(6*std::size_t(std::max(n, 0)));
+                scanPosStruct(scanner, n, cell_facepos, cell_faces);
+                have_cell_faces = true;
+            } else if (keyword == "Faces->Vertices" || keyword == "Faces->vertices") {
+                const int n = scanner.integer();
+                face_nodes.reserve(4*std::size_t(std::max(n, 0)));
+                scanPosStruct(scanner, n, face_nodepos, face_nodes);
+                have_face_nodes = true;
+            } else if (keyword == "Faces->Volumes" || keyword == "Faces->Control") {
+                if (keyword == "Faces->Control") {
+                    scanner.word();
+                }
+                const int n = scanner.integer();
+                face_cells.resize(2*std::size_t(std::max(n, 0)));
+                for (std::size_t i = 0; i < face_cells.size(); ++i) {
+                    face_cells[i] = scanner.integer() - 1;
+                }
+                have_face_cells = true;
+            } else {
+                // Edges, volume to vertex and face to edge mappings and
+                // materials are not part of an UnstructuredGrid.
+                scanner.skipNumbers();
+            }
+        }
+
+        if (!have_cell_faces || !have_face_nodes || !have_face_cells) {
+            OPM_THROW(std::runtime_error, "Vag file " << filename
+                      << " lacks one of the Volumes->Faces, Faces->Vertices"
+                      " and Faces->Volumes sections");
+        }
+        const int nv = int(coords.size()/3);
+        const int nc = int(cell_facepos.size()) - 1;
+        const int nf = int(face_nodepos.size()) - 1;
+        if ((header_vertices >= 0 && header_vertices != nv)
+            || (header_volumes >= 0 && header_volumes != nc)
+            || (header_faces >= 0 && header_faces != nf)
+            || face_cells.size() != 2*std::size_t(nf)) {
+            OPM_THROW(std::runtime_error, "Vag file " << filename
+                      << " has inconsistent numbers of vertices, volumes or faces");
+        }
+        checkRange(face_nodes, 0, nv, "vertex");
+        checkRange(cell_faces, 0, nf, "face");
+        checkRange(face_cells, -1, nc, "volume");
+
+        UnstructuredGrid* grid = allocate_grid(3, nc, nf, face_nodes.size(),
+                                               cell_faces.size(), nv);
+        if (grid == 0) {
+            OPM_THROW(std::runtime_error, "Failed to allocate grid for vag file " << filename);
+        }
+        std::copy(coords.begin(), coords.end(), grid->node_coordinates);
+        std::copy(face_nodepos.begin(), face_nodepos.end(), grid->face_nodepos);
+        std::copy(face_nodes.begin(), face_nodes.end(), grid->face_nodes);
+        std::copy(cell_facepos.begin(), cell_facepos.end(), grid->cell_facepos);
+        std::copy(cell_faces.begin(), cell_faces.end(), grid->cell_faces);
+        std::copy(face_cells.begin(), face_cells.end(), grid->face_cells);
+
+        compute_geometry(grid);
+        return grid;
+    }
+
 
 }
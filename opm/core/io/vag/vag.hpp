@@ -93,6 +93,15 @@ namespace Opm
        \param[out] vag_grid is a reference to a vag_grid struct.
     */
     void readVagGrid(std::istream& is,Opm::VAG& vag_grid);
+    /**
+       Read a grid in the vag format directly into an UnstructuredGrid,
+       including its geometry. The file is mapped into memory and parsed
+       in one pass, and only the sections needed by the grid are converted.
+       Throws std::runtime_error if the file is missing or malformed.
+       \param[in] filename name of the vag file.
+       \return grid to be released with destroy_grid().
+    */
+    UnstructuredGrid* readVagUnstructuredGrid(const std::string& filename);
     /**
        Function to write vag format.
        \param[out]  is is is stream of the file.
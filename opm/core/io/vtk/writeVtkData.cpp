@@ -22,12 +22,17 @@
 #include <opm/core/utility/DataMap.hpp>
 #include <opm/core/grid.h>
 #include <opm/core/utility/ErrorMacros.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 #include <set>
 #include <cmath>
+#include <cstring>
 #include <algorithm>
+#include <fstream>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <vector>
 
 
@@ -109,34 +114,40 @@ namespace Opm
                 os << " " << it->first << "=\"" << it->second << "\"";
             }
             os << ">\n";
-            ++indent_;
+            ++level(os);
         }
         Tag(const std::string& tag, std::ostream& os)
             : name_(tag), os_(os)
         {
             indent(os);
             os << "<" << tag << ">\n";
-            ++indent_;
+            ++level(os);
         }
         ~Tag()
         {
-            --indent_;
+            --level(os_);
             indent(os_);
             os_ << "</" << name_ << ">\n";
         }
         static void indent(std::ostream& os)
         {
-            for (int i = 0; i < indent_; ++i) {
+            for (long i = 0; i < level(os); ++i) {
                 os << "  ";
             }
         }
     private:
-        static int indent_;
+        // The indentation level is stored in the stream itself, so that
+        // separate streams may be written concurrently.
+        static long& level(std::ostream& os)
+        {
+            return os.iword(indent_index_);
+        }
+        static const int indent_index_;
         std::string name_;
         std::ostream& os_;
     };
 
-    int Tag::indent_ = 0;
+    const int Tag::indent_index_ = std::ios_base::xalloc();
 
 
     void writeVtkData(const UnstructuredGrid& grid,
@@ -315,5 +326,365 @@ namespace Opm
         }
     }
 
-} // namespace Opm
 
+    namespace {
+
+        bool isLittleEndian()
+        {
+            const unsigned int one = 1;
+            return *reinterpret_cast<const unsigned char*>(&one) == 1;
+        }
+
+        // Name of the field to be used as the active scalars.
+        std::string activeScalars(const DataMap& data)
+        {
+            if (data.find("saturation") != data.end()) {
+                return "saturation";
+            } else if (data.find("pressure") != data.end()) {
+                return "pressure";
+            }
+            return std::string();
+        }
+
+        // All arrays of a contiguous range of cells, in the layout in
+        // which they are stored in a vtu file.  Nodes are renumbered to
+        // those used by the cells of the piece, in increasing order.
+        struct VtuPiece
+        {
+            int num_points;
+            int num_cells;
+            std::vector<double> points;
+            std::vector<int> connectivity;
+            std::vector<int> offsets;
+            std::vector<int> faces;
+            std::vector<int> faceoffsets;
+            std::vector<unsigned char> types;
+            std::vector<std::string> field_names;
+            std::vector<int> field_comps;
+            std::vector< std::vector<double> > fields;
+        };
+
+        void buildPiece(const UnstructuredGrid& grid,
+                        const DataMap& data,
+                        const int cell_begin,
+                        const int cell_end,
+                        VtuPiece& piece)
+        {
+            const int* fp = grid.cell_facepos;
+            const int* np = grid.face_nodepos;
+
+            // Number the nodes used by the piece.
+            std::vector<int> local_node(grid.number_of_nodes, -1);
+            for (int hf = fp[cell_begin]; hf < fp[cell_end]; ++hf) {
+                const int f = grid.cell_faces[hf];
+                for (int i = np[f]; i < np[f+1]; ++i) {
+                    local_node[grid.face_nodes[i]] = 0;
+                }
+            }
+            piece.num_points = 0;
+            for (int n = 0; n < grid.number_of_nodes; ++n) {
+                if (local_node[n] == 0) {
+                    local_node[n] = piece.num_points++;
+                    piece.points.insert(piece.points.end(),
+                                        grid.node_coordinates + 3*n,
+                                        grid.node_coordinates + 3*(n + 1));
+                } else {
+                    local_node[n] = -1;
+                }
+            }
+
+            piece.num_cells = cell_end - cell_begin;
+            piece.offsets.reserve(piece.num_cells);
+            piece.faceoffsets.reserve(piece.num_cells);
+            piece.types.assign(piece.num_cells, 42); // VTK_POLYHEDRON
+            std::vector<int> cell_pts;
+            for (int c = cell_begin; c < cell_end; ++c) {
+                cell_pts.clear();
+                piece.faces.push_back(fp[c+1] - fp[c]);
+                for (int hf = fp[c]; hf < fp[c+1]; ++hf) {
+                    const int f = grid.cell_faces[hf];
+                    piece.faces.push_back(np[f+1] - np[f]);
+                    for (int i = np[f]; i < np[f+1]; ++i) {
+                        const int n = local_node[grid.face_nodes[i]];
+                        piece.faces.push_back(n);
+                        cell_pts.push_back(n);
+                    }
+                }
+                std::sort(cell_pts.begin(), cell_pts.end());
+                cell_pts.erase(std::unique(cell_pts.begin(), cell_pts.end()),
+                               cell_pts.end());
+                piece.connectivity.insert(piece.connectivity.end(),
+                                          cell_pts.begin(), cell_pts.end());
+                piece.offsets.push_back(piece.connectivity.size());
+                piece.faceoffsets.push_back(piece.faces.size());
+            }
+
+            for (DataMap::const_iterator dit = data.begin(); dit != data.end(); ++dit) {
+                const std::vector<double>& field = *(dit->second);
+                const int num_comps = field.size()/grid.number_of_cells;
+                piece.field_names.push_back(dit->first);
+                piece.field_comps.push_back(num_comps);
+                piece.fields.push_back(std::vector<double>(field.begin() + num_comps*cell_begin,
+                                                           field.begin() + num_comps*cell_end));
+                for (double& value : piece.fields.back()) {
+                    if (std::fabs(value) < std::numeric_limits<double>::min()) {
+                        // Avoiding denormal numbers to work around
+                        // bug in Paraview.
+                        value = 0.0;
+                    }
+                }
+            }
+        }
+
+        // An array of the appended data section.
+        struct AppendedArray
+        {
+            template <typename T>
+            AppendedArray(const std::string& name_arg, const char* type_arg,
+                          const int num_comps_arg, const std::vector<T>& values)
+                : name(name_arg), type(type_arg), num_comps(num_comps_arg),
+                  data(reinterpret_cast<const char*>(values.data())),
+                  size(values.size()*sizeof(T))
+            {
+            }
+            std::string name;
+            std::string type;
+            int num_comps;
+            const char* data;
+            boost::uint64_t size;
+        };
+
+        void writeDataArrayTag(const AppendedArray& array,
+                               const boost::uint64_t offset,
+                               std::ostream& os)
+        {
+            PMap pm;
+            pm["type"] = array.type;
+            pm["Name"] = array.name;
+            pm["NumberOfComponents"] = boost::lexical_cast<std::string>(array.num_comps);
+            pm["format"] = "appended";
+            pm["offset"] = boost::lexical_cast<std::string>(offset);
+            Tag t("DataArray", pm, os);
+        }
+
+        // Write a piece as a vtu file with raw appended data.  Every
+        // array is preceded by its size in bytes as a 64 bit integer.
+        void writePiece(const VtuPiece& piece,
+                        const std::string& scalars,
+                        std::ostream& os)
+        {
+            std::vector<AppendedArray> arrays;
+            arrays.push_back(AppendedArray("Coordinates", "Float64", 3, piece.points));
+            arrays.push_back(AppendedArray("connectivity", "Int32", 1, piece.connectivity));
+            arrays.push_back(AppendedArray("offsets", "Int32", 1, piece.offsets));
+            arrays.push_back(AppendedArray("faces", "Int32", 1, piece.faces));
+            arrays.push_back(AppendedArray("faceoffsets", "Int32", 1, piece.faceoffsets));
+            arrays.push_back(AppendedArray("types", "UInt8", 1, piece.types));
+            const int num_fixed = arrays.size();
+            for (size_t i = 0; i < piece.fields.size(); ++i) {
+                arrays.push_back(AppendedArray(piece.field_names[i], "Float64",
+                                               piece.field_comps[i], piece.fields[i]));
+            }
+            std::vector<boost::uint64_t> offsets(arrays.size() + 1, 0);
+            for (size_t i = 0; i < arrays.size(); ++i) {
+                offsets[i+1] = offsets[i] + sizeof(boost::uint64_t) + arrays[i].size;
+            }
+
+            os << "<?xml version=\"1.0\"?>\n";
+            PMap pm;
+            pm["type"] = "UnstructuredGrid";
+            pm["version"] = "1.0";
+            pm["byte_order"] = isLittleEndian() ? "LittleEndian" : "BigEndian";
+            pm["header_type"] = "UInt64";
+            Tag vtkfiletag("VTKFile", pm, os);
+            {
+                Tag ugtag("UnstructuredGrid", os);
+                pm.clear();
+                pm["NumberOfPoints"] = boost::lexical_cast<std::string>(piece.num_points);
+                pm["NumberOfCells"] = boost::lexical_cast<std::string>(piece.num_cells);
+                Tag piecetag("Piece", pm, os);
+                {
+                    Tag pointstag("Points", os);
+                    writeDataArrayTag(arrays[0], offsets[0], os);
+                }
+                {
+                    Tag cellstag("Cells", os);
+                    for (int i = 1; i < num_fixed; ++i) {
+                        writeDataArrayTag(arrays[i], offsets[i], os);
+                    }
+                }
+                {
+                    pm.clear();
+                    if (!scalars.empty()) {
+                        pm["Scalars"] = scalars;
+                    }
+                    Tag celldatatag("CellData", pm, os);
+                    for (size_t i = num_fixed; i < arrays.size(); ++i) {
+                        writeDataArrayTag(arrays[i], offsets[i], os);
+                    }
+                }
+            }
+            pm.clear();
+            pm["encoding"] = "raw";
+            Tag appendedtag("AppendedData", pm, os);
+            Tag::indent(os);
+            os << '_';
+            for (size_t i = 0; i < arrays.size(); ++i) {
+                os.write(reinterpret_cast<const char*>(&arrays[i].size), sizeof(boost::uint64_t));
+                os.write(arrays[i].data, arrays[i].size);
+            }
+            os << '\n';
+        }
+
+    } // anonymous namespace
+
+
+    void writeVtkDataBinary(const std::array<int, 3>& dims,
+                            const std::array<double, 3>& cell_size,
+                            const DataMap& data,
+                            std::ostream& os)
+    {
+        const int num_cells = dims[0]*dims[1]*dims[2];
+
+        os << "# vtk DataFile Version 2.0\n";
+        os << "Structured Grid\n";
+        os << "BINARY\n";
+        os << "DATASET STRUCTURED_POINTS\n";
+        os << "DIMENSIONS "
+           << dims[0] + 1 << " " << dims[1] + 1 << " " << dims[2] + 1 << "\n";
+        os << "ORIGIN " << 0.0 << " " << 0.0 << " " << 0.0 << "\n";
+        os << "SPACING "
+           << cell_size[0] << " " << cell_size[1] << " " << cell_size[2] << "\n";
+
+        // The legacy format stores binary data in big endian byte order.
+        const bool swap = isLittleEndian();
+        std::vector<boost::uint32_t> buffer(num_cells);
+        os << "CELL_DATA " << num_cells << '\n';
+        for (DataMap::const_iterator dit = data.begin(); dit != data.end(); ++dit) {
+            std::string name = dit->first;
+            os << "SCALARS " << name << " float" << '\n';
+            os << "LOOKUP_TABLE " << name << "_table " << '\n';
+            const std::vector<double>& field = *(dit->second);
+            // As for the ascii output, only the first data item for
+            // every cell is written.
+            const int stride = field.size()/num_cells;
+            for (int c = 0; c < num_cells; ++c) {
+                const float value = field[stride*c];
+                boost::uint32_t bits;
+                std::memcpy(&bits, &value, sizeof bits);
+                if (swap) {
+                    bits = ((bits & 0x000000ffu) << 24) | ((bits & 0x0000ff00u) << 8)
+                        | ((bits & 0x00ff0000u) >> 8) | ((bits & 0xff000000u) >> 24);
+                }
+                buffer[c] = bits;
+            }
+            os.write(reinterpret_cast<const char*>(buffer.data()),
+                     num_cells*sizeof(boost::uint32_t));
+            os << '\n';
+        }
+    }
+
+
+    void writeVtkDataBinary(const UnstructuredGrid& grid,
+                            const DataMap& data,
+                            std::ostream& os)
+    {
+        if (grid.dimensions != 3) {
+            OPM_THROW(std::runtime_error, "Vtk output for 3d grids only");
+        }
+        VtuPiece piece;
+        buildPiece(grid, data, 0, grid.number_of_cells, piece);
+        writePiece(piece, activeScalars(data), os);
+    }
+
+
+    void writeVtkDataParallel(const UnstructuredGrid& grid,
+                              const DataMap& data,
+                              const std::string& basename,
+                              const int num_pieces)
+    {
+        if (grid.dimensions != 3) {
+            OPM_THROW(std::runtime_error, "Vtk output for 3d grids only");
+        }
+        if (num_pieces < 1) {
+            OPM_THROW(std::runtime_error, "Number of vtk pieces must be positive, got " << num_pieces);
+        }
+
+        // The piece files are referred to relative to the master file.
+        const std::string leafname = boost::filesystem::path(basename).filename().string();
+        std::vector<std::string> piece_names(num_pieces);
+        for (int p = 0; p < num_pieces; ++p) {
+            piece_names[p] = leafname + "_" + boost::lexical_cast<std::string>(p) + ".vtu";
+        }
+
+        const std::string scalars = activeScalars(data);
+        const int num_cells = grid.number_of_cells;
+        std::vector<int> failed(num_pieces, 0);
+#pragma omp parallel for schedule(dynamic, 1)
+        for (int p = 0; p < num_pieces; ++p) {
+            const int cell_begin = (long(num_cells)*p)/num_pieces;
+            const int cell_end = (long(num_cells)*(p + 1))/num_pieces;
+            std::ofstream os((basename + "_" + boost::lexical_cast<std::string>(p) + ".vtu").c_str(),
+                             std::ios::out | std::ios::binary);
+            if (!os) {
+                failed[p] = 1;
+                continue;
+            }
+            VtuPiece piece;
+            buildPiece(grid, data, cell_begin, cell_end, piece);
+            writePiece(piece, scalars, os);
+            failed[p] = !os;
+        }
+        for (int p = 0; p < num_pieces; ++p) {
+            if (failed[p]) {
+                OPM_THROW(std::runtime_error, "Failed to write vtk piece " << basename
+                          << "_" << p << ".vtu");
+            }
+        }
+
+        const std::string master_name = basename + ".pvtu";
+        std::ofstream os(master_name.c_str());
+        if (!os) {
+            OPM_THROW(std::runtime_error, "Failed to open " << master_name);
+        }
+        os << "<?xml version=\"1.0\"?>\n";
+        PMap pm;
+        pm["type"] = "PUnstructuredGrid";
+        pm["version"] = "1.0";
+        pm["byte_order"] = isLittleEndian() ? "LittleEndian" : "BigEndian";
+        pm["header_type"] = "UInt64";
+        Tag vtkfiletag("VTKFile", pm, os);
+        pm.clear();
+        pm["GhostLevel"] = "0";
+        Tag pugtag("PUnstructuredGrid", pm, os);
+        {
+            Tag pointstag("PPoints", os);
+            pm.clear();
+            pm["type"] = "Float64";
+            pm["Name"] = "Coordinates";
+            pm["NumberOfComponents"] = "3";
+            Tag t("PDataArray", pm, os);
+        }
+        {
+            pm.clear();
+            if (!scalars.empty()) {
+                pm["Scalars"] = scalars;
+            }
+            Tag celldatatag("PCellData", pm, os);
+            for (DataMap::const_iterator dit = data.begin(); dit != data.end(); ++dit) {
+                pm.clear();
+                pm["type"] = "Float64";
+                pm["Name"] = dit->first;
+                const int num_comps = dit->second->size()/num_cells;
+                pm["NumberOfComponents"] = boost::lexical_cast<std::string>(num_comps);
+                Tag t("PDataArray", pm, os);
+            }
+        }
+        for (int p = 0; p < num_pieces; ++p) {
+            pm.clear();
+            pm["Source"] = piece_names[p];
+            Tag t("Piece", pm, os);
+        }
+    }
+
+} // namespace Opm
@@ -43,6 +43,29 @@ namespace Opm
     void writeVtkData(const UnstructuredGrid& grid,
                       const DataMap& data,
                       std::ostream& os);
+
+    /// Vtk output for cartesian grids, using the binary variant of
+    /// the legacy format.  The stream should be opened in binary mode.
+    void writeVtkDataBinary(const std::array<int, 3>& dims,
+                            const std::array<double, 3>& cell_size,
+                            const DataMap& data,
+                            std::ostream& os);
+
+    /// Vtk output for general grids, with all arrays stored as raw
+    /// binary appended data.  The stream should be opened in binary mode.
+    void writeVtkDataBinary(const UnstructuredGrid& grid,
+                            const DataMap& data,
+                            std::ostream& os);
+
+    /// Partitioned vtk output for general grids.  The cells are split
+    /// in num_pieces contiguous ranges, each of which is written as in
+    /// writeVtkDataBinary() to the file basename_<piece>.vtu.  The
+    /// pieces are written concurrently if OpenMP is enabled.  The file
+    /// basename.pvtu, referring to all the pieces, is also written.
+    void writeVtkDataParallel(const UnstructuredGrid& grid,
+                              const DataMap& data,
+                              const std::string& basename,
+                              const int num_pieces);
 } // namespace Opm
 
 #endif // OPM_WRITEVTKDATA_HEADER_INCLUDED
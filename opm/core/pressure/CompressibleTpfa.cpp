@@ -28,6 +28,7 @@
 #include <opm/core/linalg/sparse_sys.h>
 #include <opm/core/utility/ErrorMacros.hpp>
 #include <opm/core/utility/miscUtilities.hpp>
+#include <opm/core/utility/miscUtilitiesBlackoil.hpp>
 #include <opm/core/wells.h>
 #include <opm/core/simulator/BlackoilState.hpp>
 #include <opm/core/simulator/WellState.hpp>
@@ -273,7 +274,6 @@ namespace Opm
         //
         // std::vector<double> cell_A_;
         // std::vector<double> cell_dA_;
-        // std::vector<double> cell_viscosity_;
         // std::vector<double> cell_phasemob_;
         // std::vector<double> cell_voldisc_;
         // std::vector<double> face_A_;
@@ -301,7 +301,6 @@ namespace Opm
         //
         // std::vector<double> cell_A_;
         // std::vector<double> cell_dA_;
-        // std::vector<double> cell_viscosity_;
         // std::vector<double> cell_phasemob_;
         // std::vector<double> cell_voldisc_;
         // std::vector<double> porevol_;   // Only modified if rock_comp_props_ is non-null.
@@ -315,14 +314,9 @@ namespace Opm
         cell_A_.resize(nc*np*np);
         cell_dA_.resize(nc*np*np);
         props_.matrix(nc, cell_p, cell_T, cell_z, &allcells_[0], &cell_A_[0], &cell_dA_[0]);
-        cell_viscosity_.resize(nc*np);
-        props_.viscosity(nc, cell_p, cell_T, cell_z, &allcells_[0], &cell_viscosity_[0], 0);
         cell_phasemob_.resize(nc*np);
-        props_.relperm(nc, cell_s, &allcells_[0], &cell_phasemob_[0], 0);
-        std::transform(cell_phasemob_.begin(), cell_phasemob_.end(),
-                       cell_viscosity_.begin(),
-                       cell_phasemob_.begin(),
-                       std::divides<double>());
+        computeMobilities(props_, nc, &allcells_[0], cell_p, cell_T, cell_z, cell_s, 0,
+                          &cell_phasemob_[0], 0, 0, 0, 0);
         // Volume discrepancy: we have that
         //     z = Au, voldiscr = sum(u) - 1,
         // but I am not sure it is actually needed.
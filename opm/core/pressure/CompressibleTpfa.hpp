@@ -140,7 +140,6 @@ namespace Opm
         // ------ Data that will be modified for every solver iteration. ------
         std::vector<double> cell_A_;
         std::vector<double> cell_dA_;
-        std::vector<double> cell_viscosity_;
         std::vector<double> cell_phasemob_;
         std::vector<double> cell_voldisc_;
         std::vector<double> face_A_;
@@ -340,13 +340,18 @@ namespace Opm
                             gravity_ ? gravity_[2] : 0.0, true, wdp_);
         }
         // totmob_, omega_, gpress_omegaweighted_
+        const int nc = grid_.number_of_cells;
+        totmob_.resize(nc);
         if (gravity_) {
-            computeTotalMobilityOmega(props_, allcells_, state.saturation(), totmob_, omega_);
+            omega_.resize(nc);
+            computeMobilities(props_, nc, &allcells_[0], &state.saturation()[0],
+                              0, 0, &totmob_[0], &omega_[0], 0);
             mim_ip_density_update(grid_.number_of_cells, grid_.cell_facepos,
                                   &omega_[0],
                                   &gpress_[0], &gpress_omegaweighted_[0]);
         } else {
-            computeTotalMobility(props_, allcells_, state.saturation(), totmob_);
+            computeMobilities(props_, nc, &allcells_[0], &state.saturation()[0],
+                              0, 0, &totmob_[0], 0, 0);
         }
         // trans_
         tpfa_eff_trans_compute(const_cast<UnstructuredGrid*>(&grid_), &totmob_[0], &htrans_[0], &trans_[0]);
@@ -7,6 +7,9 @@
 
 #include <opm/core/linalg/sparse_sys.h>
 
+#include <opm/core/grid.h>
+#include <opm/core/grid/cart_grid.h>
+
 #include <opm/core/wells.h>
 #include <opm/core/well_controls.h>
 #include <opm/core/pressure/flow_bc.h>
@@ -37,11 +40,110 @@ struct ifs_tpfa_impl {
     double *fgrav;              /* Accumulated grav contrib/face */
     double *work;
 
+    /* Cartesian topology: seven-point stencil rows. */
+    int     cartesian;
+    int     nx, ny, nz;
+
     /* Linear storage */
     double *ddata;
 };
 
 
+/* ---------------------------------------------------------------------- */
+/* Positions, relative to the start of row c, of the matrix entries for   */
+/* the neighbours across faces tagged 0..5 (pos[0..5]) and of the         */
+/* diagonal (pos[6]) in a grid of Cartesian topology.  The columns of a   */
+/* sorted row are c-nx*ny, c-nx, c-1, c, c+1, c+nx, c+nx*ny (those        */
+/* present), followed by any well connections.  A position is -1 if the  */
+/* face is on the boundary.                                               */
+/* ---------------------------------------------------------------------- */
+static void
+cartesian_row_positions(const struct ifs_tpfa_impl *pimpl, int c, int *pos)
+/* ---------------------------------------------------------------------- */
+{
+    int i, j, k, n;
+
+    i = c % pimpl->nx;
+    j = (c / pimpl->nx) % pimpl->ny;
+    k = c / (pimpl->nx * pimpl->ny);
+
+    n = 0;
+    pos[4] = (k > 0)             ? n++ : -1;
+    pos[2] = (j > 0)             ? n++ : -1;
+    pos[0] = (i > 0)             ? n++ : -1;
+    pos[6] =                       n++     ;
+    pos[1] = (i < pimpl->nx - 1) ? n++ : -1;
+    pos[3] = (j < pimpl->ny - 1) ? n++ : -1;
+    pos[5] = (k < pimpl->nz - 1) ? n++ : -1;
+}
+
+
+/* ---------------------------------------------------------------------- */
+static size_t
+diagonal_index(const struct ifs_tpfa_data *h, int c)
+/* ---------------------------------------------------------------------- */
+{
+    int pos[7];
+
+    if (h->pimpl->cartesian) {
+        cartesian_row_positions(h->pimpl, c, pos);
+
+        return h->A->ia[c] + pos[6];
+    }
+
+    return csrmatrix_elm_index(c, c, h->A);
+}
+
+
+/* ---------------------------------------------------------------------- */
+/* v = A*u.  Interior cell rows of a Cartesian-topology matrix with no   */
+/* well connections are the fixed seven-point stencil.                    */
+/* ---------------------------------------------------------------------- */
+static void
+mult_cartesian_matrix(const struct CSRMatrix     *A    ,
+                      const struct ifs_tpfa_impl *pimpl,
+                      const double               *u    ,
+                      double                     *v    )
+/* ---------------------------------------------------------------------- */
+{
+    int           c, i, j, k, nx, nxy, nc, p;
+    const double *a;
+
+    nx  = pimpl->nx;
+    nxy = pimpl->nx * pimpl->ny;
+    nc  = nxy * pimpl->nz;
+
+#pragma omp parallel for private(i, j, k, p, a)
+    for (c = 0; c < (int) A->m; c++) {
+        i = c % nx;
+        j = (c / nx) % pimpl->ny;
+        k = c / nxy;
+
+        a = A->sa + A->ia[c];
+
+        if ((c < nc) && (A->ia[c + 1] - A->ia[c] == 7) &&
+            (i > 0) && (i < nx        - 1) &&
+            (j > 0) && (j < pimpl->ny - 1) &&
+            (k > 0) && (k < pimpl->nz - 1)) {
+            v[c]  = 0.0;
+            v[c] += a[0] * u[c - nxy];
+            v[c] += a[1] * u[c - nx ];
+            v[c] += a[2] * u[c - 1  ];
+            v[c] += a[3] * u[c      ];
+            v[c] += a[4] * u[c + 1  ];
+            v[c] += a[5] * u[c + nx ];
+            v[c] += a[6] * u[c + nxy];
+        }
+        else {
+            v[c] = 0.0;
+            for (p = A->ia[c]; p < A->ia[c + 1]; p++) {
+                v[c] += A->sa[p] * u[ A->ja[p] ];
+            }
+        }
+    }
+}
+
+
 /* ---------------------------------------------------------------------- */
 static void
 impl_deallocate(struct ifs_tpfa_impl *pimpl)
@@ -78,6 +180,11 @@ impl_allocate(struct UnstructuredGrid *G,
     new = malloc(1 * sizeof *new);
 
     if (new != NULL) {
+        new->cartesian = grid_has_cartesian_topology(G);
+        new->nx        = G->cartdims[0];
+        new->ny        = G->cartdims[1];
+        new->nz        = G->cartdims[2];
+
         new->ddata = malloc(ddata_sz * sizeof *new->ddata);
 
         if (new->ddata == NULL) {
@@ -582,27 +689,15 @@ well_solution(const struct UnstructuredGrid *G   ,
 
 /* ---------------------------------------------------------------------- */
 static void
-assemble_incompressible(struct UnstructuredGrid      *G     ,
-                        const struct ifs_tpfa_forces *F     ,
-                        const double                 *trans ,
-                        const double                 *gpress,
-                        struct ifs_tpfa_data         *h     ,
-                        int                          *singular,
-                        int                          *ok    )
+assemble_general_flux(struct UnstructuredGrid *G    ,
+                      const double            *trans,
+                      struct ifs_tpfa_data    *h    )
 /* ---------------------------------------------------------------------- */
 {
-    int c1, c2, c, i, f, j1, j2;
-
-    int res_is_neumann, wells_are_rate;
-
+    int    c1, c2, c, i, f;
+    size_t j1, j2;
     double s;
 
-    *ok = 1;
-    csrmatrix_zero(         h->A);
-    vector_zero   (h->A->m, h->b);
-
-    compute_grav_term(G, gpress, h->pimpl->fgrav);
-
     for (c = i = 0; c < G->number_of_cells; c++) {
         j1 = csrmatrix_elm_index(c, c, h->A);
 
@@ -625,6 +720,73 @@ assemble_incompressible(struct UnstructuredGrid      *G     ,
             }
         }
     }
+}
+
+
+/* ---------------------------------------------------------------------- */
+/* Inter-cell flux contributions for a grid of Cartesian topology.  Same  */
+/* operations, in the same order, as assemble_general_flux(), but matrix  */
+/* positions follow from the face tags rather than from row searches.     */
+/* ---------------------------------------------------------------------- */
+static void
+assemble_cartesian_flux(struct UnstructuredGrid *G    ,
+                        const double            *trans,
+                        struct ifs_tpfa_data    *h    )
+/* ---------------------------------------------------------------------- */
+{
+    int     c, i, f, t, pos[7];
+    double  s, *row;
+
+#pragma omp parallel for private(i, f, t, pos, s, row)
+    for (c = 0; c < G->number_of_cells; c++) {
+        cartesian_row_positions(h->pimpl, c, pos);
+
+        row = h->A->sa + h->A->ia[c];
+
+        for (i = G->cell_facepos[c]; i < G->cell_facepos[c + 1]; i++) {
+            f = G->cell_faces  [i];
+            t = G->cell_facetag[i];
+
+            s = 2.0*(G->face_cells[2*f + 0] == c) - 1.0;
+
+            h->b[c] -= trans[f] * (s * h->pimpl->fgrav[f]);
+
+            if (pos[t] >= 0) {
+                row[pos[6]] += trans[f];
+                row[pos[t]] -= trans[f];
+            }
+        }
+    }
+}
+
+
+/* ---------------------------------------------------------------------- */
+static void
+assemble_incompressible(struct UnstructuredGrid      *G     ,
+                        const struct ifs_tpfa_forces *F     ,
+                        const double                 *trans ,
+                        const double                 *gpress,
+                        struct ifs_tpfa_data         *h     ,
+                        int                          *singular,
+                        int                          *ok    )
+/* ---------------------------------------------------------------------- */
+{
+    int c;
+
+    int res_is_neumann, wells_are_rate;
+
+    *ok = 1;
+    csrmatrix_zero(         h->A);
+    vector_zero   (h->A->m, h->b);
+
+    compute_grav_term(G, gpress, h->pimpl->fgrav);
+
+    if (h->pimpl->cartesian) {
+        assemble_cartesian_flux(G, trans, h);
+    }
+    else {
+        assemble_general_flux(G, trans, h);
+    }
 
 
     /* Assemble contributions from driving forces other than gravity */
@@ -747,7 +909,7 @@ ifs_tpfa_assemble_comprock(struct UnstructuredGrid      *G        ,
      */
     if (ok) {
         for (c = 0; c < G->number_of_cells; c++) {
-            j = csrmatrix_elm_index(c, c, h->A);
+            j = diagonal_index(h, c);
 
             d = porevol[c] * rock_comp[c] / dt;
 
@@ -788,10 +950,15 @@ ifs_tpfa_assemble_comprock_increment(struct UnstructuredGrid      *G        ,
 
     if (ok) {
         v = h->pimpl->work;
-        mult_csr_matrix(h->A, prev_pressure, v);
+        if (h->pimpl->cartesian) {
+            mult_cartesian_matrix(h->A, h->pimpl, prev_pressure, v);
+        }
+        else {
+            mult_csr_matrix(h->A, prev_pressure, v);
+        }
 
         for (c = 0; c < G->number_of_cells; c++) {
-            j = csrmatrix_elm_index(c, c, h->A);
+            j = diagonal_index(h, c);
 
             dpvdt = (porevol[c] - initial_porevolume[c]) / dt;
 
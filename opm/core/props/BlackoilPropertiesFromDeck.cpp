@@ -23,6 +23,18 @@
 
 namespace Opm
 {
+    namespace
+    {
+        // Smaller loops are not worth starting threads for.
+        const int minParallelSize = 10000;
+
+        BlackoilPropertiesFromDeck::Workspace& threadWorkspace()
+        {
+            static thread_local BlackoilPropertiesFromDeck::Workspace ws;
+            return ws;
+        }
+    }
+
     BlackoilPropertiesFromDeck::BlackoilPropertiesFromDeck(Opm::DeckConstPtr deck,
                                                            Opm::EclipseStateConstPtr eclState,
                                                            const UnstructuredGrid& grid,
@@ -103,17 +115,29 @@ namespace Opm
                                                const int* cells,
                                                double* mu,
                                                double* dmudp) const
+    {
+        viscosity(n, p, T, z, cells, mu, dmudp, threadWorkspace());
+    }
+
+    void BlackoilPropertiesFromDeck::viscosity(const int n,
+                                               const double* p,
+                                               const double* T,
+                                               const double* z,
+                                               const int* cells,
+                                               double* mu,
+                                               double* dmudp,
+                                               Workspace& ws) const
     {
         if (dmudp) {
             OPM_THROW(std::runtime_error, "BlackoilPropertiesFromDeck::viscosity()  --  derivatives of viscosity not yet implemented.");
         } else {
             const int *cellPvtTableIdx = cellPvtRegionIndex();
             assert(cellPvtTableIdx != 0);
-            std::vector<int> pvtTableIdx(n);
+            ws.pvtTableIdx.resize(n);
             for (int i = 0; i < n; ++ i)
-                pvtTableIdx[i] = cellPvtTableIdx[cells[i]];
+                ws.pvtTableIdx[i] = cellPvtTableIdx[cells[i]];
 
-            pvt_.mu(n, &pvtTableIdx[0], p, T, z, mu);
+            pvt_.mu(n, &ws.pvtTableIdx[0], p, T, z, mu, ws.pvt);
         }
     }
 
@@ -135,25 +159,41 @@ namespace Opm
                                             const int* cells,
                                             double* A,
                                             double* dAdp) const
+    {
+        matrix(n, p, T, z, cells, A, dAdp, threadWorkspace());
+    }
+
+    void BlackoilPropertiesFromDeck::matrix(const int n,
+                                            const double* p,
+                                            const double* T,
+                                            const double* z,
+                                            const int* cells,
+                                            double* A,
+                                            double* dAdp,
+                                            Workspace& ws) const
     {
         const int np = numPhases();
 
         const int *cellPvtTableIdx = cellPvtRegionIndex();
-        std::vector<int> pvtTableIdx(n);
+        ws.pvtTableIdx.resize(n);
         for (int i = 0; i < n; ++ i)
-            pvtTableIdx[i] = cellPvtTableIdx[cells[i]];
+            ws.pvtTableIdx[i] = cellPvtTableIdx[cells[i]];
 
-        B_.resize(n*np);
-        R_.resize(n*np);
+        ws.B.resize(n*np);
+        ws.R.resize(n*np);
         if (dAdp) {
-            dB_.resize(n*np);
-            dR_.resize(n*np);
-            pvt_.dBdp(n, &pvtTableIdx[0], p, T, z, &B_[0], &dB_[0]);
-            pvt_.dRdp(n, &pvtTableIdx[0], p, z, &R_[0], &dR_[0]);
+            ws.dB.resize(n*np);
+            ws.dR.resize(n*np);
+            pvt_.dBdp(n, &ws.pvtTableIdx[0], p, T, z, &ws.B[0], &ws.dB[0], ws.pvt);
+            pvt_.dRdp(n, &ws.pvtTableIdx[0], p, z, &ws.R[0], &ws.dR[0], ws.pvt);
         } else {
-            pvt_.B(n, &pvtTableIdx[0], p, T, z, &B_[0]);
-            pvt_.R(n, &pvtTableIdx[0], p, z, &R_[0]);
+            pvt_.B(n, &ws.pvtTableIdx[0], p, T, z, &ws.B[0], ws.pvt);
+            pvt_.R(n, &ws.pvtTableIdx[0], p, z, &ws.R[0], ws.pvt);
         }
+        const double* B_vals = &ws.B[0];
+        const double* R_vals = &ws.R[0];
+        const double* dB_vals = dAdp ? &ws.dB[0] : 0;
+        const double* dR_vals = dAdp ? &ws.dR[0] : 0;
         const int* phase_pos = pvt_.phasePosition();
         bool oil_and_gas = pvt_.phaseUsed()[BlackoilPhases::Liquid] &&
             pvt_.phaseUsed()[BlackoilPhases::Vapour];
@@ -161,18 +201,18 @@ namespace Opm
         const int g = phase_pos[BlackoilPhases::Vapour];
 
         // Compute A matrix
-// #pragma omp parallel for
+#pragma omp parallel for if (n > minParallelSize)
         for (int i = 0; i < n; ++i) {
             double* m = A + i*np*np;
             std::fill(m, m + np*np, 0.0);
             // Diagonal entries.
             for (int phase = 0; phase < np; ++phase) {
-                m[phase + phase*np] = 1.0/B_[i*np + phase];
+                m[phase + phase*np] = 1.0/B_vals[i*np + phase];
             }
             // Off-diagonal entries.
             if (oil_and_gas) {
-                m[o + g*np] = R_[i*np + g]/B_[i*np + g];
-                m[g + o*np] = R_[i*np + o]/B_[i*np + o];
+                m[o + g*np] = R_vals[i*np + g]/B_vals[i*np + g];
+                m[g + o*np] = R_vals[i*np + o]/B_vals[i*np + o];
             }
         }
 
@@ -186,15 +226,15 @@ namespace Opm
         // The B matrix is diagonal and that fact is exploited in the
         // following implementation.
         if (dAdp) {
-// #pragma omp parallel for
-            // (1): dA/dp <- A
-            std::copy(A, A + n*np*np, dAdp);
-
+#pragma omp parallel for if (n > minParallelSize)
             for (int i = 0; i < n; ++i) {
                 double*       m  = dAdp + i*np*np;
 
+                // (1): dA/dp <- A
+                std::copy(A + i*np*np, A + (i + 1)*np*np, m);
+
                 // (2): dA/dp <- -dA/dp*(dB/dp) == -A*(dB/dp)
-                const double* dB = & dB_[i * np];
+                const double* dB = & dB_vals[i * np];
                 for (int col = 0; col < np; ++col) {
                     for (int row = 0; row < np; ++row) {
                         m[col*np + row] *= - dB[ col ]; // Note sign.
@@ -203,14 +243,14 @@ namespace Opm
 
                 if (oil_and_gas) {
                     // (2b): dA/dp += dR/dp (== dR/dp - A*(dB/dp))
-                    const double* dR = & dR_[i * np];
+                    const double* dR = & dR_vals[i * np];
 
                     m[o*np + g] += dR[ o ];
                     m[g*np + o] += dR[ g ];
                 }
 
                 // (3): dA/dp *= inv(B) (== final result)
-                const double* B = & B_[i * np];
+                const double* B = & B_vals[i * np];
                 for (int col = 0; col < np; ++col) {
                     for (int row = 0; row < np; ++row) {
                         m[col*np + row] /= B[ col ];
@@ -233,7 +273,7 @@ namespace Opm
                                              double* rho) const
     {
         const int np = numPhases();
-// #pragma omp parallel for
+#pragma omp parallel for if (n > minParallelSize)
         for (int i = 0; i < n; ++i) {
             int cellIdx = cells?cells[i]:i;
             int pvtRegionIdx = getTableIndex_(cellPvtRegionIndex(), cellIdx);
@@ -30,6 +30,7 @@
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 
 #include <memory>
+#include <vector>
 
 struct UnstructuredGrid;
 
@@ -38,6 +39,10 @@ namespace Opm
 
     /// Concrete class implementing the blackoil property interface,
     /// reading all data and properties from eclipse deck input.
+    /// The const evaluation methods keep no scratch state in the object,
+    /// so they may be called concurrently, e.g. on disjoint cell ranges.
+    /// viscosity() and matrix() have overloads taking a Workspace for
+    /// their temporaries; the others use one private to the calling thread.
     class BlackoilPropertiesFromDeck : public BlackoilPropertiesInterface
     {
     public:
@@ -59,6 +64,8 @@ namespace Opm
         ///                        pvt_tab_size (200)          number of uniform sample points for dead-oil pvt tables.
         ///                        sat_tab_size (200)          number of uniform sample points for saturation tables.
         ///                        threephase_model("simple")  three-phase relperm model (accepts "simple" and "stone2").
+        ///                        sat_eps_baked (false)       fold end-point scaling into per-cell relperm tables
+        ///                                                    at initialization (gwseg model, no hysteresis).
         ///                      For both size parameters, a 0 or negative value indicates that no spline fitting is to
         ///                      be done, and the input fluid data used directly for linear interpolation.
         BlackoilPropertiesFromDeck(Opm::DeckConstPtr deck,
@@ -158,6 +165,38 @@ namespace Opm
                             double* A,
                             double* dAdp) const;
 
+        /// Temporaries of viscosity() and matrix(), reused between calls.
+        /// Threads evaluating concurrently must use separate workspaces.
+        struct Workspace
+        {
+            std::vector<int> pvtTableIdx;
+            std::vector<double> B;
+            std::vector<double> dB;
+            std::vector<double> R;
+            std::vector<double> dR;
+            BlackoilPvtProperties::Workspace pvt;
+        };
+
+        /// As viscosity() above, with the temporaries in ws.
+        void viscosity(const int n,
+                       const double* p,
+                       const double* T,
+                       const double* z,
+                       const int* cells,
+                       double* mu,
+                       double* dmudp,
+                       Workspace& ws) const;
+
+        /// As matrix() above, with the temporaries in ws.
+        void matrix(const int n,
+                    const double* p,
+                    const double* T,
+                    const double* z,
+                    const int* cells,
+                    double* A,
+                    double* dAdp,
+                    Workspace& ws) const;
+
 
         /// Densities of stock components at reservoir conditions.
         /// \param[in]  n      Number of data points.
@@ -260,10 +299,6 @@ namespace Opm
         std::vector<int> cellPvtRegionIdx_;
         BlackoilPvtProperties pvt_;
         std::shared_ptr<SaturationPropsInterface> satprops_;
-        mutable std::vector<double> B_;
-        mutable std::vector<double> dB_;
-        mutable std::vector<double> R_;
-        mutable std::vector<double> dR_;
     };
 
 
@@ -91,6 +91,7 @@ namespace Opm
         // Unfortunate lack of pointer smartness here...
         const int sat_samples = param.getDefault("sat_tab_size", -1);
         std::string threephase_model = param.getDefault<std::string>("threephase_model", "gwseg");
+        const bool sat_eps_baked = param.getDefault("sat_eps_baked", false);
         if (deck->hasKeyword("ENDSCALE") && threephase_model != "gwseg") {
             OPM_THROW(std::runtime_error, "Sorry, end point scaling currently available for the 'gwseg' model only.");
         }
@@ -113,6 +114,9 @@ namespace Opm
                 satprops_.reset(ptr);
                 ptr->init(deck, eclState, number_of_cells, global_cell, begin_cell_centroids,
                           dimension, sat_samples);
+                if (sat_eps_baked) {
+                    ptr->bakeEPS();
+                }
             } else {
                 OPM_THROW(std::runtime_error, "Unknown threephase_model: " << threephase_model);
             }
@@ -135,6 +139,9 @@ namespace Opm
                 satprops_.reset(ptr);
                 ptr->init(deck, eclState, number_of_cells, global_cell, begin_cell_centroids,
                           dimension, sat_samples);
+                if (sat_eps_baked) {
+                    ptr->bakeEPS();
+                }
             } else {
                 OPM_THROW(std::runtime_error, "Unknown threephase_model: " << threephase_model);
             }
@@ -37,6 +37,18 @@
 namespace Opm
 {
 
+    namespace
+    {
+        // Smaller loops are not worth starting threads for.
+        const int minParallelSize = 10000;
+
+        BlackoilPvtProperties::Workspace& threadWorkspace()
+        {
+            static thread_local BlackoilPvtProperties::Workspace ws;
+            return ws;
+        }
+    }
+
     BlackoilPvtProperties::BlackoilPvtProperties()
     {
     }
@@ -165,12 +177,23 @@ namespace Opm
                                    const double* z,
                                    double* output_mu) const
     {
-        data1_.resize(n);
+        mu(n, pvtTableIdx, p, T, z, output_mu, threadWorkspace());
+    }
+
+    void BlackoilPvtProperties::mu(const int n,
+                                   const int* pvtTableIdx,
+                                   const double* p,
+                                   const double* T,
+                                   const double* z,
+                                   double* output_mu,
+                                   Workspace& ws) const
+    {
+        ws.data1.resize(n);
         for (int phase = 0; phase < phase_usage_.num_phases; ++phase) {
-            props_[phase]->mu(n, pvtTableIdx, p, T, z, &data1_[0]);
-// #pragma omp parallel for
+            props_[phase]->mu(n, pvtTableIdx, p, T, z, &ws.data1[0]);
+#pragma omp parallel for if (n > minParallelSize)
             for (int i = 0; i < n; ++i) {
-                output_mu[phase_usage_.num_phases*i + phase] = data1_[i];
+                output_mu[phase_usage_.num_phases*i + phase] = ws.data1[i];
             }
         }
     }
@@ -182,12 +205,23 @@ namespace Opm
                                   const double* z,
                                   double* output_B) const
     {
-        data1_.resize(n);
+        B(n, pvtTableIdx, p, T, z, output_B, threadWorkspace());
+    }
+
+    void BlackoilPvtProperties::B(const int n,
+                                  const int* pvtTableIdx,
+                                  const double* p,
+                                  const double* T,
+                                  const double* z,
+                                  double* output_B,
+                                  Workspace& ws) const
+    {
+        ws.data1.resize(n);
         for (int phase = 0; phase < phase_usage_.num_phases; ++phase) {
-            props_[phase]->B(n, pvtTableIdx, p, T, z, &data1_[0]);
-// #pragma omp parallel for
+            props_[phase]->B(n, pvtTableIdx, p, T, z, &ws.data1[0]);
+#pragma omp parallel for if (n > minParallelSize)
             for (int i = 0; i < n; ++i) {
-                output_B[phase_usage_.num_phases*i + phase] = data1_[i];
+                output_B[phase_usage_.num_phases*i + phase] = ws.data1[i];
             }
         }
     }
@@ -200,14 +234,26 @@ namespace Opm
                                      double* output_B,
                                      double* output_dBdp) const
     {
-        data1_.resize(n);
-        data2_.resize(n);
+        dBdp(n, pvtTableIdx, p, T, z, output_B, output_dBdp, threadWorkspace());
+    }
+
+    void BlackoilPvtProperties::dBdp(const int n,
+                                     const int* pvtTableIdx,
+                                     const double* p,
+                                     const double* T,
+                                     const double* z,
+                                     double* output_B,
+                                     double* output_dBdp,
+                                     Workspace& ws) const
+    {
+        ws.data1.resize(n);
+        ws.data2.resize(n);
         for (int phase = 0; phase < phase_usage_.num_phases; ++phase) {
-            props_[phase]->dBdp(n, pvtTableIdx, p, T, z, &data1_[0], &data2_[0]);
-// #pragma omp parallel for
+            props_[phase]->dBdp(n, pvtTableIdx, p, T, z, &ws.data1[0], &ws.data2[0]);
+#pragma omp parallel for if (n > minParallelSize)
             for (int i = 0; i < n; ++i) {
-                output_B[phase_usage_.num_phases*i + phase] = data1_[i];
-                output_dBdp[phase_usage_.num_phases*i + phase] = data2_[i];
+                output_B[phase_usage_.num_phases*i + phase] = ws.data1[i];
+                output_dBdp[phase_usage_.num_phases*i + phase] = ws.data2[i];
             }
         }
     }
@@ -219,12 +265,22 @@ namespace Opm
                                   const double* z,
                                   double* output_R) const
     {
-        data1_.resize(n);
+        R(n, pvtTableIdx, p, z, output_R, threadWorkspace());
+    }
+
+    void BlackoilPvtProperties::R(const int n,
+                                  const int* pvtTableIdx,
+                                  const double* p,
+                                  const double* z,
+                                  double* output_R,
+                                  Workspace& ws) const
+    {
+        ws.data1.resize(n);
         for (int phase = 0; phase < phase_usage_.num_phases; ++phase) {
-            props_[phase]->R(n, pvtTableIdx, p, z, &data1_[0]);
-// #pragma omp parallel for
+            props_[phase]->R(n, pvtTableIdx, p, z, &ws.data1[0]);
+#pragma omp parallel for if (n > minParallelSize)
             for (int i = 0; i < n; ++i) {
-                output_R[phase_usage_.num_phases*i + phase] = data1_[i];
+                output_R[phase_usage_.num_phases*i + phase] = ws.data1[i];
             }
         }
     }
@@ -236,14 +292,25 @@ namespace Opm
                                      double* output_R,
                                      double* output_dRdp) const
     {
-        data1_.resize(n);
-        data2_.resize(n);
+        dRdp(n, pvtTableIdx, p, z, output_R, output_dRdp, threadWorkspace());
+    }
+
+    void BlackoilPvtProperties::dRdp(const int n,
+                                     const int* pvtTableIdx,
+                                     const double* p,
+                                     const double* z,
+                                     double* output_R,
+                                     double* output_dRdp,
+                                     Workspace& ws) const
+    {
+        ws.data1.resize(n);
+        ws.data2.resize(n);
         for (int phase = 0; phase < phase_usage_.num_phases; ++phase) {
-            props_[phase]->dRdp(n, pvtTableIdx, p, z, &data1_[0], &data2_[0]);
-// #pragma omp parallel for
+            props_[phase]->dRdp(n, pvtTableIdx, p, z, &ws.data1[0], &ws.data2[0]);
+#pragma omp parallel for if (n > minParallelSize)
             for (int i = 0; i < n; ++i) {
-                output_R[phase_usage_.num_phases*i + phase] = data1_[i];
-                output_dRdp[phase_usage_.num_phases*i + phase] = data2_[i];
+                output_R[phase_usage_.num_phases*i + phase] = ws.data1[i];
+                output_dRdp[phase_usage_.num_phases*i + phase] = ws.data2[i];
             }
         }
     }
@@ -27,6 +27,7 @@
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 
 #include <string>
+#include <vector>
 #include <memory>
 #include <array>
 
@@ -40,6 +41,11 @@ namespace Opm
     ///               point and is thus expected to be an array of size n
     /// - Output arrays shall be of size n*num_phases, and must be valid
     ///   before calling the method.
+    /// - All methods are const and keep no scratch state in the object,
+    ///   so they may be called concurrently from several threads.  The
+    ///   evaluation methods take an optional Workspace for their
+    ///   temporaries; without one, a workspace private to the calling
+    ///   thread is used.
     /// NOTE: The difference between this interface and the one defined
     /// by PvtInterface is that this collects all phases' properties,
     /// and therefore the output arrays are of size n*num_phases as opposed
@@ -77,6 +83,14 @@ namespace Opm
         /// \return  Array of size numPhases().
         const double* surfaceDensities(int regionIdx = 0) const;
 
+        /// Temporaries of the evaluation methods, reused between calls.
+        /// Threads evaluating concurrently must use separate workspaces.
+        struct Workspace
+        {
+            std::vector<double> data1;
+            std::vector<double> data2;
+        };
+
         /// Viscosity as a function of p, T and z.
         void mu(const int n,
                 const int *pvtTableIdx,
@@ -84,6 +98,13 @@ namespace Opm
                 const double* T,
                 const double* z,
                 double* output_mu) const;
+        void mu(const int n,
+                const int *pvtTableIdx,
+                const double* p,
+                const double* T,
+                const double* z,
+                double* output_mu,
+                Workspace& ws) const;
 
         /// Formation volume factor as a function of p, T and z.
         void B(const int n,
@@ -92,6 +113,13 @@ namespace Opm
                const double* T,
                const double* z,
                double* output_B) const;
+        void B(const int n,
+               const int *pvtTableIdx,
+               const double* p,
+               const double* T,
+               const double* z,
+               double* output_B,
+               Workspace& ws) const;
 
         /// Formation volume factor and p-derivative as functions of p, T and z.
         void dBdp(const int n,
@@ -101,6 +129,14 @@ namespace Opm
                   const double* z,
                   double* output_B,
                   double* output_dBdp) const;
+        void dBdp(const int n,
+                  const int *pvtTableIdx,
+                  const double* p,
+                  const double* T,
+                  const double* z,
+                  double* output_B,
+                  double* output_dBdp,
+                  Workspace& ws) const;
 
         /// Solution factor as a function of p and z.
         void R(const int n,
@@ -108,6 +144,12 @@ namespace Opm
                const double* p,
                const double* z,
                double* output_R) const;
+        void R(const int n,
+               const int *pvtTableIdx,
+               const double* p,
+               const double* z,
+               double* output_R,
+               Workspace& ws) const;
 
         /// Solution factor and p-derivative as functions of p and z.
         void dRdp(const int n,
@@ -116,6 +158,13 @@ namespace Opm
                   const double* z,
                   double* output_R,
                   double* output_dRdp) const;
+        void dRdp(const int n,
+                  const int *pvtTableIdx,
+                  const double* p,
+                  const double* z,
+                  double* output_R,
+                  double* output_dRdp,
+                  Workspace& ws) const;
 
     private:
         // Disabling copying (just to avoid surprises, since we use shared_ptr).
@@ -128,9 +177,6 @@ namespace Opm
         // region per active fluid phase.
         std::vector<std::shared_ptr<PvtInterface> > props_;
         std::vector<std::array<double, MaxNumPhases> > densities_;
-
-        mutable std::vector<double> data1_;
-        mutable std::vector<double> data2_;
     };
 
 }
@@ -24,6 +24,8 @@
 
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 namespace Opm
@@ -63,6 +65,27 @@ namespace Opm
         Transform gasoil;
     };
     
+    // Piecewise linear curve on explicit, increasing breakpoints.
+    // Values are held constant outside the breakpoint range.
+    struct EPSBakedCurve {
+        std::vector<double> s;
+        std::vector<double> v;
+        double eval(const double x) const;
+        double deriv(const double x) const;
+    };
+
+    // End-point scaled relperm curves folded into direct lookups in
+    // terms of unscaled cell saturations.  Built once by
+    // SatFuncBase::bakeEPS() and shared by all cells with identical
+    // scaling.
+    struct EPSBakedTables {
+        EPSBakedCurve krw;   // of sw
+        EPSBakedCurve krg;   // of sg
+        EPSBakedCurve krow;  // of so in the water zone, 1 - sw - sg
+        EPSBakedCurve krog;  // of so in the gas zone, 1 - (sw - swco + sg) - swco
+        double swco;         // scaled connate water saturation
+    };
+
     // Hysteresis
     struct SatHyst {
         double sg_hyst;
@@ -85,6 +108,14 @@ namespace Opm
                            const EPSTransforms* epst, 
                            const EPSTransforms* epst_hyst, 
                            SatHyst* sat_hyst) const;
+        /// Capillary pressure for n cells sharing this function set,
+        /// structure-of-arrays layout: s[p][i] is the saturation of
+        /// phase p in cell i, pc[p][i] receives its capillary pressure.
+        void evalPcSoA(const int n, const double* const* s, double* const* pc) const;
+        /// Fold the end-point scaling 'epst' into piecewise linear
+        /// curves sampled at the breakpoints of the scaling and at the
+        /// preimages of the table nodes (three-phase only).
+        void bakeEPS(const EPSTransforms& epst, EPSBakedTables& baked) const;
         double smin_[PhaseUsage::MaxNumPhases];
         double smax_[PhaseUsage::MaxNumPhases];
         double krwmax_; // Max water relperm
@@ -110,6 +141,8 @@ namespace Opm
         TableType krog_;
         TableType pcog_;
         double krocw_; // = krow_(s_wc)
+        std::vector<double> sw_nodes_; // Abscissae of krw_, krow_ and pcow_.
+        std::vector<double> sg_nodes_; // Abscissae of krg_, krog_ and pcog_.
 
     private:
         void extendTable(const std::vector<double>& xv,
@@ -119,6 +152,18 @@ namespace Opm
                                  const std::vector<double>& arg,
                                  const std::vector<double>& value,
                                  const int samples);
+        void initializeTableNodes(std::vector<double>& nodes,
+                                  const std::vector<double>& arg,
+                                  const int samples);
+        static void initBreakpoints(const EPSTransforms::Transform& t,
+                                    std::vector<double>& s);
+        static void addBreakpoint(const EPSTransforms::Transform& t,
+                                  const double x,
+                                  const double s_r,
+                                  const double s_cr,
+                                  const double s_max,
+                                  std::vector<double>& s);
+        static void finishBreakpoints(std::vector<double>& s);
     };
 
     template <class TableType>
@@ -156,6 +201,7 @@ namespace Opm
             initializeTableType(krw_,sw_ex, krw_ex, samples);
             initializeTableType(krow_,sw_ex, krow_ex, samples);
             initializeTableType(pcow_,sw_ex, pcow_ex, samples);
+            initializeTableNodes(sw_nodes_, sw_ex, samples);
 
             krocw_ = krow[0]; // At connate water -> ecl. SWOF
             swco = sw[0];
@@ -208,6 +254,7 @@ namespace Opm
             initializeTableType(krg_,sg_ex, krg_ex, samples);
             initializeTableType(krog_,sg_ex, krog_ex, samples);
             initializeTableType(pcog_,sg_ex, pcog_ex, samples);
+            initializeTableNodes(sg_nodes_, sg_ex, samples);
 
             smin_[phase_usage.phase_pos[Vapour]] = sg[0];
             if (std::fabs(sg.back() + swco - 1.0) > 1e-3) {
@@ -301,6 +348,133 @@ namespace Opm
         }
     }
 
+    template <class TableType>
+    void SatFuncBase<TableType>::evalPcSoA(const int n, const double* const* s, double* const* pc) const
+    {
+        std::fill(pc[phase_usage.phase_pos[Liquid]], pc[phase_usage.phase_pos[Liquid]] + n, 0.0);
+        if (phase_usage.phase_used[Aqua]) {
+            const int pos = phase_usage.phase_pos[Aqua];
+            const double* sw = s[pos];
+            double* pcw = pc[pos];
+            for (int i = 0; i < n; ++i) {
+                pcw[i] = pcow_(sw[i]);
+            }
+        }
+        if (phase_usage.phase_used[Vapour]) {
+            const int pos = phase_usage.phase_pos[Vapour];
+            const double* sg = s[pos];
+            double* pcg = pc[pos];
+            for (int i = 0; i < n; ++i) {
+                pcg[i] = pcog_(sg[i]);
+            }
+        }
+    }
+
+    template <class TableType>
+    void SatFuncBase<TableType>::bakeEPS(const EPSTransforms& epst, EPSBakedTables& baked) const
+    {
+        if (!(phase_usage.phase_used[Aqua] && phase_usage.phase_used[Vapour])) {
+            OPM_THROW(std::runtime_error, "SatFuncBase::bakeEPS()   --  only implemented for three phases.");
+        }
+        const int wpos = phase_usage.phase_pos[Aqua];
+        const int gpos = phase_usage.phase_pos[Vapour];
+        const double _swco = smin_[wpos];
+
+        // Scaling parameters exactly as used by the pointwise evaluation.
+        const double w_r = 1.0-sowcr_-smin_[gpos], w_cr = swcr_, w_max = smax_[wpos];
+        const double g_r = 1.0-sogcr_-smin_[wpos], g_cr = sgcr_, g_max = smax_[gpos];
+        const double ow_r = 1.0-swcr_-smin_[gpos], ow_cr = sowcr_, ow_max = 1.0-smin_[wpos]-smin_[gpos];
+        const double og_r = 1.0-sgcr_-smin_[wpos], og_cr = sogcr_, og_max = 1.0-smin_[wpos]-smin_[gpos];
+
+        initBreakpoints(epst.wat, baked.krw.s);
+        initBreakpoints(epst.watoil, baked.krow.s);
+        for (std::vector<double>::size_type i = 0; i < sw_nodes_.size(); ++i) {
+            addBreakpoint(epst.wat, sw_nodes_[i], w_r, w_cr, w_max, baked.krw.s);
+            addBreakpoint(epst.watoil, 1.0 - sw_nodes_[i], ow_r, ow_cr, ow_max, baked.krow.s);
+        }
+        initBreakpoints(epst.gas, baked.krg.s);
+        initBreakpoints(epst.gasoil, baked.krog.s);
+        for (std::vector<double>::size_type i = 0; i < sg_nodes_.size(); ++i) {
+            addBreakpoint(epst.gas, sg_nodes_[i], g_r, g_cr, g_max, baked.krg.s);
+            addBreakpoint(epst.gasoil, 1.0 - sg_nodes_[i] - _swco, og_r, og_cr, og_max, baked.krog.s);
+        }
+        finishBreakpoints(baked.krw.s);
+        finishBreakpoints(baked.krow.s);
+        finishBreakpoints(baked.krg.s);
+        finishBreakpoints(baked.krog.s);
+
+        baked.krw.v.resize(baked.krw.s.size());
+        for (std::vector<double>::size_type i = 0; i < baked.krw.s.size(); ++i) {
+            const double sw = baked.krw.s[i];
+            baked.krw.v[i] = epst.wat.scaleKr(sw, krw_(epst.wat.scaleSat(sw, w_r, w_cr, w_max)), krwr_);
+        }
+        baked.krg.v.resize(baked.krg.s.size());
+        for (std::vector<double>::size_type i = 0; i < baked.krg.s.size(); ++i) {
+            const double sg = baked.krg.s[i];
+            baked.krg.v[i] = epst.gas.scaleKr(sg, krg_(epst.gas.scaleSat(sg, g_r, g_cr, g_max)), krgr_);
+        }
+        baked.krow.v.resize(baked.krow.s.size());
+        for (std::vector<double>::size_type i = 0; i < baked.krow.s.size(); ++i) {
+            const double ssow = baked.krow.s[i];
+            const double _ssow = epst.watoil.scaleSat(ssow, ow_r, ow_cr, ow_max);
+            baked.krow.v[i] = epst.watoil.scaleKr(ssow, krow_(1.0-_ssow), krorw_);
+        }
+        baked.krog.v.resize(baked.krog.s.size());
+        for (std::vector<double>::size_type i = 0; i < baked.krog.s.size(); ++i) {
+            const double ssog = baked.krog.s[i];
+            const double _ssog = epst.gasoil.scaleSat(ssog, og_r, og_cr, og_max);
+            baked.krog.v[i] = epst.gasoil.scaleKr(ssog, krog_(1.0-_ssog-_swco), krorg_);
+        }
+        baked.swco = epst.wat.smin;
+    }
+
+    // Breakpoints of a baked curve: the domain ends and the kinks of
+    // the scaling ...
+    template <class TableType>
+    void SatFuncBase<TableType>::initBreakpoints(const EPSTransforms::Transform& t,
+                                                 std::vector<double>& s)
+    {
+        s.clear();
+        s.push_back(0.0);
+        s.push_back(1.0);
+        if (!t.doNotScale) {
+            s.push_back(t.smin);
+        }
+        if (!t.doNotScale || t.doKrMax || t.doKrCrit) {
+            s.push_back(t.scr);
+            s.push_back(t.sr);
+            s.push_back(t.smax);
+        }
+        if (t.doKrMax || t.doKrCrit) {
+            // Value scaling may jump at scr, sr and smax; sample the right limits.
+            s.push_back(std::nextafter(t.scr, 2.0));
+            s.push_back(std::nextafter(t.sr, 2.0));
+            s.push_back(std::nextafter(t.smax, 2.0));
+        }
+    }
+
+    // ... and the cell saturations that are mapped onto table nodes.
+    template <class TableType>
+    void SatFuncBase<TableType>::addBreakpoint(const EPSTransforms::Transform& t,
+                                               const double x,
+                                               const double s_r,
+                                               const double s_cr,
+                                               const double s_max,
+                                               std::vector<double>& s)
+    {
+        const double si = t.scaleSatInv(x, s_r, s_cr, s_max);
+        if (std::isfinite(si)) {
+            s.push_back(si);
+        }
+    }
+
+    template <class TableType>
+    void SatFuncBase<TableType>::finishBreakpoints(std::vector<double>& s)
+    {
+        std::sort(s.begin(), s.end());
+        s.erase(std::unique(s.begin(), s.end()), s.end());
+    }
+
     template <class TableType>
     void SatFuncBase<TableType>::extendTable(const std::vector<double>& xv,
                                   std::vector<double>& xv_ex,
@@ -31,6 +31,7 @@ namespace Opm
         void evalKrDeriv(const double* s, double* kr, double* dkrds) const;
         void evalPc(const double* s, double* pc) const;
         void evalPcDeriv(const double* s, double* pc, double* dpcds) const;
+        void evalKrSoA(const int n, const double* const* s, double* const* kr) const;
 
         void evalKr(const double* s, double* kr, const EPSTransforms* epst) const;
         void evalKr(const double* s, double* kr, const EPSTransforms* epst, const EPSTransforms* epst_hyst, const SatHyst* sat_hyst) const;
@@ -38,6 +39,8 @@ namespace Opm
         void evalKrDeriv(const double* s, double* kr, double* dkrds, const EPSTransforms* epst, const EPSTransforms* epst_hyst, const SatHyst* sat_hyst) const;
         void evalPc(const double* s, double* pc, const EPSTransforms* epst) const;
         void evalPcDeriv(const double* s, double* pc, double* dpcds, const EPSTransforms* epst) const;
+        void evalKr(const double* s, double* kr, const EPSBakedTables* baked) const;
+        void evalKrDeriv(const double* s, double* kr, double* dkrds, const EPSBakedTables* baked) const;
 
     private:
 
@@ -95,6 +98,61 @@ namespace Opm
     }
 
 
+    template<class TableType>
+    void SatFuncGwseg<TableType>::evalKrSoA(const int n, const double* const* s, double* const* kr) const
+    {
+        if (this->phase_usage.num_phases == 3) {
+            // Relative permeability model based on segregation of water
+            // and gas, with oil present in both water and gas zones.
+            const double* swin = s[BlackoilPhases::Aqua];
+            const double* sgin = s[BlackoilPhases::Vapour];
+            double* krw = kr[BlackoilPhases::Aqua];
+            double* krg = kr[BlackoilPhases::Vapour];
+            double* kro = kr[BlackoilPhases::Liquid];
+            const double swco_tab = this->smin_[this->phase_usage.phase_pos[BlackoilPhases::Aqua]];
+            const double eps = 1e-5;
+            for (int i = 0; i < n; ++i) {
+                const double sw = std::max(swin[i], swco_tab);
+                const double sg = sgin[i];
+                const double swco = std::min(swco_tab, sw-eps);
+
+                // xw and xg are the fractions occupied by water and gas zones.
+                const double ssg = sw - swco + sg;
+                const double xw = (sw - swco) / ssg;
+                const double xg = 1 - xw;
+                const double ssw = sg + sw;
+
+                krw[i] = this->krw_(sw);
+                krg[i] = this->krg_(sg);
+                kro[i] = xw*this->krow_(ssw) + xg*this->krog_(ssg);
+            }
+            return;
+        }
+        // We have a two-phase situation. We know that oil is active.
+        const int opos = this->phase_usage.phase_pos[BlackoilPhases::Liquid];
+        if (this->phase_usage.phase_used[BlackoilPhases::Aqua]) {
+            const int wpos = this->phase_usage.phase_pos[BlackoilPhases::Aqua];
+            const double* sw = s[wpos];
+            double* krw = kr[wpos];
+            double* kro = kr[opos];
+            for (int i = 0; i < n; ++i) {
+                krw[i] = this->krw_(sw[i]);
+                kro[i] = this->krow_(sw[i]);
+            }
+        } else {
+            assert(this->phase_usage.phase_used[BlackoilPhases::Vapour]);
+            const int gpos = this->phase_usage.phase_pos[BlackoilPhases::Vapour];
+            const double* sg = s[gpos];
+            double* krg = kr[gpos];
+            double* kro = kr[opos];
+            for (int i = 0; i < n; ++i) {
+                krg[i] = this->krg_(sg[i]);
+                kro[i] = this->krog_(sg[i]);
+            }
+        }
+    }
+
+
     template<class TableType>
     void SatFuncGwseg<TableType>::evalKr(const double* s, double* kr, const EPSTransforms* epst) const
     {
@@ -250,6 +308,74 @@ namespace Opm
         }
     }
 
+    template<class TableType>
+    void SatFuncGwseg<TableType>::evalKr(const double* s, double* kr, const EPSBakedTables* baked) const
+    {
+        if (this->phase_usage.num_phases == 3) {
+            // As evalKr() with end-point scaling, but with the scaled
+            // curves looked up directly.
+            double swco = baked->swco;
+            const double sw = std::max(s[BlackoilPhases::Aqua], swco);
+            const double sg = s[BlackoilPhases::Vapour];
+            const double eps = 1e-6;
+            swco = std::min(swco,sw-eps);
+            const double ssw = sg + sw;
+            const double ssg = std::max(sg + sw - swco, eps);
+            const double d = ssg;
+
+            const double xw = (sw - swco) / d;
+            const double xg = 1 - xw;
+            kr[BlackoilPhases::Aqua]   = baked->krw.eval(sw);
+            kr[BlackoilPhases::Vapour] = baked->krg.eval(sg);
+            kr[BlackoilPhases::Liquid] = xw*baked->krow.eval(1.0-ssw) + xg*baked->krog.eval(1.0-ssg-swco);
+            return;
+        }
+        OPM_THROW(std::runtime_error, "SatFuncGwseg   --  need to be implemented ...");
+    }
+
+    template<class TableType>
+    void SatFuncGwseg<TableType>::evalKrDeriv(const double* s, double* kr, double* dkrds, const EPSBakedTables* baked) const
+    {
+        const int np = this->phase_usage.num_phases;
+        std::fill(dkrds, dkrds + np*np, 0.0);
+
+        if (np == 3) {
+            double swco = baked->swco;
+            const double sw = std::max(s[BlackoilPhases::Aqua], swco);
+            const double sg = s[BlackoilPhases::Vapour];
+            const double eps = 1e-6;
+            swco = std::min(swco,sw-eps);
+            const double ssw = sg + sw;
+            const double ssg = std::max(sg + sw - swco, eps);
+            const double d = ssg;
+            const double ssow = 1.0-ssw;
+            const double ssog = 1.0-ssg-swco;
+
+            const double krw = baked->krw.eval(sw);
+            const double krg = baked->krg.eval(sg);
+            const double krow = baked->krow.eval(ssow);
+            const double krog = baked->krog.eval(ssog);
+
+            const double xw = (sw - swco) / d;
+            const double xg = 1 - xw;
+            kr[BlackoilPhases::Aqua]   = krw;
+            kr[BlackoilPhases::Vapour] = krg;
+            kr[BlackoilPhases::Liquid] = xw*krow + xg*krog;
+
+            // Derivatives, krow and krog with respect to ssw and ssg.
+            const double dkrww = baked->krw.deriv(sw);
+            const double dkrgg = baked->krg.deriv(sg);
+            const double dkrow = -baked->krow.deriv(ssow);
+            const double dkrog = -baked->krog.deriv(ssog);
+            dkrds[BlackoilPhases::Aqua   + BlackoilPhases::Aqua*np]   =  dkrww;
+            dkrds[BlackoilPhases::Liquid + BlackoilPhases::Aqua*np]   =  (xg/d)*krow + xw*dkrow - (xg/d)*krog + xg*dkrog;
+            dkrds[BlackoilPhases::Liquid + BlackoilPhases::Vapour*np] = -(xw/d)*krow + xw*dkrow + (xw/d)*krog + xg*dkrog;
+            dkrds[BlackoilPhases::Vapour + BlackoilPhases::Vapour*np] =  dkrgg;
+            return;
+        }
+        OPM_THROW(std::runtime_error, "SatFuncGwseg   --  need to be implemented ...");
+    }
+
     template<class TableType>
     void SatFuncGwseg<TableType>::evalKrDeriv(const double* s, double* kr, double* dkrds) const
     {
@@ -25,6 +25,7 @@
 #include <opm/core/props/phaseUsageFromDeck.hpp>
 #include <opm/core/utility/buildUniformMonotoneTable.hpp>
 #include <opm/core/utility/ErrorMacros.hpp>
+#include <algorithm>
 #include <iostream>
 
 namespace Opm
@@ -50,6 +51,47 @@ namespace Opm
       buildUniformMonotoneTable(arg, value,  samples, table);
     }
 
+    template<>
+    void SatFuncBase<NonuniformTableLinear<double> >::initializeTableNodes(std::vector<double>& nodes,
+                                                                           const std::vector<double>& arg,
+                                                                           const int /* samples */)
+    {
+      nodes = arg;
+    }
+
+    template<>
+    void SatFuncBase<UniformTableLinear<double> >::initializeTableNodes(std::vector<double>& nodes,
+                                                                        const std::vector<double>& arg,
+                                                                        const int samples)
+    {
+      // Same sampling as buildUniformMonotoneTable().
+      nodes.resize(samples);
+      for (int i = 0; i < samples; ++i) {
+          const double w = double(i)/double(samples - 1);
+          nodes[i] = (1.0 - w)*arg.front() + w*arg.back();
+      }
+    }
+
+    double EPSBakedCurve::eval(const double x) const
+    {
+        if (x <= s.front()) {
+            return v.front();
+        } else if (x >= s.back()) {
+            return v.back();
+        }
+        const int i = std::upper_bound(s.begin(), s.end(), x) - s.begin() - 1;
+        return v[i] + (v[i+1] - v[i])*(x - s[i])/(s[i+1] - s[i]);
+    }
+
+    double EPSBakedCurve::deriv(const double x) const
+    {
+        if (x < s.front() || x > s.back()) {
+            return 0.0;
+        }
+        const int i = std::min(int(std::upper_bound(s.begin(), s.end(), x) - s.begin()) - 1, int(s.size()) - 2);
+        return (v[i+1] - v[i])/(s[i+1] - s[i]);
+    }
+
     double EPSTransforms::Transform::scaleSat(double s, double s_r, double s_cr, double s_max) const
     {
         if (doNotScale) {
@@ -31,6 +31,7 @@ namespace Opm
         void evalKrDeriv(const double* s, double* kr, double* dkrds) const;
         void evalPc(const double* s, double* pc) const;
         void evalPcDeriv(const double* s, double* pc, double* dpcds) const;
+        void evalKrSoA(const int n, const double* const* s, double* const* kr) const;
 
         void evalKr(const double* /* s */, double* /* kr */, const EPSTransforms* /* epst */) const
         {OPM_THROW(std::runtime_error, "SatFuncSimple   --  need to be implemented ...");}
@@ -43,6 +44,10 @@ namespace Opm
         {OPM_THROW(std::runtime_error, "SatFuncSimple   --  need to be implemented ...");}
         void evalPcDeriv(const double* /* s */, double* /* pc */, double* /* dpcds */, const EPSTransforms* /* epst */) const
         {OPM_THROW(std::runtime_error, "SatFuncSimple   --  need to be implemented ...");}
+        void evalKr(const double* /* s */, double* /* kr */, const EPSBakedTables* /* baked */) const
+        {OPM_THROW(std::runtime_error, "SatFuncSimple   --  need to be implemented ...");}
+        void evalKrDeriv(const double* /* s */, double* /* kr */, double* /* dkrds */, const EPSBakedTables* /* baked */) const
+        {OPM_THROW(std::runtime_error, "SatFuncSimple   --  need to be implemented ...");}
 
     private:
 
@@ -93,6 +98,47 @@ namespace Opm
         }
     }
 
+    template<class TableType>
+    void SatFuncSimple<TableType>::evalKrSoA(const int n, const double* const* s, double* const* kr) const
+    {
+        if (this->phase_usage.num_phases == 3) {
+            const double* sw = s[BlackoilPhases::Aqua];
+            const double* sg = s[BlackoilPhases::Vapour];
+            double* krw = kr[BlackoilPhases::Aqua];
+            double* krg = kr[BlackoilPhases::Vapour];
+            double* kro = kr[BlackoilPhases::Liquid];
+            for (int i = 0; i < n; ++i) {
+                krw[i] = this->krw_(sw[i]);
+                krg[i] = this->krg_(sg[i]);
+                kro[i] = std::max(this->krow_(sw[i] + sg[i]), 0.0);
+            }
+            return;
+        }
+        // We have a two-phase situation. We know that oil is active.
+        const int opos = this->phase_usage.phase_pos[BlackoilPhases::Liquid];
+        if (this->phase_usage.phase_used[BlackoilPhases::Aqua]) {
+            const int wpos = this->phase_usage.phase_pos[BlackoilPhases::Aqua];
+            const double* sw = s[wpos];
+            const double* so = s[opos];
+            double* krw = kr[wpos];
+            double* kro = kr[opos];
+            for (int i = 0; i < n; ++i) {
+                krw[i] = this->krw_(sw[i]);
+                kro[i] = this->krow_(1.0 - so[i]);
+            }
+        } else {
+            assert(this->phase_usage.phase_used[BlackoilPhases::Vapour]);
+            const int gpos = this->phase_usage.phase_pos[BlackoilPhases::Vapour];
+            const double* sg = s[gpos];
+            double* krg = kr[gpos];
+            double* kro = kr[opos];
+            for (int i = 0; i < n; ++i) {
+                krg[i] = this->krg_(sg[i]);
+                kro[i] = this->krog_(sg[i]);
+            }
+        }
+    }
+
     template<class TableType>
     void SatFuncSimple<TableType>::evalKrDeriv(const double* s, double* kr, double* dkrds) const
     {
@@ -30,6 +30,9 @@
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 struct UnstructuredGrid;
@@ -89,6 +92,10 @@ namespace Opm
         /// \return   P, the number of phases.
         int numPhases() const;
 
+        /// \return   Number of distinct end-point scaling transforms;
+        ///           cells with identical scaling parameters share one.
+        int numEPSTransforms() const;
+
         /// Relative permeability.
         /// \param[in]  n      Number of data points.
         /// \param[in]  s      Array of nP saturation values.
@@ -143,6 +150,25 @@ namespace Opm
                              const double pcow, 
                              double & swat);
 
+        /// Fold the end-point scaling of relative permeabilities into
+        /// piecewise linear tables, one per distinct combination of
+        /// saturation function region and scaling parameters.  Relperm
+        /// evaluation then bypasses the scaling transforms.  Does
+        /// nothing unless end-point scaling is active without hysteresis.
+        /// Capillary pressure keeps using the transforms, as
+        /// swatInitScaling() may modify them after initialization.
+        /// Pays off with nonuniform tables only; the search among the
+        /// breakpoints is slower than a uniform table lookup.
+        void bakeEPS();
+
+        /// \return   Number of distinct baked relperm tables, zero
+        ///           unless bakeEPS() has taken effect.
+        int numEPSBakedTables() const;
+
+        /// \return   Bytes held by the baked relperm tables, including
+        ///           the cell to table map.
+        std::size_t bakedEPSBytes() const;
+
     private:
         PhaseUsage phase_usage_;
         std::vector<SatFuncSet> satfuncset_;
@@ -152,13 +178,29 @@ namespace Opm
         bool do_eps_;  // ENDSCALE is active
         bool do_3pt_;  // SCALECRS: YES~true  NO~false
         bool do_hyst_;  // Keywords ISWL etc detected     
+        // Distinct scaling transforms, and the index of each cell's.
         std::vector<EPSTransforms> eps_transf_;
         std::vector<EPSTransforms> eps_transf_hyst_;
+        std::vector<int> cell_to_eps_;
+        std::vector<int> cell_to_eps_hyst_;
+        std::vector<int> eps_use_count_; // Number of cells using each eps_transf_ entry.
         std::vector<SatHyst> sat_hyst_;
+        bool do_eps_baked_;  // Relperm scaling folded into eps_baked_
+        std::vector<EPSBakedTables> eps_baked_;
+        std::vector<int> cell_to_baked_;
 
         typedef SatFuncSet Funcs;
 
         const Funcs& funcForCell(const int cell) const;
+        const EPSTransforms& epsForCell(const int cell) const;
+        const EPSTransforms& epsHystForCell(const int cell) const;
+        EPSTransforms& unsharedEpsForCell(const int cell);
+        typedef void (Funcs::*SoAKernel)(const int n, const double* const* s, double* const* out) const;
+        void evalSoA(const int n,
+                     const double* s,
+                     const int* cells,
+                     double* out,
+                     SoAKernel kernel) const;
         template<class T>
         void initEPS(Opm::DeckConstPtr deck,
                      Opm::EclipseStateConstPtr eclipseState,
@@ -167,7 +209,8 @@ namespace Opm
                      const T& begin_cell_centroids,
                      int dimensions,
                      const std::vector<std::string>& eps_kw,
-                     std::vector<EPSTransforms>& eps_transf);
+                     std::vector<EPSTransforms>& eps_transf,
+                     std::vector<int>& cell_to_eps);
         template<class T>
         void initEPSKey(Opm::DeckConstPtr deck,
                         Opm::EclipseStateConstPtr eclipseState,
@@ -177,6 +220,10 @@ namespace Opm
                         int dimensions,
                         const std::string& keyword,
                         std::vector<double>& scaleparam);
+        typedef std::array<std::uint64_t, 64> EPSBits;
+        static void epsBits(const EPSTransforms& transf, EPSBits& bits);
+        static void appendEPSKey(const EPSTransforms::Transform& t,
+                                 std::vector<double>& key);
         void initEPSParam(const int cell, 
                           EPSTransforms::Transform& data,
                           const bool oil,
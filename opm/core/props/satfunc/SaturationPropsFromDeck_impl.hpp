@@ -30,7 +30,12 @@
 #include <opm/parser/eclipse/Utility/EndscaleWrapper.hpp>
 #include <opm/parser/eclipse/Utility/ScalecrsWrapper.hpp>
 
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <limits>
 #include <map>
 
 namespace Opm
@@ -43,6 +48,7 @@ namespace Opm
     /// Default constructor.
     template <class SatFuncSet>
     SaturationPropsFromDeck<SatFuncSet>::SaturationPropsFromDeck()
+        : do_eps_baked_(false)
     {
     }
 
@@ -157,6 +163,14 @@ namespace Opm
         // Saturation table scaling
         do_eps_ = false;
         do_3pt_ = false;
+        do_eps_baked_ = false;
+        eps_baked_.clear();
+        cell_to_baked_.clear();
+        eps_transf_.clear();
+        eps_transf_hyst_.clear();
+        cell_to_eps_.clear();
+        cell_to_eps_hyst_.clear();
+        eps_use_count_.clear();
         if (deck->hasKeyword("ENDSCALE")) {
             Opm::EndscaleWrapper endscale(deck->getKeyword("ENDSCALE"));
             if (endscale.directionSwitch() != std::string("NODIR")) {
@@ -193,9 +207,12 @@ namespace Opm
 
             const std::vector<std::string> eps_kw{"SWL", "SWU", "SWCR", "SGL", "SGU", "SGCR", "SOWCR",
                 "SOGCR", "KRW", "KRG", "KRO", "KRWR", "KRGR", "KRORW", "KRORG", "PCW", "PCG"};
-            eps_transf_.resize(number_of_cells);
             initEPS(deck, eclipseState, number_of_cells, global_cell, begin_cell_centroids,
-                    dimensions, eps_kw, eps_transf_);
+                    dimensions, eps_kw, eps_transf_, cell_to_eps_);
+            eps_use_count_.assign(eps_transf_.size(), 0);
+            for (int cell = 0; cell < number_of_cells; ++cell) {
+                ++eps_use_count_[cell_to_eps_[cell]];
+            }
 
             if (do_hyst_) {
                 if (deck->hasKeyword("KRW")
@@ -237,10 +254,9 @@ namespace Opm
 
                 const std::vector<std::string> eps_i_kw{"ISWL", "ISWU", "ISWCR", "ISGL", "ISGU", "ISGCR", "ISOWCR",
                     "ISOGCR", "IKRW", "IKRG", "IKRO", "IKRWR", "IKRGR", "IKRORW", "IKRORG", "IPCW", "IPCG"};
-                eps_transf_hyst_.resize(number_of_cells);
-                sat_hyst_.resize(number_of_cells);                
+                sat_hyst_.resize(number_of_cells);
                 initEPS(deck, eclipseState, number_of_cells, global_cell, begin_cell_centroids,
-                        dimensions, eps_i_kw, eps_transf_hyst_);
+                        dimensions, eps_i_kw, eps_transf_hyst_, cell_to_eps_hyst_);
             }
         }
     }
@@ -255,6 +271,13 @@ namespace Opm
         return phase_usage_.num_phases;
     }
 
+    /// \return   Number of distinct end-point scaling transforms.
+    template <class SatFuncSet>
+    int SaturationPropsFromDeck<SatFuncSet>::numEPSTransforms() const
+    {
+        return eps_transf_.size();
+    }
+
 
 
 
@@ -281,21 +304,27 @@ namespace Opm
         if (dkrds) {
 // #pragma omp parallel for
             for (int i = 0; i < n; ++i) {
-                if (do_hyst_) {
-                   funcForCell(cells[i]).evalKrDeriv(s + np*i, kr + np*i, dkrds + np*np*i, &(eps_transf_[cells[i]]), &(eps_transf_hyst_[cells[i]]), &(sat_hyst_[cells[i]]));
+                if (do_eps_baked_) {
+                   funcForCell(cells[i]).evalKrDeriv(s + np*i, kr + np*i, dkrds + np*np*i, &(eps_baked_[cell_to_baked_[cells[i]]]));
+                } else if (do_hyst_) {
+                   funcForCell(cells[i]).evalKrDeriv(s + np*i, kr + np*i, dkrds + np*np*i, &epsForCell(cells[i]), &epsHystForCell(cells[i]), &(sat_hyst_[cells[i]]));
                 } else if (do_eps_) {
-                   funcForCell(cells[i]).evalKrDeriv(s + np*i, kr + np*i, dkrds + np*np*i, &(eps_transf_[cells[i]]));
+                   funcForCell(cells[i]).evalKrDeriv(s + np*i, kr + np*i, dkrds + np*np*i, &epsForCell(cells[i]));
                 } else {
                    funcForCell(cells[i]).evalKrDeriv(s + np*i, kr + np*i, dkrds + np*np*i);
                 }
             }
+        } else if (!do_eps_) {
+            evalSoA(n, s, cells, kr, &Funcs::evalKrSoA);
         } else {
 // #pragma omp parallel for
             for (int i = 0; i < n; ++i) {
-                if (do_hyst_) {
-                   funcForCell(cells[i]).evalKr(s + np*i, kr + np*i, &(eps_transf_[cells[i]]), &(eps_transf_hyst_[cells[i]]), &(sat_hyst_[cells[i]]));
+                if (do_eps_baked_) {
+                   funcForCell(cells[i]).evalKr(s + np*i, kr + np*i, &(eps_baked_[cell_to_baked_[cells[i]]]));
+                } else if (do_hyst_) {
+                   funcForCell(cells[i]).evalKr(s + np*i, kr + np*i, &epsForCell(cells[i]), &epsHystForCell(cells[i]), &(sat_hyst_[cells[i]]));
                 } else if (do_eps_) {
-                   funcForCell(cells[i]).evalKr(s + np*i, kr + np*i, &(eps_transf_[cells[i]]));
+                   funcForCell(cells[i]).evalKr(s + np*i, kr + np*i, &epsForCell(cells[i]));
                 } else {
                    funcForCell(cells[i]).evalKr(s + np*i, kr + np*i);
                 }
@@ -330,16 +359,18 @@ namespace Opm
 // #pragma omp parallel for
             for (int i = 0; i < n; ++i) {
                 if (do_eps_) {
-                   funcForCell(cells[i]).evalPcDeriv(s + np*i, pc + np*i, dpcds + np*np*i, &(eps_transf_[cells[i]]));
+                   funcForCell(cells[i]).evalPcDeriv(s + np*i, pc + np*i, dpcds + np*np*i, &epsForCell(cells[i]));
                 } else {
                    funcForCell(cells[i]).evalPcDeriv(s + np*i, pc + np*i, dpcds + np*np*i);
                 }
             }
+        } else if (!do_eps_) {
+            evalSoA(n, s, cells, pc, &Funcs::evalPcSoA);
         } else {
 // #pragma omp parallel for
             for (int i = 0; i < n; ++i) {         
                 if (do_eps_) {
-                   funcForCell(cells[i]).evalPc(s + np*i, pc + np*i, &(eps_transf_[cells[i]]));
+                   funcForCell(cells[i]).evalPc(s + np*i, pc + np*i, &epsForCell(cells[i]));
                 } else {
                    funcForCell(cells[i]).evalPc(s + np*i, pc + np*i);
                 }
@@ -372,18 +403,18 @@ namespace Opm
                 smin[np*i + opos] = 1.0;
                 smax[np*i + opos] = 1.0;
                 if (phase_usage_.phase_used[Aqua]) {
-                    smin[np*i + wpos] = eps_transf_[cells[i]].wat.doNotScale ? funcForCell(cells[i]).smin_[wpos]
-                                                                             : eps_transf_[cells[i]].wat.smin;
-                    smax[np*i + wpos] = eps_transf_[cells[i]].wat.doNotScale ? funcForCell(cells[i]).smax_[wpos]
-                                                                             : eps_transf_[cells[i]].wat.smax;
+                    smin[np*i + wpos] = epsForCell(cells[i]).wat.doNotScale ? funcForCell(cells[i]).smin_[wpos]
+                                                                            : epsForCell(cells[i]).wat.smin;
+                    smax[np*i + wpos] = epsForCell(cells[i]).wat.doNotScale ? funcForCell(cells[i]).smax_[wpos]
+                                                                            : epsForCell(cells[i]).wat.smax;
                     smin[np*i + opos] -= smax[np*i + wpos];
                     smax[np*i + opos] -= smin[np*i + wpos];
                 }  
                 if (phase_usage_.phase_used[Vapour]) {
-                    smin[np*i + gpos] = eps_transf_[cells[i]].gas.doNotScale ? funcForCell(cells[i]).smin_[gpos]
-                                                                             : eps_transf_[cells[i]].gas.smin;
-                    smax[np*i + gpos] = eps_transf_[cells[i]].gas.doNotScale ? funcForCell(cells[i]).smax_[gpos]
-                                                                             : eps_transf_[cells[i]].gas.smax;
+                    smin[np*i + gpos] = epsForCell(cells[i]).gas.doNotScale ? funcForCell(cells[i]).smin_[gpos]
+                                                                            : epsForCell(cells[i]).gas.smin;
+                    smax[np*i + gpos] = epsForCell(cells[i]).gas.doNotScale ? funcForCell(cells[i]).smax_[gpos]
+                                                                            : epsForCell(cells[i]).gas.smax;
                     smin[np*i + opos] -= smax[np*i + gpos];
                     smax[np*i + opos] -= smin[np*i + gpos];
                 }
@@ -416,7 +447,7 @@ namespace Opm
         if (do_hyst_) {
 // #pragma omp parallel for
             for (int i = 0; i < n; ++i) {
-                funcForCell(cells[i]).updateSatHyst(s + np*i, &(eps_transf_[cells[i]]), &(eps_transf_hyst_[cells[i]]), &(sat_hyst_[cells[i]]));
+                funcForCell(cells[i]).updateSatHyst(s + np*i, &epsForCell(cells[i]), &epsHystForCell(cells[i]), &(sat_hyst_[cells[i]]));
             }
         } 
     }
@@ -434,19 +465,19 @@ namespace Opm
         if (phase_usage_.phase_used[BlackoilPhases::Aqua]) {
             const double pc_low_threshold = 1.0e-8;
             // TODO: Mixed wettability systems - see ecl kw OPTIONS switch 74
-            if (swat <= eps_transf_[cell].wat.smin) {
-                swat = eps_transf_[cell].wat.smin;
+            if (swat <= epsForCell(cell).wat.smin) {
+                swat = epsForCell(cell).wat.smin;
             } else if (pcow < pc_low_threshold) {
-                swat = eps_transf_[cell].wat.smax;
+                swat = epsForCell(cell).wat.smax;
             } else {
                 const int wpos = phase_usage_.phase_pos[BlackoilPhases::Aqua];
                 const int max_np = BlackoilPhases::MaxNumPhases;
                 double s[max_np] = { 0.0 };
                 s[wpos] = swat;
                 double pc[max_np] = { 0.0 };
-                funcForCell(cell).evalPc(s, pc, &(eps_transf_[cell]));
+                funcForCell(cell).evalPc(s, pc, &epsForCell(cell));
                 if (pc[wpos] > pc_low_threshold) {
-                    eps_transf_[cell].wat.pcFactor *= pcow/pc[wpos];
+                    unsharedEpsForCell(cell).wat.pcFactor *= pcow/pc[wpos];
                 }
             }
         } else {
@@ -455,6 +486,60 @@ namespace Opm
     }
 
 
+    /// Fold the end-point scaling of relative permeabilities into tables.
+    template <class SatFuncSet>
+    void SaturationPropsFromDeck<SatFuncSet>::bakeEPS()
+    {
+        if (!do_eps_ || do_hyst_) {
+            return;
+        }
+
+        // Cells with the same function set and identical scaling
+        // parameters share a baked table.
+        const int num_cells = cell_to_eps_.size();
+        std::map<std::vector<double>, int> table_index;
+        std::vector<double> key;
+        eps_baked_.clear();
+        cell_to_baked_.resize(num_cells);
+        for (int cell = 0; cell < num_cells; ++cell) {
+            key.assign(1, cell_to_func_.empty() ? 0.0 : double(cell_to_func_[cell]));
+            appendEPSKey(epsForCell(cell).wat, key);
+            appendEPSKey(epsForCell(cell).watoil, key);
+            appendEPSKey(epsForCell(cell).gas, key);
+            appendEPSKey(epsForCell(cell).gasoil, key);
+            std::map<std::vector<double>, int>::const_iterator it = table_index.find(key);
+            if (it == table_index.end()) {
+                const int index = eps_baked_.size();
+                eps_baked_.push_back(EPSBakedTables());
+                funcForCell(cell).bakeEPS(epsForCell(cell), eps_baked_.back());
+                it = table_index.insert(std::make_pair(key, index)).first;
+            }
+            cell_to_baked_[cell] = it->second;
+        }
+        do_eps_baked_ = true;
+    }
+
+    /// \return   Number of distinct baked relperm tables.
+    template <class SatFuncSet>
+    int SaturationPropsFromDeck<SatFuncSet>::numEPSBakedTables() const
+    {
+        return eps_baked_.size();
+    }
+
+    /// \return   Bytes held by the baked relperm tables.
+    template <class SatFuncSet>
+    std::size_t SaturationPropsFromDeck<SatFuncSet>::bakedEPSBytes() const
+    {
+        std::size_t num_points = 0;
+        for (std::size_t t = 0; t < eps_baked_.size(); ++t) {
+            num_points += eps_baked_[t].krw.s.size() + eps_baked_[t].krow.s.size()
+                + eps_baked_[t].krg.s.size() + eps_baked_[t].krog.s.size();
+        }
+        return eps_baked_.size()*sizeof(EPSBakedTables)
+            + 2*num_points*sizeof(double) + cell_to_baked_.size()*sizeof(int);
+    }
+
+
     // Map the cell number to the correct function set.
     template <class SatFuncSet>
     const typename SaturationPropsFromDeck<SatFuncSet>::Funcs&
@@ -463,7 +548,108 @@ namespace Opm
         return cell_to_func_.empty() ? satfuncset_[0] : satfuncset_[cell_to_func_[cell]];
     }
 
-    // Initialize saturation scaling parameters
+    // Evaluate a structure-of-arrays kernel for n data points given in
+    // the interleaved (s + np*i) layout.  The points are bucketed by
+    // saturation function region and transposed so that each kernel
+    // call runs a tight loop over contiguous per-phase arrays of a
+    // single table set; results are transposed back into 'out'.
+    template <class SatFuncSet>
+    void SaturationPropsFromDeck<SatFuncSet>::evalSoA(const int n,
+                                                      const double* s,
+                                                      const int* cells,
+                                                      double* out,
+                                                      SoAKernel kernel) const
+    {
+        const int np = phase_usage_.num_phases;
+        const int num_funcs = cell_to_func_.empty() ? 1 : satfuncset_.size();
+
+        // Counting sort of the data points by region.
+        std::vector<int> start(num_funcs + 1, 0);
+        std::vector<int> order(n);
+        if (cell_to_func_.empty()) {
+            start[1] = n;
+            for (int i = 0; i < n; ++i) {
+                order[i] = i;
+            }
+        } else {
+            for (int i = 0; i < n; ++i) {
+                ++start[cell_to_func_[cells[i]] + 1];
+            }
+            for (int f = 0; f < num_funcs; ++f) {
+                start[f + 1] += start[f];
+            }
+            std::vector<int> pos(start.begin(), start.end() - 1);
+            for (int i = 0; i < n; ++i) {
+                order[pos[cell_to_func_[cells[i]]]++] = i;
+            }
+        }
+
+        std::vector<double> s_soa(np*n);
+        std::vector<double> out_soa(np*n);
+        for (int k = 0; k < n; ++k) {
+            const double* si = s + np*order[k];
+            for (int p = 0; p < np; ++p) {
+                s_soa[p*n + k] = si[p];
+            }
+        }
+
+        const double* sp[BlackoilPhases::MaxNumPhases];
+        double* outp[BlackoilPhases::MaxNumPhases];
+        for (int f = 0; f < num_funcs; ++f) {
+            const int len = start[f + 1] - start[f];
+            if (len == 0) {
+                continue;
+            }
+            for (int p = 0; p < np; ++p) {
+                sp[p] = &s_soa[p*n + start[f]];
+                outp[p] = &out_soa[p*n + start[f]];
+            }
+            (satfuncset_[f].*kernel)(len, sp, outp);
+        }
+
+        for (int k = 0; k < n; ++k) {
+            double* oi = out + np*order[k];
+            for (int p = 0; p < np; ++p) {
+                oi[p] = out_soa[p*n + k];
+            }
+        }
+    }
+
+    // Scaling transforms of a cell.
+    template <class SatFuncSet>
+    const EPSTransforms&
+    SaturationPropsFromDeck<SatFuncSet>::epsForCell(const int cell) const
+    {
+        return eps_transf_[cell_to_eps_[cell]];
+    }
+
+    // Imbibition scaling transforms of a cell.
+    template <class SatFuncSet>
+    const EPSTransforms&
+    SaturationPropsFromDeck<SatFuncSet>::epsHystForCell(const int cell) const
+    {
+        return eps_transf_hyst_[cell_to_eps_hyst_[cell]];
+    }
+
+    // Scaling transforms of a cell, detached from other cells sharing
+    // them so that they may be modified.
+    template <class SatFuncSet>
+    EPSTransforms&
+    SaturationPropsFromDeck<SatFuncSet>::unsharedEpsForCell(const int cell)
+    {
+        const int ix = cell_to_eps_[cell];
+        if (eps_use_count_[ix] > 1) {
+            --eps_use_count_[ix];
+            cell_to_eps_[cell] = eps_transf_.size();
+            eps_transf_.push_back(eps_transf_[ix]);
+            eps_use_count_.push_back(1);
+        }
+        return eps_transf_[cell_to_eps_[cell]];
+    }
+
+    // Initialize saturation scaling parameters.  Cells with identical
+    // parameters share one entry of 'eps_transf', typically most cells
+    // share the unscaled default of their saturation function region.
     template <class SatFuncSet>
     template<class T>
     void SaturationPropsFromDeck<SatFuncSet>::initEPS(Opm::DeckConstPtr deck,
@@ -473,7 +659,8 @@ namespace Opm
                                                       const T& begin_cell_centroid,
                                                       int dimensions,
                                                       const std::vector<std::string>& eps_kw,
-                                                      std::vector<EPSTransforms>& eps_transf)
+                                                      std::vector<EPSTransforms>& eps_transf,
+                                                      std::vector<int>& cell_to_eps)
     {
         std::vector<std::vector<double> > eps_vec(eps_kw.size());
         const std::vector<double> dummy;
@@ -489,10 +676,16 @@ namespace Opm
         const bool oilGas = !phase_usage_.phase_used[Aqua] && phase_usage_.phase_used[Liquid] && phase_usage_.phase_used[Vapour];
         const bool threephase = phase_usage_.phase_used[Aqua] && phase_usage_.phase_used[Liquid] && phase_usage_.phase_used[Vapour];
 
+        // Transforms by FNV-1a hash of their bit patterns.
+        std::multimap<std::uint64_t, int> transf_index;
+        EPSBits bits, other;
+        eps_transf.clear();
+        cell_to_eps.resize(number_of_cells);
         for (int cell = 0; cell < number_of_cells; ++cell) {
+            EPSTransforms transf = EPSTransforms();
             if (threephase || oilWater) {
                 // ### krw
-                initEPSParam(cell, eps_transf[cell].wat, false,
+                initEPSParam(cell, transf.wat, false,
                              funcForCell(cell).smin_[wpos],
                              funcForCell(cell).swcr_,
                              funcForCell(cell).smax_[wpos],
@@ -503,7 +696,7 @@ namespace Opm
                              funcForCell(cell).pcwmax_,
                              eps_vec[0], eps_vec[2], eps_vec[1], eps_vec[6], eps_vec[3], eps_vec[11], eps_vec[8], eps_vec[15]);
                 // ### krow
-                initEPSParam(cell, eps_transf[cell].watoil, true,
+                initEPSParam(cell, transf.watoil, true,
                              0.0,
                              funcForCell(cell).sowcr_,
                              funcForCell(cell).smin_[wpos],
@@ -516,7 +709,7 @@ namespace Opm
             }
             if (threephase || oilGas) {
                 // ### krg
-                initEPSParam(cell, eps_transf[cell].gas, false,
+                initEPSParam(cell, transf.gas, false,
                              funcForCell(cell).smin_[gpos],
                              funcForCell(cell).sgcr_,
                              funcForCell(cell).smax_[gpos],
@@ -527,7 +720,7 @@ namespace Opm
                              funcForCell(cell).pcgmax_,
                              eps_vec[3], eps_vec[5], eps_vec[4], eps_vec[7], eps_vec[0], eps_vec[12], eps_vec[9], eps_vec[16]);
                 // ### krog
-                initEPSParam(cell, eps_transf[cell].gasoil, true,
+                initEPSParam(cell, transf.gasoil, true,
                              0.0,
                              funcForCell(cell).sogcr_,
                              funcForCell(cell).smin_[gpos],
@@ -538,6 +731,52 @@ namespace Opm
                              0.0,
                              eps_vec[3], eps_vec[7], eps_vec[3], eps_vec[5], eps_vec[0], eps_vec[14], eps_vec[10], dummy);
             }
+
+            // Share only bitwise identical parameters, so that results
+            // do not depend on the sharing.
+            epsBits(transf, bits);
+            std::uint64_t hash = 14695981039346656037ULL;
+            for (std::size_t i = 0; i < bits.size(); ++i) {
+                for (int b = 0; b < 64; b += 8) {
+                    hash = (hash ^ ((bits[i] >> b) & 0xff)) * 1099511628211ULL;
+                }
+            }
+            int index = -1;
+            typedef std::multimap<std::uint64_t, int>::const_iterator Iter;
+            const std::pair<Iter, Iter> range = transf_index.equal_range(hash);
+            for (Iter it = range.first; it != range.second && index < 0; ++it) {
+                epsBits(eps_transf[it->second], other);
+                if (other == bits) {
+                    index = it->second;
+                }
+            }
+            if (index < 0) {
+                index = eps_transf.size();
+                transf_index.insert(std::make_pair(hash, index));
+                eps_transf.push_back(transf);
+            }
+            cell_to_eps[cell] = index;
+        }
+    }
+
+    // Bit patterns of all parameters of a set of transforms; unlike
+    // the values they compare equal for identical NaN.
+    template <class SatFuncSet>
+    void SaturationPropsFromDeck<SatFuncSet>::epsBits(const EPSTransforms& transf,
+                                                      EPSBits& bits)
+    {
+        const EPSTransforms::Transform* t[] = { &transf.wat, &transf.watoil, &transf.gas, &transf.gasoil };
+        std::size_t k = 0;
+        for (int i = 0; i < 4; ++i) {
+            const double v[] = { double(t[i]->doNotScale), double(t[i]->do_3pt), t[i]->smin, t[i]->scr,
+                                 t[i]->sr, t[i]->smax, t[i]->slope1, t[i]->slope2,
+                                 double(t[i]->doKrMax), double(t[i]->doKrCrit), double(t[i]->doSatInterp),
+                                 t[i]->krsr, t[i]->krmax, t[i]->krSlopeMax, t[i]->krSlopeCrit, t[i]->pcFactor };
+            static_assert(4*sizeof(v)/sizeof(v[0]) == std::tuple_size<EPSBits>::value,
+                          "EPSBits must hold all parameters of the four transforms");
+            for (std::size_t j = 0; j < sizeof(v)/sizeof(v[0]); ++j) {
+                std::memcpy(&bits[k++], &v[j], sizeof(std::uint64_t));
+            }
         }
     }
 
@@ -737,6 +976,39 @@ namespace Opm
 
     }
 
+    // Parameters of a scaling transform that influence relperm values.
+    template <class SatFuncSet>
+    void SaturationPropsFromDeck<SatFuncSet>::appendEPSKey(const EPSTransforms::Transform& t,
+                                                           std::vector<double>& key)
+    {
+        const std::size_t first = key.size();
+        key.push_back(t.doNotScale);
+        if (!t.doNotScale) {
+            key.push_back(t.do_3pt);
+            key.push_back(t.smin);
+            key.push_back(t.sr);
+            key.push_back(t.slope1);
+            key.push_back(t.slope2);
+        } else if (t.doKrCrit) {
+            key.push_back(t.sr);
+        }
+        key.push_back(t.scr);
+        key.push_back(t.smax);
+        key.push_back(t.doKrMax);
+        key.push_back(t.doKrCrit);
+        key.push_back(t.doSatInterp);
+        key.push_back(t.krsr);
+        key.push_back(t.krmax);
+        key.push_back(t.krSlopeMax);
+        key.push_back(t.krSlopeCrit);
+        // Unused slopes may be NaN, which would break the ordering.
+        for (std::size_t i = first; i < key.size(); ++i) {
+            if (std::isnan(key[i])) {
+                key[i] = -std::numeric_limits<double>::max();
+            }
+        }
+    }
+
     // Saturation scaling
     template <class SatFuncSet>
     void SaturationPropsFromDeck<SatFuncSet>::initEPSParam(const int cell,
@@ -768,6 +1040,8 @@ namespace Opm
                 data.smax = su_tab;
             }
             data.scr = scr_tab;
+            // Tabulated critical displacing saturation, for value scaling (krwr etc)
+            data.sr = (s0_tab < 0.0) ? 1.0-sxcr_tab : 1.0-sxcr_tab-s0_tab;
         } else {
             data.doNotScale = false;
             data.do_3pt = do_3pt_;
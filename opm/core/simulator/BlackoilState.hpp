@@ -47,6 +47,11 @@ namespace Opm
         virtual bool equals(const SimulatorState& other,
                             double epsilon = 1e-8) const;
 
+        virtual BlackoilState* clone() const { return new BlackoilState(*this); }
+
+        virtual void assign(const SimulatorState& other)
+        { *this = dynamic_cast<const BlackoilState&>(other); }
+
         std::vector<double>& surfacevol  () { return surfvol_; }
         std::vector<double>& gasoilratio () { return gor_   ; }
         std::vector<double>& rv () {return rv_ ; }
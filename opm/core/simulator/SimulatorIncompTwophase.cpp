@@ -36,6 +36,7 @@
 #include <opm/core/simulator/SimulatorTimer.hpp>
 #include <opm/core/utility/StopWatch.hpp>
 #include <opm/core/io/vtk/writeVtkData.hpp>
+#include <opm/core/io/Checkpoint.hpp>
 #include <opm/core/utility/miscUtilities.hpp>
 #include <opm/core/utility/Event.hpp>
 
@@ -82,6 +83,7 @@ namespace Opm
         std::ostream* log_;
         bool output_;
         bool output_vtk_;
+        bool output_checkpoint_;
         std::string output_dir_;
         int output_interval_;
         // Parameters for well control
@@ -265,6 +267,18 @@ namespace Opm
     }
 
 
+    static void outputCheckpoint(const SimulatorTimer& timer,
+                                 const Opm::TwophaseState& state,
+                                 const Opm::WellState& well_state,
+                                 const std::string& output_dir)
+    {
+        std::ostringstream fname;
+        fname << output_dir << "/checkpoint-" << std::setw(3) << std::setfill('0')
+              << timer.currentStepNum() << ".bin";
+        Opm::writeCheckpoint(fname.str(), timer, state, well_state);
+    }
+
+
     static void outputWaterCut(const Opm::Watercut& watercut,
                                const std::string& output_dir)
     {
@@ -377,6 +391,7 @@ namespace Opm
         output_ = param.getDefault("output", true);
         if (output_) {
             output_vtk_ = param.getDefault("output_vtk", true);
+            output_checkpoint_ = param.getDefault("output_checkpoint", false);
             output_dir_ = param.getDefault("output_dir", std::string("output"));
             // Ensure that output dir exists
             boost::filesystem::path fpath(output_dir_);
@@ -462,6 +477,9 @@ namespace Opm
                 if (output_vtk_) {
                     outputStateVtk(grid_, state, timer.currentStepNum(), output_dir_);
                 }
+                if (output_checkpoint_) {
+                    outputCheckpoint(timer, state, well_state, output_dir_);
+                }
                 outputStateMatlab(grid_, state, timer.currentStepNum(), output_dir_);
                 if (use_reorder_) {
                     // This use of dynamic_cast is not ideal, but should be safe.
@@ -622,6 +640,9 @@ namespace Opm
             if (output_vtk_) {
                 outputStateVtk(grid_, state, timer.currentStepNum(), output_dir_);
             }
+            if (output_checkpoint_) {
+                outputCheckpoint(timer, state, well_state, output_dir_);
+            }
             outputStateMatlab(grid_, state, timer.currentStepNum(), output_dir_);
             if (use_reorder_) {
                 // This use of dynamic_cast is not ideal, but should be safe.
@@ -21,8 +21,10 @@
 
 // we need complete definitions for these types
 #include <opm/parser/eclipse/EclipseState/Schedule/TimeMap.hpp>
+#include <opm/core/io/AsyncOutputWriter.hpp>
 #include <opm/core/io/OutputWriter.hpp>
 #include <opm/core/simulator/SimulatorTimer.hpp>
+#include <opm/core/utility/parameters/ParameterGroup.hpp>
 
 #include <numeric> // partial_sum
 
@@ -50,6 +52,13 @@ SimulatorOutputBase::SimulatorOutputBase (
     // always start from the first timestep
     , next_ (0) {
 
+    // optionally let the writers run in the background, so that the
+    // simulation may proceed while a report step is written
+    if (params.getDefault <bool> ("output_async", false)) {
+        const int max_pending = params.getDefault <int> ("output_async_queue", 2);
+        writer_.reset (new AsyncOutputWriter (std::move (writer_), max_pending));
+    }
+
     // write the static initialization files, even before simulation starts
     writer_->writeInit (*timer);
 }
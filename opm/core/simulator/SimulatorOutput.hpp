@@ -47,6 +47,11 @@ struct PhaseUsage;
  * a function object holding curried arguments to the writing backend
  * which is used when invoked through the event handler (which passes
  * on no arguments on it own).
+ *
+ * With the parameter output_async=true, the state is copied at each
+ * report step and written in a background thread (see
+ * AsyncOutputWriter), holding at most output_async_queue (default 2)
+ * copies at a time.
  */
 class SimulatorOutputBase {
 protected:
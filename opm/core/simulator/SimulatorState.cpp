@@ -20,6 +20,16 @@ SimulatorState::equals (const SimulatorState& other,
     return equal;
 }
 
+SimulatorState*
+SimulatorState::clone () const {
+    return new SimulatorState (*this);
+}
+
+void
+SimulatorState::assign (const SimulatorState& other) {
+    *this = other;
+}
+
 bool
 SimulatorState::vectorApproxEqual(const std::vector<double>& v1,
                                   const std::vector<double>& v2,
@@ -14,6 +14,7 @@ namespace Opm
     class SimulatorState
     {
     public:
+        virtual ~SimulatorState() {}
 
         virtual void init(const UnstructuredGrid& g, int num_phases);
 
@@ -55,6 +56,19 @@ namespace Opm
          */
         virtual bool equals(const SimulatorState& other,
                             double epsilon = 1e-8) const;
+
+        /**
+         * Create a copy of this state, of the same dynamic type.
+         * Derived classes with additional fields must override this.
+         */
+        virtual SimulatorState* clone() const;
+
+        /**
+         * Copy the values of another state of the same dynamic type,
+         * reusing the storage of this one.  Derived classes with
+         * additional fields must override this.
+         */
+        virtual void assign(const SimulatorState& other);
     private:
         int num_phases_;
         /// \brief pressure per cell.
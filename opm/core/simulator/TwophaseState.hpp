@@ -36,6 +36,11 @@ namespace Opm
 
         virtual bool equals (const SimulatorState& other,
                              double epsilon = 1e-8) const;
+
+        virtual TwophaseState* clone () const { return new TwophaseState (*this); }
+
+        virtual void assign (const SimulatorState& other)
+        { *this = dynamic_cast <const TwophaseState&> (other); }
     };
 
 } // namespace Opm
@@ -203,20 +203,11 @@ namespace Opm
                               const std::vector<double>& s,
                               std::vector<double>& totmob)
     {
-        std::vector<double> pmobc;
+        const int nc = cells.size();
+        assert(int(s.size()) == nc * props.numPhases());
 
-        computePhaseMobilities(props, cells, s, pmobc);
-
-        const std::size_t                 np = props.numPhases();
-        const std::vector<int>::size_type nc = cells.size();
-
-        std::vector<double>(cells.size(), 0.0).swap(totmob);
-
-        for (std::vector<int>::size_type c = 0; c < nc; ++c) {
-            for (std::size_t p = 0; p < np; ++p) {
-                totmob[ c ] += pmobc[c*np + p];
-            }
-        }
+        totmob.resize(nc);
+        computeMobilities(props, nc, &cells[0], &s[0], 0, 0, &totmob[0], 0, 0);
     }
 
 
@@ -232,25 +223,12 @@ namespace Opm
                                    std::vector<double>& totmob,
                                    std::vector<double>& omega)
     {
-        std::vector<double> pmobc;
-
-        computePhaseMobilities(props, cells, s, pmobc);
-
-        const std::size_t                 np = props.numPhases();
-        const std::vector<int>::size_type nc = cells.size();
-
-        std::vector<double>(cells.size(), 0.0).swap(totmob);
-        std::vector<double>(cells.size(), 0.0).swap(omega );
+        const int nc = cells.size();
+        assert(int(s.size()) == nc * props.numPhases());
 
-        const double* rho = props.density();
-        for (std::vector<int>::size_type c = 0; c < nc; ++c) {
-            for (std::size_t p = 0; p < np; ++p) {
-                totmob[ c ] += pmobc[c*np + p];
-                omega [ c ] += pmobc[c*np + p] * rho[ p ];
-            }
-
-            omega[ c ] /= totmob[ c ];
-        }
+        totmob.resize(nc);
+        omega.resize(nc);
+        computeMobilities(props, nc, &cells[0], &s[0], 0, 0, &totmob[0], &omega[0], 0);
     }
 
 
@@ -264,23 +242,13 @@ namespace Opm
                                 const std::vector<double>&            s    ,
                                 std::vector<double>&                  pmobc)
     {
-        const std::vector<int>::size_type nc = cells.size();
-        const std::size_t                 np = props.numPhases();
-
-        assert(s.size() == nc * np);
+        const int nc = cells.size();
+        const int np = props.numPhases();
 
-        std::vector<double>(nc * np, 0.0).swap(pmobc );
-        double*                                dpmobc = 0;
-        props.relperm(static_cast<const int>(nc), &s[0], &cells[0],
-                      &pmobc[0], dpmobc);
+        assert(int(s.size()) == nc * np);
 
-        const double*                 mu  = props.viscosity();
-        std::vector<double>::iterator lam = pmobc.begin();
-        for (std::vector<int>::size_type c = 0; c < nc; ++c) {
-            for (std::size_t p = 0; p < np; ++p, ++lam) {
-                *lam /= mu[ p ];
-            }
-        }
+        pmobc.resize(nc * np);
+        computeMobilities(props, nc, &cells[0], &s[0], &pmobc[0], 0, 0, 0, 0);
     }
 
     /// Computes the fractional flow for each cell in the cells argument
@@ -294,17 +262,76 @@ namespace Opm
                                const std::vector<double>& saturations,
                                std::vector<double>& fractional_flows)
     {
-        const int num_phases = props.numPhases();
+        const int nc = cells.size();
+        const int np = props.numPhases();
 
-        computePhaseMobilities(props, cells, saturations, fractional_flows);
+        assert(int(saturations.size()) == nc * np);
 
-        for (std::vector<int>::size_type i = 0; i < cells.size(); ++i) {
-            double phase_sum = 0.0;
-            for (int phase = 0; phase < num_phases; ++phase) {
-                phase_sum += fractional_flows[i * num_phases + phase];
-            }
-            for (int phase = 0; phase < num_phases; ++phase) {
-                fractional_flows[i * num_phases + phase] /= phase_sum;
+        fractional_flows.resize(nc * np);
+        computeMobilities(props, nc, &cells[0], &saturations[0], 0, 0, 0, 0, &fractional_flows[0]);
+    }
+
+    /// @brief Computes phase mobilities and the quantities derived from
+    /// them in a single pass over a set of saturation values.
+    /// Relative permeabilities are evaluated in blocks of cells, so
+    /// that each block is still in cache when the derived quantities
+    /// are formed from it.
+    void computeMobilities(const Opm::IncompPropertiesInterface& props,
+                           const int n,
+                           const int* cells,
+                           const double* s,
+                           double* pmobc,
+                           double* dpmobc,
+                           double* totmob,
+                           double* omega,
+                           double* fractional_flows)
+    {
+        const int np = props.numPhases();
+        const double* mu = props.viscosity();
+        const double* rho = omega ? props.density() : 0;
+
+        const int block_size = std::min(n, 512);
+        std::vector<double> kr(block_size * np);
+        std::vector<double> dkrds(dpmobc ? block_size * np * np : 0);
+        for (int start = 0; start < n; start += block_size) {
+            const int m = std::min(block_size, n - start);
+            props.relperm(m, s + np*start, cells + start, &kr[0], dpmobc ? &dkrds[0] : 0);
+
+            for (int i = 0; i < m; ++i) {
+                const int c = start + i;
+                double* lam = &kr[np*i];
+                double tm = 0.0;
+                double om = 0.0;
+                for (int p = 0; p < np; ++p) {
+                    lam[p] /= mu[p];
+                    tm += lam[p];
+                    if (rho) {
+                        om += lam[p] * rho[p];
+                    }
+                }
+                if (pmobc) {
+                    std::copy(lam, lam + np, pmobc + np*c);
+                }
+                if (dpmobc) {
+                    // Entry (p, q) of the Fortran-ordered matrix is at p + np*q.
+                    const double* dkr = &dkrds[np*np*i];
+                    for (int q = 0; q < np; ++q) {
+                        for (int p = 0; p < np; ++p) {
+                            dpmobc[np*np*c + p + np*q] = dkr[p + np*q] / mu[p];
+                        }
+                    }
+                }
+                if (totmob) {
+                    totmob[c] = tm;
+                }
+                if (omega) {
+                    omega[c] = om / tm;
+                }
+                if (fractional_flows) {
+                    for (int p = 0; p < np; ++p) {
+                        fractional_flows[np*c + p] = lam[p] / tm;
+                    }
+                }
             }
         }
     }
@@ -179,6 +179,31 @@ namespace Opm
                                std::vector<double>& fractional_flows);
 
 
+    /// @brief Computes phase mobilities and the quantities derived from
+    /// them in a single pass over a set of saturation values.
+    /// Every output is optional: pass null for quantities not needed.
+    /// Non-null outputs must point to arrays of the indicated size.
+    /// @param[in]  props             rock and fluid properties
+    /// @param[in]  n                 number of data points
+    /// @param[in]  cells             cells with which the saturation values are associated (n values)
+    /// @param[in]  s                 saturation values (nP values)
+    /// @param[out] pmobc             phase mobilities (nP values)
+    /// @param[out] dpmobc            phase mobility derivatives d(pmobc_i)/d(s_j) (nP^2 values,
+    ///                               in Fortran order as for relperm())
+    /// @param[out] totmob            total mobility (n values)
+    /// @param[out] omega             fractional-flow weighted fluid densities (n values)
+    /// @param[out] fractional_flows  fractional flow for each phase (nP values)
+    void computeMobilities(const Opm::IncompPropertiesInterface& props,
+                           const int n,
+                           const int* cells,
+                           const double* s,
+                           double* pmobc,
+                           double* dpmobc,
+                           double* totmob,
+                           double* omega,
+                           double* fractional_flows);
+
+
     /// Compute two-phase transport source terms from face fluxes,
     /// and pressure equation source terms. This puts boundary flows
     /// into the source terms for the transport equation.
@@ -134,21 +134,12 @@ namespace Opm
                               const std::vector<double>& s,
                               std::vector<double>& totmob)
     {
-        std::vector<double> pmobc;
-
-        computePhaseMobilities(props, cells, press, temp, z, s, pmobc);
-
-        const std::size_t                 np = props.numPhases();
-        const std::vector<int>::size_type nc = cells.size();
+        const int nc = cells.size();
+        assert(int(s.size()) == nc * props.numPhases());
 
-        totmob.clear();
-        totmob.resize(nc, 0.0);
-
-        for (std::vector<int>::size_type c = 0; c < nc; ++c) {
-            for (std::size_t p = 0; p < np; ++p) {
-                totmob[ c ] += pmobc[c*np + p];
-            }
-        }
+        totmob.resize(nc);
+        computeMobilities(props, nc, &cells[0], &press[0], &temp[0], &z[0], &s[0], 0,
+                          0, 0, &totmob[0], 0, 0);
     }
 
     /*
@@ -208,24 +199,14 @@ namespace Opm
                                 const std::vector<double>&              s,
                                 std::vector<double>&                    pmobc)
     {
-        const int nc = props.numCells();
+        const int nc = cells.size();
         const int np = props.numPhases();
 
         assert(int(s.size()) == nc * np);
 
-        std::vector<double> mu(nc*np);
-        props.viscosity(nc, &p[0], &T[0], &z[0], &cells[0], &mu[0], 0);
-
-        pmobc.clear();
-        pmobc.resize(nc*np, 0.0);
-        double* dpmobc = 0;
-        props.relperm(nc, &s[0], &cells[0],
-                      &pmobc[0], dpmobc);
-
-        std::transform(pmobc.begin(), pmobc.end(),
-                       mu.begin(),
-                       pmobc.begin(),
-                       std::divides<double>());
+        pmobc.resize(nc*np);
+        computeMobilities(props, nc, &cells[0], &p[0], &T[0], &z[0], &s[0], 0,
+                          &pmobc[0], 0, 0, 0, 0);
     }
 
     /// Computes the fractional flow for each cell in the cells argument
@@ -244,17 +225,90 @@ namespace Opm
                                const std::vector<double>& s,
                                std::vector<double>& fractional_flows)
     {
-        const int num_phases = props.numPhases();
+        const int nc = cells.size();
+        const int np = props.numPhases();
 
-        computePhaseMobilities(props, cells, p, T, z, s, fractional_flows);
+        assert(int(s.size()) == nc * np);
 
-        for (std::vector<int>::size_type i = 0; i < cells.size(); ++i) {
-            double phase_sum = 0.0;
-            for (int phase = 0; phase < num_phases; ++phase) {
-                phase_sum += fractional_flows[i * num_phases + phase];
+        fractional_flows.resize(nc*np);
+        computeMobilities(props, nc, &cells[0], &p[0], &T[0], &z[0], &s[0], 0,
+                          0, 0, 0, 0, &fractional_flows[0]);
+    }
+
+
+    /// @brief Computes phase mobilities and the quantities derived from
+    /// them in a single pass over a set of data points.
+    /// Viscosities and relative permeabilities are evaluated in blocks
+    /// of data points, so that each block is still in cache when the
+    /// derived quantities are formed from it.
+    void computeMobilities(const Opm::BlackoilPropertiesInterface& props,
+                           const int n,
+                           const int* cells,
+                           const double* p,
+                           const double* T,
+                           const double* z,
+                           const double* s,
+                           const double* A,
+                           double* pmobc,
+                           double* dpmobc,
+                           double* totmob,
+                           double* omega,
+                           double* fractional_flows)
+    {
+        if (omega && !A) {
+            OPM_THROW(std::runtime_error, "computeMobilities(): the A matrices are required to compute omega.");
+        }
+        const int np = props.numPhases();
+
+        const int block_size = std::min(n, 512);
+        std::vector<double> mu(block_size * np);
+        std::vector<double> kr(block_size * np);
+        std::vector<double> dkrds(dpmobc ? block_size * np * np : 0);
+        std::vector<double> rho(omega ? block_size * np : 0);
+        for (int start = 0; start < n; start += block_size) {
+            const int m = std::min(block_size, n - start);
+            props.viscosity(m, p + start, T + start, z + np*start, cells + start, &mu[0], 0);
+            props.relperm(m, s + np*start, cells + start, &kr[0], dpmobc ? &dkrds[0] : 0);
+            if (omega) {
+                props.density(m, A + np*np*start, cells + start, &rho[0]);
             }
-            for (int phase = 0; phase < num_phases; ++phase) {
-                fractional_flows[i * num_phases + phase] /= phase_sum;
+
+            for (int i = 0; i < m; ++i) {
+                const int c = start + i;
+                double* lam = &kr[np*i];
+                const double* cmu = &mu[np*i];
+                double tm = 0.0;
+                double om = 0.0;
+                for (int phase = 0; phase < np; ++phase) {
+                    lam[phase] /= cmu[phase];
+                    tm += lam[phase];
+                    if (omega) {
+                        om += lam[phase] * rho[np*i + phase];
+                    }
+                }
+                if (pmobc) {
+                    std::copy(lam, lam + np, pmobc + np*c);
+                }
+                if (dpmobc) {
+                    // Entry (i, j) of the Fortran-ordered matrix is at i + np*j.
+                    const double* dkr = &dkrds[np*np*i];
+                    for (int col = 0; col < np; ++col) {
+                        for (int row = 0; row < np; ++row) {
+                            dpmobc[np*np*c + row + np*col] = dkr[row + np*col] / cmu[row];
+                        }
+                    }
+                }
+                if (totmob) {
+                    totmob[c] = tm;
+                }
+                if (omega) {
+                    omega[c] = om / tm;
+                }
+                if (fractional_flows) {
+                    for (int phase = 0; phase < np; ++phase) {
+                        fractional_flows[np*c + phase] = lam[phase] / tm;
+                    }
+                }
             }
         }
     }
@@ -122,6 +122,40 @@ namespace Opm
                                std::vector<double>& fractional_flows);
 
 
+    /// @brief Computes phase mobilities and the quantities derived from
+    /// them in a single pass over a set of data points.
+    /// Every output is optional: pass null for quantities not needed.
+    /// Non-null outputs must point to arrays of the indicated size.
+    /// @param[in]  props             rock and fluid properties
+    /// @param[in]  n                 number of data points
+    /// @param[in]  cells             cells with which the data points are associated (n values)
+    /// @param[in]  p                 pressure (n values)
+    /// @param[in]  T                 temperature (n values)
+    /// @param[in]  z                 surface-volume values (nP values)
+    /// @param[in]  s                 saturation values (nP values)
+    /// @param[in]  A                 phase-to-component matrices as computed by the matrix()
+    ///                               method (nP^2 values), only needed if omega is requested
+    /// @param[out] pmobc             phase mobilities (nP values)
+    /// @param[out] dpmobc            phase mobility derivatives d(pmobc_i)/d(s_j) (nP^2 values,
+    ///                               in Fortran order as for relperm())
+    /// @param[out] totmob            total mobility (n values)
+    /// @param[out] omega             fractional-flow weighted fluid densities (n values)
+    /// @param[out] fractional_flows  fractional flow for each phase (nP values)
+    void computeMobilities(const Opm::BlackoilPropertiesInterface& props,
+                           const int n,
+                           const int* cells,
+                           const double* p,
+                           const double* T,
+                           const double* z,
+                           const double* s,
+                           const double* A,
+                           double* pmobc,
+                           double* dpmobc,
+                           double* totmob,
+                           double* omega,
+                           double* fractional_flows);
+
+
     /// Computes the surface volume densities from saturations by the formula
     ///     z = A s
     /// for a number of data points, where z is the surface volume density,
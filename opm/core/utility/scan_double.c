@@ -0,0 +1,150 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "config.h"
+#include <opm/core/utility/scan_double.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+/* Tokens shorter than this are passed on to strtod() from the stack. */
+#define SCAN_DOUBLE_MAX_TOKEN 128
+
+
+/* ---------------------------------------------------------------------- */
+static int
+is_space(char c)
+/* ---------------------------------------------------------------------- */
+{
+    /* ' ' or one of '\t', '\n', '\v', '\f' and '\r'. */
+    return (c == ' ') | ((unsigned char) (c - '\t') < 5);
+}
+
+
+/* ---------------------------------------------------------------------- */
+static int
+is_digit(char c)
+/* ---------------------------------------------------------------------- */
+{
+    return (c >= '0') && (c <= '9');
+}
+
+
+/* ---------------------------------------------------------------------- */
+static const char *
+scan_strtod(const char *p, const char *end, double *v)
+/* ---------------------------------------------------------------------- */
+{
+    const char *q;
+    char        sbuf[SCAN_DOUBLE_MAX_TOKEN], *buf, *stop;
+    size_t      len;
+    int         ok;
+
+    for (q = p; (q != end) && ! is_space(*q); ++q) { }
+
+    len = q - p;
+    buf = (len < sizeof sbuf) ? sbuf : malloc(len + 1);
+    if (buf == NULL) {
+        return NULL;
+    }
+
+    memcpy(buf, p, len);
+    buf[len] = '\0';
+
+    *v = strtod(buf, &stop);
+    ok = (len > 0) && (stop == buf + len);
+
+    if (buf != sbuf) { free(buf); }
+
+    return ok ? q : NULL;
+}
+
+
+/* ---------------------------------------------------------------------- */
+const char *
+scan_double(const char *p, const char *end, double *v)
+/* ---------------------------------------------------------------------- */
+{
+    static const double pow10[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+        1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+        1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    const char         *q, *e;
+    unsigned long long  mantissa;
+    int                 neg, eneg, significant, ndigits, exponent, x;
+
+    q   = p;
+    neg = (q != end) && (*q == '-');
+    if ((q != end) && ((*q == '-') || (*q == '+'))) { ++q; }
+
+    mantissa    = 0;
+    significant = 0;
+    ndigits     = 0;
+    exponent    = 0;
+
+    for (; (q != end) && is_digit(*q); ++q, ++ndigits) {
+        significant += (mantissa != 0) || (*q != '0');
+        if (significant <= 15) {
+            mantissa = 10*mantissa + (unsigned long long) (*q - '0');
+        }
+        else {
+            exponent += 1;
+        }
+    }
+
+    if ((q != end) && (*q == '.')) {
+        for (++q; (q != end) && is_digit(*q); ++q, ++ndigits) {
+            significant += (mantissa != 0) || (*q != '0');
+            if (significant <= 15) {
+                mantissa  = 10*mantissa + (unsigned long long) (*q - '0');
+                exponent -= 1;
+            }
+        }
+    }
+
+    if ((ndigits > 0) && (q != end) && ((*q == 'e') || (*q == 'E'))) {
+        ++q;
+        eneg = (q != end) && (*q == '-');
+        if ((q != end) && ((*q == '-') || (*q == '+'))) { ++q; }
+
+        e = q;
+        x = 0;
+        for (; (q != end) && is_digit(*q); ++q) {
+            if (x < 10000) { x = 10*x + (*q - '0'); }
+        }
+
+        if (q == e) { ndigits = 0; }
+
+        exponent += eneg ? -x : x;
+    }
+
+    if ((ndigits > 0) && ((q == end) || is_space(*q)) &&
+        (significant <= 15) && (exponent >= -22) && (exponent <= 22)) {
+        *v = (double) mantissa;
+        *v = (exponent < 0) ? *v / pow10[-exponent] : *v * pow10[exponent];
+        if (neg) { *v = - *v; }
+
+        return q;
+    }
+
+    return scan_strtod(p, end, v);
+}
@@ -0,0 +1,57 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef OPM_SCAN_DOUBLE_H_HEADER
+#define OPM_SCAN_DOUBLE_H_HEADER
+
+/**
+ * \file
+ * Conversion of floating point numbers in character buffers that need
+ * not be null terminated, shared by the memory-mapped file readers.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Convert the number starting at @c p, which must extend to the next
+ * white space or to @c end.
+ *
+ * Numbers with at most 15 significant digits and a decimal exponent of
+ * magnitude at most 22 are converted exactly by a single multiplication
+ * or division, giving the same correctly rounded result as strtod().
+ * All other tokens, including "inf", "nan" and hexadecimal floating
+ * point numbers, are converted by strtod().
+ *
+ * @param[in]  p   Start of the number.
+ * @param[in]  end End of the buffer.
+ * @param[out] v   Converted value.
+ * @return Position after the number, or @c NULL if the token is not a
+ * number.
+ */
+const char *
+scan_double(const char *p, const char *end, double *v);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OPM_SCAN_DOUBLE_H_HEADER */
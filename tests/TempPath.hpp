@@ -0,0 +1,43 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_TEMPPATH_HEADER_INCLUDED
+#define OPM_TEMPPATH_HEADER_INCLUDED
+
+#include <boost/filesystem.hpp>
+
+#include <string>
+
+/// A unique path in the temporary directory, for a test's output file
+/// or directory.  Nothing is created; whatever exists at the path when
+/// the object goes out of scope is removed.
+struct TempPath
+{
+    /// \param[in] model  file name with '%' for random characters,
+    ///                   as in boost::filesystem::unique_path().
+    explicit TempPath(const std::string& model)
+        : path(boost::filesystem::temp_directory_path()
+               / boost::filesystem::unique_path(model))
+    {}
+    ~TempPath() { boost::filesystem::remove_all(path); }
+    std::string name() const { return path.string(); }
+    boost::filesystem::path path;
+};
+
+#endif // OPM_TEMPPATH_HEADER_INCLUDED
@@ -0,0 +1,203 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+#define NVERBOSE // to suppress our messages when throwing
+
+#define BOOST_TEST_MODULE AsyncOutputWriterTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/core/io/AsyncOutputWriter.hpp>
+#include <opm/core/simulator/BlackoilState.hpp>
+#include <opm/core/simulator/WellState.hpp>
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    class FakeTimer : public Opm::SimulatorTimerInterface
+    {
+    public:
+        FakeTimer() : step_(0) {}
+        virtual int currentStepNum() const { return step_; }
+        virtual double currentStepLength() const { return 1.0; }
+        virtual double stepLengthTaken() const { return 1.0; }
+        virtual double simulationTimeElapsed() const { return step_; }
+        virtual void advance() { ++step_; }
+        virtual bool done() const { return false; }
+        virtual boost::posix_time::ptime startDateTime() const
+        { return boost::posix_time::ptime(boost::gregorian::date(2014, 1, 1)); }
+    private:
+        int step_;
+    };
+
+    struct Record
+    {
+        int step;
+        double pressure;
+        double bhp;
+        bool blackoil;
+    };
+
+    // Records what it is asked to write, slowly; throws at a given step.
+    class RecordingWriter : public Opm::OutputWriter
+    {
+    public:
+        RecordingWriter(std::vector<Record>& records, int fail_step = -1)
+            : records_(records), fail_step_(fail_step) {}
+        virtual void writeInit(const Opm::SimulatorTimerInterface&) {}
+        virtual void writeTimeStep(const Opm::SimulatorTimerInterface& timer,
+                                   const Opm::SimulatorState& state,
+                                   const Opm::WellState& wellState)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            if (timer.currentStepNum() == fail_step_) {
+                throw std::runtime_error("write failed");
+            }
+            Record r = { timer.currentStepNum(), state.pressure()[0], wellState.bhp()[0],
+                         dynamic_cast<const Opm::BlackoilState*>(&state) != 0 };
+            records_.push_back(r);
+        }
+    private:
+        std::vector<Record>& records_;
+        int fail_step_;
+    };
+
+    // Derived state that does not override clone().
+    class OtherState : public Opm::SimulatorState
+    {
+    };
+
+} // anonymous namespace
+
+
+BOOST_AUTO_TEST_CASE(SnapshotsAreWrittenInOrder)
+{
+    std::vector<Record> records;
+    FakeTimer timer;
+    Opm::BlackoilState state;
+    state.init(10, 20, 3);
+    Opm::WellState wellState;
+    wellState.bhp().assign(2, 0.0);
+    {
+        std::unique_ptr<Opm::OutputWriter> writer(new RecordingWriter(records));
+        Opm::AsyncOutputWriter async(std::move(writer), 2);
+        for (int step = 1; step <= 6; ++step) {
+            timer.advance();
+            state.pressure()[0] = 100.0 + step;
+            wellState.bhp()[0] = 200.0 + step;
+            async.writeTimeStep(timer, state, wellState);
+            // Modifying the state after returning must not affect output.
+            state.pressure()[0] = -1.0;
+        }
+        // The destructor writes the remaining snapshots.
+    }
+
+    BOOST_REQUIRE_EQUAL(records.size(), 6);
+    for (int i = 0; i < 6; ++i) {
+        BOOST_CHECK_EQUAL(records[i].step, i + 1);
+        BOOST_CHECK_EQUAL(records[i].pressure, 101.0 + i);
+        BOOST_CHECK_EQUAL(records[i].bhp, 201.0 + i);
+        BOOST_CHECK(records[i].blackoil);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(ErrorIsRethrown)
+{
+    std::vector<Record> records;
+    FakeTimer timer;
+    Opm::BlackoilState state;
+    state.init(10, 20, 3);
+    Opm::WellState wellState;
+    wellState.bhp().assign(1, 0.0);
+
+    std::unique_ptr<Opm::OutputWriter> writer(new RecordingWriter(records, 2));
+    Opm::AsyncOutputWriter async(std::move(writer));
+    timer.advance();
+    async.writeTimeStep(timer, state, wellState);
+    timer.advance();
+    async.writeTimeStep(timer, state, wellState);
+    BOOST_CHECK_THROW(async.flush(), std::runtime_error);
+
+    // Writing continues after the error has been reported.
+    timer.advance();
+    async.writeTimeStep(timer, state, wellState);
+    async.flush();
+    BOOST_REQUIRE_EQUAL(records.size(), 2);
+    BOOST_CHECK_EQUAL(records[1].step, 3);
+}
+
+
+BOOST_AUTO_TEST_CASE(UnclonableStateIsWrittenDirectly)
+{
+    std::vector<Record> records;
+    FakeTimer timer;
+    OtherState state;
+    state.init(10, 20, 2);
+    Opm::WellState wellState;
+    wellState.bhp().assign(1, 0.0);
+
+    std::unique_ptr<Opm::OutputWriter> writer(new RecordingWriter(records));
+    Opm::AsyncOutputWriter async(std::move(writer));
+    timer.advance();
+    state.pressure()[0] = 5.0;
+    async.writeTimeStep(timer, state, wellState);
+    BOOST_REQUIRE_EQUAL(records.size(), 1);
+    BOOST_CHECK_EQUAL(records[0].pressure, 5.0);
+}
+
+
+BOOST_AUTO_TEST_CASE(ReusedSnapshotsTakeTheStateType)
+{
+    std::vector<Record> records;
+    FakeTimer timer;
+    Opm::BlackoilState blackoil;
+    blackoil.init(10, 20, 3);
+    Opm::SimulatorState plain;
+    plain.init(4, 8, 2);
+    Opm::WellState wellState;
+    wellState.bhp().assign(1, 0.0);
+
+    // A single snapshot, reused for every time step.
+    std::unique_ptr<Opm::OutputWriter> writer(new RecordingWriter(records));
+    Opm::AsyncOutputWriter async(std::move(writer), 1);
+    for (int step = 1; step <= 6; ++step) {
+        timer.advance();
+        Opm::SimulatorState& state = (step % 3 == 0)
+            ? plain : static_cast<Opm::SimulatorState&>(blackoil);
+        state.pressure()[0] = 100.0 + step;
+        async.writeTimeStep(timer, state, wellState);
+        state.pressure()[0] = -1.0;
+    }
+    async.flush();
+
+    BOOST_REQUIRE_EQUAL(records.size(), 6);
+    for (int i = 0; i < 6; ++i) {
+        BOOST_CHECK_EQUAL(records[i].pressure, 101.0 + i);
+        BOOST_CHECK_EQUAL(records[i].blackoil, (i + 1) % 3 != 0);
+    }
+}
@@ -0,0 +1,161 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+/* --- Boost.Test boilerplate --- */
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE BinaryOutputWriterTest
+#include <boost/test/unit_test.hpp>
+
+/* --- our own headers --- */
+#include <opm/core/io/BinaryOutputWriter.hpp>
+#include <opm/core/props/BlackoilPhases.hpp>
+#include <opm/core/simulator/BlackoilState.hpp>
+#include <opm/core/simulator/SimulatorTimer.hpp>
+#include <opm/core/simulator/WellState.hpp>
+#include <opm/core/utility/parameters/ParameterGroup.hpp>
+
+#include "TempPath.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct Fixture
+    {
+        Fixture()
+            : dir("opm-binout-%%%%-%%%%")
+        {
+            Opm::parameter::ParameterGroup param;
+            param.insertParameter("num_psteps", "10");
+            param.insertParameter("stepsize_days", "1.0");
+            timer.init(param);
+
+            state.init(50, 120, 3);
+            for (int c = 0; c < 50; ++c) {
+                state.pressure()[c] = 2.0e7 + 1.0e3*c;
+            }
+            well_state.bhp().assign(2, 1.8e7);
+        }
+
+        // Small changes in pressure only, as in a nearly converged run.
+        void step(Opm::OutputWriter& writer)
+        {
+            writer.writeTimeStep(timer, state, well_state);
+            for (int c = 0; c < 50; ++c) {
+                state.pressure()[c] *= 1.0 + 1.0e-9*(c % 7);
+            }
+            ++timer;
+        }
+
+        TempPath dir;
+        Opm::SimulatorTimer timer;
+        Opm::BlackoilState state;
+        Opm::WellState well_state;
+    };
+
+    std::uintmax_t fileSize(const TempPath& dir, int step)
+    {
+        return boost::filesystem::file_size(
+            Opm::BinaryOutputWriter::fileName(dir.name(), "case", step));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE ()
+
+BOOST_FIXTURE_TEST_CASE (deltaRoundTrip, Fixture)
+{
+    Opm::BinaryOutputWriter writer(dir.name(), "case", std::vector<std::string>(),
+                                   /*delta=*/true, /*keyframeInterval=*/3);
+    writer.writeInit(timer);
+
+    std::vector< std::vector<double> > pressures;
+    for (int s = 0; s < 5; ++s) {
+        pressures.push_back(state.pressure());
+        step(writer);
+    }
+
+    const std::string base = "case";
+    for (int s = 0; s < 5; ++s) {
+        const std::vector<double> p =
+            Opm::BinaryOutputWriter::readField(dir.name(), base, s, "pressure");
+        BOOST_CHECK(p == pressures[s]);
+        const std::vector<double> sat =
+            Opm::BinaryOutputWriter::readField(dir.name(), base, s, "saturation");
+        BOOST_CHECK(sat == state.saturation());
+        const std::vector<double> bhp =
+            Opm::BinaryOutputWriter::readField(dir.name(), base, s, "well_bhp");
+        BOOST_CHECK(bhp == well_state.bhp());
+    }
+
+    // Steps 1, 2 and 4 only store a small difference for the pressure;
+    // steps 0 and 3 are keyframes.
+    BOOST_CHECK(fileSize(dir, 1) < fileSize(dir, 0) / 4);
+    BOOST_CHECK(fileSize(dir, 2) < fileSize(dir, 0) / 4);
+    BOOST_CHECK_EQUAL(fileSize(dir, 3), fileSize(dir, 0));
+    BOOST_CHECK(fileSize(dir, 4) < fileSize(dir, 0) / 4);
+}
+
+BOOST_FIXTURE_TEST_CASE (unchangedFieldsAreSkipped, Fixture)
+{
+    Opm::BinaryOutputWriter writer(dir.name(), "case", std::vector<std::string>(),
+                                   /*delta=*/false, /*keyframeInterval=*/10);
+    writer.writeInit(timer);
+    step(writer);
+    step(writer);
+
+    // Only the pressure is written again, in full.
+    BOOST_CHECK(fileSize(dir, 1) < fileSize(dir, 0) / 4);
+    BOOST_CHECK(fileSize(dir, 1) > 50*sizeof(double));
+    BOOST_CHECK(Opm::BinaryOutputWriter::readField(dir.name(), "case", 1, "temperature")
+                == state.temperature());
+}
+
+BOOST_FIXTURE_TEST_CASE (selection, Fixture)
+{
+    Opm::parameter::ParameterGroup params;
+    params.insertParameter("output_dir", dir.name());
+    params.insertParameter("output_fields", "pressure, well_bhp");
+    Opm::PhaseUsage phase_usage = Opm::PhaseUsage();
+    Opm::BinaryOutputWriter writer(params, std::shared_ptr<const Opm::EclipseState>(),
+                                   phase_usage, 50, 0);
+    writer.writeInit(timer);
+    step(writer);
+
+    BOOST_CHECK_EQUAL(Opm::BinaryOutputWriter::readField(dir.name(), "output", 0, "well_bhp").size(), 2u);
+    BOOST_CHECK_THROW(Opm::BinaryOutputWriter::readField(dir.name(), "output", 0, "saturation"),
+                      std::runtime_error);
+
+    params.insertParameter("output_fields", "pressure,no_such_field");
+    BOOST_CHECK_THROW(Opm::BinaryOutputWriter(params, std::shared_ptr<const Opm::EclipseState>(),
+                                              phase_usage, 50, 0),
+                      std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
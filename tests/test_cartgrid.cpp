@@ -34,8 +34,33 @@
 /* --- our own headers --- */
 #include <opm/core/grid/cart_grid.h>
 #include <opm/core/grid.h>
+#include <opm/core/linalg/sparse_sys.h>
+#include <opm/core/pressure/flow_bc.h>
+#include <opm/core/pressure/tpfa/ifs_tpfa.h>
+#include <opm/core/wells.h>
 #include <stdio.h>
 
+#include <memory>
+#include <vector>
+
+namespace
+{
+    void checkSameSystem(const struct ifs_tpfa_data* h1,
+                         const struct ifs_tpfa_data* h2)
+    {
+        BOOST_REQUIRE_EQUAL(h1->A->m, h2->A->m);
+        BOOST_REQUIRE_EQUAL(h1->A->nnz, h2->A->nnz);
+        const std::size_t m = h1->A->m, nnz = h1->A->nnz;
+        BOOST_CHECK_EQUAL_COLLECTIONS(h1->A->ia, h1->A->ia + m + 1,
+                                      h2->A->ia, h2->A->ia + m + 1);
+        BOOST_CHECK_EQUAL_COLLECTIONS(h1->A->ja, h1->A->ja + nnz,
+                                      h2->A->ja, h2->A->ja + nnz);
+        BOOST_CHECK_EQUAL_COLLECTIONS(h1->A->sa, h1->A->sa + nnz,
+                                      h2->A->sa, h2->A->sa + nnz);
+        BOOST_CHECK_EQUAL_COLLECTIONS(h1->b, h1->b + m, h2->b, h2->b + m);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE ()
 
 BOOST_AUTO_TEST_CASE (facenumbers)
@@ -55,4 +80,108 @@ BOOST_AUTO_TEST_CASE (facenumbers)
     destroy_grid(g);
 }
 
+BOOST_AUTO_TEST_CASE (cartesian_topology)
+{
+    struct UnstructuredGrid *g = create_grid_hexa3d(4, 3, 2, 1., 2., 3.);
+    BOOST_CHECK (grid_has_cartesian_topology(g));
+
+    /* Swapping two cells breaks natural ordering. */
+    g->face_cells[2*g->cell_faces[1] + 1] = 2;
+    BOOST_CHECK (!grid_has_cartesian_topology(g));
+    destroy_grid(g);
+
+    g = create_grid_cart2d(2, 2, 1., 1.);
+    BOOST_CHECK (!grid_has_cartesian_topology(g));
+    destroy_grid(g);
+}
+
+BOOST_AUTO_TEST_CASE (cartesian_assembly)
+{
+    /* The seven-point assembly of a Cartesian grid must give the same
+     * system as the general assembly, which is used when the
+     * topology is not detected. */
+    std::shared_ptr<UnstructuredGrid>
+        g(create_grid_hexa3d(5, 4, 3, 1., 2., 3.), destroy_grid);
+    const int nc  = g->number_of_cells;
+    const int nf  = g->number_of_faces;
+    const int nhf = g->cell_facepos[nc];
+    BOOST_REQUIRE(grid_has_cartesian_topology(g.get()));
+
+    struct ifs_tpfa_data* cart = ifs_tpfa_construct(g.get(), 0);
+    BOOST_REQUIRE(cart != 0);
+
+    std::shared_ptr<Wells> W(create_wells(1, 1, 2), destroy_wells);
+    {
+        const double frac = 1.0;
+        const int    cells[] = { 7, 7 + 20 };
+        const double WI[]    = { 2.5, 1.5 };
+        BOOST_REQUIRE(add_well(PRODUCER, 0.0, 2, &frac, cells, WI, "P", W.get()));
+        BOOST_REQUIRE(append_well_controls(BHP, 1.0e5, &frac, 0, W.get()));
+        set_current_control(0, 0, W.get());
+    }
+
+    struct ifs_tpfa_data* cart_w = ifs_tpfa_construct(g.get(), W.get());
+    BOOST_REQUIRE(cart_w != 0);
+
+    /* Hide the face tags to select the general path. */
+    int* tags = g->cell_facetag;
+    g->cell_facetag = 0;
+    BOOST_REQUIRE(!grid_has_cartesian_topology(g.get()));
+    struct ifs_tpfa_data* gen   = ifs_tpfa_construct(g.get(), 0);
+    struct ifs_tpfa_data* gen_w = ifs_tpfa_construct(g.get(), W.get());
+    g->cell_facetag = tags;
+    BOOST_REQUIRE(gen != 0);
+    BOOST_REQUIRE(gen_w != 0);
+
+    std::vector<double> trans(nf), gpress(nhf), src(nc, 0.0);
+    for (int f = 0; f < nf; ++f) {
+        trans[f] = 1.0 + 0.1*((f*7) % 13);
+    }
+    for (int i = 0; i < nhf; ++i) {
+        gpress[i] = 0.01*((i*5) % 11) - 0.05;
+    }
+    src[3] = 1.0;
+    src[nc - 2] = -0.5;
+
+    std::shared_ptr<FlowBoundaryConditions>
+        bc(flow_conditions_construct(2), flow_conditions_destroy);
+    BOOST_REQUIRE(flow_conditions_append(BC_PRESSURE, g->cell_faces[0], 2.0e5, bc.get()));
+    BOOST_REQUIRE(flow_conditions_append(BC_FLUX_TOTVOL, g->cell_faces[g->cell_facepos[nc - 1] + 5],
+                                         0.25, bc.get()));
+
+    std::vector<double> totmob(nc), wdp(2, 10.0);
+    std::vector<double> porevol(nc), rock_comp(nc, 1.0e-5), pressure(nc), pv0(nc);
+    for (int c = 0; c < nc; ++c) {
+        totmob[c]   = 0.5 + 0.01*c;
+        porevol[c]  = 1.0 + 0.001*c;
+        pv0[c]      = porevol[c] - 1.0e-4*((c*3) % 7);
+        pressure[c] = 1.0e5 + 100.0*c;
+    }
+
+    struct ifs_tpfa_forces F = { &src[0], bc.get(), 0, 0, 0 };
+    BOOST_REQUIRE(ifs_tpfa_assemble(g.get(), &F, &trans[0], &gpress[0], cart));
+    BOOST_REQUIRE(ifs_tpfa_assemble(g.get(), &F, &trans[0], &gpress[0], gen));
+    checkSameSystem(cart, gen);
+
+    struct ifs_tpfa_forces Fw = { &src[0], bc.get(), W.get(), &totmob[0], &wdp[0] };
+    BOOST_REQUIRE(ifs_tpfa_assemble(g.get(), &Fw, &trans[0], &gpress[0], cart_w));
+    BOOST_REQUIRE(ifs_tpfa_assemble(g.get(), &Fw, &trans[0], &gpress[0], gen_w));
+    checkSameSystem(cart_w, gen_w);
+
+    std::vector<double> prev(pressure);
+    prev.push_back(0.9e5);
+    BOOST_REQUIRE(ifs_tpfa_assemble_comprock_increment(g.get(), &Fw, &trans[0], &gpress[0],
+                                                       &porevol[0], &rock_comp[0], 10.0,
+                                                       &prev[0], &pv0[0], cart_w));
+    BOOST_REQUIRE(ifs_tpfa_assemble_comprock_increment(g.get(), &Fw, &trans[0], &gpress[0],
+                                                       &porevol[0], &rock_comp[0], 10.0,
+                                                       &prev[0], &pv0[0], gen_w));
+    checkSameSystem(cart_w, gen_w);
+
+    ifs_tpfa_destroy(gen_w);
+    ifs_tpfa_destroy(gen);
+    ifs_tpfa_destroy(cart_w);
+    ifs_tpfa_destroy(cart);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
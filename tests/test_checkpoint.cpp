@@ -0,0 +1,167 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+/* --- Boost.Test boilerplate --- */
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE CheckpointTest
+#include <boost/test/unit_test.hpp>
+
+/* --- our own headers --- */
+#include <opm/core/io/Checkpoint.hpp>
+#include <opm/core/simulator/BlackoilState.hpp>
+#include <opm/core/simulator/SimulatorTimer.hpp>
+#include <opm/core/simulator/TwophaseState.hpp>
+#include <opm/core/simulator/WellState.hpp>
+#include <opm/core/utility/parameters/ParameterGroup.hpp>
+
+#include "TempPath.hpp"
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    void fill(std::vector<double>& v, const double start)
+    {
+        for (std::size_t i = 0; i < v.size(); ++i) {
+            v[i] = start + 0.5*i;
+        }
+    }
+
+    void advance(Opm::SimulatorTimer& timer, const int steps)
+    {
+        Opm::parameter::ParameterGroup param;
+        param.insertParameter("num_psteps", "10");
+        param.insertParameter("stepsize_days", "2.0");
+        timer.init(param);
+        timer.setCurrentStepNum(steps);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE ()
+
+BOOST_AUTO_TEST_CASE (blackoilRoundTrip)
+{
+    const int nc = 17, nf = 40, np = 3;
+    Opm::BlackoilState state;
+    state.init(nc, nf, np);
+    fill(state.pressure(), 1.0e7);
+    fill(state.temperature(), 300.0);
+    fill(state.facepressure(), 2.0e7);
+    fill(state.faceflux(), -3.0);
+    fill(state.saturation(), 0.1);
+    fill(state.surfacevol(), 4.0);
+    fill(state.gasoilratio(), 5.0);
+    fill(state.rv(), 6.0);
+
+    Opm::WellState well_state;
+    well_state.bhp().assign(2, 1.5e7);
+    well_state.temperature().assign(2, 350.0);
+    well_state.wellRates().assign(2*np, 0.0);
+    fill(well_state.wellRates(), -1.0);
+    well_state.perfRates().assign(5, 0.25);
+    well_state.perfPress().assign(5, 1.2e7);
+
+    Opm::SimulatorTimer timer;
+    advance(timer, 4);
+
+    TempPath file("opm-checkpoint-%%%%-%%%%.bin");
+    Opm::writeCheckpoint(file.name(), timer, state, well_state);
+
+    Opm::Checkpoint checkpoint(file.name());
+    BOOST_CHECK_EQUAL(checkpoint.stepNum(), 4);
+    BOOST_CHECK_EQUAL(checkpoint.simulationTime(), timer.simulationTimeElapsed());
+    BOOST_CHECK_EQUAL(checkpoint.numPhases(), np);
+
+    std::size_t size;
+    const double* p = checkpoint.field("pressure", size);
+    BOOST_REQUIRE(p != 0);
+    BOOST_CHECK_EQUAL(size, std::size_t(nc));
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::size_t>(p) % 64, 0u);
+    BOOST_CHECK(checkpoint.field("no_such_field", size) == 0);
+
+    Opm::BlackoilState restored;
+    restored.init(nc, nf, np);
+    Opm::WellState restored_wells;
+    checkpoint.restore(restored, restored_wells);
+
+    BOOST_CHECK(restored.equals(state, 0.0));
+    BOOST_CHECK(restored_wells.bhp() == well_state.bhp());
+    BOOST_CHECK(restored_wells.temperature() == well_state.temperature());
+    BOOST_CHECK(restored_wells.wellRates() == well_state.wellRates());
+    BOOST_CHECK(restored_wells.perfRates() == well_state.perfRates());
+    BOOST_CHECK(restored_wells.perfPress() == well_state.perfPress());
+}
+
+BOOST_AUTO_TEST_CASE (mismatchIsRejected)
+{
+    const int nc = 6, nf = 11, np = 2;
+    Opm::TwophaseState state;
+    state.init(nc, nf, np);
+    fill(state.pressure(), 1.0e5);
+    Opm::WellState well_state;
+
+    Opm::SimulatorTimer timer;
+    advance(timer, 0);
+
+    TempPath file("opm-checkpoint-%%%%-%%%%.bin");
+    Opm::writeCheckpoint(file.name(), timer, state, well_state);
+    Opm::Checkpoint checkpoint(file.name());
+
+    // Twophase states restore fine, also into an empty well state.
+    Opm::TwophaseState restored;
+    restored.init(nc, nf, np);
+    Opm::WellState restored_wells;
+    checkpoint.restore(restored, restored_wells);
+    BOOST_CHECK(restored.equals(state, 0.0));
+    BOOST_CHECK(restored_wells.bhp().empty());
+
+    // Wrong number of cells.
+    Opm::TwophaseState other_grid;
+    other_grid.init(nc + 1, nf, np);
+    BOOST_CHECK_THROW(checkpoint.restore(other_grid, restored_wells), std::runtime_error);
+
+    // Missing blackoil fields.
+    Opm::BlackoilState blackoil;
+    blackoil.init(nc, nf, np);
+    BOOST_CHECK_THROW(checkpoint.restore(blackoil, restored_wells), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE (invalidFile)
+{
+    TempPath file("opm-checkpoint-%%%%-%%%%.bin");
+    BOOST_CHECK_THROW(Opm::Checkpoint(file.name()), std::runtime_error);
+
+    {
+        std::ofstream os(file.name().c_str());
+        os << "This is not a checkpoint file, although it is long enough to hold a header.";
+    }
+    BOOST_CHECK_THROW(Opm::Checkpoint(file.name()), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,262 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+/* --- Boost.Test boilerplate --- */
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE CpgPreprocessTest
+#include <boost/test/unit_test.hpp>
+
+/* --- our own headers --- */
+#include <opm/core/grid/cpgpreprocess/preprocess.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace
+{
+    // Deterministic pseudo-random numbers in [0, 1).
+    class Random
+    {
+    public:
+        explicit Random(unsigned long long seed) : state_(seed) {}
+
+        double operator()()
+        {
+            state_ = state_*6364136223846793005ULL + 1442695040888963407ULL;
+            return double((state_ >> 11) & ((1ULL << 52) - 1)) / double(1ULL << 52);
+        }
+
+    private:
+        unsigned long long state_;
+    };
+
+    // Corner-point grid with faults between all columns, pinched
+    // layers, gaps between layers and inactive cells.  With 'tilt'
+    // large compared to the layer thickness, the layers of
+    // neighbouring columns cross between the pillars.
+    struct FaultedDeck
+    {
+        FaultedDeck(int nx, int ny, int nz, double tilt, unsigned long long seed)
+            : coord(6*(nx + 1)*(ny + 1))
+            , zcorn(8*nx*ny*nz)
+            , actnum(nx*ny*nz)
+        {
+            Random rnd(seed);
+            for (int j = 0; j <= ny; ++j) {
+                for (int i = 0; i <= nx; ++i) {
+                    double* c = &coord[6*(i + (nx + 1)*j)];
+                    c[0] = i;                  c[1] = j;                  c[2] = 0.0;
+                    c[3] = i + 0.1*rnd();      c[4] = j + 0.1*rnd();      c[5] = 100.0;
+                }
+            }
+            for (int j = 0; j < ny; ++j) {
+                for (int i = 0; i < nx; ++i) {
+                    double z = ((i > nx/2) ? 0.7 : 0.0) + ((j > ny/3) ? 1.3*rnd() : 0.0);
+                    double offset[4];
+                    for (int q = 0; q < 4; ++q) {
+                        offset[q] = tilt*rnd();
+                    }
+                    for (int k = 0; k < nz; ++k) {
+                        const double bottom = z + ((rnd() < 0.15) ? 0.0 : 1.0 + rnd());
+                        for (int cj = 0; cj < 2; ++cj) {
+                            for (int ci = 0; ci < 2; ++ci) {
+                                const int I = 2*i + ci, J = 2*j + cj;
+                                zcorn[I + 2*nx*(J + 2*ny*(2*k + 0))] = z + offset[ci + 2*cj];
+                                zcorn[I + 2*nx*(J + 2*ny*(2*k + 1))] = bottom + offset[ci + 2*cj];
+                            }
+                        }
+                        z = bottom + ((rnd() < 0.1) ? 0.5 : 0.0);
+                        actnum[i + nx*(j + ny*k)] = (rnd() < 0.1) ? 0 : 1;
+                    }
+                }
+            }
+
+            g.dims[0] = nx;
+            g.dims[1] = ny;
+            g.dims[2] = nz;
+            g.coord   = &coord[0];
+            g.zcorn   = &zcorn[0];
+            g.actnum  = &actnum[0];
+            g.mapaxes = 0;
+        }
+
+        std::vector<double> coord;
+        std::vector<double> zcorn;
+        std::vector<int> actnum;
+        struct grdecl g;
+    };
+
+    void processWithThreads(const struct grdecl& g, int threads,
+                            struct processed_grid& out)
+    {
+#ifdef _OPENMP
+        const int saved = omp_get_max_threads();
+        omp_set_num_threads(threads);
+#else
+        static_cast<void>(threads);
+#endif
+        process_grdecl(&g, 0.0, &out);
+#ifdef _OPENMP
+        omp_set_num_threads(saved);
+#endif
+    }
+
+    template <typename T>
+    void checkArray(const T* a, const T* b, std::size_t n)
+    {
+        BOOST_CHECK_EQUAL_COLLECTIONS(a, a + n, b, b + n);
+    }
+
+    // Every array of the processed grid must be identical, not just
+    // equivalent: faces and nodes are numbered as in a serial sweep.
+    void checkThreadIndependent(const FaultedDeck& deck)
+    {
+        struct processed_grid serial, parallel;
+        processWithThreads(deck.g, 1, serial);
+        processWithThreads(deck.g, 4, parallel);
+
+        BOOST_REQUIRE_EQUAL(serial.number_of_faces, parallel.number_of_faces);
+        BOOST_REQUIRE_EQUAL(serial.number_of_nodes, parallel.number_of_nodes);
+        BOOST_REQUIRE_EQUAL(serial.number_of_nodes_on_pillars,
+                            parallel.number_of_nodes_on_pillars);
+        BOOST_REQUIRE_EQUAL(serial.number_of_cells, parallel.number_of_cells);
+
+        const std::size_t nf = serial.number_of_faces;
+        checkArray(serial.face_ptr, parallel.face_ptr, nf + 1);
+        BOOST_REQUIRE_EQUAL(serial.face_ptr[nf], parallel.face_ptr[nf]);
+        checkArray(serial.face_nodes, parallel.face_nodes, serial.face_ptr[nf]);
+        checkArray(serial.face_neighbors, parallel.face_neighbors, 2*nf);
+        checkArray(serial.face_tag, parallel.face_tag, nf);
+        checkArray(serial.node_coordinates, parallel.node_coordinates,
+                   3*std::size_t(serial.number_of_nodes));
+        checkArray(serial.local_cell_index, parallel.local_cell_index,
+                   std::size_t(serial.number_of_cells));
+
+        free_processed_grid(&serial);
+        free_processed_grid(&parallel);
+    }
+
+    int compareDoubles(const void* a, const void* b)
+    {
+        const double x = *static_cast<const double*>(a);
+        const double y = *static_cast<const double*>(b);
+        return (x < y) ? -1 : ((y < x) ? 1 : 0);
+    }
+
+    // Unique z-values of active corners on each pillar, in the order of
+    // the pillar nodes of the processed grid, found by qsort().
+    std::vector<double> pillarValues(const struct grdecl& g)
+    {
+        const int nx = g.dims[0], ny = g.dims[1], nz = g.dims[2];
+        std::vector<double> result, list;
+        for (int j = 0; j <= ny; ++j) {
+            for (int i = 0; i <= nx; ++i) {
+                list.clear();
+                for (int cj = std::max(j - 1, 0); cj < std::min(j + 1, ny); ++cj) {
+                    for (int ci = std::max(i - 1, 0); ci < std::min(i + 1, nx); ++ci) {
+                        const int I = 2*ci + (i - ci), J = 2*cj + (j - cj);
+                        for (int k = 0; k < nz; ++k) {
+                            if (g.actnum[ci + nx*(cj + ny*k)]) {
+                                list.push_back(g.zcorn[I + 2*nx*(J + 2*ny*(2*k + 0))]);
+                                list.push_back(g.zcorn[I + 2*nx*(J + 2*ny*(2*k + 1))]);
+                            }
+                        }
+                    }
+                }
+                if (list.empty()) {
+                    continue;
+                }
+                std::qsort(&list[0], list.size(), sizeof list[0], compareDoubles);
+                result.push_back(list[0]);
+                for (std::size_t p = 1; p < list.size(); ++p) {
+                    if (result.back() < list[p]) {
+                        result.push_back(list[p]);
+                    }
+                }
+            }
+        }
+        return result;
+    }
+
+    // Round the depths to a coarse grid, giving many equal values on
+    // each pillar, and move the top of the grid above z = 0.
+    void roundDepths(FaultedDeck& deck, double shift)
+    {
+        for (std::size_t i = 0; i < deck.zcorn.size(); ++i) {
+            deck.zcorn[i] = std::floor(4.0*deck.zcorn[i])/4.0 - shift;
+        }
+    }
+
+    void checkPillarNodes(const FaultedDeck& deck)
+    {
+        const std::vector<double> expected = pillarValues(deck.g);
+
+        struct processed_grid out;
+        process_grdecl(&deck.g, 0.0, &out);
+        BOOST_REQUIRE_EQUAL(std::size_t(out.number_of_nodes_on_pillars), expected.size());
+        for (std::size_t n = 0; n < expected.size(); ++n) {
+            BOOST_CHECK_EQUAL(out.node_coordinates[3*n + 2], expected[n]);
+        }
+        free_processed_grid(&out);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE ()
+
+BOOST_AUTO_TEST_CASE (faultedAndPinched)
+{
+    const FaultedDeck deck(11, 9, 12, 0.8, 12345);
+    checkThreadIndependent(deck);
+}
+
+BOOST_AUTO_TEST_CASE (crossingLayers)
+{
+    // Many crossings along each pillar pair, giving far more faces
+    // than layers.
+    const FaultedDeck deck(6, 5, 25, 30.0, 5);
+    checkThreadIndependent(deck);
+}
+
+BOOST_AUTO_TEST_CASE (pillarSort)
+{
+    // Up to 8*nz values on a pillar: sorted by insertion for nz = 8,
+    // by radix sort for larger nz.
+    const int nzs[] = { 8, 9, 40 };
+    for (int n = 0; n < 3; ++n) {
+        FaultedDeck deck(5, 4, nzs[n], 3.0, 7 + n);
+        roundDepths(deck, 0.5*nzs[n]);
+        checkPillarNodes(deck);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
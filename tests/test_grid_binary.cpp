@@ -0,0 +1,88 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+/* --- Boost.Test boilerplate --- */
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE GridBinaryTest
+#include <boost/test/unit_test.hpp>
+
+/* --- our own headers --- */
+#include <opm/core/grid/cart_grid.h>
+#include <opm/core/grid/grid_binary.h>
+#include <opm/core/grid.h>
+
+#include <cstdio>
+
+BOOST_AUTO_TEST_SUITE ()
+
+BOOST_AUTO_TEST_CASE (roundtrip)
+{
+    const char* fname = "test_grid_binary.ugrid";
+    const uint64_t key = 0x0123456789abcdefULL;
+
+    struct UnstructuredGrid *g = create_grid_hexa3d(4, 3, 2, 1.0, 2.0, 3.0);
+    BOOST_REQUIRE (g != 0);
+    BOOST_REQUIRE (write_grid_binary(g, fname, key));
+
+    struct UnstructuredGrid *m = map_grid_binary(fname, key);
+    BOOST_REQUIRE (m != 0);
+    BOOST_CHECK (grid_equal(g, m));
+    BOOST_CHECK_EQUAL (m->cartdims[0], 4);
+    BOOST_CHECK_EQUAL (m->cartdims[1], 3);
+    BOOST_CHECK_EQUAL (m->cartdims[2], 2);
+    BOOST_CHECK ((g->global_cell == 0) == (m->global_cell == 0));
+
+    // Mapping is private: modifying the grid does not alter the file.
+    m->cell_volumes[0] = -1.0;
+    unmap_grid_binary(m);
+    m = map_grid_binary(fname, key);
+    BOOST_REQUIRE (m != 0);
+    BOOST_CHECK_EQUAL (m->cell_volumes[0], g->cell_volumes[0]);
+    unmap_grid_binary(m);
+
+    // Wrong key.
+    BOOST_CHECK (map_grid_binary(fname, key + 1) == 0);
+
+    destroy_grid(g);
+    std::remove(fname);
+}
+
+BOOST_AUTO_TEST_CASE (invalid_file)
+{
+    const char* fname = "test_grid_binary_invalid.ugrid";
+
+    BOOST_CHECK (map_grid_binary(fname, 0) == 0);
+
+    std::FILE* fp = std::fopen(fname, "w");
+    BOOST_REQUIRE (fp != 0);
+    std::fputs("not a grid file", fp);
+    std::fclose(fp);
+    BOOST_CHECK (map_grid_binary(fname, 0) == 0);
+
+    std::remove(fname);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,106 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+/* --- Boost.Test boilerplate --- */
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE GridCompactTest
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+/* --- our own headers --- */
+#include <opm/core/grid/cart_grid.h>
+#include <opm/core/grid/grid_compact.h>
+#include <opm/core/grid.h>
+
+#include <cstddef>
+
+BOOST_AUTO_TEST_SUITE ()
+
+BOOST_AUTO_TEST_CASE (roundtrip)
+{
+    struct UnstructuredGrid *g = create_grid_hexa3d(10, 9, 8, 0.1, 0.2, 0.3);
+    struct UnstructuredGrid *h = create_grid_hexa3d(10, 9, 8, 0.1, 0.2, 0.3);
+    BOOST_REQUIRE (g != 0);
+    BOOST_REQUIRE (h != 0);
+
+    const std::size_t nfn = g->face_nodepos[g->number_of_faces];
+    const std::size_t full = g->dimensions * g->number_of_nodes * sizeof(double)
+        + (nfn + g->number_of_faces + 1) * sizeof(int);
+
+    struct grid_node_archive *a = archive_grid_nodes(g, 0);
+    BOOST_REQUIRE (a != 0);
+    BOOST_CHECK (g->node_coordinates == 0);
+    BOOST_CHECK (g->face_nodes == 0);
+    BOOST_CHECK (g->face_nodepos == 0);
+    BOOST_CHECK (grid_node_archive_size(a) < full);
+
+    BOOST_REQUIRE (restore_grid_nodes(g, a));
+    BOOST_CHECK (grid_equal(g, h));
+
+    destroy_grid(h);
+    destroy_grid(g);
+}
+
+BOOST_AUTO_TEST_CASE (single_precision)
+{
+    struct UnstructuredGrid *g = create_grid_hexa3d(10, 9, 8, 0.1, 0.2, 0.3);
+    struct UnstructuredGrid *h = create_grid_hexa3d(10, 9, 8, 0.1, 0.2, 0.3);
+    BOOST_REQUIRE (g != 0);
+    BOOST_REQUIRE (h != 0);
+
+    struct grid_node_archive *a = archive_grid_nodes(g, 1);
+    BOOST_REQUIRE (a != 0);
+    BOOST_REQUIRE (restore_grid_nodes(g, a));
+
+    const int nfn = h->face_nodepos[h->number_of_faces];
+    for (int f = 0; f <= h->number_of_faces; ++f) {
+        BOOST_REQUIRE_EQUAL (g->face_nodepos[f], h->face_nodepos[f]);
+    }
+    for (int i = 0; i < nfn; ++i) {
+        BOOST_REQUIRE_EQUAL (g->face_nodes[i], h->face_nodes[i]);
+    }
+    for (int i = 0; i < h->dimensions * h->number_of_nodes; ++i) {
+        BOOST_CHECK_CLOSE (g->node_coordinates[i] + 1.0,
+                           h->node_coordinates[i] + 1.0, 1.0e-5);
+    }
+
+    destroy_grid(h);
+    destroy_grid(g);
+}
+
+BOOST_AUTO_TEST_CASE (destroy_unrestored)
+{
+    struct UnstructuredGrid *g = create_grid_cart2d(5, 4, 1.0, 1.0);
+    BOOST_REQUIRE (g != 0);
+
+    struct grid_node_archive *a = archive_grid_nodes(g, 0);
+    BOOST_REQUIRE (a != 0);
+
+    destroy_grid_node_archive(a);
+    destroy_grid(g);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,131 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+/* --- Boost.Test boilerplate --- */
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE GridPartitionTest
+#include <boost/test/unit_test.hpp>
+
+/* --- our own headers --- */
+#include <opm/core/grid/GridManager.hpp>
+#include <opm/core/grid/GridPartition.hpp>
+#include <opm/core/grid.h>
+
+#include <algorithm>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE ()
+
+BOOST_AUTO_TEST_CASE (bisection)
+{
+    Opm::GridManager gm(10, 9, 8);
+    const UnstructuredGrid& g = *gm.c_grid();
+
+    for (int np = 1; np <= 7; ++np) {
+        Opm::GridPartition partition(g, np, false);
+        std::vector<int> size(np, 0);
+        for (int c = 0; c < g.number_of_cells; ++c) {
+            BOOST_REQUIRE(partition.cellPart()[c] >= 0);
+            BOOST_REQUIRE(partition.cellPart()[c] < np);
+            ++size[partition.cellPart()[c]];
+        }
+        const int smallest = *std::min_element(size.begin(), size.end());
+        const int largest = *std::max_element(size.begin(), size.end());
+        BOOST_CHECK(largest - smallest <= 3);
+    }
+
+    // Two parts of a 10x9x8 box are split across the x-direction.
+    Opm::GridPartition two(g, 2, false);
+    BOOST_CHECK_EQUAL(two.numCutFaces(), 9*8);
+}
+
+BOOST_AUTO_TEST_CASE (refinement)
+{
+    Opm::GridManager gm(13, 11, 3);
+    const UnstructuredGrid& g = *gm.c_grid();
+
+    Opm::GridPartition coarse(g, 6, false);
+    Opm::GridPartition refined(g, 6, true, 0.1);
+    BOOST_CHECK(refined.numCutFaces() <= coarse.numCutFaces());
+
+    std::vector<int> size(6, 0);
+    for (int c = 0; c < g.number_of_cells; ++c) {
+        ++size[refined.cellPart()[c]];
+    }
+    const double avg = double(g.number_of_cells)/6;
+    for (int p = 0; p < 6; ++p) {
+        BOOST_CHECK(size[p] <= avg*1.1 + 1);
+        BOOST_CHECK(size[p] >= avg*0.9 - 1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (subdomains)
+{
+    Opm::GridManager gm(6, 5, 4);
+    const UnstructuredGrid& g = *gm.c_grid();
+    const int np = 3;
+    Opm::GridPartition partition(g, np);
+
+    std::vector<int> owner_count(g.number_of_cells, 0);
+    double total_volume = 0.0;
+    for (int p = 0; p < np; ++p) {
+        Opm::SubdomainGrid sub(g, partition, p);
+        const UnstructuredGrid& s = *sub.c_grid();
+        const std::vector<int>& parent = sub.parentCell();
+        BOOST_REQUIRE_EQUAL(int(parent.size()), s.number_of_cells);
+        BOOST_REQUIRE_EQUAL(int(sub.parentFace().size()), s.number_of_faces);
+
+        std::vector<double> volumes(g.cell_volumes, g.cell_volumes + g.number_of_cells);
+        const std::vector<double> sub_volumes = sub.cellDataFromParent(volumes, g.number_of_cells);
+
+        for (int c = 0; c < s.number_of_cells; ++c) {
+            const bool owned = c < sub.numOwnedCells();
+            BOOST_CHECK_EQUAL(partition.cellPart()[parent[c]] == p, owned);
+            BOOST_CHECK_EQUAL(s.global_cell[c], parent[c]);
+            BOOST_CHECK_EQUAL(s.cell_volumes[c], sub_volumes[c]);
+            if (owned) {
+                ++owner_count[parent[c]];
+                total_volume += s.cell_volumes[c];
+
+                // All neighbours of owned cells are in the subgrid.
+                for (int hf = s.cell_facepos[c]; hf < s.cell_facepos[c + 1]; ++hf) {
+                    const int f = s.cell_faces[hf];
+                    const int pf = sub.parentFace()[f];
+                    const bool parent_boundary = g.face_cells[2*pf] < 0 || g.face_cells[2*pf + 1] < 0;
+                    const bool sub_boundary = s.face_cells[2*f] < 0 || s.face_cells[2*f + 1] < 0;
+                    BOOST_CHECK_EQUAL(parent_boundary, sub_boundary);
+                }
+            }
+        }
+    }
+
+    for (int c = 0; c < g.number_of_cells; ++c) {
+        BOOST_CHECK_EQUAL(owner_count[c], 1);
+    }
+    BOOST_CHECK_CLOSE(total_volume, double(g.number_of_cells), 1e-10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,152 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+/* --- Boost.Test boilerplate --- */
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE GridRenumberTest
+#include <boost/test/unit_test.hpp>
+
+/* --- our own headers --- */
+#include <opm/core/grid/cart_grid.h>
+#include <opm/core/grid/GridRenumbering.hpp>
+#include <opm/core/grid.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+    // Maximum index distance between neighbouring cells.
+    int bandwidth(const UnstructuredGrid& g)
+    {
+        int bw = 0;
+        for (int f = 0; f < g.number_of_faces; ++f) {
+            const int c1 = g.face_cells[2*f];
+            const int c2 = g.face_cells[2*f + 1];
+            if (c1 >= 0 && c2 >= 0) {
+                bw = std::max(bw, std::abs(c1 - c2));
+            }
+        }
+        return bw;
+    }
+
+    void checkRenumbering(const UnstructuredGrid& g,
+                          const Opm::GridRenumbering& r)
+    {
+        const UnstructuredGrid& rg = *r.c_grid();
+        BOOST_REQUIRE_EQUAL(rg.number_of_cells, g.number_of_cells);
+        BOOST_REQUIRE_EQUAL(rg.number_of_faces, g.number_of_faces);
+
+        // Orderings are permutations.
+        std::vector<int> cells = r.cellNewToOld();
+        std::sort(cells.begin(), cells.end());
+        for (int c = 0; c < g.number_of_cells; ++c) {
+            BOOST_REQUIRE_EQUAL(cells[c], c);
+        }
+        std::vector<int> faces = r.faceNewToOld();
+        std::sort(faces.begin(), faces.end());
+        for (int f = 0; f < g.number_of_faces; ++f) {
+            BOOST_REQUIRE_EQUAL(faces[f], f);
+        }
+
+        // Cell data and topology are consistently permuted.
+        const int nd = g.dimensions;
+        for (int c = 0; c < rg.number_of_cells; ++c) {
+            const int oc = r.cellNewToOld()[c];
+            BOOST_CHECK_EQUAL(r.cellOldToNew()[oc], c);
+            BOOST_CHECK_EQUAL(rg.cell_volumes[c], g.cell_volumes[oc]);
+            BOOST_CHECK_EQUAL(rg.cell_centroids[nd*c], g.cell_centroids[nd*oc]);
+            BOOST_CHECK_EQUAL(rg.global_cell[c], g.global_cell ? g.global_cell[oc] : oc);
+            BOOST_REQUIRE_EQUAL(rg.cell_facepos[c + 1] - rg.cell_facepos[c],
+                                g.cell_facepos[oc + 1] - g.cell_facepos[oc]);
+            for (int i = 0; i < rg.cell_facepos[c + 1] - rg.cell_facepos[c]; ++i) {
+                const int f  = rg.cell_faces[rg.cell_facepos[c] + i];
+                const int of = g.cell_faces[g.cell_facepos[oc] + i];
+                BOOST_CHECK_EQUAL(r.faceNewToOld()[f], of);
+                BOOST_CHECK_EQUAL(rg.cell_facetag[rg.cell_facepos[c] + i],
+                                  g.cell_facetag[g.cell_facepos[oc] + i]);
+            }
+        }
+        for (int f = 0; f < rg.number_of_faces; ++f) {
+            const int of = r.faceNewToOld()[f];
+            BOOST_CHECK_EQUAL(r.faceOldToNew()[of], f);
+            BOOST_CHECK_EQUAL(rg.face_areas[f], g.face_areas[of]);
+            for (int k = 0; k < 2; ++k) {
+                const int c = rg.face_cells[2*f + k];
+                const int oc = g.face_cells[2*of + k];
+                BOOST_CHECK_EQUAL(c < 0 ? c : r.cellNewToOld()[c], oc);
+            }
+        }
+
+        // Data translation round trip, with two components per cell.
+        std::vector<double> data(2*g.number_of_cells);
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            data[i] = i;
+        }
+        const std::vector<double> renumbered = r.cellDataToNew(data);
+        BOOST_CHECK_EQUAL(renumbered[1], data[2*r.cellNewToOld()[0] + 1]);
+        const std::vector<double> back = r.cellDataToOld(renumbered);
+        BOOST_CHECK(back == data);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE ()
+
+BOOST_AUTO_TEST_CASE (reverseCuthillMcKee)
+{
+    UnstructuredGrid* g = create_grid_cart3d(7, 5, 3);
+    {
+        Opm::GridRenumbering r(*g, Opm::GridRenumbering::ReverseCuthillMcKee);
+        checkRenumbering(*g, r);
+        BOOST_CHECK(bandwidth(*r.c_grid()) < bandwidth(*g));
+    }
+    destroy_grid(g);
+}
+
+BOOST_AUTO_TEST_CASE (hilbert)
+{
+    UnstructuredGrid* g = create_grid_cart3d(8, 8, 8);
+    {
+        Opm::GridRenumbering r(*g, Opm::GridRenumbering::Hilbert);
+        checkRenumbering(*g, r);
+
+        // Consecutive cells along a Hilbert curve through a uniform
+        // grid of power-of-two size are neighbours.
+        const UnstructuredGrid& rg = *r.c_grid();
+        for (int c = 0; c + 1 < rg.number_of_cells; ++c) {
+            double dist = 0.0;
+            for (int d = 0; d < 3; ++d) {
+                dist += std::abs(rg.cell_centroids[3*c + d] - rg.cell_centroids[3*(c + 1) + d]);
+            }
+            BOOST_CHECK_CLOSE(dist, 1.0, 1e-10);
+        }
+    }
+    destroy_grid(g);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
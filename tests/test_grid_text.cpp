@@ -0,0 +1,234 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+/* --- Boost.Test boilerplate --- */
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE GridTextTest
+#include <boost/test/unit_test.hpp>
+
+/* --- our own headers --- */
+#include <opm/core/grid/cart_grid.h>
+#include <opm/core/grid/grid_text.h>
+#include <opm/core/grid.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <iomanip>
+#include <limits>
+#include <string>
+
+namespace
+{
+    template <typename T>
+    void writeArray(std::ostream& os, const T* a, std::size_t n)
+    {
+        for (std::size_t i = 0; i < n; ++i) {
+            os << a[i] << ((i % 8 == 7) ? '\n' : ' ');
+        }
+        os << '\n';
+    }
+
+    // Character representation read by read_grid().
+    void writeGrid(const UnstructuredGrid& g, const char* fname,
+                   bool tags, bool indexmap)
+    {
+        const std::size_t nd  = g.dimensions;
+        const std::size_t nc  = g.number_of_cells;
+        const std::size_t nf  = g.number_of_faces;
+        const std::size_t ncf = g.cell_facepos[nc];
+
+        std::ofstream os(fname);
+        os << std::setprecision(std::numeric_limits<double>::digits10 + 2);
+        os << nd << ' ' << nc << ' ' << nf << ' ' << g.number_of_nodes << ' '
+           << g.face_nodepos[nf] << ' ' << ncf << '\n'
+           << int(tags) << ' ' << int(indexmap) << '\n';
+        writeArray(os, g.cartdims, nd);
+
+        writeArray(os, g.node_coordinates, nd * g.number_of_nodes);
+        writeArray(os, g.face_nodepos, nf + 1);
+        writeArray(os, g.face_nodes, g.face_nodepos[nf]);
+        writeArray(os, g.face_cells, 2 * nf);
+        writeArray(os, g.face_areas, nf);
+        writeArray(os, g.face_centroids, nd * nf);
+        writeArray(os, g.face_normals, nd * nf);
+        writeArray(os, g.cell_facepos, nc + 1);
+        for (std::size_t i = 0; i < ncf; ++i) {
+            os << g.cell_faces[i];
+            if (tags) {
+                os << ' ' << g.cell_facetag[i];
+            }
+            os << '\n';
+        }
+        if (indexmap) {
+            for (std::size_t c = 0; c < nc; ++c) {
+                os << 7 * c << '\n';
+            }
+        }
+        writeArray(os, g.cell_volumes, nc);
+        writeArray(os, g.cell_centroids, nd * nc);
+    }
+
+    std::string readFile(const char* fname)
+    {
+        std::ifstream is(fname);
+        return std::string(std::istreambuf_iterator<char>(is),
+                           std::istreambuf_iterator<char>());
+    }
+
+    void writeFile(const char* fname, const std::string& contents)
+    {
+        std::ofstream os(fname);
+        os << contents;
+    }
+
+    // Bitwise equality, which is stricter than grid_equal().
+    void checkIdentical(const UnstructuredGrid* g, const UnstructuredGrid* h)
+    {
+        BOOST_REQUIRE (g != 0);
+        BOOST_REQUIRE (h != 0);
+        BOOST_CHECK (grid_equal(g, h));
+
+        const std::size_t nd = g->dimensions;
+        const std::size_t nc = g->number_of_cells;
+        const std::size_t nf = g->number_of_faces;
+        const std::size_t nn = g->number_of_nodes;
+
+        BOOST_CHECK (std::memcmp(g->cartdims, h->cartdims, sizeof g->cartdims) == 0);
+        BOOST_CHECK (std::memcmp(g->node_coordinates, h->node_coordinates, nd*nn*sizeof(double)) == 0);
+        BOOST_CHECK (std::memcmp(g->face_areas, h->face_areas, nf*sizeof(double)) == 0);
+        BOOST_CHECK (std::memcmp(g->face_centroids, h->face_centroids, nd*nf*sizeof(double)) == 0);
+        BOOST_CHECK (std::memcmp(g->face_normals, h->face_normals, nd*nf*sizeof(double)) == 0);
+        BOOST_CHECK (std::memcmp(g->cell_volumes, h->cell_volumes, nc*sizeof(double)) == 0);
+        BOOST_CHECK (std::memcmp(g->cell_centroids, h->cell_centroids, nd*nc*sizeof(double)) == 0);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE ()
+
+BOOST_AUTO_TEST_CASE (sameAsReadGrid)
+{
+    const char* fname = "test_grid_text.txt";
+
+    struct UnstructuredGrid *g = create_grid_hexa3d(12, 10, 8, 0.1, 2.0/3.0, 1.0e3);
+    BOOST_REQUIRE (g != 0);
+
+    // Large enough to be processed in several chunks.
+    for (int variant = 0; variant < 4; ++variant) {
+        const bool tags     = (variant & 1) != 0;
+        const bool indexmap = (variant & 2) != 0;
+        writeGrid(*g, fname, tags, indexmap);
+
+        struct UnstructuredGrid *r = read_grid(fname);
+        struct UnstructuredGrid *m = read_grid_mapped(fname);
+        checkIdentical(r, m);
+        BOOST_CHECK ((m->cell_facetag != 0) == tags);
+        BOOST_CHECK ((m->global_cell != 0) == indexmap);
+        if (indexmap) {
+            BOOST_CHECK_EQUAL (m->global_cell[3], 21);
+        }
+
+        destroy_grid(m);
+        destroy_grid(r);
+    }
+
+    destroy_grid(g);
+    std::remove(fname);
+}
+
+BOOST_AUTO_TEST_CASE (numberSyntax)
+{
+    const char* fname = "test_grid_text_syntax.txt";
+
+    struct UnstructuredGrid *g = create_grid_cart2d(3, 2, 1.0, 1.0);
+    BOOST_REQUIRE (g != 0);
+    writeGrid(*g, fname, true, false);
+    const std::string text = readFile(fname);
+    const std::size_t nodes = text.find("\n0 0 1 0") + 1;
+    BOOST_REQUIRE (nodes != std::string::npos + 1);
+
+    // Explicit signs, exponents, long mantissas, hexadecimal numbers,
+    // tabs and trailing text.
+    std::string modified = text;
+    modified.replace(nodes, 7, "+0 -0.0e0\t1.0000000000000000001 0x0p0");
+    modified += "trailing garbage\n";
+    writeFile(fname, modified);
+    {
+        struct UnstructuredGrid *r = read_grid(fname);
+        struct UnstructuredGrid *m = read_grid_mapped(fname);
+        checkIdentical(r, m);
+        destroy_grid(m);
+        destroy_grid(r);
+    }
+
+    // Numbers not separated by white space.
+    modified = text;
+    modified.replace(nodes, 7, "0 0 1-0");
+    writeFile(fname, modified);
+    {
+        struct UnstructuredGrid *r = read_grid(fname);
+        struct UnstructuredGrid *m = read_grid_mapped(fname);
+        checkIdentical(r, m);
+        destroy_grid(m);
+        destroy_grid(r);
+    }
+
+    destroy_grid(g);
+    std::remove(fname);
+}
+
+BOOST_AUTO_TEST_CASE (invalidFile)
+{
+    const char* fname = "test_grid_text_invalid.txt";
+
+    BOOST_CHECK (read_grid_mapped(fname) == 0);
+
+    writeFile(fname, "");
+    BOOST_CHECK (read_grid_mapped(fname) == 0);
+
+    writeFile(fname, "not a grid file");
+    BOOST_CHECK (read_grid_mapped(fname) == 0);
+
+    // Truncated file.
+    struct UnstructuredGrid *g = create_grid_cart2d(3, 2, 1.0, 1.0);
+    BOOST_REQUIRE (g != 0);
+    writeGrid(*g, fname, false, false);
+    const std::string text = readFile(fname);
+    writeFile(fname, text.substr(0, text.size() - 10));
+    BOOST_CHECK (read_grid_mapped(fname) == 0);
+
+    // Face-node count exceeding the header.
+    std::string bad = text;
+    bad.replace(0, bad.find('\n'), "2 6 17 12 10 24");
+    writeFile(fname, bad);
+    BOOST_CHECK (read_grid_mapped(fname) == 0);
+
+    destroy_grid(g);
+    std::remove(fname);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -68,3 +68,37 @@ BOOST_AUTO_TEST_CASE(Processing)
     mp3.process(pv, 2.5, actnum, z3.data());
     BOOST_CHECK_EQUAL_COLLECTIONS(z3.begin(), z3.end(), zcorn3after.begin(), zcorn3after.end());
 }
+
+
+BOOST_AUTO_TEST_CASE(CollapsedCellsAndPinchConnections)
+{
+    // Two columns of four cells.  In column 0, cell k = 1 is collapsed,
+    // connecting k = 0 and k = 2.  In column 1, the top cell is
+    // collapsed, which creates no connection.
+    const int nx = 2, ny = 1, nz = 4;
+    std::vector<double> zcorn(8*nx*ny*nz);
+    for (int k = 0; k < nz; ++k) {
+        for (int corner = 0; corner < 8*nx*ny; ++corner) {
+            zcorn[8*nx*ny*k + corner] = (corner < 4*nx*ny) ? k : k + 1;
+        }
+    }
+    std::vector<double> pv = { 1,   0.1,
+                               0.1, 1,
+                               1,   1,
+                               1,   1 };
+    std::vector<int> actnum(nx*ny*nz, 1);
+
+    Opm::MinpvProcessor mp(nx, ny, nz);
+    const Opm::MinpvProcessor::Result result = mp.process(pv, 0.5, actnum, zcorn.data());
+
+    const std::vector<int> collapsed = { 1, 2 };
+    BOOST_CHECK_EQUAL_COLLECTIONS(result.collapsed_cells.begin(), result.collapsed_cells.end(),
+                                  collapsed.begin(), collapsed.end());
+    BOOST_REQUIRE_EQUAL(result.pinch_connections.size(), 1);
+    BOOST_CHECK_EQUAL(result.pinch_connections[0].first, 0);
+    BOOST_CHECK_EQUAL(result.pinch_connections[0].second, 4);
+
+    // Cell 4 (column 0, k = 2) extends up to the top of cell 2.
+    BOOST_CHECK_EQUAL(zcorn[8*nx*ny*2], 1.0);
+    BOOST_CHECK_EQUAL(zcorn[8*nx*ny*1 + 4*nx*ny], 1.0);
+}
@@ -0,0 +1,129 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+/* --- Boost.Test boilerplate --- */
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE MobilitiesTest
+#include <boost/test/unit_test.hpp>
+
+/* --- our own headers --- */
+#include <opm/core/props/BlackoilPropertiesBasic.hpp>
+#include <opm/core/utility/miscUtilitiesBlackoil.hpp>
+#include <opm/core/utility/parameters/ParameterGroup.hpp>
+
+#include <vector>
+
+namespace
+{
+    // Two-phase properties for numCells cells, and saturations,
+    // pressures etc. for a subset of them that spans several blocks
+    // of computeMobilities().
+    struct Fixture
+    {
+        Fixture()
+            : props(params(), 3, 2000)
+            , np(props.numPhases())
+        {
+            for (int c = 1999; c >= 0; c -= 3) {
+                cells.push_back(c);
+            }
+            const int n = cells.size();
+            p.assign(n, 1.0e7);
+            T.assign(n, 300.0);
+            s.resize(n*np);
+            for (int i = 0; i < n; ++i) {
+                const double sw = double(i) / (n - 1);
+                s[i*np + 0] = sw;
+                s[i*np + 1] = 1.0 - sw;
+            }
+            z = s;
+        }
+
+        static Opm::parameter::ParameterGroup params()
+        {
+            Opm::parameter::ParameterGroup param;
+            param.insertParameter("num_phases", "2");
+            param.insertParameter("relperm_func", "Quadratic");
+            param.insertParameter("mu1", "0.5");
+            param.insertParameter("mu2", "3.0");
+            return param;
+        }
+
+        // Phase mobilities as computed before computeMobilities():
+        // viscosities and relative permeabilities for all cells, then
+        // divided.
+        std::vector<double> twoPassMobilities() const
+        {
+            const int n = cells.size();
+            std::vector<double> mu(n*np);
+            props.viscosity(n, &p[0], &T[0], &z[0], &cells[0], &mu[0], 0);
+            std::vector<double> mob(n*np);
+            props.relperm(n, &s[0], &cells[0], &mob[0], 0);
+            for (int i = 0; i < n*np; ++i) {
+                mob[i] /= mu[i];
+            }
+            return mob;
+        }
+
+        Opm::BlackoilPropertiesBasic props;
+        const int np;
+        std::vector<int> cells;
+        std::vector<double> p, T, z, s;
+    };
+}
+
+BOOST_AUTO_TEST_SUITE ()
+
+BOOST_FIXTURE_TEST_CASE (cellSubset, Fixture)
+{
+    const int n = cells.size();
+    BOOST_REQUIRE (n < props.numCells());
+    const std::vector<double> expected = twoPassMobilities();
+
+    std::vector<double> pmobc;
+    Opm::computePhaseMobilities(props, cells, p, T, z, s, pmobc);
+    BOOST_REQUIRE_EQUAL (pmobc.size(), expected.size());
+    for (int i = 0; i < n*np; ++i) {
+        BOOST_CHECK_CLOSE (pmobc[i], expected[i], 1.0e-12);
+    }
+
+    std::vector<double> totmob(n);
+    Opm::computeMobilities(props, n, &cells[0], &p[0], &T[0], &z[0], &s[0], 0,
+                           0, 0, &totmob[0], 0, 0);
+
+    std::vector<double> ff;
+    Opm::computeFractionalFlow(props, cells, p, T, z, s, ff);
+    BOOST_REQUIRE_EQUAL (ff.size(), expected.size());
+    for (int i = 0; i < n; ++i) {
+        const double tot = expected[i*np + 0] + expected[i*np + 1];
+        BOOST_CHECK_CLOSE (totmob[i], tot, 1.0e-12);
+        for (int phase = 0; phase < np; ++phase) {
+            BOOST_CHECK_CLOSE (ff[i*np + phase], expected[i*np + phase] / tot, 1.0e-12);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
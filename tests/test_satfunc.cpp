@@ -26,6 +26,8 @@
 #include <opm/core/props/BlackoilPropertiesBasic.hpp>
 #include <opm/core/props/BlackoilPropertiesFromDeck.hpp>
 #include <opm/core/props/BlackoilPhases.hpp>
+#include <opm/core/props/satfunc/SaturationPropsFromDeck.hpp>
+#include <opm/core/props/satfunc/SatFuncGwseg.hpp>
 
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/Deck/Deck.hpp>
@@ -103,6 +105,14 @@ BOOST_AUTO_TEST_CASE (GwsegStandard)
       BOOST_CHECK_CLOSE(dkrds[i*np*np+np*gpos+opos], DkroDsg[i], reltol);
     }
 
+    // Without derivatives relperm() takes the structure-of-arrays path,
+    // which must reproduce the pointwise values exactly.
+    double kr_soa[n*np];
+    props.relperm(n, s, cells, kr_soa, 0);
+    for (int i=0; i<n*np; ++i) {
+      BOOST_CHECK_EQUAL(kr_soa[i], kr[i]);
+    }
+
 /*    
     std::cout << std::setw(12) << "sw";
     std::cout << std::setw(12) << "so";
@@ -645,4 +655,154 @@ BOOST_AUTO_TEST_CASE (GwsegEPS_D)
 */
 }
 
+BOOST_AUTO_TEST_CASE (GwsegEPS_A_Baked)
+{
+    // Relperms from end-point scaling folded into per-cell tables must
+    // match those evaluated through the scaling transforms.
+
+    Opm::GridManager gm(1, 1, 10, 1.0, 1.0, 5.0);
+    const UnstructuredGrid& grid = *(gm.c_grid());
+    Opm::ParserPtr parser(new Opm::Parser() );
+    Opm::DeckConstPtr deck = parser->parseFile("satfuncEPS_A.DATA");
+    Opm::EclipseStateConstPtr eclipseState(new Opm::EclipseState(deck));
+
+    Opm::parameter::ParameterGroup param;
+    Opm::BlackoilPropertiesFromDeck props(deck, eclipseState, grid, param, false);
+    Opm::parameter::ParameterGroup param_baked;
+    param_baked.insertParameter("sat_eps_baked", "true");
+    Opm::BlackoilPropertiesFromDeck props_baked(deck, eclipseState, grid, param_baked, false);
+
+    const int np = 3;
+    BOOST_REQUIRE(np == props.numPhases());
+
+    const int n = 10*23;
+    std::vector<double> s(n*np);
+    std::vector<int> cells(n);
+    for (int i = 0; i < n; ++i) {
+        cells[i] = i % 10;
+        const double sw = 0.01 + 0.98*((i*7) % 23)/22.0;
+        const double sg = (1.0 - sw)*((i*5) % 17)/16.0;
+        s[i*np + 0] = sw;
+        s[i*np + 1] = 1.0 - sw - sg;
+        s[i*np + 2] = sg;
+    }
+
+    std::vector<double> kr(n*np), kr_baked(n*np);
+    props.relperm(n, &s[0], &cells[0], &kr[0], 0);
+    props_baked.relperm(n, &s[0], &cells[0], &kr_baked[0], 0);
+    for (int i = 0; i < n*np; ++i) {
+        BOOST_CHECK_SMALL(kr_baked[i] - kr[i], 1.0e-12);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (GwsegEPS_E_Baked)
+{
+    // As GwsegEPS_A_Baked, but with relperm value scaling only (KRW,
+    // KRORW etc), which jumps at the tabulated end points.  Uniform
+    // tables are resampled, so the jumps are not at table nodes.
+
+    Opm::GridManager gm(1, 1, 10, 1.0, 1.0, 5.0);
+    const UnstructuredGrid& grid = *(gm.c_grid());
+    Opm::ParserPtr parser(new Opm::Parser() );
+    Opm::DeckConstPtr deck = parser->parseFile("satfuncEPS_E.DATA");
+    Opm::EclipseStateConstPtr eclipseState(new Opm::EclipseState(deck));
+
+    const int np = 3;
+    const int n = 10*23;
+    std::vector<double> s(n*np);
+    std::vector<int> cells(n);
+    for (int i = 0; i < n; ++i) {
+        cells[i] = i % 10;
+        const double sw = 0.01 + 0.98*((i*7) % 23)/22.0;
+        const double sg = (1.0 - sw)*((i*5) % 17)/16.0;
+        s[i*np + 0] = sw;
+        s[i*np + 1] = 1.0 - sw - sg;
+        s[i*np + 2] = sg;
+    }
+
+    const char* sat_tab_size[] = { "-1", "50" };
+    for (int k = 0; k < 2; ++k) {
+        Opm::parameter::ParameterGroup param;
+        param.insertParameter("sat_tab_size", sat_tab_size[k]);
+        Opm::BlackoilPropertiesFromDeck props(deck, eclipseState, grid, param, false);
+        param.insertParameter("sat_eps_baked", "true");
+        Opm::BlackoilPropertiesFromDeck props_baked(deck, eclipseState, grid, param, false);
+        BOOST_REQUIRE(np == props.numPhases());
+
+        std::vector<double> kr(n*np), kr_baked(n*np);
+        std::vector<double> dkrds(n*np*np), dkrds_baked(n*np*np);
+        props.relperm(n, &s[0], &cells[0], &kr[0], &dkrds[0]);
+        props_baked.relperm(n, &s[0], &cells[0], &kr_baked[0], &dkrds_baked[0]);
+        for (int i = 0; i < n*np; ++i) {
+            BOOST_CHECK_SMALL(kr_baked[i] - kr[i], 1.0e-12);
+        }
+        for (int i = 0; i < n*np*np; ++i) {
+            BOOST_CHECK_SMALL(dkrds_baked[i] - dkrds[i], 1.0e-9);
+        }
+    }
+
+    // Cells 8 and 9 share the transform and baked table of cell 0.
+    typedef Opm::SaturationPropsFromDeck<Opm::SatFuncGwsegNonuniform> SatProps;
+    SatProps satprops;
+    satprops.init(deck, eclipseState, grid, 200);
+    BOOST_CHECK_EQUAL(satprops.numEPSBakedTables(), 0);
+    BOOST_CHECK_EQUAL(satprops.bakedEPSBytes(), 0u);
+    satprops.bakeEPS();
+    BOOST_CHECK_EQUAL(satprops.numEPSTransforms(), 8);
+    BOOST_CHECK_EQUAL(satprops.numEPSBakedTables(), 8);
+    BOOST_CHECK(satprops.bakedEPSBytes() > 8*sizeof(Opm::EPSBakedTables));
+}
+
+BOOST_AUTO_TEST_CASE (GwsegEPS_B_Shared)
+{
+    // Cells with identical scaling parameters share one transform, and
+    // evaluate as when each cell has a transform of its own.  In
+    // satfuncEPS_B.DATA cells 0, 8 and 9 have the same parameters.
+
+    Opm::GridManager gm(1, 1, 10, 1.0, 1.0, 5.0);
+    const UnstructuredGrid& grid = *(gm.c_grid());
+    Opm::ParserPtr parser(new Opm::Parser() );
+    Opm::DeckConstPtr deck = parser->parseFile("satfuncEPS_B.DATA");
+    Opm::EclipseStateConstPtr eclipseState(new Opm::EclipseState(deck));
+
+    typedef Opm::SaturationPropsFromDeck<Opm::SatFuncGwsegNonuniform> SatProps;
+    SatProps props;
+    props.init(deck, eclipseState, grid, 200);
+    BOOST_CHECK_EQUAL(props.numEPSTransforms(), 8);
+
+    const int np = 3;
+    BOOST_REQUIRE(np == props.numPhases());
+
+    const int n = 23;
+    std::vector<double> s(n*np);
+    for (int i = 0; i < n; ++i) {
+        const double sw = 0.01 + 0.98*((i*7) % 23)/22.0;
+        const double sg = (1.0 - sw)*((i*5) % 17)/16.0;
+        s[i*np + 0] = sw;
+        s[i*np + 1] = 1.0 - sw - sg;
+        s[i*np + 2] = sg;
+    }
+
+    for (int c = 0; c < grid.number_of_cells; ++c) {
+        // The same cell alone, which cannot share its transform.
+        SatProps single;
+        const double* centroid = grid.cell_centroids + c*grid.dimensions;
+        single.init(deck, eclipseState, 1, &c, centroid, grid.dimensions, 200);
+        BOOST_CHECK_EQUAL(single.numEPSTransforms(), 1);
+
+        const std::vector<int> cells(n, c);
+        const std::vector<int> cells_single(n, 0);
+        std::vector<double> kr(n*np), kr_single(n*np);
+        std::vector<double> pc(n*np), pc_single(n*np);
+        props.relperm(n, &s[0], &cells[0], &kr[0], 0);
+        single.relperm(n, &s[0], &cells_single[0], &kr_single[0], 0);
+        props.capPress(n, &s[0], &cells[0], &pc[0], 0);
+        single.capPress(n, &s[0], &cells_single[0], &pc_single[0], 0);
+        for (int i = 0; i < n*np; ++i) {
+            BOOST_CHECK_EQUAL(kr[i], kr_single[i]);
+            BOOST_CHECK_EQUAL(pc[i], pc_single[i]);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,94 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "config.h"
+
+/* --- Boost.Test boilerplate --- */
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE ScanDoubleTest
+#include <boost/test/unit_test.hpp>
+
+/* --- our own headers --- */
+#include <opm/core/utility/scan_double.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace
+{
+    // The token must convert to the bits strtod() gives.
+    void checkAsStrtod(const std::string& token)
+    {
+        BOOST_TEST_MESSAGE(token);
+        const std::string text = token + " 9";
+        double value = 0.0;
+        const char* end = scan_double(text.data(), text.data() + text.size(), &value);
+        BOOST_REQUIRE (end == text.data() + token.size());
+
+        const double expected = std::strtod(token.c_str(), 0);
+        BOOST_CHECK (std::memcmp(&value, &expected, sizeof value) == 0);
+
+        // Also when the number ends the (unterminated) buffer.
+        end = scan_double(text.data(), text.data() + token.size(), &value);
+        BOOST_CHECK (end == text.data() + token.size());
+        BOOST_CHECK (std::memcmp(&value, &expected, sizeof value) == 0);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE ()
+
+BOOST_AUTO_TEST_CASE (exactFallbackBoundary)
+{
+    // Converted exactly: up to 15 significant digits, |exponent| <= 22.
+    checkAsStrtod("123456789012345e22");
+    checkAsStrtod("-123456789012345e-22");
+    checkAsStrtod("0000001.23456789012345");
+    checkAsStrtod("12345678901234.5E+8");
+    checkAsStrtod("0." + std::string(21, '0') + "1");
+    checkAsStrtod("+7");
+    checkAsStrtod("-0");
+
+    // Just outside: passed on to strtod().
+    checkAsStrtod("123456789012345e23");
+    checkAsStrtod("123456789012345e-23");
+    checkAsStrtod("1234567890123456");
+    checkAsStrtod("9007199254740993");
+    checkAsStrtod("1.0000000000000000001");
+    checkAsStrtod("0." + std::string(22, '0') + "1");
+    checkAsStrtod("1e400");
+    checkAsStrtod("0x1.8p-3");
+    checkAsStrtod("inf");
+    checkAsStrtod("0." + std::string(200, '0') + "1");
+
+    const char* invalid[] = { "1e", "1e+", ".", "-", "1.2.3", "1,5", "abc", "" };
+    for (std::size_t i = 0; i < sizeof invalid / sizeof invalid[0]; ++i) {
+        const std::string text = std::string(invalid[i]) + " 9";
+        double value;
+        BOOST_CHECK (scan_double(text.data(), text.data() + std::strlen(invalid[i]), &value) == 0);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,243 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+/* --- Boost.Test boilerplate --- */
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE StreamingCornerPointChopperTest
+#include <boost/test/unit_test.hpp>
+
+/* --- our own headers --- */
+#include <opm/core/io/eclipse/StreamingCornerpointChopper.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const int nx = 5, ny = 4, nz = 3;
+
+    // A small deck with comments, repeat counts, an ignored keyword
+    // and PERMX in an included file.
+    struct Deck
+    {
+        Deck()
+            : dir(boost::filesystem::temp_directory_path()
+                  / boost::filesystem::unique_path("opm-chopper-%%%%-%%%%"))
+        {
+            boost::filesystem::create_directories(dir);
+            for (int j = 0; j <= ny; ++j) {
+                for (int i = 0; i <= nx; ++i) {
+                    const double c[6] = { 10.0*i, 20.0*j, 0.0, 10.0*i + 1.0, 20.0*j, 100.0 };
+                    coord.insert(coord.end(), c, c + 6);
+                }
+            }
+            for (int z = 0; z < 2*nz; ++z) {
+                for (int n = 0; n < 4*nx*ny; ++n) {
+                    zcorn.push_back(1000.0 + 10.0*((z + 1)/2) + 0.001*n);
+                }
+            }
+            for (int c = 0; c < nx*ny*nz; ++c) {
+                actnum.push_back(c % 7 == 3 ? 0 : 1);
+                poro.push_back(0.1 + 0.001*c);
+                permx.push_back(100.0 + c);
+            }
+
+            std::ofstream os(file().c_str());
+            os << std::setprecision(17);
+            os << "-- Test deck\nSPECGRID\n " << nx << ' ' << ny << ' ' << nz << " 1 F /\n\n";
+            os << "MAPUNITS\n METRES /\n\n";
+            writeField(os, "COORD", coord);
+            writeField(os, "ZCORN", zcorn);
+            // Run-length encoded, with runs crossing rows.
+            os << "ACTNUM\n";
+            for (std::size_t c = 0; c < actnum.size(); ) {
+                std::size_t r = c;
+                while (r < actnum.size() && actnum[r] == actnum[c]) {
+                    ++r;
+                }
+                os << r - c << '*' << actnum[c] << ' ';
+                c = r;
+            }
+            os << "/\n";
+            writeField(os, "PORO", poro);
+            os << "INCLUDE\n 'perm.inc' /\n";
+
+            std::ofstream inc((dir / "perm.inc").string().c_str());
+            inc << std::setprecision(17);
+            writeField(inc, "PERMX", permx);
+        }
+        ~Deck() { boost::filesystem::remove_all(dir); }
+
+        std::string file() const { return (dir / "deck.grdecl").string(); }
+
+        template <typename T>
+        static void writeField(std::ostream& os, const std::string& keyword, const std::vector<T>& v)
+        {
+            os << keyword << " -- comment\n";
+            for (std::size_t i = 0; i < v.size(); ++i) {
+                os << v[i] << ((i % 7 == 6) ? '\n' : ' ');
+            }
+            os << "/\n\n";
+        }
+
+        boost::filesystem::path dir;
+        std::vector<double> coord, zcorn, poro, permx;
+        std::vector<int> actnum;
+    };
+}
+
+BOOST_AUTO_TEST_SUITE ()
+
+BOOST_FIXTURE_TEST_CASE (extractBox, Deck)
+{
+    Opm::StreamingCornerPointChopper chopper(file());
+    BOOST_CHECK_EQUAL(chopper.dimensions()[0], nx);
+    BOOST_CHECK_EQUAL(chopper.dimensions()[1], ny);
+    BOOST_CHECK_EQUAL(chopper.dimensions()[2], nz);
+
+    const int imin = 1, imax = 4, jmin = 1, jmax = 3, kmin = 1, kmax = 3;
+    chopper.chop(imin, imax, jmin, jmax, kmin, kmax);
+    const int mx = imax - imin, my = jmax - jmin, mz = kmax - kmin;
+    BOOST_CHECK_EQUAL(chopper.newDimensions()[0], mx);
+    BOOST_CHECK_EQUAL(chopper.newDimensions()[1], my);
+    BOOST_CHECK_EQUAL(chopper.newDimensions()[2], mz);
+
+    std::vector<double> expected_coord;
+    for (int j = jmin; j <= jmax; ++j) {
+        for (int i = imin; i <= imax; ++i) {
+            const int p = j*(nx + 1) + i;
+            expected_coord.insert(expected_coord.end(), coord.begin() + 6*p, coord.begin() + 6*p + 6);
+        }
+    }
+    BOOST_CHECK(chopper.coord() == expected_coord);
+
+    std::vector<double> expected_zcorn;
+    for (int z = 2*kmin; z < 2*kmax; ++z) {
+        for (int y = 2*jmin; y < 2*jmax; ++y) {
+            for (int x = 2*imin; x < 2*imax; ++x) {
+                expected_zcorn.push_back(zcorn[(z*2*ny + y)*2*nx + x]);
+            }
+        }
+    }
+    BOOST_CHECK(chopper.zcorn() == expected_zcorn);
+
+    std::vector<double> expected_poro, expected_permx;
+    std::vector<int> expected_actnum;
+    for (int k = kmin; k < kmax; ++k) {
+        for (int j = jmin; j < jmax; ++j) {
+            for (int i = imin; i < imax; ++i) {
+                const int c = (k*ny + j)*nx + i;
+                expected_poro.push_back(poro[c]);
+                expected_permx.push_back(permx[c]);
+                expected_actnum.push_back(actnum[c]);
+            }
+        }
+    }
+    BOOST_CHECK(chopper.doubleField("PORO") == expected_poro);
+    BOOST_CHECK(chopper.doubleField("PERMX") == expected_permx);
+    BOOST_CHECK(chopper.intField("ACTNUM") == expected_actnum);
+    BOOST_CHECK(!chopper.hasField("SATNUM"));
+    BOOST_CHECK_THROW(chopper.doubleField("ACTNUM"), std::runtime_error);
+
+    // The text output reads back to the same box.
+    const std::size_t ncell = mx*my*mz;
+    const std::string text = (dir / "box.grdecl").string();
+    chopper.writeGrdecl(text);
+    Opm::StreamingCornerPointChopper reread(text);
+    reread.chop(0, mx, 0, my, 0, mz);
+    BOOST_CHECK(reread.coord() == chopper.coord());
+    BOOST_CHECK(reread.zcorn() == chopper.zcorn());
+    BOOST_REQUIRE_EQUAL(reread.doubleField("PORO").size(), ncell);
+    for (std::size_t c = 0; c < ncell; ++c) {
+        // Written with 15 decimals.
+        BOOST_CHECK_CLOSE(reread.doubleField("PORO")[c], chopper.doubleField("PORO")[c], 1.0e-12);
+    }
+    BOOST_CHECK(reread.intField("ACTNUM") == chopper.intField("ACTNUM"));
+
+    // Binary output: SPECGRID, COORD, ZCORN, ACTNUM, PORO and PERMX,
+    // each a 24 byte header record plus one data record.
+    const std::string binary = (dir / "box.grdecl.bin").string();
+    chopper.writeBinaryGrdecl(binary);
+    const std::size_t expected_size = 6*(24 + 8)
+        + 5*4 + expected_coord.size()*8 + expected_zcorn.size()*8
+        + ncell*4 + 2*ncell*8;
+    BOOST_CHECK_EQUAL(boost::filesystem::file_size(binary), expected_size);
+    std::ifstream is(binary.c_str(), std::ios::binary);
+    char header[24];
+    is.read(header, 24);
+    BOOST_CHECK_EQUAL(std::string(header + 4, 8), "SPECGRID");
+    BOOST_CHECK_EQUAL(std::string(header + 16, 4), "INTE");
+    BOOST_CHECK_EQUAL(int(header[15]), 5);
+}
+
+BOOST_FIXTURE_TEST_CASE (operationKeywords, Deck)
+{
+    // Property names within the records of EQUALS and MULTIPLY, and a
+    // keyword without data before SATNUM.
+    {
+        std::ofstream os(file().c_str(), std::ios::app);
+        os << "EDIT\nEQUALS\n PORO 0.2 1 5 1 4 1 1 / -- comment\n PERMX 1.0/\n 'NTG' 0.5 /\n/\n"
+           << "MULTIPLY\n PERMX 2.0 /\n/\nNOECHO\n";
+        writeField(os, "SATNUM", std::vector<int>(nx*ny*nz, 2));
+    }
+
+    Opm::StreamingCornerPointChopper chopper(file());
+    chopper.chop(0, nx, 0, ny, 0, nz);
+    BOOST_CHECK(chopper.doubleField("PORO") == poro);
+    BOOST_CHECK(chopper.doubleField("PERMX") == permx);
+    BOOST_CHECK(!chopper.hasField("NTG"));
+    BOOST_CHECK(chopper.intField("SATNUM") == std::vector<int>(nx*ny*nz, 2));
+}
+
+BOOST_FIXTURE_TEST_CASE (invalidInput, Deck)
+{
+    Opm::StreamingCornerPointChopper chopper(file());
+    BOOST_CHECK_THROW(chopper.chop(0, nx + 1, 0, ny, 0, nz), std::runtime_error);
+    BOOST_CHECK_THROW(chopper.chop(2, 2, 0, ny, 0, nz), std::runtime_error);
+
+    {
+        std::ofstream os(file().c_str());
+        os << "SPECGRID\n" << nx << ' ' << ny << ' ' << nz << " 1 F /\n";
+        writeField(os, "COORD", coord);
+        os << "ZCORN\n 10*1.0 /\n";
+    }
+    Opm::StreamingCornerPointChopper truncated(file());
+    BOOST_CHECK_THROW(truncated.chop(0, nx, 0, ny, 0, nz), std::runtime_error);
+
+    {
+        std::ofstream os(file().c_str());
+        os << "COORD\n 1 2 3 /\n";
+    }
+    BOOST_CHECK_THROW(Opm::StreamingCornerPointChopper no_dimensions(file()), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,172 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+/* --- Boost.Test boilerplate --- */
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE SummaryOutputWriterTest
+#include <boost/test/unit_test.hpp>
+
+/* --- our own headers --- */
+#include <opm/core/io/SummaryOutputWriter.hpp>
+#include <opm/core/props/BlackoilPhases.hpp>
+#include <opm/core/simulator/BlackoilState.hpp>
+#include <opm/core/simulator/SimulatorTimer.hpp>
+#include <opm/core/simulator/WellState.hpp>
+#include <opm/core/utility/parameters/ParameterGroup.hpp>
+#include <opm/core/utility/Units.hpp>
+
+#include "TempPath.hpp"
+
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct Fixture
+    {
+        Fixture()
+            : dir("opm-summary-%%%%-%%%%")
+        {
+            Opm::parameter::ParameterGroup param;
+            param.insertParameter("num_psteps", "10");
+            param.insertParameter("stepsize_days", "1.0");
+            timer.init(param);
+
+            phase_usage.num_phases = 3;
+            for (int p = 0; p < 3; ++p) {
+                phase_usage.phase_used[p] = 1;
+                phase_usage.phase_pos[p] = p;
+            }
+
+            state.init(10, 20, 3);
+
+            // W1 produces water, oil and gas, W2 injects water.
+            well_state.bhp().assign(2, 2.0e7);
+            const double rates[] = { -1.0, -2.0, -3.0, 5.0, 0.0, 0.0 };
+            well_state.wellRates().assign(rates, rates + 6);
+        }
+
+        void step(Opm::OutputWriter& writer)
+        {
+            writer.writeTimeStep(timer, state, well_state);
+            ++timer;
+        }
+
+        TempPath dir;
+        Opm::SimulatorTimer timer;
+        Opm::PhaseUsage phase_usage;
+        Opm::BlackoilState state;
+        Opm::WellState well_state;
+    };
+}
+
+BOOST_AUTO_TEST_SUITE ()
+
+BOOST_FIXTURE_TEST_CASE (wellAndFieldVectors, Fixture)
+{
+    Opm::SummaryOutputWriter writer(dir.name(), "case", phase_usage,
+                                    std::vector<std::string>(),
+                                    Opm::SummaryOutputWriter::BINARY);
+    writer.writeInit(timer);
+    step(writer);
+    step(writer);
+
+    // A third well appears.
+    well_state.bhp().push_back(1.0e7);
+    well_state.wellRates().push_back(0.0);
+    well_state.wellRates().push_back(-4.0);
+    well_state.wellRates().push_back(0.0);
+    step(writer);
+
+    const double day = Opm::unit::day;
+    const std::vector<double> fopr = { 2.0, 2.0, 6.0 };
+    const std::vector<double> fopt = { 0.0, 2.0*day, 8.0*day };
+    const std::vector<double> fwir = { 5.0, 5.0, 5.0 };
+    const std::vector<double> wopr3 = { 0.0, 0.0, 4.0 };
+    BOOST_CHECK(writer.vector("TIME") == std::vector<double>({ 0.0, day, 2.0*day }));
+    BOOST_CHECK(writer.vector("FOPR") == fopr);
+    BOOST_CHECK(writer.vector("FOPT") == fopt);
+    BOOST_CHECK(writer.vector("FWIR") == fwir);
+    BOOST_CHECK(writer.vector("WGPR:W1") == std::vector<double>(3, 3.0));
+    BOOST_CHECK(writer.vector("WWIT:W2") == std::vector<double>({ 0.0, 5.0*day, 10.0*day }));
+    BOOST_CHECK(writer.vector("WWPR:W2") == std::vector<double>(3, 0.0));
+    BOOST_CHECK(writer.vector("WOPR:W3") == wopr3);
+    BOOST_CHECK(writer.vector("WBHP:W3") == std::vector<double>({ 0.0, 0.0, 1.0e7 }));
+    BOOST_CHECK_THROW(writer.vector("FBHP"), std::runtime_error);
+
+    writer.writeFile();
+    std::map<std::string, std::vector<double> > vectors =
+        Opm::SummaryOutputWriter::readBinary(
+            Opm::SummaryOutputWriter::fileName(dir.name(), "case",
+                                               Opm::SummaryOutputWriter::BINARY));
+    BOOST_CHECK_EQUAL(vectors.size(), writer.vectorNames().size());
+    BOOST_CHECK(vectors["FOPT"] == fopt);
+    BOOST_CHECK(vectors["WOPR:W3"] == wopr3);
+}
+
+BOOST_FIXTURE_TEST_CASE (selection, Fixture)
+{
+    Opm::parameter::ParameterGroup params;
+    params.insertParameter("output_dir", dir.name());
+    params.insertParameter("output_summary_vectors", "FOPR, WBHP");
+    {
+        Opm::SummaryOutputWriter writer(params, std::shared_ptr<const Opm::EclipseState>(),
+                                        phase_usage, 10, 0);
+        writer.writeInit(timer);
+        step(writer);
+        step(writer);
+
+        const std::vector<std::string> names = { "TIME", "FOPR", "WBHP:W1", "WBHP:W2" };
+        BOOST_CHECK(writer.vectorNames() == names);
+    }
+
+    // Written as CSV by the destructor.
+    std::ifstream is(Opm::SummaryOutputWriter::fileName(dir.name(), "output",
+                                                        Opm::SummaryOutputWriter::CSV).c_str());
+    std::string line;
+    BOOST_REQUIRE(std::getline(is, line));
+    BOOST_CHECK_EQUAL(line, "TIME,FOPR,WBHP:W1,WBHP:W2");
+    BOOST_REQUIRE(std::getline(is, line));
+    BOOST_CHECK_EQUAL(line, "0,2,20000000,20000000");
+    BOOST_CHECK(std::getline(is, line));
+    BOOST_CHECK(!std::getline(is, line));
+
+    params.insertParameter("output_summary_vectors", "FOPR,FBHP");
+    BOOST_CHECK_THROW(Opm::SummaryOutputWriter(params, std::shared_ptr<const Opm::EclipseState>(),
+                                               phase_usage, 10, 0),
+                      std::runtime_error);
+
+    params.insertParameter("output_summary_vectors", "FOPR");
+    params.insertParameter("output_summary_format", "hdf5");
+    BOOST_CHECK_THROW(Opm::SummaryOutputWriter(params, std::shared_ptr<const Opm::EclipseState>(),
+                                               phase_usage, 10, 0),
+                      std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -17,6 +17,7 @@
 
 /* --- our own headers --- */
 #include <algorithm>
+#include <string>
 #include <vector>
 #include <opm/core/grid.h>
 #include <opm/core/grid/cornerpoint_grid.h>  /* compute_geometry */
@@ -26,6 +27,8 @@
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
 
+#include "TempPath.hpp"
+
 using namespace std;
 
 
@@ -108,3 +111,63 @@ BOOST_AUTO_TEST_CASE(EqualEclipseGrid) {
     destroy_grid( cgrid2 );
 }
 
+
+
+BOOST_AUTO_TEST_CASE(Cache) {
+    const char *deckData =
+        "RUNSPEC\n"
+        "\n"
+        "DIMENS\n"
+        " 4 3 2 /\n"
+        "GRID\n"
+        "DXV\n"
+        "4*0.25 /\n"
+        "DYV\n"
+        "3*0.25 /\n"
+        "DZV\n"
+        "2*0.25 /\n"
+        "TOPS\n"
+        "12*0.25 /\n"
+        "EDIT\n"
+        "\n";
+    std::string changedData(deckData);
+    changedData.replace(changedData.find("2*0.25"), 6, "2*0.50");
+
+    Opm::ParserPtr parser(new Opm::Parser() );
+    std::shared_ptr<const Opm::EclipseGrid> grid(new Opm::EclipseGrid(parser->parseString(deckData)));
+    std::shared_ptr<const Opm::EclipseGrid> changed(new Opm::EclipseGrid(parser->parseString(changedData)));
+    const std::vector<double> poreVolumes;
+
+    TempPath dir("opm-gridcache-%%%%-%%%%");
+    boost::filesystem::create_directory(dir.path);
+
+    Opm::GridManager uncached(grid, poreVolumes);
+    BOOST_CHECK_EQUAL(uncached.cacheStatus(), Opm::GridManager::NotCached);
+    BOOST_CHECK(uncached.cacheFile().empty());
+
+    // The first construction stores the grid, the second maps it.
+    Opm::GridManager built(grid, poreVolumes, dir.name());
+    BOOST_CHECK_EQUAL(built.cacheStatus(), Opm::GridManager::WrittenToCache);
+    BOOST_CHECK(boost::filesystem::exists(built.cacheFile()));
+    Opm::GridManager mapped(grid, poreVolumes, dir.name());
+    BOOST_CHECK_EQUAL(mapped.cacheStatus(), Opm::GridManager::ReadFromCache);
+    BOOST_CHECK_EQUAL(mapped.cacheFile(), built.cacheFile());
+    BOOST_CHECK(grid_equal(mapped.c_grid(), uncached.c_grid()));
+
+    // Changed input is not served the grid stored for other input,
+    // even from a file of its own name.
+    Opm::GridManager first(changed, poreVolumes, dir.name());
+    BOOST_CHECK_EQUAL(first.cacheStatus(), Opm::GridManager::WrittenToCache);
+    BOOST_CHECK(first.cacheFile() != built.cacheFile());
+    boost::filesystem::copy_file(built.cacheFile(), first.cacheFile(),
+                                 boost::filesystem::copy_option::overwrite_if_exists);
+    Opm::GridManager rebuilt(changed, poreVolumes, dir.name());
+    BOOST_CHECK_EQUAL(rebuilt.cacheStatus(), Opm::GridManager::WrittenToCache);
+    BOOST_CHECK(grid_equal(rebuilt.c_grid(), first.c_grid()));
+    BOOST_CHECK(!grid_equal(rebuilt.c_grid(), uncached.c_grid()));
+
+    // Failure to store the grid is reported, not thrown.
+    Opm::GridManager unwritten(grid, poreVolumes, (dir.path / "missing").string());
+    BOOST_CHECK_EQUAL(unwritten.cacheStatus(), Opm::GridManager::CacheWriteFailed);
+    BOOST_CHECK(grid_equal(unwritten.c_grid(), uncached.c_grid()));
+}
@@ -0,0 +1,166 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+/* --- Boost.Test boilerplate --- */
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE VagTest
+#include <boost/test/unit_test.hpp>
+
+/* --- our own headers --- */
+#include <opm/core/io/vag/vag.hpp>
+#include <opm/core/grid.h>
+#include <opm/core/grid/cart_grid.h>
+
+#include "TempPath.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    // The layout expected by readVagGrid(), with the counts on the line
+    // after each "Number of" and the number of vertices after "Vertices".
+    void writeVag(const std::string& filename, Opm::VAG& vag)
+    {
+        std::ofstream os(filename.c_str());
+        os << std::setprecision(17);
+        os << "File in the Vag grid format\n";
+        os << "Number of vertices\n" << vag.number_of_vertices << '\n';
+        os << "Number of control volume\n" << vag.number_of_volumes << '\n';
+        os << "Number of faces\n" << vag.number_of_faces << '\n';
+        os << "Number of edges\n" << vag.number_of_edges << '\n';
+        os << "Vertices " << vag.number_of_vertices << '\n';
+        Opm::writeVector(os, vag.vertices, 3);
+        os << "Volumes->faces " << vag.number_of_volumes << '\n';
+        Opm::writePosStruct(os, vag.volumes_to_faces);
+        os << "Volumes->Vertices " << vag.number_of_volumes << '\n';
+        Opm::writePosStruct(os, vag.volumes_to_vertices);
+        os << "Faces->edges " << vag.number_of_faces << '\n';
+        Opm::writePosStruct(os, vag.faces_to_edges);
+        os << "Faces->vertices " << vag.number_of_faces << '\n';
+        Opm::writePosStruct(os, vag.faces_to_vertices);
+        os << "Faces->Control volumes " << vag.number_of_faces << '\n';
+        Opm::writeVector(os, vag.faces_to_volumes, 2);
+        os << "Edges " << vag.number_of_edges << '\n';
+        Opm::writeVector(os, vag.edges, 2);
+        os << "Material number 1\n";
+        for (int c = 0; c < vag.number_of_volumes; ++c) {
+            os << c + 1 << " 1 0.25\n";
+        }
+    }
+
+    template <typename T>
+    bool equalArrays(const T* a, const T* b, int n)
+    {
+        return std::equal(a, a + n, b);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE ()
+
+BOOST_AUTO_TEST_CASE (sameGridAsReadVagGrid)
+{
+    UnstructuredGrid* cart = create_grid_cart3d(4, 3, 2);
+    BOOST_REQUIRE(cart != 0);
+    // Perturb the nodes so that both the exact and the fallback number
+    // conversions are exercised.
+    for (int n = 0; n < cart->number_of_nodes; ++n) {
+        cart->node_coordinates[3*n + 0] += 0.1 * (n % 3);
+        cart->node_coordinates[3*n + 2] *= 1.0 / 3.0;
+    }
+    Opm::VAG vag;
+    Opm::unstructuredGridToVag(*cart, vag);
+
+    TempPath file("opm-vag-%%%%-%%%%.dat");
+    writeVag(file.name(), vag);
+
+    Opm::VAG vag_read;
+    {
+        std::ifstream is(file.name().c_str());
+        Opm::readVagGrid(is, vag_read);
+    }
+    UnstructuredGrid* expected = allocate_grid(3, vag_read.number_of_volumes,
+                                               vag_read.number_of_faces,
+                                               vag_read.faces_to_vertices.value.size(),
+                                               vag_read.volumes_to_faces.value.size(),
+                                               vag_read.number_of_vertices);
+    Opm::vagToUnstructuredGrid(vag_read, *expected);
+
+    UnstructuredGrid* grid = Opm::readVagUnstructuredGrid(file.name());
+    BOOST_REQUIRE(grid != 0);
+
+    const int nc = expected->number_of_cells;
+    const int nf = expected->number_of_faces;
+    const int nn = expected->number_of_nodes;
+    BOOST_CHECK_EQUAL(grid->dimensions, 3);
+    BOOST_CHECK_EQUAL(grid->number_of_cells, nc);
+    BOOST_CHECK_EQUAL(grid->number_of_faces, nf);
+    BOOST_CHECK_EQUAL(grid->number_of_nodes, nn);
+    BOOST_CHECK_EQUAL(nc, cart->number_of_cells);
+
+    BOOST_CHECK(equalArrays(grid->node_coordinates, cart->node_coordinates, 3*nn));
+    BOOST_CHECK(equalArrays(grid->node_coordinates, expected->node_coordinates, 3*nn));
+    BOOST_CHECK(equalArrays(grid->face_nodepos, expected->face_nodepos, nf + 1));
+    BOOST_CHECK(equalArrays(grid->face_nodes, expected->face_nodes, expected->face_nodepos[nf]));
+    BOOST_CHECK(equalArrays(grid->cell_facepos, expected->cell_facepos, nc + 1));
+    BOOST_CHECK(equalArrays(grid->cell_faces, expected->cell_faces, expected->cell_facepos[nc]));
+    BOOST_CHECK(equalArrays(grid->face_cells, expected->face_cells, 2*nf));
+    BOOST_CHECK(equalArrays(grid->cell_volumes, expected->cell_volumes, nc));
+    BOOST_CHECK(equalArrays(grid->cell_centroids, expected->cell_centroids, 3*nc));
+    BOOST_CHECK(equalArrays(grid->face_areas, expected->face_areas, nf));
+    BOOST_CHECK(equalArrays(grid->face_normals, expected->face_normals, 3*nf));
+
+    destroy_grid(grid);
+    destroy_grid(expected);
+    destroy_grid(cart);
+}
+
+BOOST_AUTO_TEST_CASE (malformedFiles)
+{
+    TempPath file("opm-vag-%%%%-%%%%.dat");
+    BOOST_CHECK_THROW(Opm::readVagUnstructuredGrid(file.name()), std::runtime_error);
+
+    {
+        std::ofstream os(file.name().c_str());
+        os << "Vertices 2\n0 0 0\n1 1 1\n"
+           << "Volumes->faces 1\n1 1\n"
+           << "Faces->vertices 1\n2 1 3\n"
+           << "Faces->Control volumes 1\n1 0\n";
+    }
+    // Vertex 3 does not exist.
+    BOOST_CHECK_THROW(Opm::readVagUnstructuredGrid(file.name()), std::runtime_error);
+
+    {
+        std::ofstream os(file.name().c_str());
+        os << "Vertices 2\n0 0 0\n1 x 1\n";
+    }
+    BOOST_CHECK_THROW(Opm::readVagUnstructuredGrid(file.name()), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
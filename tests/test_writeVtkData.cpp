@@ -0,0 +1,203 @@
+/*
+  Copyright 2014 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+/* --- Boost.Test boilerplate --- */
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE WriteVtkDataTest
+#include <boost/test/unit_test.hpp>
+
+/* --- our own headers --- */
+#include <opm/core/io/vtk/writeVtkData.hpp>
+#include <opm/core/grid/GridManager.hpp>
+#include <opm/core/grid.h>
+
+#include <boost/cstdint.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::string readFile(const std::string& filename)
+    {
+        std::ifstream is(filename.c_str(), std::ios::in | std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(is),
+                           std::istreambuf_iterator<char>());
+    }
+
+    std::string attribute(const std::string& vtu,
+                          const std::string& tag_start,
+                          const std::string& name)
+    {
+        const std::string::size_type tag = vtu.find(tag_start);
+        BOOST_REQUIRE(tag != std::string::npos);
+        const std::string key = " " + name + "=\"";
+        const std::string::size_type begin = vtu.find(key, tag) + key.size();
+        return vtu.substr(begin, vtu.find('"', begin) - begin);
+    }
+
+    // Extract a named array from the raw appended data of a vtu file.
+    template <typename T>
+    std::vector<T> appendedArray(const std::string& vtu, const std::string& name)
+    {
+        const std::string tag_start = "Name=\"" + name + "\"";
+        const boost::uint64_t offset =
+            boost::lexical_cast<boost::uint64_t>(attribute(vtu, tag_start, "offset"));
+        const std::string::size_type data =
+            vtu.find("<AppendedData encoding=\"raw\">");
+        BOOST_REQUIRE(data != std::string::npos);
+        const char* pos = vtu.data() + vtu.find('_', data) + 1 + offset;
+        boost::uint64_t size;
+        std::memcpy(&size, pos, sizeof size);
+        std::vector<T> values(size/sizeof(T));
+        std::memcpy(values.data(), pos + sizeof size, size);
+        return values;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE ()
+
+BOOST_AUTO_TEST_CASE (appendedBinary)
+{
+    Opm::GridManager gm(3, 2, 2);
+    const UnstructuredGrid& g = *gm.c_grid();
+    const int nc = g.number_of_cells;
+
+    std::vector<double> pressure(nc), saturation(2*nc);
+    for (int c = 0; c < nc; ++c) {
+        pressure[c] = 1.5*c;
+        saturation[2*c + 0] = 0.1*c;
+        saturation[2*c + 1] = 1.0 - 0.1*c;
+    }
+    Opm::DataMap dm;
+    dm["pressure"] = &pressure;
+    dm["saturation"] = &saturation;
+
+    std::ostringstream os;
+    Opm::writeVtkDataBinary(g, dm, os);
+    const std::string vtu = os.str();
+
+    BOOST_CHECK_EQUAL(attribute(vtu, "<Piece", "NumberOfCells"), "12");
+    BOOST_CHECK_EQUAL(attribute(vtu, "<Piece", "NumberOfPoints"), "36");
+    BOOST_CHECK_EQUAL(attribute(vtu, "<CellData", "Scalars"), "saturation");
+
+    const std::vector<double> p = appendedArray<double>(vtu, "pressure");
+    BOOST_CHECK_EQUAL_COLLECTIONS(p.begin(), p.end(), pressure.begin(), pressure.end());
+    const std::vector<double> s = appendedArray<double>(vtu, "saturation");
+    BOOST_CHECK_EQUAL_COLLECTIONS(s.begin(), s.end(), saturation.begin(), saturation.end());
+
+    const std::vector<double> coords = appendedArray<double>(vtu, "Coordinates");
+    BOOST_CHECK_EQUAL_COLLECTIONS(coords.begin(), coords.end(),
+                                  g.node_coordinates, g.node_coordinates + 3*g.number_of_nodes);
+
+    // Hexahedra: eight points and six quadrilateral faces per cell.
+    const std::vector<int> offsets = appendedArray<int>(vtu, "offsets");
+    const std::vector<int> faceoffsets = appendedArray<int>(vtu, "faceoffsets");
+    BOOST_REQUIRE_EQUAL(offsets.size(), std::size_t(nc));
+    BOOST_REQUIRE_EQUAL(faceoffsets.size(), std::size_t(nc));
+    for (int c = 0; c < nc; ++c) {
+        BOOST_CHECK_EQUAL(offsets[c], 8*(c + 1));
+        BOOST_CHECK_EQUAL(faceoffsets[c], (1 + 6*5)*(c + 1));
+    }
+    const std::vector<unsigned char> types = appendedArray<unsigned char>(vtu, "types");
+    BOOST_CHECK_EQUAL(types.size(), std::size_t(nc));
+    BOOST_CHECK(types[0] == 42);
+}
+
+BOOST_AUTO_TEST_CASE (parallelPieces)
+{
+    Opm::GridManager gm(5, 4, 3);
+    const UnstructuredGrid& g = *gm.c_grid();
+    const int nc = g.number_of_cells;
+
+    std::vector<double> pressure(nc);
+    for (int c = 0; c < nc; ++c) {
+        pressure[c] = 100.0 + c;
+    }
+    Opm::DataMap dm;
+    dm["pressure"] = &pressure;
+
+    boost::filesystem::path dir = boost::filesystem::temp_directory_path()
+        / boost::filesystem::unique_path("opm-vtk-%%%%-%%%%");
+    boost::filesystem::create_directories(dir);
+    const std::string basename = (dir / "state").string();
+
+    const int num_pieces = 4;
+    Opm::writeVtkDataParallel(g, dm, basename, num_pieces);
+
+    const std::string pvtu = readFile(basename + ".pvtu");
+    BOOST_CHECK_EQUAL(attribute(pvtu, "<VTKFile", "type"), "PUnstructuredGrid");
+    std::vector<double> gathered;
+    std::string::size_type pos = 0;
+    for (int p = 0; p < num_pieces; ++p) {
+        pos = pvtu.find("<Piece", pos);
+        BOOST_REQUIRE(pos != std::string::npos);
+        const std::string source = attribute(pvtu.substr(pos), "<Piece", "Source");
+        BOOST_CHECK_EQUAL(source, "state_" + boost::lexical_cast<std::string>(p) + ".vtu");
+        ++pos;
+
+        const std::string vtu = readFile((dir / source).string());
+        const std::vector<double> piece = appendedArray<double>(vtu, "pressure");
+        BOOST_CHECK_EQUAL(attribute(vtu, "<Piece", "NumberOfCells"),
+                          boost::lexical_cast<std::string>(piece.size()));
+        gathered.insert(gathered.end(), piece.begin(), piece.end());
+    }
+    BOOST_CHECK(pvtu.find("<Piece", pos) == std::string::npos);
+    BOOST_CHECK_EQUAL_COLLECTIONS(gathered.begin(), gathered.end(),
+                                  pressure.begin(), pressure.end());
+
+    boost::filesystem::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_CASE (legacyBinary)
+{
+    std::array<int, 3> dims = {{ 2, 1, 1 }};
+    std::array<double, 3> cell_size = {{ 1.0, 2.0, 3.0 }};
+    std::vector<double> foo = { 1.0, -2.0 };
+    Opm::DataMap dm;
+    dm["foo"] = &foo;
+
+    std::ostringstream os;
+    Opm::writeVtkDataBinary(dims, cell_size, dm, os);
+    const std::string vtk = os.str();
+
+    BOOST_CHECK(vtk.find("\nBINARY\n") != std::string::npos);
+    const std::string table = "LOOKUP_TABLE foo_table \n";
+    const std::string::size_type data = vtk.find(table) + table.size();
+    BOOST_REQUIRE_EQUAL(vtk.size(), data + 2*4 + 1);
+
+    // Big endian single precision: 1.0f == 0x3f800000, -2.0f == 0xc0000000.
+    const unsigned char expected[8] = { 0x3f, 0x80, 0x00, 0x00, 0xc0, 0x00, 0x00, 0x00 };
+    BOOST_CHECK(std::memcmp(vtk.data() + data, expected, 8) == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()